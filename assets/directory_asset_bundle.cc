@@ -35,8 +35,15 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
     return nullptr;
   }
 
-  auto mapping = std::make_unique<fml::FileMapping>(fml::OpenFile(
-      descriptor_, asset_name.c_str(), false, fml::FilePermission::kRead));
+  // Assets are asked for when they are about to be used, usually in full, so
+  // the read is started right away.
+  auto mapping = std::make_unique<fml::FileMapping>(
+      fml::OpenFile(descriptor_, asset_name.c_str(), false,
+                    fml::FilePermission::kRead),
+      std::initializer_list<fml::FileMapping::Protection>{
+          fml::FileMapping::Protection::kRead},
+      std::initializer_list<fml::FileMapping::Advice>{
+          fml::FileMapping::Advice::kWillNeed});
 
   if (mapping->GetMapping() == nullptr) {
     return nullptr;
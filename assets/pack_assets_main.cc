@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Packs the contents of a Flutter assets directory into a single file that is
+// read by |PackedAssetBundle|.
+//
+//   pack_assets --assets-dir=<flutter_assets> [--output=<file>]
+//
+// The output defaults to |kPackedAssetBundleFileName| inside the assets
+// directory, where the engine looks for it.
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <iostream>
+#include <string>
+
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+// Adds every non-empty file below |path| using its path relative to the assets
+// directory as the asset name, which is how |DirectoryAssetBundle| resolves
+// it.
+static bool AddDirectory(PackedAssetBundleBuilder& builder,
+                         const std::string& path,
+                         const std::string& prefix) {
+  DIR* directory = ::opendir(path.c_str());
+  if (directory == nullptr) {
+    std::cerr << "Could not open directory " << path << std::endl;
+    return false;
+  }
+
+  bool success = true;
+  while (struct dirent* entry = ::readdir(directory)) {
+    const std::string name = entry->d_name;
+    if (name == "." || name == "..") {
+      continue;
+    }
+    if (prefix.empty() && name == kPackedAssetBundleFileName) {
+      continue;
+    }
+
+    const std::string entry_path = path + "/" + name;
+    const std::string asset_name = prefix + name;
+    struct stat stat_buffer = {};
+    if (::stat(entry_path.c_str(), &stat_buffer) != 0) {
+      std::cerr << "Could not stat " << entry_path << std::endl;
+      success = false;
+      break;
+    }
+
+    if (S_ISDIR(stat_buffer.st_mode)) {
+      if (!AddDirectory(builder, entry_path, asset_name + "/")) {
+        success = false;
+        break;
+      }
+      continue;
+    }
+
+    if (!S_ISREG(stat_buffer.st_mode) || stat_buffer.st_size == 0) {
+      continue;
+    }
+
+    auto mapping = fml::FileMapping::CreateReadOnly(entry_path);
+    if (!mapping || mapping->GetMapping() == nullptr) {
+      std::cerr << "Could not read " << entry_path << std::endl;
+      success = false;
+      break;
+    }
+    builder.AddAsset(asset_name, std::move(mapping));
+  }
+
+  ::closedir(directory);
+  return success;
+}
+
+static int PackAssets(const fml::CommandLine& command_line) {
+  std::string assets_dir;
+  if (!command_line.GetOptionValue("assets-dir", &assets_dir)) {
+    std::cerr << "Usage: pack_assets --assets-dir=<dir> [--output=<file>]"
+              << std::endl;
+    return 1;
+  }
+
+  std::string output = assets_dir + "/" + kPackedAssetBundleFileName;
+  command_line.GetOptionValue("output", &output);
+
+  PackedAssetBundleBuilder builder;
+  if (!AddDirectory(builder, assets_dir, "")) {
+    return 1;
+  }
+
+  fml::DataMapping pack(builder.Build());
+
+  auto current_directory =
+      fml::OpenDirectory(".", false, fml::FilePermission::kRead);
+  if (!fml::WriteAtomically(current_directory, output.c_str(), pack)) {
+    std::cerr << "Could not write " << output << std::endl;
+    return 1;
+  }
+
+  std::cout << "Packed " << builder.GetAssetCount() << " assets ("
+            << pack.GetSize() << " bytes) into " << output << std::endl;
+  return 0;
+}
+
+}  // namespace flutter
+
+int main(int argc, char* argv[]) {
+  return flutter::PackAssets(fml::CommandLineFromArgcArgv(argc, argv));
+}
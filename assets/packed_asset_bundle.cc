@@ -0,0 +1,256 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+const char kPackedAssetBundleFileName[] = "assets.pack";
+
+// The layout of a pack is:
+//
+//   PackHeader
+//   PackEntry[entry_count], sorted by asset name
+//   Asset names, not terminated
+//   Asset contents, each aligned to kPackDataAlignment
+//
+// All integers are little endian.
+namespace {
+
+constexpr char kPackMagic[8] = {'F', 'L', 'T', 'A', 'S', 'S', 'E', 'T'};
+constexpr uint32_t kPackVersion = 1;
+constexpr size_t kPackDataAlignment = 16;
+
+struct PackHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+};
+
+struct PackEntry {
+  uint32_t name_offset;
+  uint32_t name_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+};
+
+static_assert(sizeof(PackHeader) == 16, "Pack header must not be padded.");
+static_assert(sizeof(PackEntry) == 24, "Pack entry must not be padded.");
+
+// The pack is only guaranteed to be byte aligned.
+PackEntry ReadEntry(const uint8_t* entries, size_t index) {
+  PackEntry entry;
+  std::memcpy(&entry, entries + index * sizeof(PackEntry), sizeof(PackEntry));
+  return entry;
+}
+
+class PackedAssetMapping final : public fml::Mapping {
+ public:
+  PackedAssetMapping(std::shared_ptr<const fml::Mapping> pack,
+                     const uint8_t* data,
+                     size_t size)
+      : pack_(std::move(pack)), data_(data), size_(size) {}
+
+  // |Mapping|
+  size_t GetSize() const override { return size_; }
+
+  // |Mapping|
+  const uint8_t* GetMapping() const override { return data_; }
+
+ private:
+  const std::shared_ptr<const fml::Mapping> pack_;
+  const uint8_t* const data_;
+  const size_t size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetMapping);
+};
+
+}  // namespace
+
+PackedAssetBundle::PackedAssetBundle(std::unique_ptr<fml::Mapping> pack)
+    : pack_(std::move(pack)) {
+  is_valid_ = Validate();
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+std::unique_ptr<PackedAssetBundle> PackedAssetBundle::OpenInDirectory(
+    const fml::UniqueFD& directory) {
+  if (!directory.is_valid() ||
+      !fml::FileExists(directory, kPackedAssetBundleFileName)) {
+    return nullptr;
+  }
+
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(directory, kPackedAssetBundleFileName);
+  if (!mapping) {
+    return nullptr;
+  }
+
+  auto bundle = std::make_unique<PackedAssetBundle>(std::move(mapping));
+  if (!bundle->IsValid()) {
+    FML_LOG(ERROR) << "Ignoring invalid asset pack "
+                   << kPackedAssetBundleFileName;
+    return nullptr;
+  }
+  return bundle;
+}
+
+// Checks every entry once so that lookups need no bounds checks.
+bool PackedAssetBundle::Validate() {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::Validate");
+  if (!pack_ || pack_->GetMapping() == nullptr) {
+    return false;
+  }
+
+  const uint8_t* base = pack_->GetMapping();
+  const size_t size = pack_->GetSize();
+
+  PackHeader header;
+  if (size < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, base, sizeof(header));
+  if (std::memcmp(header.magic, kPackMagic, sizeof(kPackMagic)) != 0 ||
+      header.version != kPackVersion) {
+    return false;
+  }
+
+  // Checked by division so that the size of the entries cannot overflow on
+  // 32-bit targets.
+  if (header.entry_count > (size - sizeof(header)) / sizeof(PackEntry)) {
+    return false;
+  }
+  const size_t entries_end =
+      sizeof(header) + header.entry_count * sizeof(PackEntry);
+
+  std::string_view previous_name;
+  for (size_t i = 0; i < header.entry_count; i++) {
+    const PackEntry entry = ReadEntry(base + sizeof(header), i);
+    if (entry.name_offset < entries_end ||
+        static_cast<uint64_t>(entry.name_offset) + entry.name_size > size ||
+        entry.data_offset > size || entry.data_size > size - entry.data_offset) {
+      return false;
+    }
+    std::string_view name(
+        reinterpret_cast<const char*>(base + entry.name_offset),
+        entry.name_size);
+    if (i > 0 && !(previous_name < name)) {
+      return false;
+    }
+    previous_name = name;
+  }
+
+  entries_ = base + sizeof(header);
+  entry_count_ = header.entry_count;
+  return true;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  const uint8_t* base = pack_->GetMapping();
+  const std::string_view name(asset_name);
+
+  size_t low = 0;
+  size_t high = entry_count_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const PackEntry entry = ReadEntry(entries_, middle);
+    const std::string_view entry_name(
+        reinterpret_cast<const char*>(base + entry.name_offset),
+        entry.name_size);
+    const int comparison = entry_name.compare(name);
+    if (comparison == 0) {
+      return std::make_unique<PackedAssetMapping>(
+          pack_, base + entry.data_offset, entry.data_size);
+    }
+    if (comparison < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return nullptr;
+}
+
+PackedAssetBundleBuilder::PackedAssetBundleBuilder() = default;
+
+PackedAssetBundleBuilder::~PackedAssetBundleBuilder() = default;
+
+void PackedAssetBundleBuilder::AddAsset(const std::string& asset_name,
+                                        std::unique_ptr<fml::Mapping> contents) {
+  if (asset_name.empty() || contents == nullptr) {
+    return;
+  }
+  assets_[asset_name] = std::move(contents);
+}
+
+static size_t AlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+std::vector<uint8_t> PackedAssetBundleBuilder::Build() const {
+  PackHeader header = {};
+  std::memcpy(header.magic, kPackMagic, sizeof(kPackMagic));
+  header.version = kPackVersion;
+  header.entry_count = assets_.size();
+
+  // Lay out the names after the index, then the contents.
+  size_t offset = sizeof(header) + assets_.size() * sizeof(PackEntry);
+  std::vector<PackEntry> entries;
+  entries.reserve(assets_.size());
+  for (const auto& asset : assets_) {
+    PackEntry entry = {};
+    entry.name_offset = offset;
+    entry.name_size = asset.first.size();
+    offset += asset.first.size();
+    entries.push_back(entry);
+  }
+  size_t index = 0;
+  for (const auto& asset : assets_) {
+    offset = AlignUp(offset, kPackDataAlignment);
+    entries[index].data_offset = offset;
+    entries[index].data_size = asset.second->GetSize();
+    offset += asset.second->GetSize();
+    index++;
+  }
+
+  std::vector<uint8_t> pack(offset, 0);
+  std::memcpy(pack.data(), &header, sizeof(header));
+  std::memcpy(pack.data() + sizeof(header), entries.data(),
+              entries.size() * sizeof(PackEntry));
+  index = 0;
+  for (const auto& asset : assets_) {
+    const PackEntry& entry = entries[index++];
+    std::memcpy(pack.data() + entry.name_offset, asset.first.data(),
+                entry.name_size);
+    if (entry.data_size > 0) {
+      std::memcpy(pack.data() + entry.data_offset,
+                  asset.second->GetMapping(), entry.data_size);
+    }
+  }
+  return pack;
+}
+
+}  // namespace flutter
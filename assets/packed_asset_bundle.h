@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+// The name of the packed bundle looked for in an assets directory.
+extern const char kPackedAssetBundleFileName[];
+
+// An asset resolver backed by a single file that contains every asset along
+// with a sorted index of their names.
+//
+// The file is mapped once. Looking up an asset is a binary search of the index
+// and the returned mapping refers directly to the pack, so there is no file
+// system access per asset.
+class PackedAssetBundle : public AssetResolver {
+ public:
+  explicit PackedAssetBundle(std::unique_ptr<fml::Mapping> pack);
+
+  ~PackedAssetBundle() override;
+
+  // Opens |kPackedAssetBundleFileName| in |directory|. Returns null if there
+  // is no valid pack in the directory.
+  static std::unique_ptr<PackedAssetBundle> OpenInDirectory(
+      const fml::UniqueFD& directory);
+
+  size_t GetAssetCount() const { return entry_count_; }
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+ private:
+  // Shared with the mappings handed out so that they can outlive the bundle.
+  std::shared_ptr<const fml::Mapping> pack_;
+  const uint8_t* entries_ = nullptr;
+  size_t entry_count_ = 0;
+  bool is_valid_ = false;
+
+  bool Validate();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+// Collects assets and serializes them in the format read by
+// |PackedAssetBundle|.
+class PackedAssetBundleBuilder {
+ public:
+  PackedAssetBundleBuilder();
+
+  ~PackedAssetBundleBuilder();
+
+  // Adds (or replaces) the asset with the given name.
+  void AddAsset(const std::string& asset_name,
+                std::unique_ptr<fml::Mapping> contents);
+
+  size_t GetAssetCount() const { return assets_.size(); }
+
+  std::vector<uint8_t> Build() const;
+
+ private:
+  std::map<std::string, std::unique_ptr<fml::Mapping>> assets_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundleBuilder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// Roughly what an app loads during startup: the manifests and a few hundred
+// small icons and JSON files.
+class AssetDirectoryFixture {
+ public:
+  explicit AssetDirectoryFixture(size_t asset_count) {
+    icons_ = fml::CreateDirectory(directory_.fd(), {"icons"},
+                                  fml::FilePermission::kReadWrite);
+    FML_CHECK(icons_.is_valid());
+
+    PackedAssetBundleBuilder builder;
+    for (size_t i = 0; i < asset_count; i++) {
+      const std::string file_name = "icon_" + std::to_string(i) + ".png";
+      std::vector<uint8_t> contents(1024 + (i * 37) % 4096,
+                                    static_cast<uint8_t>(i));
+      fml::DataMapping mapping(contents);
+      FML_CHECK(fml::WriteAtomically(icons_, file_name.c_str(), mapping));
+      builder.AddAsset("icons/" + file_name,
+                       std::make_unique<fml::DataMapping>(contents));
+      file_names_.push_back(file_name);
+      asset_names_.push_back("icons/" + file_name);
+    }
+
+    fml::DataMapping pack(builder.Build());
+    FML_CHECK(fml::WriteAtomically(directory_.fd(), kPackedAssetBundleFileName,
+                                   pack));
+  }
+
+  ~AssetDirectoryFixture() {
+    for (const auto& file_name : file_names_) {
+      fml::UnlinkFile(icons_, file_name.c_str());
+    }
+    icons_.reset();
+    fml::UnlinkDirectory(directory_.fd(), "icons");
+    fml::UnlinkFile(directory_.fd(), kPackedAssetBundleFileName);
+  }
+
+  const fml::UniqueFD& directory() { return directory_.fd(); }
+
+  const std::vector<std::string>& asset_names() const { return asset_names_; }
+
+ private:
+  fml::ScopedTemporaryDirectory directory_;
+  fml::UniqueFD icons_;
+  std::vector<std::string> file_names_;
+  std::vector<std::string> asset_names_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AssetDirectoryFixture);
+};
+
+// Reads one byte of every asset so that page faults are accounted for.
+static size_t TouchAllAssets(const AssetResolver& resolver,
+                             const std::vector<std::string>& asset_names) {
+  size_t checksum = 0;
+  for (const auto& asset_name : asset_names) {
+    auto mapping = resolver.GetAsMapping(asset_name);
+    FML_CHECK(mapping && mapping->GetSize() > 0);
+    checksum += mapping->GetMapping()[0];
+  }
+  return checksum;
+}
+
+static void BM_DirectoryAssetBundleStartup(benchmark::State& state) {
+  AssetDirectoryFixture fixture(state.range(0));
+  while (state.KeepRunning()) {
+    DirectoryAssetBundle bundle(fml::Duplicate(fixture.directory().get()));
+    benchmark::DoNotOptimize(TouchAllAssets(bundle, fixture.asset_names()));
+  }
+}
+
+static void BM_PackedAssetBundleStartup(benchmark::State& state) {
+  AssetDirectoryFixture fixture(state.range(0));
+  while (state.KeepRunning()) {
+    auto bundle = PackedAssetBundle::OpenInDirectory(fixture.directory());
+    FML_CHECK(bundle);
+    benchmark::DoNotOptimize(TouchAllAssets(*bundle, fixture.asset_names()));
+  }
+}
+
+BENCHMARK(BM_DirectoryAssetBundleStartup)
+    ->Arg(50)
+    ->Arg(300)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PackedAssetBundleStartup)
+    ->Arg(50)
+    ->Arg(300)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
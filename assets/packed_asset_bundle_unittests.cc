@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static std::unique_ptr<fml::Mapping> MappingFromString(const std::string& s) {
+  return std::make_unique<fml::DataMapping>(
+      std::vector<uint8_t>(s.begin(), s.end()));
+}
+
+static std::string StringFromMapping(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+static std::unique_ptr<PackedAssetBundle> BuildBundle(
+    const std::vector<std::pair<std::string, std::string>>& assets) {
+  PackedAssetBundleBuilder builder;
+  for (const auto& asset : assets) {
+    builder.AddAsset(asset.first, MappingFromString(asset.second));
+  }
+  return std::make_unique<PackedAssetBundle>(
+      std::make_unique<fml::DataMapping>(builder.Build()));
+}
+
+TEST(PackedAssetBundleTest, CanResolvePackedAssets) {
+  auto bundle = BuildBundle({
+      {"FontManifest.json", "[]"},
+      {"assets/icons/a.png", "png a"},
+      {"assets/icons/b.png", "png b"},
+      {"AssetManifest.json", "{}"},
+  });
+  ASSERT_TRUE(bundle->IsValid());
+  ASSERT_EQ(bundle->GetAssetCount(), 4u);
+
+  auto mapping = bundle->GetAsMapping("assets/icons/b.png");
+  ASSERT_TRUE(mapping);
+  ASSERT_EQ(StringFromMapping(*mapping), "png b");
+  mapping = bundle->GetAsMapping("AssetManifest.json");
+  ASSERT_TRUE(mapping);
+  ASSERT_EQ(StringFromMapping(*mapping), "{}");
+
+  ASSERT_FALSE(bundle->GetAsMapping("assets/icons/c.png"));
+  ASSERT_FALSE(bundle->GetAsMapping("assets/icons"));
+  ASSERT_FALSE(bundle->GetAsMapping(""));
+}
+
+TEST(PackedAssetBundleTest, MappingsOutliveTheBundle) {
+  auto bundle = BuildBundle({{"kernel_blob.bin", "kernel"}});
+  auto mapping = bundle->GetAsMapping("kernel_blob.bin");
+  bundle.reset();
+  ASSERT_TRUE(mapping);
+  ASSERT_EQ(StringFromMapping(*mapping), "kernel");
+}
+
+TEST(PackedAssetBundleTest, RejectsCorruptPacks) {
+  PackedAssetBundleBuilder builder;
+  builder.AddAsset("a", MappingFromString("contents"));
+  auto pack = builder.Build();
+
+  auto truncated = pack;
+  truncated.resize(truncated.size() / 2);
+  PackedAssetBundle truncated_bundle(
+      std::make_unique<fml::DataMapping>(std::move(truncated)));
+  ASSERT_FALSE(truncated_bundle.IsValid());
+
+  auto bad_magic = pack;
+  bad_magic[0] = 'X';
+  PackedAssetBundle bad_magic_bundle(
+      std::make_unique<fml::DataMapping>(std::move(bad_magic)));
+  ASSERT_FALSE(bad_magic_bundle.IsValid());
+
+  // The entry count follows the magic and the version.
+  auto bad_entry_count = pack;
+  std::fill(bad_entry_count.begin() + 12, bad_entry_count.begin() + 16, 0xFF);
+  PackedAssetBundle bad_entry_count_bundle(
+      std::make_unique<fml::DataMapping>(std::move(bad_entry_count)));
+  ASSERT_FALSE(bad_entry_count_bundle.IsValid());
+}
+
+TEST(PackedAssetBundleTest, PackTakesPrecedenceOverTheDirectory) {
+  fml::ScopedTemporaryDirectory directory;
+
+  PackedAssetBundleBuilder builder;
+  builder.AddAsset("packed.txt", MappingFromString("from pack"));
+  ASSERT_TRUE(fml::WriteAtomically(directory.fd(), kPackedAssetBundleFileName,
+                                   fml::DataMapping(builder.Build())));
+  ASSERT_TRUE(fml::WriteAtomically(directory.fd(), "loose.txt",
+                                   *MappingFromString("from directory")));
+
+  AssetManager asset_manager;
+  asset_manager.PushBack(PackedAssetBundle::OpenInDirectory(directory.fd()));
+  asset_manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::Duplicate(directory.fd().get())));
+
+  auto packed = asset_manager.GetAsMapping("packed.txt");
+  ASSERT_TRUE(packed);
+  ASSERT_EQ(StringFromMapping(*packed), "from pack");
+  auto loose = asset_manager.GetAsMapping("loose.txt");
+  ASSERT_TRUE(loose);
+  ASSERT_EQ(StringFromMapping(*loose), "from directory");
+
+  ASSERT_TRUE(fml::UnlinkFile(directory.fd(), kPackedAssetBundleFileName));
+  ASSERT_TRUE(fml::UnlinkFile(directory.fd(), "loose.txt"));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -43,12 +43,16 @@ std::string Settings::ToString() const {
   stream << "endless_trace_buffer: " << endless_trace_buffer << std::endl;
   stream << "enable_dart_profiling: " << enable_dart_profiling << std::endl;
   stream << "disable_dart_asserts: " << disable_dart_asserts << std::endl;
+  stream << "enable_isolate_groups: " << enable_isolate_groups << std::endl;
   stream << "enable_observatory: " << enable_observatory << std::endl;
   stream << "observatory_host: " << observatory_host << std::endl;
   stream << "observatory_port: " << observatory_port << std::endl;
   stream << "use_test_fonts: " << use_test_fonts << std::endl;
   stream << "enable_software_rendering: " << enable_software_rendering
          << std::endl;
+  stream << "enable_predictive_frame_pacing: "
+         << enable_predictive_frame_pacing << std::endl;
+  stream << "memory_budget_mb: " << memory_budget_mb << std::endl;
   stream << "log_tag: " << log_tag << std::endl;
   stream << "icu_initialization_required: " << icu_initialization_required
          << std::endl;
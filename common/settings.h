@@ -93,9 +93,15 @@ struct Settings {
   bool trace_startup = false;
   bool trace_systrace = false;
   bool dump_skp_on_shader_compilation = false;
+  // If not empty, every rasterized layer tree is appended to this file.
+  std::string layer_tree_capture_path;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
+  // Whether isolates spawned by Dart code join the group of the isolate that
+  // spawned them. Isolates in a group share the program loaded from the
+  // snapshots instead of each loading their own copy.
+  bool enable_isolate_groups = false;
   // Used as the script URI in debug messages. Does not affect how the Dart code
   // is executed.
   std::string advisory_script_uri = "main.dart";
@@ -160,6 +166,14 @@ struct Settings {
   // blocking calls in this callback will cause applications to jank.
   UnhandledExceptionCallback unhandled_exception_callback;
   bool enable_software_rendering = false;
+  // Start frames ahead of their vsync when recent frames predict that they
+  // would otherwise miss it. See |FramePacer|.
+  bool enable_predictive_frame_pacing = false;
+  // If not zero, caches are trimmed whenever the memory the shell accounts for
+  // grows past this many megabytes. Decoded images count towards the budget
+  // but are owned by the application, so they are not trimmed. See
+  // |Shell::GetMemoryUsage|.
+  uint32_t memory_budget_mb = 0;
   bool skia_deterministic_rendering_on_cpu = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
@@ -4,21 +4,204 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 namespace flutter {
 
-BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter)
-    : filter_(std::move(filter)) {}
+BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter,
+                                         int downsample_factor)
+    : filter_(std::move(filter)),
+      downsample_factor_(std::max(downsample_factor, 1)) {
+  if (filter_) {
+    filter_data_ = filter_->serialize();
+  }
+}
 
 BackdropFilterLayer::~BackdropFilterLayer() = default;
 
+void BackdropFilterLayer::MixContentSignature(
+    ContentSignature* signature) const {
+  signature->MixTag("BackdropFilterLayer");
+  signature->Mix(filter_.get());
+  signature->Mix(static_cast<uint64_t>(downsample_factor_));
+}
+
+void BackdropFilterLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kBackdropFilter);
+  writer.WriteFlattenable(filter_.get());
+  writer.WriteInt(downsample_factor_);
+  SerializeChildren(writer);
+}
+
+void BackdropFilterLayer::Preroll(PrerollContext* context,
+                                  const SkMatrix& matrix) {
+  // Everything that affects the backdrop has been prerolled at this point.
+  // The children are drawn on top of the filtered backdrop.
+  const ContentSignature backdrop_signature = context->content_signature;
+  // The surface only holds the backdrop if no ancestor painted into a save
+  // layer. Skia reads the backdrop from the innermost layer otherwise.
+  const bool inside_save_layer = context->inside_save_layer;
+
+  {
+    // Whether the children end up in a save layer is only known once they
+    // are prerolled, so assume they do.
+    Layer::AutoPrerollSaveLayerState save =
+        Layer::AutoPrerollSaveLayerState::Create(context);
+    ContainerLayer::Preroll(context, matrix);
+  }
+
+  snapshot_backdrop_ = false;
+  cache_key_.reset();
+
+  SkRect bounds = paint_bounds();
+  if (!filter_ || inside_save_layer || !matrix.isScaleTranslate() ||
+      !bounds.intersect(context->cull_rect)) {
+    return;
+  }
+  snapshot_matrix_ = matrix;
+  snapshot_bounds_ = RasterCache::GetDeviceBounds(bounds, matrix);
+
+  if (context->raster_cache && filter_data_ &&
+      !backdrop_signature.is_volatile()) {
+    cache_key_ = std::make_unique<BackdropRasterCacheKey>(
+        backdrop_signature.value(), filter_data_, snapshot_bounds_, matrix,
+        downsample_factor_);
+    context->raster_cache->Prepare(*cache_key_);
+  }
+
+  // Without a cache entry to fill, reading back the surface only pays off if
+  // it lets us filter at a lower resolution.
+  snapshot_backdrop_ = cache_key_ != nullptr || downsample_factor_ > 1;
+}
+
 void BackdropFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "BackdropFilterLayer::Paint");
   FML_DCHECK(needs_painting());
 
-  Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
-      context,
-      SkCanvas::SaveLayerRec{&paint_bounds(), nullptr, filter_.get(), 0});
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  SkSurface* surface = canvas->getSurface();
+  FilteredBackdrop backdrop;
+  if (snapshot_backdrop_ && surface != nullptr &&
+      !context.checkerboard_offscreen_layers &&
+      canvas->getTotalMatrix() == snapshot_matrix_) {
+    if (cache_key_ && context.raster_cache) {
+      backdrop = context.raster_cache->Get(*cache_key_);
+    }
+    if (!backdrop.is_valid()) {
+      backdrop = FilterBackdrop(surface, snapshot_bounds_, snapshot_matrix_,
+                                filter_.get(), downsample_factor_);
+      if (backdrop.is_valid() && cache_key_ && context.raster_cache) {
+        context.raster_cache->Put(*cache_key_, backdrop);
+      }
+    }
+  }
+
+  if (!backdrop.is_valid()) {
+    Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
+        context,
+        SkCanvas::SaveLayerRec{&paint_bounds(), nullptr, filter_.get(), 0});
+    PaintChildren(context);
+    return;
+  }
+
+  // The save layer would have clipped the backdrop and the children to the
+  // layer bounds.
+  SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
+  context.internal_nodes_canvas->clipRect(paint_bounds());
+  backdrop.draw(*canvas);
   PaintChildren(context);
 }
 
+FilteredBackdrop BackdropFilterLayer::FilterBackdrop(
+    SkSurface* surface,
+    const SkIRect& device_bounds,
+    const SkMatrix& ctm,
+    const SkImageFilter* filter,
+    int downsample_factor) {
+  TRACE_EVENT0("flutter", "BackdropFilterLayer::FilterBackdrop");
+  FML_DCHECK(ctm.isScaleTranslate());
+
+  const SkIRect surface_bounds =
+      SkIRect::MakeWH(surface->width(), surface->height());
+  SkIRect bounds = device_bounds;
+  if (!bounds.intersect(surface_bounds)) {
+    return {};
+  }
+
+  // Image filters are specified in the local coordinates of the layer.
+  SkMatrix filter_matrix =
+      SkMatrix::MakeScale(ctm.getScaleX(), ctm.getScaleY());
+
+  // Filters like blurs sample pixels outside of the area they produce. Read
+  // those as well so that the edges of the result match the save layer.
+  SkIRect read_bounds = filter->filterBounds(
+      bounds, filter_matrix, SkImageFilter::kReverse_MapDirection);
+  if (!read_bounds.intersect(surface_bounds)) {
+    return {};
+  }
+
+  sk_sp<SkImage> backdrop = surface->makeImageSnapshot(read_bounds);
+  if (!backdrop) {
+    return {};
+  }
+
+  SkScalar scale_x = 1.0f;
+  SkScalar scale_y = 1.0f;
+  if (downsample_factor > 1) {
+    const float factor = downsample_factor;
+    const SkImageInfo info = backdrop->imageInfo().makeWH(
+        std::max(1, static_cast<int>(std::ceil(read_bounds.width() / factor))),
+        std::max(1,
+                 static_cast<int>(std::ceil(read_bounds.height() / factor))));
+    scale_x = static_cast<SkScalar>(info.width()) / read_bounds.width();
+    scale_y = static_cast<SkScalar>(info.height()) / read_bounds.height();
+    sk_sp<SkSurface> small_surface = surface->makeSurface(info);
+    if (!small_surface) {
+      return {};
+    }
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    paint.setFilterQuality(kLow_SkFilterQuality);
+    small_surface->getCanvas()->drawImageRect(
+        backdrop, SkRect::MakeIWH(info.width(), info.height()), &paint);
+    backdrop = small_surface->makeImageSnapshot();
+    if (!backdrop) {
+      return {};
+    }
+    filter_matrix.postScale(scale_x, scale_y);
+  }
+
+  sk_sp<SkImageFilter> local_filter =
+      filter->makeWithLocalMatrix(filter_matrix);
+  const SkIRect subset = SkIRect::MakeWH(backdrop->width(), backdrop->height());
+  // Only the part of the result within the layer bounds is drawn.
+  SkIRect clip_bounds =
+      SkRect::MakeXYWH((bounds.x() - read_bounds.x()) * scale_x,
+                       (bounds.y() - read_bounds.y()) * scale_y,
+                       bounds.width() * scale_x, bounds.height() * scale_y)
+          .roundOut();
+  if (!clip_bounds.intersect(subset)) {
+    return {};
+  }
+  SkIRect filtered_subset;
+  SkIPoint offset;
+  sk_sp<SkImage> filtered = backdrop->makeWithFilter(
+      local_filter.get(), subset, clip_bounds, &filtered_subset, &offset);
+  if (!filtered) {
+    return {};
+  }
+
+  FilteredBackdrop result;
+  result.image = std::move(filtered);
+  result.src = filtered_subset;
+  result.dst = SkRect::MakeXYWH(read_bounds.x() + offset.x() / scale_x,
+                                read_bounds.y() + offset.y() / scale_y,
+                                filtered_subset.width() / scale_x,
+                                filtered_subset.height() / scale_y);
+  return result;
+}
+
 }  // namespace flutter
@@ -5,21 +5,54 @@
 #ifndef FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 
+#include <memory>
+
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/raster_cache_key.h"
 
+#include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
 class BackdropFilterLayer : public ContainerLayer {
  public:
-  BackdropFilterLayer(sk_sp<SkImageFilter> filter);
+  // If |downsample_factor| is greater than one, the backdrop is shrunk by that
+  // factor before it is filtered and the result is scaled back up.
+  BackdropFilterLayer(sk_sp<SkImageFilter> filter, int downsample_factor = 1);
   ~BackdropFilterLayer() override;
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
   void Paint(PaintContext& context) const override;
 
  private:
+  // Reads back |device_bounds| of |surface|, plus the pixels |filter| samples
+  // around them, and applies |filter| to it as if it were the backdrop of a
+  // layer drawn with |ctm|, which must only scale and translate. The result
+  // covers at most |device_bounds|.
+  static FilteredBackdrop FilterBackdrop(SkSurface* surface,
+                                         const SkIRect& device_bounds,
+                                         const SkMatrix& ctm,
+                                         const SkImageFilter* filter,
+                                         int downsample_factor);
+
   sk_sp<SkImageFilter> filter_;
+  sk_sp<SkData> filter_data_;
+  int downsample_factor_;
+
+  // Set during |Preroll| if the backdrop can be filtered from a snapshot of
+  // the surface instead of through a save layer. This requires that no
+  // ancestor paints into a save layer.
+  bool snapshot_backdrop_ = false;
+  SkMatrix snapshot_matrix_;
+  SkIRect snapshot_bounds_;
+  std::unique_ptr<BackdropRasterCacheKey> cache_key_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
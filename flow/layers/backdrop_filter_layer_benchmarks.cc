@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkBlurImageFilter.h"
+
+namespace flutter {
+
+// A frosted app bar over a page of cards.
+static std::shared_ptr<ContainerLayer> CreateFrostedAppBarTree(
+    const SkISize& size,
+    int downsample_factor) {
+  auto root = std::make_shared<ContainerLayer>();
+  const int card_size = 120;
+  for (int y = 0; y < size.height(); y += card_size) {
+    for (int x = 0; x < size.width(); x += card_size) {
+      SkPath path;
+      path.addRRect(SkRRect::MakeRectXY(
+          SkRect::MakeXYWH(x + 8, y + 8, card_size - 16, card_size - 16), 12,
+          12));
+      root->Add(std::make_shared<PhysicalShapeLayer>(
+          SkColorSetRGB(x % 255, y % 255, (x + y) % 255), SK_ColorBLACK,
+          1.0f,  // pixel ratio
+          1.0f,  // depth
+          0.0f,  // elevation
+          path, Clip::antiAlias));
+    }
+  }
+
+  auto app_bar = std::make_shared<BackdropFilterLayer>(
+      SkBlurImageFilter::Make(20, 20, nullptr), downsample_factor);
+  SkPath bar_path;
+  bar_path.addRect(SkRect::MakeWH(size.width(), 240));
+  app_bar->Add(std::make_shared<PhysicalShapeLayer>(
+      SkColorSetARGB(0x40, 0xFF, 0xFF, 0xFF), SK_ColorBLACK,
+      1.0f,  // pixel ratio
+      1.0f,  // depth
+      0.0f,  // elevation
+      bar_path, Clip::none));
+  root->Add(app_bar);
+  return root;
+}
+
+// Arguments are the downsample factor and whether the raster cache is used.
+static void BM_BackdropFilterLayer(benchmark::State& state) {
+  const SkISize size = SkISize::Make(1080, 1920);
+  const int downsample_factor = state.range(0);
+  const bool use_raster_cache = state.range(1) != 0;
+
+  auto surface = SkSurface::MakeRasterN32Premul(size.width(), size.height());
+  FML_CHECK(surface);
+  SkCanvas* canvas = surface->getCanvas();
+
+  auto root = CreateFrostedAppBarTree(size, downsample_factor);
+  RasterCache raster_cache;
+  const Stopwatch unused_stopwatch;
+  TextureRegistry unused_texture_registry;
+  MutatorsStack unused_stack;
+
+  while (state.KeepRunning()) {
+    PrerollContext preroll_context{
+        use_raster_cache ? &raster_cache : nullptr,  // raster_cache
+        nullptr,                                     // gr_context
+        nullptr,                                     // external view embedder
+        unused_stack,                                // mutator stack
+        nullptr,                                     // dst_color_space
+        SkRect::Make(size),                          // cull_rect
+        unused_stopwatch,                            // frame time
+        unused_stopwatch,                            // engine time
+        unused_texture_registry,                     // texture registry
+        false,  // checkerboard_offscreen_layers
+    };
+    root->Preroll(&preroll_context, SkMatrix::I());
+
+    Layer::PaintContext paint_context = {
+        canvas,                                      // internal_nodes_canvas
+        canvas,                                      // leaf_nodes_canvas
+        nullptr,                                     // gr_context
+        nullptr,                                     // view_embedder
+        unused_stopwatch,                            // raster_time
+        unused_stopwatch,                            // ui_time
+        unused_texture_registry,                     // texture_registry
+        use_raster_cache ? &raster_cache : nullptr,  // raster_cache
+        false,  // checkerboard_offscreen_layers
+    };
+    canvas->clear(SK_ColorTRANSPARENT);
+    root->Paint(paint_context);
+    surface->flush();
+
+    raster_cache.SweepAfterFrame();
+  }
+}
+
+BENCHMARK(BM_BackdropFilterLayer)
+    ->Args({1, 0})
+    ->Args({2, 0})
+    ->Args({4, 0})
+    ->Args({1, 1})
+    ->Args({4, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/flow/layers/texture_layer.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/effects/SkBlurImageFilter.h"
+
+namespace flutter {
+
+static std::shared_ptr<ContainerLayer> CreateFrostedTree(SkColor color) {
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<PhysicalShapeLayer>(
+      color, SK_ColorBLACK,
+      1.0f,  // pixel ratio
+      1.0f,  // depth
+      0.0f,  // elevation
+      SkPath().addRect(SkRect::MakeWH(100, 100)), Clip::none));
+  auto backdrop = std::make_shared<BackdropFilterLayer>(
+      SkBlurImageFilter::Make(4, 4, nullptr));
+  backdrop->Add(std::make_shared<PhysicalShapeLayer>(
+      SK_ColorWHITE, SK_ColorBLACK,
+      1.0f,  // pixel ratio
+      1.0f,  // depth
+      0.0f,  // elevation
+      SkPath().addRect(SkRect::MakeWH(100, 20)), Clip::none));
+  root->Add(backdrop);
+  return root;
+}
+
+// Records whether it was prerolled inside a save layer of an ancestor.
+class SaveLayerProbeLayer : public Layer {
+ public:
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override {
+    inside_save_layer_ = context->inside_save_layer;
+    set_paint_bounds(SkRect::MakeWH(10, 10));
+  }
+
+  void Paint(PaintContext& context) const override {}
+
+  bool inside_save_layer() const { return inside_save_layer_; }
+
+ private:
+  bool inside_save_layer_ = false;
+};
+
+static ContentSignature PrerollSignature(Layer* layer) {
+  const Stopwatch unused_stopwatch;
+  TextureRegistry unused_texture_registry;
+  MutatorsStack unused_stack;
+  PrerollContext preroll_context{
+      nullptr,                  // raster_cache (don't consult the cache)
+      nullptr,                  // gr_context  (used for the raster cache)
+      nullptr,                  // external view embedder
+      unused_stack,             // mutator stack
+      nullptr,                  // SkColorSpace* dst_color_space
+      kGiantRect,               // SkRect cull_rect
+      unused_stopwatch,         // frame time (dont care)
+      unused_stopwatch,         // engine time (dont care)
+      unused_texture_registry,  // texture registry (not supported)
+      false,                    // checkerboard_offscreen_layers
+      0.0f,                     // total elevation
+  };
+  layer->Preroll(&preroll_context, SkMatrix::I());
+  EXPECT_FALSE(preroll_context.inside_save_layer);
+  return preroll_context.content_signature;
+}
+
+TEST(BackdropFilterLayer, ContentSignatureIsStableAcrossRebuilds) {
+  auto first = PrerollSignature(CreateFrostedTree(SK_ColorRED).get());
+  auto second = PrerollSignature(CreateFrostedTree(SK_ColorRED).get());
+  EXPECT_FALSE(first.is_volatile());
+  EXPECT_FALSE(second.is_volatile());
+  EXPECT_EQ(first.value(), second.value());
+
+  auto changed = PrerollSignature(CreateFrostedTree(SK_ColorBLUE).get());
+  EXPECT_NE(first.value(), changed.value());
+}
+
+TEST(BackdropFilterLayer, TexturesMakeContentSignatureVolatile) {
+  auto root = CreateFrostedTree(SK_ColorRED);
+  root->Add(std::make_shared<TextureLayer>(SkPoint::Make(0, 0),
+                                           SkSize::Make(10, 10), 1, false));
+  EXPECT_TRUE(PrerollSignature(root.get()).is_volatile());
+}
+
+TEST(BackdropFilterLayer, ChildrenOfSaveLayersArePrerolledInsideThem) {
+  auto root = std::make_shared<ContainerLayer>();
+
+  auto outside = std::make_shared<SaveLayerProbeLayer>();
+  root->Add(outside);
+
+  auto hard_edge_clip = std::make_shared<ClipRectLayer>(
+      SkRect::MakeWH(100, 100), Clip::hardEdge);
+  auto inside_hard_edge_clip = std::make_shared<SaveLayerProbeLayer>();
+  hard_edge_clip->Add(inside_hard_edge_clip);
+  root->Add(hard_edge_clip);
+
+  auto save_layer_clip = std::make_shared<ClipRectLayer>(
+      SkRect::MakeWH(100, 100), Clip::antiAliasWithSaveLayer);
+  auto inside_save_layer_clip = std::make_shared<SaveLayerProbeLayer>();
+  save_layer_clip->Add(inside_save_layer_clip);
+  root->Add(save_layer_clip);
+
+  auto opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  auto inside_opacity = std::make_shared<SaveLayerProbeLayer>();
+  opacity->Add(inside_opacity);
+  root->Add(opacity);
+
+  auto after = std::make_shared<SaveLayerProbeLayer>();
+  root->Add(after);
+
+  PrerollSignature(root.get());
+  EXPECT_FALSE(outside->inside_save_layer());
+  EXPECT_FALSE(inside_hard_edge_clip->inside_save_layer());
+  EXPECT_TRUE(inside_save_layer_clip->inside_save_layer());
+  EXPECT_TRUE(inside_opacity->inside_save_layer());
+  EXPECT_FALSE(after->inside_save_layer());
+}
+
+}  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/clip_path_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 #if defined(OS_FUCHSIA)
 
 #include "lib/ui/scenic/cpp/commands.h"
@@ -19,13 +21,31 @@ ClipPathLayer::ClipPathLayer(const SkPath& clip_path, Clip clip_behavior)
 
 ClipPathLayer::~ClipPathLayer() = default;
 
+void ClipPathLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("ClipPathLayer");
+  signature->Mix(clip_path_);
+  signature->Mix(static_cast<uint64_t>(clip_behavior_));
+}
+
+void ClipPathLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kClipPath);
+  writer.WritePath(clip_path_);
+  writer.WriteInt(clip_behavior_);
+  SerializeChildren(writer);
+}
+
 void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect previous_cull_rect = context->cull_rect;
   SkRect clip_path_bounds = clip_path_.getBounds();
   if (context->cull_rect.intersect(clip_path_bounds)) {
     context->mutators_stack.PushClipPath(clip_path_);
     SkRect child_paint_bounds = SkRect::MakeEmpty();
-    PrerollChildren(context, matrix, &child_paint_bounds);
+    {
+      Layer::AutoPrerollSaveLayerState save =
+          Layer::AutoPrerollSaveLayerState::Create(
+              context, clip_behavior_ == Clip::antiAliasWithSaveLayer);
+      PrerollChildren(context, matrix, &child_paint_bounds);
+    }
 
     if (child_paint_bounds.intersect(clip_path_bounds)) {
       set_paint_bounds(child_paint_bounds);
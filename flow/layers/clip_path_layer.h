@@ -14,6 +14,10 @@ class ClipPathLayer : public ContainerLayer {
   ClipPathLayer(const SkPath& clip_path, Clip clip_behavior = Clip::antiAlias);
   ~ClipPathLayer() override;
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
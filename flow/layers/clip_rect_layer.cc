@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/clip_rect_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 namespace flutter {
 
 ClipRectLayer::ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior)
@@ -13,12 +15,30 @@ ClipRectLayer::ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior)
 
 ClipRectLayer::~ClipRectLayer() = default;
 
+void ClipRectLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("ClipRectLayer");
+  signature->Mix(clip_rect_);
+  signature->Mix(static_cast<uint64_t>(clip_behavior_));
+}
+
+void ClipRectLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kClipRect);
+  writer.WriteRect(clip_rect_);
+  writer.WriteInt(clip_behavior_);
+  SerializeChildren(writer);
+}
+
 void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect previous_cull_rect = context->cull_rect;
   if (context->cull_rect.intersect(clip_rect_)) {
     context->mutators_stack.PushClipRect(clip_rect_);
     SkRect child_paint_bounds = SkRect::MakeEmpty();
-    PrerollChildren(context, matrix, &child_paint_bounds);
+    {
+      Layer::AutoPrerollSaveLayerState save =
+          Layer::AutoPrerollSaveLayerState::Create(
+              context, clip_behavior_ == Clip::antiAliasWithSaveLayer);
+      PrerollChildren(context, matrix, &child_paint_bounds);
+    }
 
     if (child_paint_bounds.intersect(clip_rect_)) {
       set_paint_bounds(child_paint_bounds);
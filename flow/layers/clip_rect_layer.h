@@ -14,6 +14,10 @@ class ClipRectLayer : public ContainerLayer {
   ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior);
   ~ClipRectLayer() override;
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
 
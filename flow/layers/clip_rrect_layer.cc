@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/clip_rrect_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 namespace flutter {
 
 ClipRRectLayer::ClipRRectLayer(const SkRRect& clip_rrect, Clip clip_behavior)
@@ -13,13 +15,31 @@ ClipRRectLayer::ClipRRectLayer(const SkRRect& clip_rrect, Clip clip_behavior)
 
 ClipRRectLayer::~ClipRRectLayer() = default;
 
+void ClipRRectLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("ClipRRectLayer");
+  signature->Mix(clip_rrect_);
+  signature->Mix(static_cast<uint64_t>(clip_behavior_));
+}
+
+void ClipRRectLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kClipRRect);
+  writer.WriteRRect(clip_rrect_);
+  writer.WriteInt(clip_behavior_);
+  SerializeChildren(writer);
+}
+
 void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect previous_cull_rect = context->cull_rect;
   SkRect clip_rrect_bounds = clip_rrect_.getBounds();
   if (context->cull_rect.intersect(clip_rrect_bounds)) {
     context->mutators_stack.PushClipRRect(clip_rrect_);
     SkRect child_paint_bounds = SkRect::MakeEmpty();
-    PrerollChildren(context, matrix, &child_paint_bounds);
+    {
+      Layer::AutoPrerollSaveLayerState save =
+          Layer::AutoPrerollSaveLayerState::Create(
+              context, clip_behavior_ == Clip::antiAliasWithSaveLayer);
+      PrerollChildren(context, matrix, &child_paint_bounds);
+    }
 
     if (child_paint_bounds.intersect(clip_rrect_bounds)) {
       set_paint_bounds(child_paint_bounds);
@@ -14,6 +14,10 @@ class ClipRRectLayer : public ContainerLayer {
   ClipRRectLayer(const SkRRect& clip_rrect, Clip clip_behavior);
   ~ClipRRectLayer() override;
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/color_filter_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 namespace flutter {
 
 ColorFilterLayer::ColorFilterLayer(sk_sp<SkColorFilter> filter)
@@ -11,6 +13,24 @@ ColorFilterLayer::ColorFilterLayer(sk_sp<SkColorFilter> filter)
 
 ColorFilterLayer::~ColorFilterLayer() = default;
 
+void ColorFilterLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("ColorFilterLayer");
+  signature->Mix(filter_.get());
+}
+
+void ColorFilterLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kColorFilter);
+  writer.WriteFlattenable(filter_.get());
+  SerializeChildren(writer);
+}
+
+void ColorFilterLayer::Preroll(PrerollContext* context,
+                               const SkMatrix& matrix) {
+  Layer::AutoPrerollSaveLayerState save =
+      Layer::AutoPrerollSaveLayerState::Create(context);
+  ContainerLayer::Preroll(context, matrix);
+}
+
 void ColorFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ColorFilterLayer::Paint");
   FML_DCHECK(needs_painting());
@@ -16,6 +16,12 @@ class ColorFilterLayer : public ContainerLayer {
   ColorFilterLayer(sk_sp<SkColorFilter> filter);
   ~ColorFilterLayer() override;
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
   void Paint(PaintContext& context) const override;
 
  private:
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() {}
@@ -15,6 +17,15 @@ void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.push_back(std::move(layer));
 }
 
+void ContainerLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("ContainerLayer");
+}
+
+void ContainerLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kContainer);
+  SerializeChildren(writer);
+}
+
 void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "ContainerLayer::Preroll");
 
@@ -27,6 +38,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      const SkMatrix& child_matrix,
                                      SkRect* child_paint_bounds) {
   for (auto& layer : layers_) {
+    layer->MixContentSignature(&context->content_signature);
     layer->Preroll(context, child_matrix);
 
     if (layer->needs_system_composite()) {
@@ -34,6 +46,15 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     }
     child_paint_bounds->join(layer->paint_bounds());
   }
+  // Keeps the signatures of siblings and of nested children distinct.
+  context->content_signature.Mix(static_cast<uint64_t>(layers_.size()));
+}
+
+void ContainerLayer::SerializeChildren(LayerTreeWriter& writer) const {
+  writer.WriteUInt(layers_.size());
+  for (auto& layer : layers_) {
+    writer.WriteLayer(layer.get());
+  }
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
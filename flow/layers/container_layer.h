@@ -17,6 +17,10 @@ class ContainerLayer : public Layer {
 
   void Add(std::shared_ptr<Layer> layer);
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
 #if defined(OS_FUCHSIA)
@@ -30,6 +34,7 @@ class ContainerLayer : public Layer {
                        const SkMatrix& child_matrix,
                        SkRect* child_paint_bounds);
   void PaintChildren(PaintContext& context) const;
+  void SerializeChildren(LayerTreeWriter& writer) const;
 
 #if defined(OS_FUCHSIA)
   void UpdateSceneChildren(SceneUpdateContext& context);
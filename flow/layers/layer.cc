@@ -4,11 +4,78 @@
 
 #include "flutter/flow/layers/layer.h"
 
+#include <cstring>
+
+#include "flutter/flow/layers/layer_tree_serialization.h"
 #include "flutter/flow/paint_utils.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkData.h"
 
 namespace flutter {
 
+void ContentSignature::MixBytes(const void* bytes, size_t length) {
+  // FNV-1a.
+  const uint8_t* data = static_cast<const uint8_t*>(bytes);
+  for (size_t i = 0; i < length; i++) {
+    value_ = (value_ ^ data[i]) * 0x100000001b3ull;
+  }
+}
+
+void ContentSignature::Mix(uint64_t value) {
+  MixBytes(&value, sizeof(value));
+}
+
+void ContentSignature::MixTag(const char* tag) {
+  MixBytes(tag, strlen(tag) + 1);
+}
+
+void ContentSignature::MixScalar(SkScalar value) {
+  MixBytes(&value, sizeof(value));
+}
+
+void ContentSignature::Mix(const SkPoint& point) {
+  MixScalar(point.x());
+  MixScalar(point.y());
+}
+
+void ContentSignature::Mix(const SkRect& rect) {
+  MixBytes(&rect, sizeof(rect));
+}
+
+void ContentSignature::Mix(const SkRRect& rrect) {
+  SkScalar data[SkRRect::kSizeInMemory / sizeof(SkScalar)];
+  rrect.writeToMemory(data);
+  MixBytes(data, sizeof(data));
+}
+
+void ContentSignature::Mix(const SkMatrix& matrix) {
+  SkScalar values[9];
+  matrix.get9(values);
+  MixBytes(values, sizeof(values));
+}
+
+void ContentSignature::Mix(const SkPath& path) {
+  const size_t size = path.writeToMemory(nullptr);
+  std::vector<uint8_t> data(size);
+  path.writeToMemory(data.data());
+  Mix(static_cast<uint64_t>(size));
+  MixBytes(data.data(), size);
+}
+
+void ContentSignature::Mix(const SkFlattenable* flattenable) {
+  if (flattenable == nullptr) {
+    Mix(static_cast<uint64_t>(0));
+    return;
+  }
+  sk_sp<SkData> data = flattenable->serialize();
+  if (!data) {
+    MarkVolatile();
+    return;
+  }
+  Mix(static_cast<uint64_t>(data->size()));
+  MixBytes(data->data(), data->size());
+}
+
 Layer::Layer()
     : parent_(nullptr),
       needs_system_composite_(false),
@@ -28,6 +95,14 @@ uint64_t Layer::NextUniqueID() {
 
 void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {}
 
+void Layer::MixContentSignature(ContentSignature* signature) const {
+  signature->MarkVolatile();
+}
+
+void Layer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kUnsupported);
+}
+
 #if defined(OS_FUCHSIA)
 void Layer::UpdateScene(SceneUpdateContext& context) {}
 #endif  // defined(OS_FUCHSIA)
@@ -65,4 +140,25 @@ Layer::AutoSaveLayer::~AutoSaveLayer() {
   paint_context_.internal_nodes_canvas->restore();
 }
 
+Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
+    PrerollContext* preroll_context,
+    bool save_layer_is_active)
+    : preroll_context_(preroll_context),
+      prev_inside_save_layer_(preroll_context->inside_save_layer) {
+  if (save_layer_is_active) {
+    preroll_context_->inside_save_layer = true;
+  }
+}
+
+Layer::AutoPrerollSaveLayerState Layer::AutoPrerollSaveLayerState::Create(
+    PrerollContext* preroll_context,
+    bool save_layer_is_active) {
+  return Layer::AutoPrerollSaveLayerState(preroll_context,
+                                          save_layer_is_active);
+}
+
+Layer::AutoPrerollSaveLayerState::~AutoPrerollSaveLayerState() {
+  preroll_context_->inside_save_layer = prev_inside_save_layer_;
+}
+
 }  // namespace flutter
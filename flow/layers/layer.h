@@ -20,6 +20,7 @@
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkFlattenable.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -43,6 +44,39 @@ static constexpr SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 enum Clip { none, hardEdge, antiAlias, antiAliasWithSaveLayer };
 
 class ContainerLayer;
+class LayerTreeWriter;
+
+// A running hash of everything that has been prerolled so far in paint order.
+// Layers mix in the parameters that determine what they draw so that a layer
+// that samples its backdrop can tell whether the content behind it is the
+// same as in a previous frame. Layers whose output can change without any
+// change to the layer tree (textures, platform views, ...) mark the signature
+// as volatile instead.
+class ContentSignature {
+ public:
+  uint64_t value() const { return value_; }
+
+  bool is_volatile() const { return volatile_; }
+
+  void MarkVolatile() { volatile_ = true; }
+
+  void Mix(uint64_t value);
+  void MixTag(const char* tag);
+  void MixScalar(SkScalar value);
+  void Mix(const SkPoint& point);
+  void Mix(const SkRect& rect);
+  void Mix(const SkRRect& rrect);
+  void Mix(const SkMatrix& matrix);
+  void Mix(const SkPath& path);
+  void Mix(const SkFlattenable* flattenable);
+
+ private:
+  void MixBytes(const void* bytes, size_t length);
+
+  // FNV-1a offset basis.
+  uint64_t value_ = 0xcbf29ce484222325ull;
+  bool volatile_ = false;
+};
 
 struct PrerollContext {
   RasterCache* raster_cache;
@@ -58,6 +92,11 @@ struct PrerollContext {
   TextureRegistry& texture_registry;
   const bool checkerboard_offscreen_layers;
   float total_elevation = 0.0f;
+  ContentSignature content_signature;
+  // Whether an ancestor paints the layer being prerolled into a save layer.
+  // The surface does not contain the contents of such a layer, so it must not
+  // be read back in place of the backdrop.
+  bool inside_save_layer = false;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -69,6 +108,17 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context, const SkMatrix& matrix);
 
+  // Mixes everything that determines what this layer draws, excluding its
+  // children, into |signature|. Called by the parent right before |Preroll|.
+  // The default implementation marks the signature as volatile, so layers
+  // must opt in to having their content considered stable.
+  virtual void MixContentSignature(ContentSignature* signature) const;
+
+  // Writes the type and parameters of this layer, followed by its children,
+  // for replay outside of the engine. The default implementation writes the
+  // layer as unsupported. See |LayerTreeWriter|.
+  virtual void Serialize(LayerTreeWriter& writer) const;
+
   struct PaintContext {
     // When splitting the scene into multiple canvases (e.g when embedding
     // a platform view on iOS) during the paint traversal we apply the non leaf
@@ -87,7 +137,7 @@ class Layer {
     const Stopwatch& raster_time;
     const Stopwatch& ui_time;
     TextureRegistry& texture_registry;
-    const RasterCache* raster_cache;
+    RasterCache* raster_cache;
     const bool checkerboard_offscreen_layers;
   };
 
@@ -118,6 +168,25 @@ class Layer {
     const SkRect bounds_;
   };
 
+  // Marks the layers prerolled during its lifetime as painted into a save
+  // layer if |save_layer_is_active|, and restores the previous state upon
+  // destruction. See |PrerollContext::inside_save_layer|.
+  class AutoPrerollSaveLayerState {
+   public:
+    FML_WARN_UNUSED_RESULT static AutoPrerollSaveLayerState Create(
+        PrerollContext* preroll_context,
+        bool save_layer_is_active = true);
+
+    ~AutoPrerollSaveLayerState();
+
+   private:
+    AutoPrerollSaveLayerState(PrerollContext* preroll_context,
+                              bool save_layer_is_active);
+
+    PrerollContext* preroll_context_;
+    const bool prev_inside_save_layer_;
+  };
+
   virtual void Paint(PaintContext& context) const = 0;
 
 #if defined(OS_FUCHSIA)
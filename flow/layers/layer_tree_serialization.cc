@@ -0,0 +1,463 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_path_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/shader_mask_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkShader.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace flutter {
+
+// "FLTR" in little endian.
+static constexpr uint32_t kLayerTreeStreamMagic = 0x52544c46;
+static constexpr uint32_t kLayerTreeStreamVersion = 2;
+
+// Guards against malformed streams blowing the stack.
+static constexpr size_t kMaxLayerDepth = 1024;
+
+// Enum values read from the stream are checked before they are cast, since an
+// out of range value is undefined behavior once it reaches a switch.
+static bool IsValidClip(int32_t value) {
+  return value >= static_cast<int32_t>(Clip::none) &&
+         value <= static_cast<int32_t>(Clip::antiAliasWithSaveLayer);
+}
+
+static bool IsValidBlendMode(int32_t value) {
+  return value >= 0 && value <= static_cast<int32_t>(SkBlendMode::kLastMode);
+}
+
+static sk_sp<SkData> SerializeTypeface(SkTypeface* typeface, void* ctx) {
+  return typeface->serialize(SkTypeface::SerializeBehavior::kDoIncludeData);
+}
+
+LayerTreeWriter::LayerTreeWriter(SkWStream* stream) : stream_(stream) {
+  FML_DCHECK(stream_);
+  WriteUInt(kLayerTreeStreamMagic);
+  WriteUInt(kLayerTreeStreamVersion);
+}
+
+LayerTreeWriter::~LayerTreeWriter() = default;
+
+bool LayerTreeWriter::WriteFrame(const LayerTree& tree) {
+  WriteInt(tree.frame_size().width());
+  WriteInt(tree.frame_size().height());
+  WriteLayer(tree.root_layer());
+  return ok_;
+}
+
+void LayerTreeWriter::WriteLayer(const Layer* layer) {
+  if (layer == nullptr) {
+    WriteLayerType(SerializedLayerType::kUnsupported);
+    return;
+  }
+  layer->Serialize(*this);
+}
+
+void LayerTreeWriter::WriteLayerType(SerializedLayerType type) {
+  WriteUInt(static_cast<uint32_t>(type));
+}
+
+void LayerTreeWriter::WriteBool(bool value) {
+  ok_ &= stream_->writeBool(value);
+}
+
+void LayerTreeWriter::WriteInt(int32_t value) {
+  ok_ &= stream_->write32(static_cast<uint32_t>(value));
+}
+
+void LayerTreeWriter::WriteUInt(uint32_t value) {
+  ok_ &= stream_->write32(value);
+}
+
+void LayerTreeWriter::WriteScalar(SkScalar value) {
+  ok_ &= stream_->writeScalar(value);
+}
+
+void LayerTreeWriter::WritePoint(const SkPoint& point) {
+  WriteScalar(point.x());
+  WriteScalar(point.y());
+}
+
+void LayerTreeWriter::WriteRect(const SkRect& rect) {
+  WriteScalar(rect.left());
+  WriteScalar(rect.top());
+  WriteScalar(rect.right());
+  WriteScalar(rect.bottom());
+}
+
+void LayerTreeWriter::WriteRRect(const SkRRect& rrect) {
+  char data[SkRRect::kSizeInMemory];
+  rrect.writeToMemory(data);
+  WriteData(data, sizeof(data));
+}
+
+void LayerTreeWriter::WriteMatrix(const SkMatrix& matrix) {
+  SkScalar values[9];
+  matrix.get9(values);
+  for (SkScalar value : values) {
+    WriteScalar(value);
+  }
+}
+
+void LayerTreeWriter::WritePath(const SkPath& path) {
+  std::vector<uint8_t> data(path.writeToMemory(nullptr));
+  path.writeToMemory(data.data());
+  WriteData(data.data(), data.size());
+}
+
+void LayerTreeWriter::WriteFlattenable(const SkFlattenable* flattenable) {
+  sk_sp<SkData> data = flattenable ? flattenable->serialize() : nullptr;
+  if (flattenable && !data) {
+    ok_ = false;
+  }
+  WriteData(data ? data->data() : nullptr, data ? data->size() : 0);
+}
+
+void LayerTreeWriter::WritePicture(const SkPicture* picture) {
+  FML_DCHECK(picture);
+  auto found = picture_indices_.find(picture->uniqueID());
+  if (found != picture_indices_.end()) {
+    WriteUInt(found->second);
+    return;
+  }
+
+  const uint32_t index = picture_indices_.size();
+  picture_indices_[picture->uniqueID()] = index;
+  WriteUInt(index);
+
+  SkSerialProcs procs = {0};
+  procs.fTypefaceProc = SerializeTypeface;
+  sk_sp<SkData> data = picture->serialize(&procs);
+  if (!data) {
+    ok_ = false;
+  }
+  WriteData(data ? data->data() : nullptr, data ? data->size() : 0);
+}
+
+void LayerTreeWriter::WriteData(const void* data, size_t length) {
+  WriteUInt(length);
+  if (length > 0) {
+    ok_ &= stream_->write(data, length);
+  }
+}
+
+LayerTreeReader::LayerTreeReader(SkStream* stream,
+                                 fml::RefPtr<SkiaUnrefQueue> unref_queue)
+    : stream_(stream), unref_queue_(std::move(unref_queue)) {
+  FML_DCHECK(stream_);
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  valid_ = ReadUInt(&magic) && magic == kLayerTreeStreamMagic &&
+           ReadUInt(&version) && version == kLayerTreeStreamVersion;
+}
+
+LayerTreeReader::~LayerTreeReader() = default;
+
+std::unique_ptr<LayerTree> LayerTreeReader::ReadFrame() {
+  if (!valid_ || stream_->isAtEnd()) {
+    return nullptr;
+  }
+
+  int32_t width = 0;
+  int32_t height = 0;
+  std::shared_ptr<Layer> root_layer;
+  if (!ReadInt(&width) || !ReadInt(&height) || width < 0 || height < 0 ||
+      !ReadLayer(0, &root_layer)) {
+    FML_LOG(ERROR) << "Malformed layer tree stream.";
+    valid_ = false;
+    return nullptr;
+  }
+
+  auto tree = std::make_unique<LayerTree>();
+  tree->set_frame_size(SkISize::Make(width, height));
+  tree->set_root_layer(std::move(root_layer));
+  return tree;
+}
+
+bool LayerTreeReader::ReadLayer(size_t depth, std::shared_ptr<Layer>* layer) {
+  uint32_t type = 0;
+  if (depth > kMaxLayerDepth || !ReadUInt(&type)) {
+    return false;
+  }
+
+  int32_t clip_behavior = 0;
+  std::shared_ptr<ContainerLayer> container;
+  switch (static_cast<SerializedLayerType>(type)) {
+    case SerializedLayerType::kUnsupported:
+      layer->reset();
+      return true;
+    case SerializedLayerType::kContainer:
+      container = std::make_shared<ContainerLayer>();
+      break;
+    case SerializedLayerType::kPicture: {
+      SkPoint offset;
+      bool is_complex = false;
+      bool will_change = false;
+      sk_sp<SkPicture> picture;
+      if (!ReadPoint(&offset) || !ReadBool(&is_complex) ||
+          !ReadBool(&will_change) || !ReadPicture(&picture)) {
+        return false;
+      }
+      *layer = std::make_shared<PictureLayer>(
+          offset, SkiaGPUObject<SkPicture>{std::move(picture), unref_queue_},
+          is_complex, will_change);
+      return true;
+    }
+    case SerializedLayerType::kTransform: {
+      SkMatrix transform;
+      if (!ReadMatrix(&transform)) {
+        return false;
+      }
+      container = std::make_shared<TransformLayer>(transform);
+      break;
+    }
+    case SerializedLayerType::kClipRect: {
+      SkRect clip_rect;
+      if (!ReadRect(&clip_rect) || !ReadInt(&clip_behavior) ||
+          !IsValidClip(clip_behavior)) {
+        return false;
+      }
+      container = std::make_shared<ClipRectLayer>(
+          clip_rect, static_cast<Clip>(clip_behavior));
+      break;
+    }
+    case SerializedLayerType::kClipRRect: {
+      SkRRect clip_rrect;
+      if (!ReadRRect(&clip_rrect) || !ReadInt(&clip_behavior) ||
+          !IsValidClip(clip_behavior)) {
+        return false;
+      }
+      container = std::make_shared<ClipRRectLayer>(
+          clip_rrect, static_cast<Clip>(clip_behavior));
+      break;
+    }
+    case SerializedLayerType::kClipPath: {
+      SkPath clip_path;
+      if (!ReadPath(&clip_path) || !ReadInt(&clip_behavior) ||
+          !IsValidClip(clip_behavior)) {
+        return false;
+      }
+      container = std::make_shared<ClipPathLayer>(
+          clip_path, static_cast<Clip>(clip_behavior));
+      break;
+    }
+    case SerializedLayerType::kOpacity: {
+      int32_t alpha = 0;
+      SkPoint offset;
+      if (!ReadInt(&alpha) || !ReadPoint(&offset)) {
+        return false;
+      }
+      container = std::make_shared<OpacityLayer>(alpha, offset);
+      break;
+    }
+    case SerializedLayerType::kColorFilter: {
+      sk_sp<SkData> data = ReadData();
+      if (!data) {
+        return false;
+      }
+      auto filter = SkColorFilter::Deserialize(data->data(), data->size());
+      if (!filter) {
+        return false;
+      }
+      container = std::make_shared<ColorFilterLayer>(std::move(filter));
+      break;
+    }
+    case SerializedLayerType::kBackdropFilter: {
+      sk_sp<SkData> data = ReadData();
+      int32_t downsample_factor = 1;
+      if (!data || !ReadInt(&downsample_factor)) {
+        return false;
+      }
+      auto filter = SkImageFilter::Deserialize(data->data(), data->size());
+      if (!filter) {
+        return false;
+      }
+      container = std::make_shared<BackdropFilterLayer>(std::move(filter),
+                                                        downsample_factor);
+      break;
+    }
+    case SerializedLayerType::kPhysicalShape: {
+      uint32_t color = 0;
+      uint32_t shadow_color = 0;
+      SkScalar device_pixel_ratio = 0;
+      SkScalar viewport_depth = 0;
+      SkScalar elevation = 0;
+      SkPath path;
+      if (!ReadUInt(&color) || !ReadUInt(&shadow_color) ||
+          !ReadScalar(&device_pixel_ratio) || !ReadScalar(&viewport_depth) ||
+          !ReadScalar(&elevation) || !ReadPath(&path) ||
+          !ReadInt(&clip_behavior) || !IsValidClip(clip_behavior)) {
+        return false;
+      }
+      container = std::make_shared<PhysicalShapeLayer>(
+          color, shadow_color, device_pixel_ratio, viewport_depth, elevation,
+          path, static_cast<Clip>(clip_behavior));
+      break;
+    }
+    case SerializedLayerType::kShaderMask: {
+      sk_sp<SkData> data = ReadData();
+      SkRect mask_rect;
+      int32_t blend_mode = 0;
+      if (!data || !ReadRect(&mask_rect) || !ReadInt(&blend_mode) ||
+          !IsValidBlendMode(blend_mode)) {
+        return false;
+      }
+      sk_sp<SkFlattenable> shader = SkFlattenable::Deserialize(
+          SkFlattenable::kSkShaderBase_Type, data->data(), data->size());
+      if (!shader) {
+        return false;
+      }
+      container = std::make_shared<ShaderMaskLayer>(
+          sk_sp<SkShader>(static_cast<SkShader*>(shader.release())),
+          mask_rect, static_cast<SkBlendMode>(blend_mode));
+      break;
+    }
+    default:
+      return false;
+  }
+
+  if (!ReadChildren(depth + 1, container.get())) {
+    return false;
+  }
+  *layer = std::move(container);
+  return true;
+}
+
+bool LayerTreeReader::ReadChildren(size_t depth, ContainerLayer* container) {
+  uint32_t count = 0;
+  if (!ReadUInt(&count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    std::shared_ptr<Layer> child;
+    if (!ReadLayer(depth, &child)) {
+      return false;
+    }
+    if (child) {
+      container->Add(std::move(child));
+    }
+  }
+  return true;
+}
+
+bool LayerTreeReader::ReadBool(bool* value) {
+  return stream_->readBool(value);
+}
+
+bool LayerTreeReader::ReadInt(int32_t* value) {
+  return stream_->readS32(value);
+}
+
+bool LayerTreeReader::ReadUInt(uint32_t* value) {
+  return stream_->readU32(value);
+}
+
+bool LayerTreeReader::ReadScalar(SkScalar* value) {
+  return stream_->readScalar(value);
+}
+
+bool LayerTreeReader::ReadPoint(SkPoint* point) {
+  SkScalar x = 0;
+  SkScalar y = 0;
+  if (!ReadScalar(&x) || !ReadScalar(&y)) {
+    return false;
+  }
+  point->set(x, y);
+  return true;
+}
+
+bool LayerTreeReader::ReadRect(SkRect* rect) {
+  SkScalar left = 0;
+  SkScalar top = 0;
+  SkScalar right = 0;
+  SkScalar bottom = 0;
+  if (!ReadScalar(&left) || !ReadScalar(&top) || !ReadScalar(&right) ||
+      !ReadScalar(&bottom)) {
+    return false;
+  }
+  rect->setLTRB(left, top, right, bottom);
+  return true;
+}
+
+bool LayerTreeReader::ReadRRect(SkRRect* rrect) {
+  sk_sp<SkData> data = ReadData();
+  return data && data->size() == SkRRect::kSizeInMemory &&
+         rrect->readFromMemory(data->data(), data->size()) ==
+             SkRRect::kSizeInMemory;
+}
+
+bool LayerTreeReader::ReadMatrix(SkMatrix* matrix) {
+  SkScalar values[9];
+  for (SkScalar& value : values) {
+    if (!ReadScalar(&value)) {
+      return false;
+    }
+  }
+  matrix->set9(values);
+  return true;
+}
+
+bool LayerTreeReader::ReadPath(SkPath* path) {
+  sk_sp<SkData> data = ReadData();
+  return data && path->readFromMemory(data->data(), data->size()) != 0;
+}
+
+bool LayerTreeReader::ReadPicture(sk_sp<SkPicture>* picture) {
+  uint32_t index = 0;
+  if (!ReadUInt(&index) || index > pictures_.size()) {
+    return false;
+  }
+  if (index < pictures_.size()) {
+    *picture = pictures_[index];
+    return true;
+  }
+
+  sk_sp<SkData> data = ReadData();
+  if (!data) {
+    return false;
+  }
+  *picture = SkPicture::MakeFromData(data.get());
+  if (!*picture) {
+    return false;
+  }
+  pictures_.push_back(*picture);
+  return true;
+}
+
+sk_sp<SkData> LayerTreeReader::ReadData() {
+  uint32_t length = 0;
+  if (!ReadUInt(&length)) {
+    return nullptr;
+  }
+  if (length == 0) {
+    return SkData::MakeEmpty();
+  }
+  if (stream_->hasLength() && stream_->hasPosition() &&
+      length > stream_->getLength() - stream_->getPosition()) {
+    return nullptr;
+  }
+  sk_sp<SkData> data = SkData::MakeUninitialized(length);
+  if (stream_->read(data->writable_data(), length) != length) {
+    return nullptr;
+  }
+  return data;
+}
+
+}  // namespace flutter
@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_TREE_SERIALIZATION_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_TREE_SERIALIZATION_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkFlattenable.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace flutter {
+
+class ContainerLayer;
+class Layer;
+class LayerTree;
+
+// The layer types that can be serialized. Layers that draw content owned by
+// something other than the layer tree (textures, platform views, child
+// scenes, the performance overlay, ...) are written as |kUnsupported| and
+// dropped when the frame is read back.
+enum class SerializedLayerType : uint32_t {
+  kUnsupported = 0,
+  kContainer,
+  kPicture,
+  kTransform,
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+  kOpacity,
+  kColorFilter,
+  kBackdropFilter,
+  kPhysicalShape,
+  kShaderMask,
+};
+
+// Writes a sequence of layer trees to a stream so that the frames can be
+// replayed without the isolate that produced them. Pictures are written once
+// and referenced by later frames that use the same picture, so retained
+// layers stay shared when the frames are read back.
+class LayerTreeWriter {
+ public:
+  // Writes the stream header.
+  explicit LayerTreeWriter(SkWStream* stream);
+
+  ~LayerTreeWriter();
+
+  // Returns false if any write to the stream failed.
+  bool WriteFrame(const LayerTree& tree);
+
+  // Used by |Layer::Serialize|.
+  void WriteLayer(const Layer* layer);
+  void WriteLayerType(SerializedLayerType type);
+  void WriteBool(bool value);
+  void WriteInt(int32_t value);
+  void WriteUInt(uint32_t value);
+  void WriteScalar(SkScalar value);
+  void WritePoint(const SkPoint& point);
+  void WriteRect(const SkRect& rect);
+  void WriteRRect(const SkRRect& rrect);
+  void WriteMatrix(const SkMatrix& matrix);
+  void WritePath(const SkPath& path);
+  void WriteFlattenable(const SkFlattenable* flattenable);
+  void WritePicture(const SkPicture* picture);
+
+ private:
+  SkWStream* stream_;
+  bool ok_ = true;
+  std::unordered_map<uint32_t, uint32_t> picture_indices_;
+
+  void WriteData(const void* data, size_t length);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerTreeWriter);
+};
+
+// Reads the frames written by a |LayerTreeWriter|.
+class LayerTreeReader {
+ public:
+  // Reads the stream header. Pictures are wrapped in GPU objects that are
+  // released on |unref_queue|.
+  LayerTreeReader(SkStream* stream, fml::RefPtr<SkiaUnrefQueue> unref_queue);
+
+  ~LayerTreeReader();
+
+  bool is_valid() const { return valid_; }
+
+  // Returns null once all frames have been read or if the stream is
+  // malformed.
+  std::unique_ptr<LayerTree> ReadFrame();
+
+ private:
+  SkStream* stream_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+  bool valid_ = false;
+  std::vector<sk_sp<SkPicture>> pictures_;
+
+  // Returns false if the stream is malformed. |layer| is null for layers that
+  // could not be serialized.
+  bool ReadLayer(size_t depth, std::shared_ptr<Layer>* layer);
+  bool ReadChildren(size_t depth, ContainerLayer* container);
+  bool ReadBool(bool* value);
+  bool ReadInt(int32_t* value);
+  bool ReadUInt(uint32_t* value);
+  bool ReadScalar(SkScalar* value);
+  bool ReadPoint(SkPoint* point);
+  bool ReadRect(SkRect* rect);
+  bool ReadRRect(SkRRect* rrect);
+  bool ReadMatrix(SkMatrix* matrix);
+  bool ReadPath(SkPath* path);
+  bool ReadPicture(sk_sp<SkPicture>* picture);
+  sk_sp<SkData> ReadData();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerTreeReader);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_TREE_SERIALIZATION_H_
@@ -0,0 +1,251 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
+#include <cstring>
+
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/shader_mask_layer.h"
+#include "flutter/flow/layers/texture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/message_loop.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+
+namespace flutter {
+
+static sk_sp<SkPicture> CreatePicture(SkColor color) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setColor(color);
+  canvas->drawRect(SkRect::MakeXYWH(10, 10, 80, 80), paint);
+  return recorder.finishRecordingAsPicture();
+}
+
+static std::unique_ptr<LayerTree> CreateFrame(
+    sk_sp<SkPicture> picture,
+    fml::RefPtr<SkiaUnrefQueue> unref_queue,
+    bool with_texture = true) {
+  auto root = std::make_shared<ContainerLayer>();
+  auto transform =
+      std::make_shared<TransformLayer>(SkMatrix::MakeScale(2.0f, 3.0f));
+  auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeWH(50, 50),
+                                              Clip::antiAlias);
+  auto opacity =
+      std::make_shared<OpacityLayer>(128, SkPoint::Make(5.0f, 6.0f));
+  opacity->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(1.0f, 2.0f),
+      SkiaGPUObject<SkPicture>{std::move(picture), unref_queue}, true, false));
+  clip->Add(opacity);
+  transform->Add(clip);
+  root->Add(transform);
+  if (with_texture) {
+    root->Add(std::make_shared<TextureLayer>(SkPoint::Make(0, 0),
+                                             SkSize::Make(10, 10), 1, false));
+  }
+
+  auto tree = std::make_unique<LayerTree>();
+  tree->set_frame_size(SkISize::Make(320, 240));
+  tree->set_root_layer(std::move(root));
+  return tree;
+}
+
+static sk_sp<SkData> WriteFrames(
+    const std::vector<std::unique_ptr<LayerTree>>& frames) {
+  SkDynamicMemoryWStream stream;
+  LayerTreeWriter writer(&stream);
+  for (const auto& frame : frames) {
+    EXPECT_TRUE(writer.WriteFrame(*frame));
+  }
+  return stream.detachAsData();
+}
+
+// Serializes |frame| on its own, so that every picture is written in full.
+static sk_sp<SkData> WriteFrame(const LayerTree& frame) {
+  SkDynamicMemoryWStream stream;
+  LayerTreeWriter writer(&stream);
+  EXPECT_TRUE(writer.WriteFrame(frame));
+  return stream.detachAsData();
+}
+
+static sk_sp<SkImage> RenderFrame(LayerTree& frame) {
+  auto surface = SkSurface::MakeRasterN32Premul(frame.frame_size().width(),
+                                                frame.frame_size().height());
+  surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+  CompositorContext compositor_context;
+  auto compositor_frame = compositor_context.AcquireFrame(
+      nullptr, surface->getCanvas(), nullptr, SkMatrix::I(), false);
+  compositor_frame->Raster(frame, true);
+  return surface->makeImageSnapshot();
+}
+
+static bool HaveSamePixels(const sk_sp<SkImage>& a, const sk_sp<SkImage>& b) {
+  SkPixmap a_pixmap, b_pixmap;
+  if (!a->peekPixels(&a_pixmap) || !b->peekPixels(&b_pixmap) ||
+      a_pixmap.info() != b_pixmap.info()) {
+    return false;
+  }
+  for (int y = 0; y < a_pixmap.height(); y++) {
+    if (memcmp(a_pixmap.addr(0, y), b_pixmap.addr(0, y),
+               a_pixmap.info().minRowBytes()) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(LayerTreeSerialization, RoundTripsFrames) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(),
+      fml::TimeDelta::FromMilliseconds(8));
+
+  auto shared_picture = CreatePicture(SK_ColorRED);
+  std::vector<std::unique_ptr<LayerTree>> frames;
+  frames.push_back(CreateFrame(shared_picture, unref_queue));
+  frames.push_back(CreateFrame(shared_picture, unref_queue));
+  frames.push_back(CreateFrame(CreatePicture(SK_ColorBLUE), unref_queue));
+  auto data = WriteFrames(frames);
+
+  SkMemoryStream stream(data);
+  LayerTreeReader reader(&stream, unref_queue);
+  ASSERT_TRUE(reader.is_valid());
+  std::vector<std::unique_ptr<LayerTree>> read_frames;
+  while (auto frame = reader.ReadFrame()) {
+    read_frames.push_back(std::move(frame));
+  }
+  ASSERT_EQ(read_frames.size(), 3u);
+  EXPECT_TRUE(reader.is_valid());
+
+  std::vector<SkPicture*> pictures;
+  for (const auto& frame : read_frames) {
+    EXPECT_EQ(frame->frame_size(), SkISize::Make(320, 240));
+    // The texture layer cannot be replayed and is dropped.
+    auto* root = static_cast<ContainerLayer*>(frame->root_layer());
+    ASSERT_EQ(root->layers().size(), 1u);
+    Layer* layer = root;
+    for (int depth = 0; depth < 4; depth++) {
+      auto* container = static_cast<ContainerLayer*>(layer);
+      ASSERT_EQ(container->layers().size(), 1u);
+      layer = container->layers()[0].get();
+    }
+    auto* picture_layer = static_cast<PictureLayer*>(layer);
+    ASSERT_NE(picture_layer->picture(), nullptr);
+    EXPECT_EQ(picture_layer->picture()->cullRect(), SkRect::MakeWH(100, 100));
+    pictures.push_back(picture_layer->picture());
+  }
+  // Frames that shared a picture still share it after they were read back.
+  EXPECT_EQ(pictures[0], pictures[1]);
+  EXPECT_NE(pictures[1], pictures[2]);
+
+  // Apart from the texture, the layers and pictures read back are the same as
+  // the ones written, and draw the same pixels.
+  const SkColor colors[] = {SK_ColorRED, SK_ColorRED, SK_ColorBLUE};
+  for (size_t i = 0; i < read_frames.size(); i++) {
+    auto expected = CreateFrame(CreatePicture(colors[i]), unref_queue, false);
+    EXPECT_TRUE(WriteFrame(*expected)->equals(WriteFrame(*read_frames[i])));
+    EXPECT_TRUE(HaveSamePixels(RenderFrame(*frames[i]),
+                               RenderFrame(*read_frames[i])));
+  }
+  EXPECT_FALSE(HaveSamePixels(RenderFrame(*read_frames[0]),
+                              RenderFrame(*read_frames[2])));
+
+  read_frames.clear();
+  frames.clear();
+  unref_queue->Drain();
+}
+
+TEST(LayerTreeSerialization, RejectsMalformedStreams) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(),
+      fml::TimeDelta::FromMilliseconds(8));
+
+  const char garbage[] = "not a layer tree";
+  SkMemoryStream garbage_stream(garbage, sizeof(garbage));
+  EXPECT_FALSE(LayerTreeReader(&garbage_stream, unref_queue).is_valid());
+
+  std::vector<std::unique_ptr<LayerTree>> frames;
+  frames.push_back(CreateFrame(CreatePicture(SK_ColorRED), unref_queue));
+  auto data = WriteFrames(frames);
+  auto truncated = SkData::MakeSubset(data.get(), 0, data->size() - 4);
+  SkMemoryStream truncated_stream(truncated);
+  LayerTreeReader reader(&truncated_stream, unref_queue);
+  ASSERT_TRUE(reader.is_valid());
+  EXPECT_EQ(reader.ReadFrame(), nullptr);
+  EXPECT_FALSE(reader.is_valid());
+
+  frames.clear();
+  unref_queue->Drain();
+}
+
+TEST(LayerTreeSerialization, RoundTripsShaderMasks) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(),
+      fml::TimeDelta::FromMilliseconds(8));
+
+  const SkPoint points[] = {SkPoint::Make(0, 0), SkPoint::Make(100, 0)};
+  const SkColor colors[] = {SK_ColorBLACK, SK_ColorTRANSPARENT};
+  auto mask = std::make_shared<ShaderMaskLayer>(
+      SkGradientShader::MakeLinear(points, colors, nullptr, 2,
+                                   SkTileMode::kClamp),
+      SkRect::MakeWH(100, 100), SkBlendMode::kDstIn);
+  mask->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0),
+      SkiaGPUObject<SkPicture>{CreatePicture(SK_ColorRED), unref_queue}, false,
+      false));
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(mask);
+  LayerTree frame;
+  frame.set_frame_size(SkISize::Make(100, 100));
+  frame.set_root_layer(std::move(root));
+
+  auto data = WriteFrame(frame);
+  SkMemoryStream stream(data);
+  LayerTreeReader reader(&stream, unref_queue);
+  auto read_frame = reader.ReadFrame();
+  ASSERT_NE(read_frame, nullptr);
+  EXPECT_TRUE(data->equals(WriteFrame(*read_frame).get()));
+  EXPECT_TRUE(HaveSamePixels(RenderFrame(frame), RenderFrame(*read_frame)));
+
+  read_frame.reset();
+  frame.set_root_layer(nullptr);
+  unref_queue->Drain();
+}
+
+TEST(LayerTreeSerialization, RejectsOutOfRangeClipBehavior) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(),
+      fml::TimeDelta::FromMilliseconds(8));
+
+  for (int32_t clip_behavior : {-1, 4}) {
+    SkDynamicMemoryWStream write_stream;
+    LayerTreeWriter writer(&write_stream);
+    writer.WriteInt(100);
+    writer.WriteInt(100);
+    writer.WriteLayerType(SerializedLayerType::kClipRect);
+    writer.WriteRect(SkRect::MakeWH(50, 50));
+    writer.WriteInt(clip_behavior);
+    writer.WriteUInt(0);
+    auto data = write_stream.detachAsData();
+
+    SkMemoryStream stream(data);
+    LayerTreeReader reader(&stream, unref_queue);
+    ASSERT_TRUE(reader.is_valid());
+    EXPECT_EQ(reader.ReadFrame(), nullptr);
+    EXPECT_FALSE(reader.is_valid());
+  }
+}
+
+}  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/opacity_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
 #include "flutter/flow/layers/transform_layer.h"
 
 namespace flutter {
@@ -33,6 +34,19 @@ void OpacityLayer::EnsureSingleChild() {
   Add(new_child);
 }
 
+void OpacityLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("OpacityLayer");
+  signature->Mix(static_cast<uint64_t>(alpha_));
+  signature->Mix(offset_);
+}
+
+void OpacityLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kOpacity);
+  writer.WriteInt(alpha_);
+  writer.WritePoint(offset_);
+  SerializeChildren(writer);
+}
+
 void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   EnsureSingleChild();
   SkMatrix child_matrix = matrix;
@@ -40,7 +54,11 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->mutators_stack.PushTransform(
       SkMatrix::MakeTrans(offset_.fX, offset_.fY));
   context->mutators_stack.PushOpacity(alpha_);
-  ContainerLayer::Preroll(context, child_matrix);
+  {
+    Layer::AutoPrerollSaveLayerState save =
+        Layer::AutoPrerollSaveLayerState::Create(context);
+    ContainerLayer::Preroll(context, child_matrix);
+  }
   context->mutators_stack.Pop();
   context->mutators_stack.Pop();
   set_paint_bounds(paint_bounds().makeOffset(offset_.fX, offset_.fY));
@@ -28,6 +28,10 @@ class OpacityLayer : public ContainerLayer {
   OpacityLayer(int alpha, const SkPoint& offset);
   ~OpacityLayer() override;
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
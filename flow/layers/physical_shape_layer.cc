@@ -4,6 +4,10 @@
 
 #include "flutter/flow/layers/physical_shape_layer.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/flow/layers/layer_tree_serialization.h"
 #include "flutter/flow/paint_utils.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
 
@@ -50,12 +54,40 @@ PhysicalShapeLayer::PhysicalShapeLayer(SkColor color,
 
 PhysicalShapeLayer::~PhysicalShapeLayer() = default;
 
+void PhysicalShapeLayer::MixContentSignature(
+    ContentSignature* signature) const {
+  signature->MixTag("PhysicalShapeLayer");
+  signature->Mix(path_);
+  signature->Mix(static_cast<uint64_t>(color_));
+  signature->Mix(static_cast<uint64_t>(shadow_color_));
+  signature->MixScalar(elevation_);
+  signature->MixScalar(device_pixel_ratio_);
+  signature->Mix(static_cast<uint64_t>(clip_behavior_));
+}
+
+void PhysicalShapeLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kPhysicalShape);
+  writer.WriteUInt(color_);
+  writer.WriteUInt(shadow_color_);
+  writer.WriteScalar(device_pixel_ratio_);
+  writer.WriteScalar(viewport_depth_);
+  writer.WriteScalar(elevation_);
+  writer.WritePath(path_);
+  writer.WriteInt(clip_behavior_);
+  SerializeChildren(writer);
+}
+
 void PhysicalShapeLayer::Preroll(PrerollContext* context,
                                  const SkMatrix& matrix) {
   context->total_elevation += elevation_;
   total_elevation_ = context->total_elevation;
   SkRect child_paint_bounds;
-  PrerollChildren(context, matrix, &child_paint_bounds);
+  {
+    Layer::AutoPrerollSaveLayerState save =
+        Layer::AutoPrerollSaveLayerState::Create(
+            context, clip_behavior_ == Clip::antiAliasWithSaveLayer);
+    PrerollChildren(context, matrix, &child_paint_bounds);
+  }
   context->total_elevation -= elevation_;
 
   if (elevation_ == 0) {
@@ -98,19 +130,113 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context,
     //        w = width of the layer
     //        h = light height
     //        t = tangent of AOB, i.e., multiplier for elevation to extent
-    SkRect bounds(path_.getBounds());
-    // tangent for x
-    double tx = (kLightRadius * device_pixel_ratio_ + bounds.width() * 0.5) /
-                kLightHeight;
-    // tangent for y
-    double ty = (kLightRadius * device_pixel_ratio_ + bounds.height() * 0.5) /
-                kLightHeight;
-    bounds.outset(elevation_ * tx, elevation_ * ty);
-    set_paint_bounds(bounds);
+    set_paint_bounds(ComputeShadowBounds(path_.getBounds(), elevation_,
+                                         device_pixel_ratio_));
+
+    if (auto* cache = context->raster_cache) {
+      ShadowRasterCacheKey cache_key(
+          path_, shadow_color_, elevation_, SkColorGetA(color_) != 0xff,
+          device_pixel_ratio_, RasterCache::GetIntegralTransCTM(matrix));
+      cache->Prepare(context->gr_context, cache_key, context->dst_color_space);
+    }
 #endif  // defined(OS_FUCHSIA)
   }
 }
 
+SkRect PhysicalShapeLayer::ComputeShadowBounds(const SkRect& bounds,
+                                               float elevation,
+                                               SkScalar dpr) {
+  // tangent for x
+  double tx = (kLightRadius * dpr + bounds.width() * 0.5) / kLightHeight;
+  // tangent for y
+  double ty = (kLightRadius * dpr + bounds.height() * 0.5) / kLightHeight;
+  SkRect shadow_bounds(bounds);
+  shadow_bounds.outset(elevation * tx, elevation * ty);
+  return shadow_bounds;
+}
+
+// The maximum deviation, in device pixels, of a nine-patch stretched shadow
+// from the shadow SkShadowUtils would have drawn for the full shape.
+static constexpr SkScalar kMaxShadowNinePatchError = 0.5f;
+
+bool PhysicalShapeLayer::ComputeShadowNinePatch(const SkPath& path,
+                                                float elevation,
+                                                SkScalar dpr,
+                                                const SkMatrix& ctm,
+                                                SkRRect* proxy,
+                                                SkVector* stretch) {
+  SkRRect rrect;
+  SkRect rect;
+  if (path.isRect(&rect)) {
+    rrect = SkRRect::MakeRect(rect);
+  } else if (!path.isRRect(&rrect)) {
+    return false;
+  }
+
+  if (!ctm.isScaleTranslate() || ctm.getScaleX() == 0 ||
+      ctm.getScaleY() == 0) {
+    return false;
+  }
+
+  const SkScalar occluder_z = dpr * elevation;
+  const SkScalar light_z = dpr * kLightHeight;
+  if (occluder_z <= 0 || occluder_z >= light_z) {
+    return false;
+  }
+
+  const SkRect& bounds = rrect.rect();
+  const SkRect shadow_bounds = ComputeShadowBounds(bounds, elevation, dpr);
+  const SkScalar margin_x = bounds.left() - shadow_bounds.left();
+  const SkScalar margin_y = bounds.top() - shadow_bounds.top();
+
+  SkScalar radius_x = 0;
+  SkScalar radius_y = 0;
+  for (int i = 0; i < 4; i++) {
+    const SkVector radii = rrect.radii(static_cast<SkRRect::Corner>(i));
+    radius_x = std::max(radius_x, radii.x());
+    radius_y = std::max(radius_y, radii.y());
+  }
+
+  // Leave a couple of device pixels between the corners so that the center of
+  // the rasterized proxy shadow is uniform and can be stretched.
+  const SkScalar scale_x = std::abs(ctm.getScaleX());
+  const SkScalar scale_y = std::abs(ctm.getScaleY());
+  const SkScalar proxy_width =
+      std::min(bounds.width(), 2 * (radius_x + margin_x) + 4 / scale_x);
+  const SkScalar proxy_height =
+      std::min(bounds.height(), 2 * (radius_y + margin_y) + 4 / scale_y);
+
+  const SkVector proxy_stretch = SkVector::Make(bounds.width() - proxy_width,
+                                                bounds.height() - proxy_height);
+  if (proxy_stretch.x() <= 0 && proxy_stretch.y() <= 0) {
+    // The shape is already about as small as its shadow corners.
+    return false;
+  }
+
+  // The spot shadow is the projection of the occluder away from the light, so
+  // it grows slightly faster than the occluder itself. Vertically the light is
+  // also placed relative to the top of the shape, which moves the spot shadow.
+  const SkScalar projection = occluder_z / (light_z - occluder_z);
+  const SkScalar error =
+      std::max(proxy_stretch.x() * scale_x, 2 * proxy_stretch.y() * scale_y) *
+      0.5f * projection;
+  if (error >= kMaxShadowNinePatchError) {
+    return false;
+  }
+
+  SkVector radii[4];
+  for (int i = 0; i < 4; i++) {
+    radii[i] = rrect.radii(static_cast<SkRRect::Corner>(i));
+  }
+  proxy->setRectRadii(
+      SkRect::MakeXYWH(bounds.centerX() - proxy_width * 0.5f,
+                       bounds.centerY() - proxy_height * 0.5f, proxy_width,
+                       proxy_height),
+      radii);
+  *stretch = proxy_stretch;
+  return true;
+}
+
 #if defined(OS_FUCHSIA)
 
 void PhysicalShapeLayer::UpdateScene(SceneUpdateContext& context) {
@@ -147,8 +273,23 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting());
 
   if (elevation_ != 0) {
-    DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
-               SkColorGetA(color_) != 0xff, device_pixel_ratio_);
+    const bool transparent_occluder = SkColorGetA(color_) != 0xff;
+    bool drawn_from_cache = false;
+    if (context.raster_cache) {
+      SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
+      SkMatrix ctm = RasterCache::GetIntegralTransCTM(
+          context.leaf_nodes_canvas->getTotalMatrix());
+      context.leaf_nodes_canvas->setMatrix(ctm);
+      ShadowRasterCacheKey cache_key(path_, shadow_color_, elevation_,
+                                     transparent_occluder, device_pixel_ratio_,
+                                     ctm);
+      drawn_from_cache = context.raster_cache->Draw(
+          cache_key, *context.leaf_nodes_canvas);
+    }
+    if (!drawn_from_cache) {
+      DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
+                 transparent_occluder, device_pixel_ratio_);
+    }
   }
 
   // Call drawPath without clip if possible for better performance.
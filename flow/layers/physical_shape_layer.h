@@ -27,6 +27,30 @@ class PhysicalShapeLayer : public ContainerLayer {
                          bool transparentOccluder,
                          SkScalar dpr);
 
+  // Returns the bounds of the shadow cast by a shape with the given bounds.
+  // This is a conservative estimate of the area touched by |DrawShadow|.
+  static SkRect ComputeShadowBounds(const SkRect& bounds,
+                                    float elevation,
+                                    SkScalar dpr);
+
+  // Computes a rounded rectangle with the same corners as |path| but a
+  // smaller interior, whose shadow can be nine-patch stretched to the size of
+  // the shadow of |path|. |stretch| receives the amount by which the shadow of
+  // |proxy| must be stretched in each dimension. Returns false if |path| is
+  // not a rounded rectangle, if |ctm| is not a scale and translate, or if
+  // stretching would deviate from the exact shadow by half a device pixel or
+  // more.
+  static bool ComputeShadowNinePatch(const SkPath& path,
+                                     float elevation,
+                                     SkScalar dpr,
+                                     const SkMatrix& ctm,
+                                     SkRRect* proxy,
+                                     SkVector* stretch);
+
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
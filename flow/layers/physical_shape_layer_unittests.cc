@@ -65,4 +65,31 @@ TEST(PhysicalShapeLayer, TotalElevation) {
   EXPECT_EQ(layers[3]->total_elevation_, 8.0f);
 }
 
+TEST(PhysicalShapeLayer, ShadowNinePatchShrinksRoundedRects) {
+  SkPath path;
+  path.addRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(0, 0, 120, 60), 4, 4));
+
+  SkRRect proxy;
+  SkVector stretch;
+  ASSERT_TRUE(PhysicalShapeLayer::ComputeShadowNinePatch(
+      path, 2.0f, 1.0f, SkMatrix::I(), &proxy, &stretch));
+  EXPECT_LT(proxy.width(), 120);
+  EXPECT_FLOAT_EQ(proxy.width() + stretch.x(), 120);
+  EXPECT_FLOAT_EQ(proxy.height() + stretch.y(), 60);
+  EXPECT_FLOAT_EQ(proxy.rect().centerX(), path.getBounds().centerX());
+}
+
+TEST(PhysicalShapeLayer, ShadowNinePatchRejectsArbitraryPaths) {
+  SkPath path;
+  path.moveTo(0, 0);
+  path.lineTo(100, 0);
+  path.lineTo(50, 80);
+  path.close();
+
+  SkRRect proxy;
+  SkVector stretch;
+  ASSERT_FALSE(PhysicalShapeLayer::ComputeShadowNinePatch(
+      path, 2.0f, 1.0f, SkMatrix::I(), &proxy, &stretch));
+}
+
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/picture_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -19,6 +21,20 @@ PictureLayer::PictureLayer(const SkPoint& offset,
 
 PictureLayer::~PictureLayer() = default;
 
+void PictureLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("PictureLayer");
+  signature->Mix(offset_);
+  signature->Mix(static_cast<uint64_t>(picture()->uniqueID()));
+}
+
+void PictureLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kPicture);
+  writer.WritePoint(offset_);
+  writer.WriteBool(is_complex_);
+  writer.WriteBool(will_change_);
+  writer.WritePicture(picture());
+}
+
 void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkPicture* sk_picture = picture();
 
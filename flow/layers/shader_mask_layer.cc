@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/shader_mask_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 namespace flutter {
 
 ShaderMaskLayer::ShaderMaskLayer(sk_sp<SkShader> shader,
@@ -13,6 +15,28 @@ ShaderMaskLayer::ShaderMaskLayer(sk_sp<SkShader> shader,
 
 ShaderMaskLayer::~ShaderMaskLayer() = default;
 
+void ShaderMaskLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("ShaderMaskLayer");
+  signature->Mix(shader_.get());
+  signature->Mix(mask_rect_);
+  signature->Mix(static_cast<uint64_t>(blend_mode_));
+}
+
+void ShaderMaskLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kShaderMask);
+  writer.WriteFlattenable(shader_.get());
+  writer.WriteRect(mask_rect_);
+  writer.WriteInt(static_cast<int32_t>(blend_mode_));
+  SerializeChildren(writer);
+}
+
+void ShaderMaskLayer::Preroll(PrerollContext* context,
+                              const SkMatrix& matrix) {
+  Layer::AutoPrerollSaveLayerState save =
+      Layer::AutoPrerollSaveLayerState::Create(context);
+  ContainerLayer::Preroll(context, matrix);
+}
+
 void ShaderMaskLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ShaderMaskLayer::Paint");
   FML_DCHECK(needs_painting());
@@ -18,6 +18,12 @@ class ShaderMaskLayer : public ContainerLayer {
                   SkBlendMode blend_mode);
   ~ShaderMaskLayer() override;
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
   void Paint(PaintContext& context) const override;
 
  private:
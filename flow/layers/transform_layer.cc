@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/transform_layer.h"
 
+#include "flutter/flow/layers/layer_tree_serialization.h"
+
 namespace flutter {
 
 TransformLayer::TransformLayer(const SkMatrix& transform)
@@ -26,6 +28,17 @@ TransformLayer::TransformLayer(const SkMatrix& transform)
 
 TransformLayer::~TransformLayer() = default;
 
+void TransformLayer::MixContentSignature(ContentSignature* signature) const {
+  signature->MixTag("TransformLayer");
+  signature->Mix(transform_);
+}
+
+void TransformLayer::Serialize(LayerTreeWriter& writer) const {
+  writer.WriteLayerType(SerializedLayerType::kTransform);
+  writer.WriteMatrix(transform_);
+  SerializeChildren(writer);
+}
+
 void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkMatrix child_matrix;
   child_matrix.setConcat(matrix, transform_);
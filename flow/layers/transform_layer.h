@@ -16,6 +16,10 @@ class TransformLayer : public ContainerLayer {
   TransformLayer(const SkMatrix& transform);
   ~TransformLayer() override;
 
+  void MixContentSignature(ContentSignature* signature) const override;
+
+  void Serialize(LayerTreeWriter& writer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
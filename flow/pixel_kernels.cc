@@ -0,0 +1,217 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/pixel_kernels.h"
+
+#include "flutter/fml/build_config.h"
+
+#if defined(ARCH_CPU_X86_64)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace flutter {
+
+namespace {
+
+// Rounds |value| / 255 to the nearest integer for every |value| up to
+// 255 * 255, without a division.
+uint32_t Div255(uint32_t value) {
+  value += 128;
+  return (value + (value >> 8)) >> 8;
+}
+
+#if defined(ARCH_CPU_X86_64)
+
+// Div255 on each 16-bit lane.
+__m128i Div255(__m128i value) {
+  value = _mm_add_epi16(value, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+// Copies the alpha of each of the two pixels unpacked into 16-bit lanes to
+// all four of its lanes.
+__m128i BroadcastAlpha(__m128i pixels) {
+  pixels = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+  return _mm_shufflehi_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+#elif defined(ARCH_CPU_ARM64)
+
+// Div255 of each 16-bit lane, narrowed to 8 bits.
+uint8x8_t Div255(uint16x8_t value) {
+  return vraddhn_u16(value, vrshrq_n_u16(value, 8));
+}
+
+uint8x16_t MultiplyAndDiv255(uint8x16_t a, uint8x16_t b) {
+  return vcombine_u8(
+      Div255(vmull_u8(vget_low_u8(a), vget_low_u8(b))),
+      Div255(vmull_u8(vget_high_u8(a), vget_high_u8(b))));
+}
+
+#endif
+
+}  // namespace
+
+namespace portable {
+
+void SwapRedAndBlue(uint32_t* dst, const uint32_t* src, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t pixel = src[i];
+    dst[i] = (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) |
+             ((pixel & 0xFF) << 16);
+  }
+}
+
+void Premultiply(uint32_t* dst, const uint32_t* src, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t pixel = src[i];
+    const uint32_t alpha = pixel >> 24;
+    dst[i] = (alpha << 24) | (Div255(((pixel >> 16) & 0xFF) * alpha) << 16) |
+             (Div255(((pixel >> 8) & 0xFF) * alpha) << 8) |
+             Div255((pixel & 0xFF) * alpha);
+  }
+}
+
+void BlendSrcOver(uint32_t* dst, const uint32_t* src, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t source = src[i];
+    const uint32_t destination = dst[i];
+    const uint32_t inverse_alpha = 255 - (source >> 24);
+    uint32_t result = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 8) {
+      const uint32_t channel =
+          ((source >> shift) & 0xFF) +
+          Div255(((destination >> shift) & 0xFF) * inverse_alpha);
+      result |= (channel > 255 ? 255 : channel) << shift;
+    }
+    dst[i] = result;
+  }
+}
+
+}  // namespace portable
+
+#if defined(ARCH_CPU_X86_64)
+
+void SwapRedAndBlue(uint32_t* dst, const uint32_t* src, size_t count) {
+  const __m128i red_and_blue = _mm_set1_epi32(0x00FF00FF);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i pixels =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i rb = _mm_and_si128(pixels, red_and_blue);
+    const __m128i swapped = _mm_or_si128(
+        _mm_andnot_si128(red_and_blue, pixels),
+        _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), swapped);
+  }
+  portable::SwapRedAndBlue(dst + i, src + i, count - i);
+}
+
+void Premultiply(uint32_t* dst, const uint32_t* src, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alpha_mask = _mm_set1_epi32(0xFF000000);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i pixels =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+    const __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+    const __m128i premultiplied =
+        _mm_packus_epi16(Div255(_mm_mullo_epi16(lo, BroadcastAlpha(lo))),
+                         Div255(_mm_mullo_epi16(hi, BroadcastAlpha(hi))));
+    // Alpha times itself is not alpha, so it is taken from the source.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_or_si128(_mm_and_si128(pixels, alpha_mask),
+                                  _mm_andnot_si128(alpha_mask, premultiplied)));
+  }
+  portable::Premultiply(dst + i, src + i, count - i);
+}
+
+void BlendSrcOver(uint32_t* dst, const uint32_t* src, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i all_ones = _mm_set1_epi16(255);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i source =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i destination =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    const __m128i inverse_lo = _mm_sub_epi16(
+        all_ones, BroadcastAlpha(_mm_unpacklo_epi8(source, zero)));
+    const __m128i inverse_hi = _mm_sub_epi16(
+        all_ones, BroadcastAlpha(_mm_unpackhi_epi8(source, zero)));
+    const __m128i scaled = _mm_packus_epi16(
+        Div255(_mm_mullo_epi16(_mm_unpacklo_epi8(destination, zero),
+                               inverse_lo)),
+        Div255(_mm_mullo_epi16(_mm_unpackhi_epi8(destination, zero),
+                               inverse_hi)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_adds_epu8(source, scaled));
+  }
+  portable::BlendSrcOver(dst + i, src + i, count - i);
+}
+
+#elif defined(ARCH_CPU_ARM64)
+
+void SwapRedAndBlue(uint32_t* dst, const uint32_t* src, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint8x16x4_t pixels = vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    const uint8x16_t lowest = pixels.val[0];
+    pixels.val[0] = pixels.val[2];
+    pixels.val[2] = lowest;
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst + i), pixels);
+  }
+  portable::SwapRedAndBlue(dst + i, src + i, count - i);
+}
+
+void Premultiply(uint32_t* dst, const uint32_t* src, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint8x16x4_t pixels = vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    for (int channel = 0; channel < 3; channel++) {
+      pixels.val[channel] =
+          MultiplyAndDiv255(pixels.val[channel], pixels.val[3]);
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst + i), pixels);
+  }
+  portable::Premultiply(dst + i, src + i, count - i);
+}
+
+void BlendSrcOver(uint32_t* dst, const uint32_t* src, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const uint8x16x4_t source =
+        vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x4_t destination = vld4q_u8(reinterpret_cast<uint8_t*>(dst + i));
+    const uint8x16_t inverse_alpha = vmvnq_u8(source.val[3]);
+    for (int channel = 0; channel < 4; channel++) {
+      destination.val[channel] = vqaddq_u8(
+          source.val[channel],
+          MultiplyAndDiv255(destination.val[channel], inverse_alpha));
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst + i), destination);
+  }
+  portable::BlendSrcOver(dst + i, src + i, count - i);
+}
+
+#else
+
+void SwapRedAndBlue(uint32_t* dst, const uint32_t* src, size_t count) {
+  portable::SwapRedAndBlue(dst, src, count);
+}
+
+void Premultiply(uint32_t* dst, const uint32_t* src, size_t count) {
+  portable::Premultiply(dst, src, count);
+}
+
+void BlendSrcOver(uint32_t* dst, const uint32_t* src, size_t count) {
+  portable::BlendSrcOver(dst, src, count);
+}
+
+#endif
+
+}  // namespace flutter
@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PIXEL_KERNELS_H_
+#define FLUTTER_FLOW_PIXEL_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flutter {
+
+// Kernels over rows of |count| 32-bit pixels with 8-bit channels and alpha in
+// the highest byte, like kRGBA_8888 and kBGRA_8888 on little endian CPUs.
+// They use SSE2 on x64 and NEON on arm64, and the portable loops below on
+// other CPUs. |dst| and |src| may be the same row but must not otherwise
+// overlap.
+
+// Exchanges the lowest and third byte of each pixel, which converts between
+// RGBA and BGRA.
+void SwapRedAndBlue(uint32_t* dst, const uint32_t* src, size_t count);
+
+// Multiplies the color channels of each pixel by its alpha, rounding to the
+// nearest value.
+void Premultiply(uint32_t* dst, const uint32_t* src, size_t count);
+
+// Draws premultiplied |src| over premultiplied |dst|.
+void BlendSrcOver(uint32_t* dst, const uint32_t* src, size_t count);
+
+// The loops that are used on CPUs without a vectorized kernel. Every kernel
+// produces exactly the same pixels as its portable loop. Only exposed for
+// tests and benchmarks.
+namespace portable {
+
+void SwapRedAndBlue(uint32_t* dst, const uint32_t* src, size_t count);
+
+void Premultiply(uint32_t* dst, const uint32_t* src, size_t count);
+
+void BlendSrcOver(uint32_t* dst, const uint32_t* src, size_t count);
+
+}  // namespace portable
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_PIXEL_KERNELS_H_
@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/pixel_kernels.h"
+
+namespace flutter {
+
+using PixelKernel = void (*)(uint32_t* dst, const uint32_t* src, size_t count);
+
+// Runs |kernel| over a 1080p frame, one row at a time, like a conversion of a
+// whole image or a blit of a full screen raster cache entry.
+static void BM_PixelKernel(benchmark::State& state, PixelKernel kernel) {
+  static constexpr size_t kWidth = 1920;
+  static constexpr size_t kHeight = 1080;
+  // Translucent premultiplied pixels, so that blending has to do the work.
+  std::vector<uint32_t> src(kWidth * kHeight, 0x80402010);
+  std::vector<uint32_t> dst(kWidth * kHeight, 0xFF336699);
+
+  while (state.KeepRunning()) {
+    for (size_t y = 0; y < kHeight; y++) {
+      kernel(dst.data() + y * kWidth, src.data() + y * kWidth, kWidth);
+    }
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * kWidth * kHeight *
+                          sizeof(uint32_t));
+}
+
+BENCHMARK_CAPTURE(BM_PixelKernel, SwapRedAndBlue, &SwapRedAndBlue)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PixelKernel,
+                  SwapRedAndBluePortable,
+                  &portable::SwapRedAndBlue)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PixelKernel, Premultiply, &Premultiply)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PixelKernel, PremultiplyPortable, &portable::Premultiply)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PixelKernel, BlendSrcOver, &BlendSrcOver)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PixelKernel,
+                  BlendSrcOverPortable,
+                  &portable::BlendSrcOver)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
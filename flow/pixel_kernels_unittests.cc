@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/pixel_kernels.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static uint32_t MakePixel(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+  return (d << 24) | (c << 16) | (b << 8) | a;
+}
+
+static uint32_t Channel(uint32_t pixel, int index) {
+  return (pixel >> (index * 8)) & 0xFF;
+}
+
+// Premultiplied pixels whose color channels do not exceed their alpha.
+static std::vector<uint32_t> RandomPremultipliedPixels(size_t count,
+                                                       uint32_t seed) {
+  std::mt19937 random(seed);
+  std::vector<uint32_t> pixels(count);
+  for (auto& pixel : pixels) {
+    const uint32_t alpha = random() % 256;
+    pixel = MakePixel(random() % (alpha + 1), random() % (alpha + 1),
+                      random() % (alpha + 1), alpha);
+  }
+  return pixels;
+}
+
+TEST(PixelKernelsTest, SwapsRedAndBlue) {
+  // Row lengths that are not a multiple of the vector width leave a tail.
+  for (size_t count : {0, 1, 3, 4, 15, 16, 17, 67}) {
+    std::vector<uint32_t> src(count);
+    for (size_t i = 0; i < count; i++) {
+      src[i] = MakePixel(i, i + 1, i + 2, i + 3);
+    }
+    std::vector<uint32_t> dst(count);
+    SwapRedAndBlue(dst.data(), src.data(), count);
+    for (size_t i = 0; i < count; i++) {
+      ASSERT_EQ(dst[i], MakePixel(i + 2, i + 1, i, i + 3));
+    }
+
+    // In place.
+    SwapRedAndBlue(dst.data(), dst.data(), count);
+    ASSERT_EQ(dst, src);
+  }
+}
+
+TEST(PixelKernelsTest, PremultipliesEveryColorAndAlphaExactly) {
+  std::vector<uint32_t> src;
+  for (uint32_t alpha = 0; alpha < 256; alpha++) {
+    for (uint32_t color = 0; color < 256; color++) {
+      src.push_back(MakePixel(color, 255 - color, color / 2, alpha));
+    }
+  }
+  std::vector<uint32_t> dst(src.size());
+  Premultiply(dst.data(), src.data(), src.size());
+
+  std::vector<uint32_t> expected(src.size());
+  portable::Premultiply(expected.data(), src.data(), src.size());
+  ASSERT_EQ(dst, expected);
+
+  for (size_t i = 0; i < src.size(); i++) {
+    const uint32_t alpha = Channel(src[i], 3);
+    ASSERT_EQ(Channel(dst[i], 3), alpha);
+    for (int channel = 0; channel < 3; channel++) {
+      ASSERT_EQ(Channel(dst[i], channel),
+                static_cast<uint32_t>(
+                    std::lround(Channel(src[i], channel) * alpha / 255.0)));
+    }
+  }
+}
+
+TEST(PixelKernelsTest, BlendsSourceOverDestination) {
+  static constexpr size_t kCount = 4099;
+  const auto src = RandomPremultipliedPixels(kCount, 1);
+  const auto original_dst = RandomPremultipliedPixels(kCount, 2);
+
+  auto dst = original_dst;
+  BlendSrcOver(dst.data(), src.data(), kCount);
+  auto expected = original_dst;
+  portable::BlendSrcOver(expected.data(), src.data(), kCount);
+  ASSERT_EQ(dst, expected);
+
+  for (size_t i = 0; i < kCount; i++) {
+    const uint32_t inverse_alpha = 255 - Channel(src[i], 3);
+    for (int channel = 0; channel < 4; channel++) {
+      ASSERT_EQ(Channel(dst[i], channel),
+                Channel(src[i], channel) +
+                    static_cast<uint32_t>(
+                        std::lround(Channel(original_dst[i], channel) *
+                                    inverse_alpha / 255.0)));
+    }
+  }
+
+  // Opaque sources replace the destination and transparent ones leave it.
+  const std::vector<uint32_t> opaque(kCount, MakePixel(1, 2, 3, 255));
+  BlendSrcOver(dst.data(), opaque.data(), kCount);
+  ASSERT_EQ(dst, opaque);
+  const std::vector<uint32_t> transparent(kCount, 0);
+  BlendSrcOver(dst.data(), transparent.data(), kCount);
+  ASSERT_EQ(dst, opaque);
+}
+
+}  // namespace testing
+}  // namespace flutter
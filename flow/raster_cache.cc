@@ -4,13 +4,17 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <cmath>
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/flow/pixel_kernels.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -27,19 +31,109 @@ RasterCacheResult::RasterCacheResult(sk_sp<SkImage> image,
                                      const SkRect& logical_rect)
     : image_(std::move(image)), logical_rect_(logical_rect) {}
 
+// Blends |image| into the pixels of a raster |canvas| with its top left corner
+// at |origin| in device space, using the engine's pixel kernels. Returns false
+// without drawing anything if the canvas does not expose its pixels, or if
+// the draw needs more than an unscaled blend within a rectangular clip.
+static bool BlendIntoRasterCanvas(SkCanvas& canvas,
+                                  const SkImage& image,
+                                  const SkIPoint& origin) {
+  SkPixmap src;
+  if (!image.peekPixels(&src) ||
+      (src.colorType() != kRGBA_8888_SkColorType &&
+       src.colorType() != kBGRA_8888_SkColorType) ||
+      (src.alphaType() != kPremul_SkAlphaType &&
+       src.alphaType() != kOpaque_SkAlphaType) ||
+      !canvas.isClipRect()) {
+    return false;
+  }
+
+  // Snapshots of the surface must not see the pixels change, so the surface
+  // copies its pixels first if there are any.
+  if (SkSurface* surface = canvas.getSurface()) {
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  }
+
+  SkImageInfo info;
+  size_t row_bytes = 0;
+  SkIPoint layer_origin;
+  auto* pixels = static_cast<uint8_t*>(
+      canvas.accessTopLayerPixels(&info, &row_bytes, &layer_origin));
+  if (pixels == nullptr || info.colorType() != src.colorType() ||
+      (info.alphaType() != kPremul_SkAlphaType &&
+       info.alphaType() != kOpaque_SkAlphaType) ||
+      !SkColorSpace::Equals(info.colorSpace(), src.colorSpace())) {
+    return false;
+  }
+
+  // The image and the clip are in device space, while the pixels of the top
+  // layer start at |layer_origin|.
+  SkIRect rect = SkIRect::MakeXYWH(origin.x(), origin.y(), src.width(),
+                                   src.height());
+  if (!rect.intersect(canvas.getDeviceClipBounds())) {
+    return true;
+  }
+  rect.offset(-layer_origin.x(), -layer_origin.y());
+  if (!rect.intersect(SkIRect::MakeWH(info.width(), info.height()))) {
+    return true;
+  }
+
+  const int src_x = rect.left() + layer_origin.x() - origin.x();
+  const int src_y = rect.top() + layer_origin.y() - origin.y();
+  for (int y = 0; y < rect.height(); y++) {
+    auto* row = reinterpret_cast<uint32_t*>(
+        pixels + (rect.top() + y) * row_bytes + rect.left() * sizeof(uint32_t));
+    BlendSrcOver(row, src.addr32(src_x, src_y + y), rect.width());
+  }
+  return true;
+}
+
 void RasterCacheResult::draw(SkCanvas& canvas, const SkPaint* paint) const {
   SkAutoCanvasRestore auto_restore(&canvas, true);
   SkIRect bounds =
       RasterCache::GetDeviceBounds(logical_rect_, canvas.getTotalMatrix());
   FML_DCHECK(bounds.size() == image_->dimensions());
+  // With software rendering, cached images are blended straight into the
+  // pixels of the canvas.
+  if (paint == nullptr &&
+      BlendIntoRasterCanvas(canvas, *image_,
+                            SkIPoint::Make(bounds.fLeft, bounds.fTop))) {
+    return;
+  }
   canvas.resetMatrix();
   canvas.drawImage(image_, bounds.fLeft, bounds.fTop, paint);
 }
 
+void RasterCacheResult::drawNinePatch(SkCanvas& canvas,
+                                      const SkVector& stretch,
+                                      const SkPaint* paint) const {
+  SkAutoCanvasRestore auto_restore(&canvas, true);
+  const SkMatrix& ctm = canvas.getTotalMatrix();
+  SkIRect bounds = RasterCache::GetDeviceBounds(logical_rect_, ctm);
+  FML_DCHECK(bounds.size() == image_->dimensions());
+  SkRect dst = SkRect::Make(bounds).makeOutset(
+      std::abs(ctm.getScaleX()) * stretch.x() * 0.5f,
+      std::abs(ctm.getScaleY()) * stretch.y() * 0.5f);
+  SkIRect center =
+      SkIRect::MakeXYWH(image_->width() / 2, image_->height() / 2, 1, 1);
+  canvas.resetMatrix();
+  canvas.drawImageNine(image_.get(), center, dst, paint);
+}
+
+void FilteredBackdrop::draw(SkCanvas& canvas) const {
+  SkAutoCanvasRestore auto_restore(&canvas, true);
+  SkPaint paint;
+  paint.setFilterQuality(kLow_SkFilterQuality);
+  canvas.resetMatrix();
+  canvas.drawImageRect(image, src, dst, &paint);
+}
+
 RasterCache::RasterCache(size_t access_threshold,
-                         size_t picture_cache_limit_per_frame)
+                         size_t picture_cache_limit_per_frame,
+                         size_t shadow_cache_bytes_limit)
     : access_threshold_(access_threshold),
       picture_cache_limit_per_frame_(picture_cache_limit_per_frame),
+      shadow_cache_bytes_limit_(shadow_cache_bytes_limit),
       checkerboard_images_(false),
       weak_factory_(this) {}
 
@@ -222,6 +316,81 @@ bool RasterCache::Prepare(GrContext* context,
   return true;
 }
 
+bool RasterCache::Prepare(GrContext* context,
+                          const ShadowRasterCacheKey& key,
+                          SkColorSpace* dst_color_space) {
+  if (!MatrixDecomposition(key.matrix()).IsValid()) {
+    return false;
+  }
+
+  ShadowEntry& entry = shadow_cache_[key];
+  entry.access_count = ClampSize(entry.access_count + 1, 0, access_threshold_);
+  entry.used_this_frame = true;
+
+  if (entry.image.is_valid()) {
+    return true;
+  }
+
+  if (entry.access_count < access_threshold_ || access_threshold_ == 0 ||
+      picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+    return false;
+  }
+
+  // Rasterize the shadow of a smaller proxy shape that is stretched when
+  // drawn if possible. This mostly saves memory on large cards and sheets.
+  SkPath path = key.path();
+  SkVector stretch = SkVector::Make(0, 0);
+  SkRRect proxy;
+  if (PhysicalShapeLayer::ComputeShadowNinePatch(
+          key.path(), key.elevation(), key.device_pixel_ratio(), key.matrix(),
+          &proxy, &stretch)) {
+    path = SkPath().addRRect(proxy);
+  }
+
+  const SkRect logical_rect = PhysicalShapeLayer::ComputeShadowBounds(
+      path.getBounds(), key.elevation(), key.device_pixel_ratio());
+  const SkIRect device_rect = GetDeviceBounds(logical_rect, key.matrix());
+  const size_t bytes = device_rect.width() * device_rect.height() * 4;
+  if (device_rect.isEmpty() ||
+      shadow_cache_bytes_ + bytes > shadow_cache_bytes_limit_) {
+    return false;
+  }
+
+  entry.image = Rasterize(context, key.matrix(), dst_color_space,
+                          checkerboard_images_, logical_rect,
+                          [&key, &path](SkCanvas* canvas) {
+                            PhysicalShapeLayer::DrawShadow(
+                                canvas, path, key.color(), key.elevation(),
+                                key.transparent_occluder(),
+                                key.device_pixel_ratio());
+                          });
+  if (!entry.image.is_valid()) {
+    return false;
+  }
+  entry.stretch = stretch;
+  shadow_cache_bytes_ += ImageBytes(entry.image);
+  picture_cached_this_frame_++;
+  return true;
+}
+
+bool RasterCache::Prepare(const BackdropRasterCacheKey& key) {
+  BackdropEntry& entry = backdrop_cache_[key];
+  entry.used_this_frame = true;
+  return entry.backdrop.is_valid();
+}
+
+void RasterCache::Put(const BackdropRasterCacheKey& key,
+                      FilteredBackdrop backdrop) {
+  BackdropEntry& entry = backdrop_cache_[key];
+  entry.used_this_frame = true;
+  entry.backdrop = std::move(backdrop);
+}
+
+FilteredBackdrop RasterCache::Get(const BackdropRasterCacheKey& key) const {
+  auto it = backdrop_cache_.find(key);
+  return it == backdrop_cache_.end() ? FilteredBackdrop() : it->second.backdrop;
+}
+
 RasterCacheResult RasterCache::Get(const SkPicture& picture,
                                    const SkMatrix& ctm) const {
   PictureRasterCacheKey cache_key(picture.uniqueID(), ctm);
@@ -235,11 +404,41 @@ RasterCacheResult RasterCache::Get(Layer* layer, const SkMatrix& ctm) const {
   return it == layer_cache_.end() ? RasterCacheResult() : it->second.image;
 }
 
+bool RasterCache::Draw(const ShadowRasterCacheKey& key,
+                       SkCanvas& canvas) const {
+  auto it = shadow_cache_.find(key);
+  if (it == shadow_cache_.end() || !it->second.image.is_valid()) {
+    return false;
+  }
+
+  const ShadowEntry& entry = it->second;
+  if (entry.stretch.isZero()) {
+    entry.image.draw(canvas);
+  } else {
+    entry.image.drawNinePatch(canvas, entry.stretch);
+  }
+  return true;
+}
+
+size_t RasterCache::ImageBytes(const RasterCacheResult& image) {
+  const auto dimensions = image.image_dimensions();
+  return dimensions.width() * dimensions.height() * 4;
+}
+
 void RasterCache::SweepAfterFrame() {
   using PictureCache = PictureRasterCacheKey::Map<Entry>;
   using LayerCache = LayerRasterCacheKey::Map<Entry>;
+  using ShadowCache = ShadowRasterCacheKey::Map<ShadowEntry>;
+  using BackdropCache = BackdropRasterCacheKey::Map<BackdropEntry>;
   SweepOneCacheAfterFrame<PictureCache, PictureCache::iterator>(picture_cache_);
   SweepOneCacheAfterFrame<LayerCache, LayerCache::iterator>(layer_cache_);
+  SweepOneCacheAfterFrame<ShadowCache, ShadowCache::iterator>(shadow_cache_);
+  SweepOneCacheAfterFrame<BackdropCache, BackdropCache::iterator>(
+      backdrop_cache_);
+  shadow_cache_bytes_ = 0;
+  for (const auto& item : shadow_cache_) {
+    shadow_cache_bytes_ += ImageBytes(item.second.image);
+  }
   picture_cached_this_frame_ = 0;
   TraceStatsToTimeline();
 }
@@ -247,6 +446,9 @@ void RasterCache::SweepAfterFrame() {
 void RasterCache::Clear() {
   picture_cache_.clear();
   layer_cache_.clear();
+  shadow_cache_.clear();
+  shadow_cache_bytes_ = 0;
+  backdrop_cache_.clear();
 }
 
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
@@ -261,6 +463,42 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+size_t RasterCache::GetCachedEntriesCount() const {
+  // Entries are also kept for items that are not rasterized yet, to count
+  // their accesses.
+  size_t count = 0;
+  for (const auto& item : picture_cache_) {
+    count += item.second.image.is_valid();
+  }
+  for (const auto& item : layer_cache_) {
+    count += item.second.image.is_valid();
+  }
+  for (const auto& item : shadow_cache_) {
+    count += item.second.image.is_valid();
+  }
+  for (const auto& item : backdrop_cache_) {
+    count += item.second.backdrop.is_valid();
+  }
+  return count;
+}
+
+size_t RasterCache::EstimateByteSize() const {
+  size_t bytes = shadow_cache_bytes_;
+  for (const auto& item : picture_cache_) {
+    bytes += ImageBytes(item.second.image);
+  }
+  for (const auto& item : layer_cache_) {
+    bytes += ImageBytes(item.second.image);
+  }
+  for (const auto& item : backdrop_cache_) {
+    const auto& image = item.second.backdrop.image;
+    if (image) {
+      bytes += image->width() * image->height() * 4;
+    }
+  }
+  return bytes;
+}
+
 void RasterCache::TraceStatsToTimeline() const {
 #if FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_RELEASE
 
@@ -281,12 +519,24 @@ void RasterCache::TraceStatsToTimeline() const {
     picture_cache_bytes += dimensions.width() * dimensions.height() * 4;
   }
 
+  size_t backdrop_cache_bytes = 0;
+  for (const auto& item : backdrop_cache_) {
+    const auto& image = item.second.backdrop.image;
+    if (image) {
+      backdrop_cache_bytes += image->width() * image->height() * 4;
+    }
+  }
+
   FML_TRACE_COUNTER("flutter", "RasterCache",
-                    reinterpret_cast<int64_t>(this),             //
-                    "LayerCount", layer_cache_count,             //
-                    "LayerMBytes", layer_cache_bytes * 1e-6,     //
-                    "PictureCount", picture_cache_count,         //
-                    "PictureMBytes", picture_cache_bytes * 1e-6  //
+                    reinterpret_cast<int64_t>(this),              //
+                    "LayerCount", layer_cache_count,              //
+                    "LayerMBytes", layer_cache_bytes * 1e-6,      //
+                    "PictureCount", picture_cache_count,          //
+                    "PictureMBytes", picture_cache_bytes * 1e-6,  //
+                    "ShadowCount", shadow_cache_.size(),          //
+                    "ShadowMBytes", shadow_cache_bytes_ * 1e-6,   //
+                    "BackdropCount", backdrop_cache_.size(),      //
+                    "BackdropMBytes", backdrop_cache_bytes * 1e-6  //
   );
 
 #endif  // FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_RELEASE
@@ -33,6 +33,12 @@ class RasterCacheResult {
 
   void draw(SkCanvas& canvas, const SkPaint* paint = nullptr) const;
 
+  // Draws the image as a nine-patch whose center pixel is stretched by
+  // |stretch| (in logical units) in each dimension.
+  void drawNinePatch(SkCanvas& canvas,
+                     const SkVector& stretch,
+                     const SkPaint* paint = nullptr) const;
+
   SkISize image_dimensions() const {
     return image_ ? image_->dimensions() : SkISize::Make(0, 0);
   };
@@ -42,6 +48,19 @@ class RasterCacheResult {
   SkRect logical_rect_;
 };
 
+// The result of applying a backdrop filter. |src| (in pixels of |image|) is
+// drawn into |dst| (in device space), which is larger than |src| if the
+// backdrop was downsampled before it was filtered.
+struct FilteredBackdrop {
+  sk_sp<SkImage> image;
+  SkIRect src;
+  SkRect dst;
+
+  bool is_valid() const { return static_cast<bool>(image); }
+
+  void draw(SkCanvas& canvas) const;
+};
+
 struct PrerollContext;
 
 class RasterCache {
@@ -52,9 +71,14 @@ class RasterCache {
   // multiple frames.
   static constexpr int kDefaultPictureCacheLimitPerFrame = 3;
 
+  // The default number of bytes the rasterized shadows of physical shapes may
+  // occupy in total.
+  static constexpr size_t kDefaultShadowCacheBytesLimit = 16 * 1024 * 1024;
+
   explicit RasterCache(
       size_t access_threshold = 3,
-      size_t picture_cache_limit_per_frame = kDefaultPictureCacheLimitPerFrame);
+      size_t picture_cache_limit_per_frame = kDefaultPictureCacheLimitPerFrame,
+      size_t shadow_cache_bytes_limit = kDefaultShadowCacheBytesLimit);
 
   ~RasterCache();
 
@@ -90,16 +114,49 @@ class RasterCache {
 
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
+  // Return true if the shadow is cached.
+  //
+  // Shadows are rasterized once they have been used for |access_threshold|
+  // consecutive frames, subject to the same per frame limit as pictures, and
+  // only while the rasterized shadows fit in |shadow_cache_bytes_limit|.
+  bool Prepare(GrContext* context,
+               const ShadowRasterCacheKey& key,
+               SkColorSpace* dst_color_space);
+
+  // Return true if the filtered backdrop is cached.
+  //
+  // Unlike pictures and layers, backdrops are filtered while the frame is
+  // painted, so this only keeps the entry for |key| alive. A missing entry is
+  // supplied through |Put| once the backdrop has been filtered.
+  bool Prepare(const BackdropRasterCacheKey& key);
+
+  void Put(const BackdropRasterCacheKey& key, FilteredBackdrop backdrop);
+
   RasterCacheResult Get(const SkPicture& picture, const SkMatrix& ctm) const;
 
   RasterCacheResult Get(Layer* layer, const SkMatrix& ctm) const;
 
+  // Draws the cached shadow for |key| into |canvas|, whose total matrix must
+  // be the ctm the key was made from. Returns false if the shadow is not
+  // cached.
+  bool Draw(const ShadowRasterCacheKey& key, SkCanvas& canvas) const;
+
+  FilteredBackdrop Get(const BackdropRasterCacheKey& key) const;
+
   void SweepAfterFrame();
 
   void Clear();
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  // The number of rasterized pictures, layers, shadows and filtered backdrops
+  // held by the cache.
+  size_t GetCachedEntriesCount() const;
+
+  // The bytes held by the rasterized images in the cache, assuming four bytes
+  // per pixel.
+  size_t EstimateByteSize() const;
+
  private:
   struct Entry {
     bool used_this_frame = false;
@@ -107,12 +164,23 @@ class RasterCache {
     RasterCacheResult image;
   };
 
+  struct ShadowEntry : public Entry {
+    // The amount by which a nine-patch image is stretched when drawn. Zero if
+    // the image is the full shadow.
+    SkVector stretch = SkVector::Make(0, 0);
+  };
+
+  struct BackdropEntry {
+    bool used_this_frame = false;
+    FilteredBackdrop backdrop;
+  };
+
   template <class Cache, class Iterator>
   static void SweepOneCacheAfterFrame(Cache& cache) {
     std::vector<Iterator> dead;
 
     for (auto it = cache.begin(); it != cache.end(); ++it) {
-      Entry& entry = it->second;
+      auto& entry = it->second;
       if (!entry.used_this_frame) {
         dead.push_back(it);
       }
@@ -126,14 +194,20 @@ class RasterCache {
 
   const size_t access_threshold_;
   const size_t picture_cache_limit_per_frame_;
+  const size_t shadow_cache_bytes_limit_;
   size_t picture_cached_this_frame_ = 0;
+  size_t shadow_cache_bytes_ = 0;
   PictureRasterCacheKey::Map<Entry> picture_cache_;
   LayerRasterCacheKey::Map<Entry> layer_cache_;
+  ShadowRasterCacheKey::Map<ShadowEntry> shadow_cache_;
+  BackdropRasterCacheKey::Map<BackdropEntry> backdrop_cache_;
   bool checkerboard_images_;
   fml::WeakPtrFactory<RasterCache> weak_factory_;
 
   void TraceStatsToTimeline() const;
 
+  static size_t ImageBytes(const RasterCacheResult& image);
+
   FML_DISALLOW_COPY_AND_ASSIGN(RasterCache);
 };
 
@@ -5,9 +5,14 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_KEY_H_
 #define FLUTTER_FLOW_RASTER_CACHE_KEY_H_
 
+#include <functional>
 #include <unordered_map>
 #include "flutter/flow/matrix_decomposition.h"
 #include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRect.h"
 
 namespace flutter {
 
@@ -59,6 +64,132 @@ class Layer;
 // The ID is the uint64_t layer unique_id
 using LayerRasterCacheKey = RasterCacheKey<uint64_t>;
 
+// Identifies the rasterized shadow of a physical shape. Unlike pictures and
+// layers, shadows are keyed on their geometry and appearance so that they can
+// be reused across frames in which the layer tree was rebuilt. Like for
+// pictures, only the fractional part of the translation is kept, so that a
+// shadow that scrolls keeps using the same entry. The cached shadow is lit as
+// if its shape was at that fractional offset, and drawn at the actual
+// translation.
+class ShadowRasterCacheKey {
+ public:
+  ShadowRasterCacheKey(const SkPath& path,
+                       SkColor color,
+                       float elevation,
+                       bool transparent_occluder,
+                       SkScalar device_pixel_ratio,
+                       const SkMatrix& ctm)
+      : path_(path),
+        color_(color),
+        elevation_(elevation),
+        transparent_occluder_(transparent_occluder),
+        device_pixel_ratio_(device_pixel_ratio),
+        matrix_(ctm) {
+    matrix_[SkMatrix::kMTransX] = SkScalarFraction(ctm.getTranslateX());
+    matrix_[SkMatrix::kMTransY] = SkScalarFraction(ctm.getTranslateY());
+  }
+
+  const SkPath& path() const { return path_; }
+  SkColor color() const { return color_; }
+  float elevation() const { return elevation_; }
+  bool transparent_occluder() const { return transparent_occluder_; }
+  SkScalar device_pixel_ratio() const { return device_pixel_ratio_; }
+  const SkMatrix& matrix() const { return matrix_; }
+
+  struct Hash {
+    size_t operator()(ShadowRasterCacheKey const& key) const {
+      const SkRect& bounds = key.path_.getBounds();
+      size_t hash = std::hash<uint32_t>()(key.color_);
+      hash = hash * 31 + std::hash<float>()(key.elevation_);
+      hash = hash * 31 + std::hash<float>()(bounds.fLeft);
+      hash = hash * 31 + std::hash<float>()(bounds.fTop);
+      hash = hash * 31 + std::hash<float>()(bounds.fRight);
+      hash = hash * 31 + std::hash<float>()(bounds.fBottom);
+      hash = hash * 31 + std::hash<float>()(key.matrix_.getScaleX());
+      hash = hash * 31 + std::hash<float>()(key.matrix_.getScaleY());
+      return hash;
+    }
+  };
+
+  struct Equal {
+    bool operator()(const ShadowRasterCacheKey& lhs,
+                    const ShadowRasterCacheKey& rhs) const {
+      return lhs.color_ == rhs.color_ && lhs.elevation_ == rhs.elevation_ &&
+             lhs.transparent_occluder_ == rhs.transparent_occluder_ &&
+             lhs.device_pixel_ratio_ == rhs.device_pixel_ratio_ &&
+             lhs.matrix_ == rhs.matrix_ && lhs.path_ == rhs.path_;
+    }
+  };
+
+  template <class Value>
+  using Map = std::unordered_map<ShadowRasterCacheKey, Value, Hash, Equal>;
+
+ private:
+  SkPath path_;
+  SkColor color_;
+  float elevation_;
+  bool transparent_occluder_;
+  SkScalar device_pixel_ratio_;
+  // ctm where only fractional (0-1) translations are preserved, like for
+  // |RasterCacheKey|.
+  SkMatrix matrix_;
+};
+
+// Identifies the filtered backdrop of a backdrop filter layer. The content
+// signature summarizes every layer painted before the backdrop filter layer
+// (see |ContentSignature|), so two equal keys sample identical pixels.
+class BackdropRasterCacheKey {
+ public:
+  BackdropRasterCacheKey(uint64_t content_signature,
+                         sk_sp<SkData> filter,
+                         const SkIRect& device_bounds,
+                         const SkMatrix& ctm,
+                         int downsample_factor)
+      : content_signature_(content_signature),
+        filter_(std::move(filter)),
+        device_bounds_(device_bounds),
+        matrix_(ctm),
+        downsample_factor_(downsample_factor) {}
+
+  uint64_t content_signature() const { return content_signature_; }
+  const SkIRect& device_bounds() const { return device_bounds_; }
+  const SkMatrix& matrix() const { return matrix_; }
+  int downsample_factor() const { return downsample_factor_; }
+
+  struct Hash {
+    size_t operator()(BackdropRasterCacheKey const& key) const {
+      size_t hash = std::hash<uint64_t>()(key.content_signature_);
+      hash = hash * 31 + std::hash<int32_t>()(key.device_bounds_.fLeft);
+      hash = hash * 31 + std::hash<int32_t>()(key.device_bounds_.fTop);
+      hash = hash * 31 + std::hash<int32_t>()(key.device_bounds_.fRight);
+      hash = hash * 31 + std::hash<int32_t>()(key.device_bounds_.fBottom);
+      return hash;
+    }
+  };
+
+  struct Equal {
+    bool operator()(const BackdropRasterCacheKey& lhs,
+                    const BackdropRasterCacheKey& rhs) const {
+      return lhs.content_signature_ == rhs.content_signature_ &&
+             lhs.device_bounds_ == rhs.device_bounds_ &&
+             lhs.matrix_ == rhs.matrix_ &&
+             lhs.downsample_factor_ == rhs.downsample_factor_ &&
+             lhs.filter_->equals(rhs.filter_.get());
+    }
+  };
+
+  template <class Value>
+  using Map = std::unordered_map<BackdropRasterCacheKey, Value, Hash, Equal>;
+
+ private:
+  uint64_t content_signature_;
+  // The serialized image filter.
+  sk_sp<SkData> filter_;
+  SkIRect device_bounds_;
+  SkMatrix matrix_;
+  int downsample_factor_;
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_RASTER_CACHE_KEY_H_
@@ -2,10 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
 #include "flutter/flow/raster_cache.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 sk_sp<SkPicture> GetSamplePicture() {
   SkPictureRecorder recorder;
@@ -93,3 +99,187 @@ TEST(RasterCache, SweepsRemoveUnusedFrames) {
   ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
                              false));  // 5
 }
+
+static flutter::ShadowRasterCacheKey GetSampleShadowKey(const SkMatrix& ctm) {
+  SkPath path;
+  path.addRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(10, 10, 200, 80), 8, 8));
+  return flutter::ShadowRasterCacheKey(path, SK_ColorBLACK, 4.0f, false, 2.0f,
+                                       ctm);
+}
+
+TEST(RasterCache, ShadowThresholdIsRespected) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  auto key = GetSampleShadowKey(SkMatrix::I());
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(cache.Prepare(NULL, key, srgb.get()));  // 1
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.Prepare(NULL, key, srgb.get()));  // 2
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();  // Extra frame without a preroll shadow access.
+  ASSERT_FALSE(cache.Prepare(NULL, key, srgb.get()));  // 3
+}
+
+TEST(RasterCache, ShadowCacheRespectsBytesLimit) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(
+      threshold, flutter::RasterCache::kDefaultPictureCacheLimitPerFrame,
+      1024);
+
+  auto key = GetSampleShadowKey(SkMatrix::I());
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(cache.Prepare(NULL, key, srgb.get()));
+  cache.SweepAfterFrame();
+  ASSERT_FALSE(cache.Prepare(NULL, key, srgb.get()));
+}
+
+TEST(RasterCache, ShadowKeyIgnoresIntegralTranslation) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  auto key = GetSampleShadowKey(SkMatrix::I());
+  const SkMatrix translation = SkMatrix::MakeTrans(20, 7);
+  auto translated_key = GetSampleShadowKey(translation);
+  auto scaled_key = GetSampleShadowKey(SkMatrix::MakeScale(2));
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_TRUE(cache.Prepare(NULL, key, srgb.get()));
+  ASSERT_TRUE(cache.Prepare(NULL, translated_key, srgb.get()));
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 1u);
+
+  auto surface = SkSurface::MakeRasterN32Premul(300, 200);
+  ASSERT_TRUE(cache.Draw(key, *surface->getCanvas()));
+  ASSERT_FALSE(cache.Draw(scaled_key, *surface->getCanvas()));
+
+  // The same image is drawn at the translation of the canvas.
+  auto translated_surface = SkSurface::MakeRasterN32Premul(300, 200);
+  translated_surface->getCanvas()->setMatrix(translation);
+  ASSERT_TRUE(cache.Draw(translated_key, *translated_surface->getCanvas()));
+
+  SkBitmap expected, actual;
+  ASSERT_TRUE(expected.tryAllocN32Pixels(280, 193));
+  ASSERT_TRUE(actual.tryAllocN32Pixels(280, 193));
+  ASSERT_TRUE(surface->readPixels(expected, 0, 0));
+  ASSERT_TRUE(translated_surface->readPixels(actual, 20, 7));
+  for (int y = 0; y < expected.height(); y++) {
+    ASSERT_EQ(memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                     expected.rowBytes()),
+              0);
+  }
+}
+
+// Returns the largest difference between the channels of the pixels of two
+// surfaces of the same size.
+static int MaxChannelDifference(SkSurface* a, SkSurface* b) {
+  SkPixmap a_pixmap, b_pixmap;
+  if (!a->peekPixels(&a_pixmap) || !b->peekPixels(&b_pixmap)) {
+    return 256;
+  }
+  int difference = 0;
+  for (int y = 0; y < a_pixmap.height(); y++) {
+    for (int x = 0; x < a_pixmap.width(); x++) {
+      const uint32_t a_pixel = *a_pixmap.addr32(x, y);
+      const uint32_t b_pixel = *b_pixmap.addr32(x, y);
+      for (int shift = 0; shift < 32; shift += 8) {
+        const int a_channel = (a_pixel >> shift) & 0xFF;
+        const int b_channel = (b_pixel >> shift) & 0xFF;
+        difference = std::max(difference, std::abs(a_channel - b_channel));
+      }
+    }
+  }
+  return difference;
+}
+
+TEST(RasterCache, DrawsIntoRasterCanvasesLikeSkia) {
+  // A translucent image, so that it has to be blended.
+  auto image_surface = SkSurface::MakeRasterN32Premul(40, 30);
+  image_surface->getCanvas()->clear(SkColorSetARGB(128, 255, 0, 0));
+  SkPaint paint;
+  paint.setColor(SkColorSetARGB(200, 0, 0, 255));
+  image_surface->getCanvas()->drawCircle(20, 15, 12, paint);
+  flutter::RasterCacheResult result(image_surface->makeImageSnapshot(),
+                                    SkRect::MakeXYWH(10, 10, 40, 30));
+
+  // The clip cuts through the image.
+  auto draw = [&result](SkCanvas* canvas) {
+    canvas->clear(SkColorSetARGB(255, 0, 128, 0));
+    canvas->clipRect(SkRect::MakeXYWH(0, 0, 35, 80));
+    canvas->translate(5, 3);
+    result.draw(*canvas);
+  };
+
+  auto blended = SkSurface::MakeRasterN32Premul(100, 80);
+  draw(blended->getCanvas());
+
+  // A recording canvas has no pixels, so the picture draws through Skia.
+  SkPictureRecorder recorder;
+  draw(recorder.beginRecording(SkRect::MakeWH(100, 80)));
+  auto expected = SkSurface::MakeRasterN32Premul(100, 80);
+  expected->getCanvas()->drawPicture(recorder.finishRecordingAsPicture());
+
+  // Skia rounds some blends differently.
+  ASSERT_LE(MaxChannelDifference(blended.get(), expected.get()), 1);
+
+  // Snapshots of the surface keep the pixels they were taken with.
+  auto snapshot = blended->makeImageSnapshot();
+  auto before = SkSurface::MakeRasterN32Premul(100, 80);
+  before->getCanvas()->drawImage(snapshot, 0, 0);
+  result.draw(*blended->getCanvas());
+  auto after = SkSurface::MakeRasterN32Premul(100, 80);
+  after->getCanvas()->drawImage(snapshot, 0, 0);
+  ASSERT_EQ(MaxChannelDifference(before.get(), after.get()), 0);
+  ASSERT_GT(MaxChannelDifference(before.get(), blended.get()), 0);
+}
+
+TEST(RasterCache, ReportsRasterizedEntriesOnly) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  auto key = GetSampleShadowKey(SkMatrix::I());
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(cache.Prepare(NULL, key, srgb.get()));
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+  ASSERT_EQ(cache.EstimateByteSize(), 0u);
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.Prepare(NULL, key, srgb.get()));
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 1u);
+  ASSERT_GT(cache.EstimateByteSize(), 0u);
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+  ASSERT_EQ(cache.EstimateByteSize(), 0u);
+}
+
+static flutter::BackdropRasterCacheKey GetSampleBackdropKey(
+    uint64_t content_signature) {
+  auto filter = SkData::MakeWithCString("filter");
+  return flutter::BackdropRasterCacheKey(content_signature, filter,
+                                         SkIRect::MakeWH(100, 50),
+                                         SkMatrix::I(), 1);
+}
+
+TEST(RasterCache, BackdropIsKeptWhileUsed) {
+  flutter::RasterCache cache;
+
+  auto key = GetSampleBackdropKey(1);
+  auto other_key = GetSampleBackdropKey(2);
+
+  ASSERT_FALSE(cache.Prepare(key));
+  flutter::FilteredBackdrop backdrop;
+  backdrop.image = SkSurface::MakeRasterN32Premul(100, 50)->makeImageSnapshot();
+  backdrop.src = SkIRect::MakeWH(100, 50);
+  backdrop.dst = SkRect::MakeWH(100, 50);
+  cache.Put(key, backdrop);
+  ASSERT_TRUE(cache.Get(key).is_valid());
+  ASSERT_FALSE(cache.Get(other_key).is_valid());
+
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.Prepare(key));
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();  // Extra frame without a preroll backdrop access.
+  ASSERT_FALSE(cache.Prepare(key));
+}
@@ -4,41 +4,121 @@
 
 #include "flutter/flow/skia_gpu_object.h"
 
+#include <algorithm>
+
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+// Reading the clock costs about as much as releasing a small object, so the
+// budget is checked after every few objects.
+static constexpr size_t kReleaseBatchSize = 16;
+
 SkiaUnrefQueue::SkiaUnrefQueue(fml::RefPtr<fml::TaskRunner> task_runner,
-                               fml::TimeDelta delay)
+                               fml::TimeDelta delay,
+                               fml::TimeDelta drain_budget)
     : task_runner_(std::move(task_runner)),
       drain_delay_(delay),
-      drain_pending_(false) {}
+      drain_budget_(drain_budget),
+      incoming_(nullptr),
+      drain_pending_(false),
+      pending_count_(0),
+      released_count_(0),
+      deferred_drain_count_(0) {}
 
 SkiaUnrefQueue::~SkiaUnrefQueue() {
   Drain();
 }
 
 void SkiaUnrefQueue::Unref(SkRefCnt* object) {
-  std::scoped_lock lock(mutex_);
-  objects_.push_back(object);
-  if (!drain_pending_) {
-    drain_pending_ = true;
+  pending_count_.fetch_add(1, std::memory_order_relaxed);
+  Node* node = new Node{object, incoming_.load(std::memory_order_relaxed)};
+  // Queuing the object and then checking for a pending drain is sequentially
+  // consistent, like the reverse in |DrainWithBudget|, so that either this
+  // sees no drain pending or the drain sees the object.
+  while (!incoming_.compare_exchange_weak(node->next, node,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+  }
+  if (!drain_pending_.exchange(true, std::memory_order_seq_cst)) {
     task_runner_->PostDelayedTask(
-        [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
+        [strong = fml::Ref(this)]() { strong->DrainWithBudget(); },
+        drain_delay_);
   }
 }
 
 void SkiaUnrefQueue::Drain() {
-  std::deque<SkRefCnt*> skia_objects;
-  {
-    std::scoped_lock lock(mutex_);
-    objects_.swap(skia_objects);
-    drain_pending_ = false;
+  // Objects queued from here on post a drain of their own, while the ones
+  // queued before are released now.
+  drain_pending_.store(false, std::memory_order_seq_cst);
+  TakeIncoming();
+  ReleaseOldest(objects_.size());
+}
+
+SkiaUnrefQueue::Stats SkiaUnrefQueue::GetStats() const {
+  Stats stats;
+  stats.pending_count = pending_count_.load(std::memory_order_relaxed);
+  stats.released_count = released_count_.load(std::memory_order_relaxed);
+  stats.deferred_drain_count =
+      deferred_drain_count_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void SkiaUnrefQueue::DrainWithBudget() {
+  TRACE_EVENT0("flutter", "SkiaUnrefQueue::Drain");
+  TakeIncoming();
+
+  const fml::TimePoint deadline = fml::TimePoint::Now() + drain_budget_;
+  while (!objects_.empty()) {
+    ReleaseOldest(std::min(kReleaseBatchSize, objects_.size()));
+    if (fml::TimePoint::Now() >= deadline) {
+      break;
+    }
+  }
+
+  FML_TRACE_COUNTER("flutter", "SkiaUnrefQueue",
+                    reinterpret_cast<int64_t>(this), "PendingObjects",
+                    pending_count_.load(std::memory_order_relaxed));
+
+  if (!objects_.empty()) {
+    // Objects queued in the meantime are released by the next drain too.
+    deferred_drain_count_.fetch_add(1, std::memory_order_relaxed);
+    task_runner_->PostTask(
+        [strong = fml::Ref(this)]() { strong->DrainWithBudget(); });
+    return;
+  }
+
+  drain_pending_.store(false, std::memory_order_seq_cst);
+  // An object queued after |TakeIncoming| saw the drain as pending and did not
+  // post another one.
+  if (incoming_.load(std::memory_order_seq_cst) != nullptr &&
+      !drain_pending_.exchange(true, std::memory_order_seq_cst)) {
+    task_runner_->PostDelayedTask(
+        [strong = fml::Ref(this)]() { strong->DrainWithBudget(); },
+        drain_delay_);
   }
+}
+
+void SkiaUnrefQueue::TakeIncoming() {
+  Node* node = incoming_.exchange(nullptr, std::memory_order_acquire);
+  const size_t taken_from = objects_.size();
+  while (node) {
+    objects_.push_back(node->object);
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+  std::reverse(objects_.begin() + taken_from, objects_.end());
+}
 
-  for (SkRefCnt* skia_object : skia_objects) {
-    skia_object->unref();
+void SkiaUnrefQueue::ReleaseOldest(size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    objects_.front()->unref();
+    objects_.pop_front();
   }
+  pending_count_.fetch_sub(count, std::memory_order_relaxed);
+  released_count_.fetch_add(count, std::memory_order_relaxed);
 }
 
 }  // namespace flutter
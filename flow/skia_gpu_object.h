@@ -5,8 +5,8 @@
 #ifndef FLUTTER_FLOW_SKIA_GPU_OBJECT_H_
 #define FLUTTER_FLOW_SKIA_GPU_OBJECT_H_
 
-#include <mutex>
-#include <queue>
+#include <atomic>
+#include <deque>
 
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -17,8 +17,26 @@ namespace flutter {
 
 // A queue that holds Skia objects that must be destructed on the the given task
 // runner.
+//
+// Objects are released in drains that each spend at most |drain_budget| doing
+// so. A burst of releases, like a long list of images being torn down, is
+// spread over several drains so that other tasks, like uploading the images
+// of the next screen, get to run in between.
 class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
  public:
+  static constexpr fml::TimeDelta kDefaultDrainBudget =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  struct Stats {
+    // The objects queued that have not been released yet.
+    size_t pending_count = 0;
+    // The objects released since the queue was created.
+    size_t released_count = 0;
+    // The drains that ran out of budget and left objects to a later drain.
+    size_t deferred_drain_count = 0;
+  };
+
+  // Can be called on any thread. This does not take a lock.
   void Unref(SkRefCnt* object);
 
   // Usually, the drain is called automatically. However, during IO manager
@@ -26,20 +44,44 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   // to go away), we may need to pre-emptively drain the unref queue. It is the
   // responsibility of the caller to ensure that no further unrefs are queued
   // after this call.
+  //
+  // This releases all queued objects regardless of the drain budget. It must be
+  // called on the task runner of the queue.
   void Drain();
 
+  Stats GetStats() const;
+
  private:
+  struct Node {
+    SkRefCnt* object;
+    Node* next;
+  };
+
   const fml::RefPtr<fml::TaskRunner> task_runner_;
   const fml::TimeDelta drain_delay_;
-  std::mutex mutex_;
+  const fml::TimeDelta drain_budget_;
+  // The objects queued since the last drain, most recent first.
+  std::atomic<Node*> incoming_;
+  // The objects taken from |incoming_| that are still to be released, oldest
+  // first. Only used on the task runner.
   std::deque<SkRefCnt*> objects_;
-  bool drain_pending_;
+  std::atomic_bool drain_pending_;
+  std::atomic_size_t pending_count_;
+  std::atomic_size_t released_count_;
+  std::atomic_size_t deferred_drain_count_;
 
   SkiaUnrefQueue(fml::RefPtr<fml::TaskRunner> task_runner,
-                 fml::TimeDelta delay);
+                 fml::TimeDelta delay,
+                 fml::TimeDelta drain_budget = kDefaultDrainBudget);
 
   ~SkiaUnrefQueue();
 
+  void DrainWithBudget();
+
+  void TakeIncoming();
+
+  void ReleaseOldest(size_t count);
+
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(SkiaUnrefQueue);
   FML_FRIEND_MAKE_REF_COUNTED(SkiaUnrefQueue);
   FML_DISALLOW_COPY_AND_ASSIGN(SkiaUnrefQueue);
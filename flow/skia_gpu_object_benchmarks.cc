@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+
+namespace flutter {
+
+// Stands in for a texture whose release takes the driver a few microseconds.
+class FakeTexture : public SkRefCnt {
+ public:
+  explicit FakeTexture(fml::CountDownLatch& released) : released_(released) {}
+
+  ~FakeTexture() override {
+    const fml::TimePoint end =
+        fml::TimePoint::Now() + fml::TimeDelta::FromMicroseconds(4);
+    while (fml::TimePoint::Now() < end) {
+    }
+    released_.CountDown();
+  }
+
+ private:
+  fml::CountDownLatch& released_;
+};
+
+// Releases |state.range(0)| textures at once, like a long list being torn
+// down, and reports how late an upload for the next screen that is due
+// shortly after the release starts gets to run on the IO thread.
+static void BM_UploadLatencyDuringMassRelease(benchmark::State& state,
+                                              fml::TimeDelta drain_budget) {
+  const fml::TimeDelta drain_delay = fml::TimeDelta::FromMilliseconds(8);
+  fml::Thread io_thread("io");
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      io_thread.GetTaskRunner(), drain_delay, drain_budget);
+
+  const size_t texture_count = state.range(0);
+  while (state.KeepRunning()) {
+    fml::CountDownLatch released(texture_count);
+    for (size_t i = 0; i < texture_count; i++) {
+      queue->Unref(new FakeTexture(released));
+    }
+
+    const fml::TimeDelta upload_delay =
+        drain_delay + fml::TimeDelta::FromMilliseconds(1);
+    const fml::TimePoint upload_due = fml::TimePoint::Now() + upload_delay;
+    fml::TimeDelta upload_latency;
+    fml::AutoResetWaitableEvent uploaded;
+    io_thread.GetTaskRunner()->PostDelayedTask(
+        [&]() {
+          upload_latency = fml::TimePoint::Now() - upload_due;
+          uploaded.Signal();
+        },
+        upload_delay);
+    uploaded.Wait();
+    released.Wait();
+
+    state.SetIterationTime(upload_latency.ToSecondsF());
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  SkiaUnrefQueue::Stats stats;
+  io_thread.GetTaskRunner()->PostTask([&]() {
+    stats = queue->GetStats();
+    latch.Signal();
+  });
+  latch.Wait();
+  state.counters["deferred_drains"] = stats.deferred_drain_count;
+}
+
+BENCHMARK_CAPTURE(BM_UploadLatencyDuringMassRelease,
+                  Unbudgeted,
+                  fml::TimeDelta::FromSeconds(60))
+    ->Arg(5000)
+    ->Iterations(20)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_UploadLatencyDuringMassRelease,
+                  Budgeted,
+                  SkiaUnrefQueue::kDefaultDrainBudget)
+    ->Arg(5000)
+    ->Iterations(20)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/skia_gpu_object.h"
+
+#include <memory>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+class ReleasedObject : public SkRefCnt {
+ public:
+  explicit ReleasedObject(fml::CountDownLatch& latch) : latch_(latch) {}
+
+  ~ReleasedObject() override { latch_.CountDown(); }
+
+ private:
+  fml::CountDownLatch& latch_;
+};
+
+// Queues |count| objects while the task runner is busy, so that the first
+// drain finds all of them.
+static void QueueObjects(fml::RefPtr<fml::TaskRunner> task_runner,
+                         SkiaUnrefQueue& queue,
+                         size_t count,
+                         fml::CountDownLatch& released) {
+  auto queued = std::make_shared<fml::ManualResetWaitableEvent>();
+  task_runner->PostTask([queued]() { queued->Wait(); });
+  for (size_t i = 0; i < count; i++) {
+    queue.Unref(new ReleasedObject(released));
+  }
+  queued->Signal();
+}
+
+static SkiaUnrefQueue::Stats GetStatsOnTaskRunner(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    const SkiaUnrefQueue& queue) {
+  SkiaUnrefQueue::Stats stats;
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&]() {
+    stats = queue.GetStats();
+    latch.Signal();
+  });
+  latch.Wait();
+  return stats;
+}
+
+TEST(SkiaUnrefQueueTest, ReleasesObjectsInOneDrainWithinBudget) {
+  fml::Thread thread("io");
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      thread.GetTaskRunner(), fml::TimeDelta::Zero(),
+      fml::TimeDelta::FromSeconds(10));
+
+  fml::CountDownLatch released(100);
+  QueueObjects(thread.GetTaskRunner(), *queue, 100, released);
+  released.Wait();
+
+  auto stats = GetStatsOnTaskRunner(thread.GetTaskRunner(), *queue);
+  ASSERT_EQ(stats.pending_count, 0u);
+  ASSERT_EQ(stats.released_count, 100u);
+  ASSERT_EQ(stats.deferred_drain_count, 0u);
+}
+
+TEST(SkiaUnrefQueueTest, SpreadsReleasesOverDrainsWhenOverBudget) {
+  fml::Thread thread("io");
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      thread.GetTaskRunner(), fml::TimeDelta::Zero(),
+      fml::TimeDelta::FromNanoseconds(1));
+
+  fml::CountDownLatch released(100);
+  QueueObjects(thread.GetTaskRunner(), *queue, 100, released);
+  released.Wait();
+
+  // Each drain releases one batch of 16 objects.
+  auto stats = GetStatsOnTaskRunner(thread.GetTaskRunner(), *queue);
+  ASSERT_EQ(stats.pending_count, 0u);
+  ASSERT_EQ(stats.released_count, 100u);
+  ASSERT_EQ(stats.deferred_drain_count, 6u);
+}
+
+TEST(SkiaUnrefQueueTest, DrainReleasesEverythingRegardlessOfBudget) {
+  fml::Thread thread("io");
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      thread.GetTaskRunner(), fml::TimeDelta::FromSeconds(10),
+      fml::TimeDelta::FromNanoseconds(1));
+
+  fml::CountDownLatch released(100);
+  QueueObjects(thread.GetTaskRunner(), *queue, 100, released);
+
+  SkiaUnrefQueue::Stats stats;
+  fml::AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&]() {
+    queue->Drain();
+    stats = queue->GetStats();
+    latch.Signal();
+  });
+  latch.Wait();
+  ASSERT_EQ(stats.pending_count, 0u);
+  ASSERT_EQ(stats.released_count, 100u);
+  ASSERT_EQ(stats.deferred_drain_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -6,25 +6,44 @@
 
 #include "flutter/fml/delayed_task.h"
 
+#include <algorithm>
+#include <functional>
+
+#include "flutter/fml/logging.h"
+
 namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
                          fml::closure task,
-                         fml::TimePoint target_time)
-    : order_(order), task_(std::move(task)), target_time_(target_time) {}
+                         fml::TimePoint target_time,
+                         TaskPriority priority)
+    : order_(order),
+      task_(std::move(task)),
+      target_time_(target_time),
+      priority_(priority) {}
 
-DelayedTask::DelayedTask(const DelayedTask& other) = default;
+DelayedTask::DelayedTask(DelayedTask&& other) = default;
 
 DelayedTask::~DelayedTask() = default;
 
+DelayedTask& DelayedTask::operator=(DelayedTask&& other) = default;
+
 const fml::closure& DelayedTask::GetTask() const {
   return task_;
 }
 
+fml::closure DelayedTask::TakeTask() {
+  return std::move(task_);
+}
+
 fml::TimePoint DelayedTask::GetTargetTime() const {
   return target_time_;
 }
 
+TaskPriority DelayedTask::GetPriority() const {
+  return priority_;
+}
+
 bool DelayedTask::operator>(const DelayedTask& other) const {
   if (target_time_ == other.target_time_) {
     return order_ > other.order_;
@@ -32,4 +51,39 @@ bool DelayedTask::operator>(const DelayedTask& other) const {
   return target_time_ > other.target_time_;
 }
 
+DelayedTaskQueue::DelayedTaskQueue() = default;
+
+DelayedTaskQueue::DelayedTaskQueue(DelayedTaskQueue&& other) = default;
+
+DelayedTaskQueue::~DelayedTaskQueue() = default;
+
+DelayedTaskQueue& DelayedTaskQueue::operator=(DelayedTaskQueue&& other) =
+    default;
+
+bool DelayedTaskQueue::empty() const {
+  return heap_.empty();
+}
+
+size_t DelayedTaskQueue::size() const {
+  return heap_.size();
+}
+
+const DelayedTask& DelayedTaskQueue::top() const {
+  FML_DCHECK(!heap_.empty());
+  return heap_.front();
+}
+
+void DelayedTaskQueue::push(DelayedTask task) {
+  heap_.push_back(std::move(task));
+  std::push_heap(heap_.begin(), heap_.end(), std::greater<DelayedTask>());
+}
+
+DelayedTask DelayedTaskQueue::pop() {
+  FML_DCHECK(!heap_.empty());
+  std::pop_heap(heap_.begin(), heap_.end(), std::greater<DelayedTask>());
+  DelayedTask task = std::move(heap_.back());
+  heap_.pop_back();
+  return task;
+}
+
 }  // namespace fml
@@ -6,35 +6,74 @@
 #define FLUTTER_FML_DELAYED_TASK_H_
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/time/time_point.h"
 
-#include <queue>
+#include <vector>
 
 namespace fml {
 
+// Move only, as copying the closure would copy everything it captured and
+// usually allocate.
 class DelayedTask {
  public:
-  DelayedTask(size_t order, fml::closure task, fml::TimePoint target_time);
+  DelayedTask(size_t order,
+              fml::closure task,
+              fml::TimePoint target_time,
+              TaskPriority priority = TaskPriority::kNormal);
 
-  DelayedTask(const DelayedTask& other);
+  DelayedTask(DelayedTask&& other);
 
   ~DelayedTask();
 
+  DelayedTask& operator=(DelayedTask&& other);
+
   const fml::closure& GetTask() const;
 
+  // Moves the closure out of the task.
+  fml::closure TakeTask();
+
   fml::TimePoint GetTargetTime() const;
 
+  TaskPriority GetPriority() const;
+
   bool operator>(const DelayedTask& other) const;
 
  private:
   size_t order_;
   fml::closure task_;
   fml::TimePoint target_time_;
+  TaskPriority priority_;
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+// The pending tasks of a queue, earliest first. Unlike a
+// |std::priority_queue|, the earliest task can be moved out rather than
+// copied, and the storage is kept for the tasks that follow so that posting
+// does not allocate once the queue has grown to its working size.
+class DelayedTaskQueue {
+ public:
+  DelayedTaskQueue();
+
+  DelayedTaskQueue(DelayedTaskQueue&& other);
+
+  ~DelayedTaskQueue();
+
+  DelayedTaskQueue& operator=(DelayedTaskQueue&& other);
+
+  bool empty() const;
+
+  size_t size() const;
+
+  const DelayedTask& top() const;
+
+  void push(DelayedTask task);
+
+  // Removes and returns the earliest task.
+  DelayedTask pop();
+
+ private:
+  std::vector<DelayedTask> heap_;
+};
 
 }  // namespace fml
 
@@ -155,3 +155,35 @@ TEST(FileTest, AtomicWriteTest) {
   // Cleanup.
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "precious_data"));
 }
+
+TEST(FileTest, MappingAdviceDoesNotChangeContents) {
+  fml::ScopedTemporaryDirectory dir;
+
+  std::vector<uint8_t> contents(64 * 1024);
+  for (size_t i = 0; i < contents.size(); i++) {
+    contents[i] = static_cast<uint8_t>(i % 251);
+  }
+  ASSERT_TRUE(fml::WriteAtomically(dir.fd(), "snapshot",
+                                   fml::DataMapping(contents)));
+
+  {
+    auto mapping = fml::FileMapping::CreateReadOnly(
+        dir.fd(), "snapshot",
+        {fml::FileMapping::Advice::kWillNeed,
+         fml::FileMapping::Advice::kSequential,
+         fml::FileMapping::Advice::kHugePages,
+         fml::FileMapping::Advice::kPopulate});
+    ASSERT_TRUE(mapping);
+    ASSERT_EQ(mapping->GetSize(), contents.size());
+    ASSERT_EQ(0, ::memcmp(mapping->GetMapping(), contents.data(),
+                          contents.size()));
+
+    // Out of range prefetches are rejected, partial ones are clamped.
+    ASSERT_FALSE(mapping->Prefetch(contents.size(), 1));
+#if !OS_WIN
+    ASSERT_TRUE(mapping->Prefetch(4097, contents.size()));
+#endif  // !OS_WIN
+  }
+
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "snapshot"));
+}
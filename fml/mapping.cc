@@ -8,6 +8,23 @@
 
 namespace fml {
 
+// The smallest page size of the supported platforms. Touching pages more often
+// than needed on platforms with larger pages is harmless.
+static constexpr size_t kMinimumPageSize = 4096;
+
+void PageInMapping(const Mapping& mapping) {
+  const uint8_t* base = mapping.GetMapping();
+  const size_t size = mapping.GetSize();
+  if (base == nullptr || size == 0) {
+    return;
+  }
+  volatile uint8_t sink = 0;
+  for (size_t offset = 0; offset < size; offset += kMinimumPageSize) {
+    sink = sink + base[offset];
+  }
+  sink = sink + base[size - 1];
+}
+
 // FileMapping
 
 uint8_t* FileMapping::GetMutableMapping() {
@@ -15,21 +32,24 @@ uint8_t* FileMapping::GetMutableMapping() {
 }
 
 std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
-    const std::string& path) {
+    const std::string& path,
+    std::initializer_list<Advice> advice) {
   return CreateReadOnly(OpenFile(path.c_str(), false, FilePermission::kRead),
-                        "");
+                        "", advice);
 }
 
 std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
     const fml::UniqueFD& base_fd,
-    const std::string& sub_path) {
+    const std::string& sub_path,
+    std::initializer_list<Advice> advice) {
   if (sub_path.size() != 0) {
     return CreateReadOnly(
-        OpenFile(base_fd, sub_path.c_str(), false, FilePermission::kRead), "");
+        OpenFile(base_fd, sub_path.c_str(), false, FilePermission::kRead), "",
+        advice);
   }
 
   auto mapping = std::make_unique<FileMapping>(
-      base_fd, std::initializer_list<Protection>{Protection::kRead});
+      base_fd, std::initializer_list<Protection>{Protection::kRead}, advice);
 
   if (mapping->GetSize() == 0 || mapping->GetMapping() == nullptr) {
     return nullptr;
@@ -39,22 +59,27 @@ std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
 }
 
 std::unique_ptr<FileMapping> FileMapping::CreateReadExecute(
-    const std::string& path) {
-  return CreateReadExecute(
-      OpenFile(path.c_str(), false, FilePermission::kRead));
+    const std::string& path,
+    std::initializer_list<Advice> advice) {
+  return CreateReadExecute(OpenFile(path.c_str(), false, FilePermission::kRead),
+                           "", advice);
 }
 
 std::unique_ptr<FileMapping> FileMapping::CreateReadExecute(
     const fml::UniqueFD& base_fd,
-    const std::string& sub_path) {
+    const std::string& sub_path,
+    std::initializer_list<Advice> advice) {
   if (sub_path.size() != 0) {
     return CreateReadExecute(
-        OpenFile(base_fd, sub_path.c_str(), false, FilePermission::kRead), "");
+        OpenFile(base_fd, sub_path.c_str(), false, FilePermission::kRead), "",
+        advice);
   }
 
   auto mapping = std::make_unique<FileMapping>(
-      base_fd, std::initializer_list<Protection>{Protection::kRead,
-                                                 Protection::kExecute});
+      base_fd,
+      std::initializer_list<Protection>{Protection::kRead,
+                                        Protection::kExecute},
+      advice);
 
   if (mapping->GetSize() == 0 || mapping->GetMapping() == nullptr) {
     return nullptr;
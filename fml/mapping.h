@@ -32,6 +32,10 @@ class Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
 
+// Reads a byte from every page of |mapping| so that a lazily populated
+// mapping is paged in on the calling thread instead of on first use.
+void PageInMapping(const Mapping& mapping);
+
 class FileMapping final : public Mapping {
  public:
   enum class Protection {
@@ -40,24 +44,50 @@ class FileMapping final : public Mapping {
     kExecute,
   };
 
+  // Hints about how the mapping will be accessed. Hints the platform does not
+  // support are ignored.
+  enum class Advice {
+    // Start reading the whole file in the background.
+    kWillNeed,
+    // Read further ahead of each faulting page than usual.
+    kSequential,
+    // Back the mapping with huge pages where the kernel allows it, which saves
+    // TLB misses on large snapshots.
+    kHugePages,
+    // Read the file and populate the page tables before the constructor
+    // returns. Trades a blocking read for not faulting on first use.
+    kPopulate,
+  };
+
   FileMapping(const fml::UniqueFD& fd,
               std::initializer_list<Protection> protection = {
-                  Protection::kRead});
+                  Protection::kRead},
+              std::initializer_list<Advice> advice = {});
 
   ~FileMapping() override;
 
-  static std::unique_ptr<FileMapping> CreateReadOnly(const std::string& path);
+  static std::unique_ptr<FileMapping> CreateReadOnly(
+      const std::string& path,
+      std::initializer_list<Advice> advice = {});
 
   static std::unique_ptr<FileMapping> CreateReadOnly(
       const fml::UniqueFD& base_fd,
-      const std::string& sub_path = "");
+      const std::string& sub_path = "",
+      std::initializer_list<Advice> advice = {});
 
   static std::unique_ptr<FileMapping> CreateReadExecute(
-      const std::string& path);
+      const std::string& path,
+      std::initializer_list<Advice> advice = {});
 
   static std::unique_ptr<FileMapping> CreateReadExecute(
       const fml::UniqueFD& base_fd,
-      const std::string& sub_path = "");
+      const std::string& sub_path = "",
+      std::initializer_list<Advice> advice = {});
+
+  // Asks the kernel to start reading the given range of the file in the
+  // background and returns immediately. Returns false if the platform cannot
+  // prefetch.
+  bool Prefetch(size_t offset, size_t length) const;
 
   // |Mapping|
   size_t GetSize() const override;
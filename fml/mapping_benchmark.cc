@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+
+#if !defined(OS_WIN)
+#include <fcntl.h>
+#include <sys/resource.h>
+#endif  // !defined(OS_WIN)
+
+namespace fml {
+namespace benchmarking {
+
+static constexpr char kSnapshotFileName[] = "isolate_snapshot_data";
+
+// Page faults are not counted on Windows, where the label always reports none.
+static int64_t GetPageFaultCount() {
+#if defined(OS_WIN)
+  return 0;
+#else   // defined(OS_WIN)
+  struct rusage usage = {};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_minflt + usage.ru_majflt;
+#endif  // defined(OS_WIN)
+}
+
+// Evicts the file from the page cache so that every iteration starts cold, as
+// the first launch after boot would. Not available everywhere, in which case
+// the page cache stays warm and only the faulting cost is measured.
+static void DropFromPageCache(const UniqueFD& file) {
+#if OS_LINUX
+  ::posix_fadvise(file.get(), 0, 0, POSIX_FADV_DONTNEED);
+#endif  // OS_LINUX
+}
+
+// Maps a snapshot sized file with |advice| and reads every page of it, which is
+// what the VM does with its snapshots during startup. The label reports the
+// page faults taken while reading.
+static void MapAndReadSnapshot(
+    benchmark::State& state,
+    std::initializer_list<FileMapping::Advice> advice) {
+  ScopedTemporaryDirectory directory;
+  {
+    std::vector<uint8_t> contents(state.range(0) << 20);
+    for (size_t i = 0; i < contents.size(); i++) {
+      contents[i] = static_cast<uint8_t>(i * 31);
+    }
+    FML_CHECK(WriteAtomically(directory.fd(), kSnapshotFileName,
+                              DataMapping(std::move(contents))));
+  }
+
+  int64_t faults_while_reading = 0;
+  size_t iterations = 0;
+  while (state.KeepRunning()) {
+    auto file = OpenFile(directory.fd(), kSnapshotFileName, false,
+                         FilePermission::kRead);
+    {
+      ::benchmarking::ScopedPauseTiming pause(state);
+      DropFromPageCache(file);
+    }
+
+    FileMapping mapping(file, {FileMapping::Protection::kRead}, advice);
+    FML_CHECK(mapping.GetMapping() != nullptr);
+
+    const int64_t faults_before_reading = GetPageFaultCount();
+    PageInMapping(mapping);
+    faults_while_reading += GetPageFaultCount() - faults_before_reading;
+    iterations++;
+  }
+
+  if (iterations > 0) {
+    state.SetLabel("faults_while_reading=" +
+                   std::to_string(faults_while_reading / iterations));
+  }
+  UnlinkFile(directory.fd(), kSnapshotFileName);
+}
+
+static void BM_MapSnapshotDefault(benchmark::State& state) {
+  MapAndReadSnapshot(state, {});
+}
+
+static void BM_MapSnapshotWillNeedSequential(benchmark::State& state) {
+  MapAndReadSnapshot(state, {FileMapping::Advice::kWillNeed,
+                             FileMapping::Advice::kSequential});
+}
+
+static void BM_MapSnapshotPopulate(benchmark::State& state) {
+  MapAndReadSnapshot(state, {FileMapping::Advice::kPopulate});
+}
+
+static void BM_MapSnapshotHugePages(benchmark::State& state) {
+  MapAndReadSnapshot(state, {FileMapping::Advice::kWillNeed,
+                             FileMapping::Advice::kHugePages});
+}
+
+BENCHMARK(BM_MapSnapshotDefault)
+    ->Arg(4)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MapSnapshotWillNeedSequential)
+    ->Arg(4)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MapSnapshotPopulate)
+    ->Arg(4)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MapSnapshotHugePages)
+    ->Arg(4)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace benchmarking
+}  // namespace fml
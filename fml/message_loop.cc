@@ -73,6 +73,10 @@ void MessageLoop::RunExpiredTasksNow() {
   loop_->RunExpiredTasksNow();
 }
 
+void MessageLoop::RunIdleTasks(fml::TimePoint deadline) {
+  loop_->RunIdleTasks(deadline);
+}
+
 void MessageLoop::SwapTaskQueues(MessageLoop* other) {
   FML_CHECK(loop_);
   FML_CHECK(other->loop_);
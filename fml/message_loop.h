@@ -34,6 +34,11 @@ class MessageLoop {
   // instead of dedicating a thread to the message loop.
   void RunExpiredTasksNow();
 
+  // Runs due tasks posted with |TaskPriority::kIdle| until |deadline| passes
+  // or there are none left. Must be called on the thread of this loop, when
+  // it knows it has nothing else to do until |deadline|.
+  void RunIdleTasks(fml::TimePoint deadline);
+
   void SwapTaskQueues(MessageLoop* other);
 
   static void EnsureInitializedForCurrentThread();
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
+
+namespace fml {
+namespace benchmarking {
+
+static void Spin(fml::TimeDelta duration) {
+  const fml::TimePoint end = fml::TimePoint::Now() + duration;
+  while (fml::TimePoint::Now() < end) {
+  }
+}
+
+// Measures how long the start of a frame waits behind a backlog of
+// |state.range(0)| tasks of 20us each, like a UI thread that is busy with
+// platform messages and timers when vsync arrives. Draining the backlog takes
+// much longer than the measured time, hence the fixed iteration counts.
+static void RunFrameStartBehindFlood(benchmark::State& state,
+                                     TaskPriority frame_priority) {
+  fml::Thread thread("flooded");
+  auto task_runner = thread.GetTaskRunner();
+  const int64_t flood_size = state.range(0);
+
+  while (state.KeepRunning()) {
+    // Hold the loop so that the whole flood is queued before it starts.
+    fml::AutoResetWaitableEvent release;
+    task_runner->PostTask([&release]() { release.Wait(); });
+    for (int64_t i = 0; i < flood_size; i++) {
+      task_runner->PostTask(
+          []() { Spin(fml::TimeDelta::FromMicroseconds(20)); });
+    }
+
+    fml::TimePoint frame_start;
+    fml::AutoResetWaitableEvent frame_started;
+    const fml::TimePoint vsync = fml::TimePoint::Now();
+    task_runner->PostTask(
+        [&frame_start, &frame_started]() {
+          frame_start = fml::TimePoint::Now();
+          frame_started.Signal();
+        },
+        frame_priority);
+    release.Signal();
+    frame_started.Wait();
+    state.SetIterationTime((frame_start - vsync).ToSecondsF());
+
+    fml::AutoResetWaitableEvent drained;
+    task_runner->PostTask([&drained]() { drained.Signal(); });
+    drained.Wait();
+  }
+}
+
+static void BM_FrameStartBehindFloodNormal(benchmark::State& state) {
+  RunFrameStartBehindFlood(state, TaskPriority::kNormal);
+}
+
+static void BM_FrameStartBehindFloodFrameCritical(benchmark::State& state) {
+  RunFrameStartBehindFlood(state, TaskPriority::kFrameCritical);
+}
+
+BENCHMARK(BM_FrameStartBehindFloodNormal)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Iterations(50)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrameStartBehindFloodFrameCritical)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Iterations(50)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -48,15 +48,17 @@ MessageLoopImpl::MessageLoopImpl()
 
 MessageLoopImpl::~MessageLoopImpl() = default;
 
-void MessageLoopImpl::PostTask(fml::closure task, fml::TimePoint target_time) {
-  FML_DCHECK(task != nullptr);
+void MessageLoopImpl::PostTask(fml::closure task,
+                               fml::TimePoint target_time,
+                               TaskPriority priority) {
   FML_DCHECK(task != nullptr);
   if (terminated_) {
     // If the message loop has already been terminated, PostTask should destruct
     // |task| synchronously within this function.
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, std::move(task), target_time,
+                            priority);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key, fml::closure callback) {
@@ -123,7 +125,6 @@ void MessageLoopImpl::SwapTaskQueues(const fml::RefPtr<MessageLoopImpl>& other)
 
 void MessageLoopImpl::FlushTasks(FlushType type) {
   TRACE_EVENT0("fml", "MessageLoop::FlushTasks");
-  std::vector<fml::closure> invocations;
 
   // We are grabbing this lock here as a proxy to indicate
   // that we are running tasks and will invoke the
@@ -132,12 +133,73 @@ void MessageLoopImpl::FlushTasks(FlushType type) {
   // gather invocations -> Swap -> execute invocations
   // will lead us to run invocations on the wrong thread.
   std::scoped_lock task_flush_lock(tasks_flushing_mutex_);
-  task_queue_->GetTasksToRunNow(queue_id_, type, invocations);
 
-  for (const auto& invocation : invocations) {
-    invocation();
+  // Tasks are taken one at a time so that frame critical tasks posted while
+  // the flush is running get to run next.
+  const fml::TimePoint flush_time = fml::TimePoint::Now();
+  std::array<fml::TimeDelta, kTaskPriorityCount> max_delays = {};
+  bool ran_tasks = false;
+  while (auto task = task_queue_->GetNextTaskToRun(queue_id_, flush_time)) {
+    auto& max_delay = max_delays[static_cast<size_t>(task->GetPriority())];
+    max_delay =
+        std::max(max_delay, fml::TimePoint::Now() - task->GetTargetTime());
+    ran_tasks = true;
+
+    task->GetTask()();
+    task_queue_->NotifyObservers(queue_id_);
+    if (type == FlushType::kSingle) {
+      break;
+    }
+  }
+  task_queue_->ScheduleWakeUp(queue_id_);
+
+  if (ran_tasks) {
+    TraceQueueingDelays(max_delays);
+  }
+}
+
+void MessageLoopImpl::RunIdleTasks(fml::TimePoint deadline) {
+  FML_DCHECK(MessageLoop::GetCurrent().GetLoopImpl().get() == this)
+      << "Idle tasks must be run on the thread of their loop.";
+  TRACE_EVENT0("fml", "MessageLoop::RunIdleTasks");
+
+  // This is called from within a task, so |tasks_flushing_mutex_| is already
+  // held by the flush that is running it.
+  std::array<fml::TimeDelta, kTaskPriorityCount> max_delays = {};
+  bool ran_tasks = false;
+  while (fml::TimePoint::Now() < deadline) {
+    auto task = task_queue_->GetIdleTaskToRunNow(queue_id_);
+    if (!task) {
+      break;
+    }
+    auto& max_delay = max_delays[static_cast<size_t>(TaskPriority::kIdle)];
+    max_delay =
+        std::max(max_delay, fml::TimePoint::Now() - task->GetTargetTime());
+    ran_tasks = true;
+
+    task->GetTask()();
     task_queue_->NotifyObservers(queue_id_);
   }
+
+  if (ran_tasks) {
+    TraceQueueingDelays(max_delays);
+  }
+}
+
+void MessageLoopImpl::TraceQueueingDelays(
+    const std::array<fml::TimeDelta, kTaskPriorityCount>& delays) const {
+#if FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_RELEASE
+  // The longest time a task of each priority waited past its target time.
+  FML_TRACE_COUNTER(
+      "fml", "TaskQueueingDelay", static_cast<int64_t>(queue_id_),
+      "FrameCriticalMicros",
+      delays[static_cast<size_t>(TaskPriority::kFrameCritical)]
+          .ToMicroseconds(),
+      "NormalMicros",
+      delays[static_cast<size_t>(TaskPriority::kNormal)].ToMicroseconds(),
+      "IdleMicros",
+      delays[static_cast<size_t>(TaskPriority::kIdle)].ToMicroseconds());
+#endif  // FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_RELEASE
 }
 
 void MessageLoopImpl::RunExpiredTasksNow() {
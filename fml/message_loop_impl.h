@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_IMPL_H_
 #define FLUTTER_FML_MESSAGE_LOOP_IMPL_H_
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <map>
@@ -19,6 +20,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/synchronization/thread_annotations.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/wakeable.h"
 
@@ -35,7 +37,9 @@ class MessageLoopImpl : public Wakeable,
 
   virtual void Terminate() = 0;
 
-  void PostTask(fml::closure task, fml::TimePoint target_time);
+  void PostTask(fml::closure task,
+                fml::TimePoint target_time,
+                TaskPriority priority = TaskPriority::kNormal);
 
   void AddTaskObserver(intptr_t key, fml::closure callback);
 
@@ -56,6 +60,8 @@ class MessageLoopImpl : public Wakeable,
 
   void RunSingleExpiredTaskNow();
 
+  void RunIdleTasks(fml::TimePoint deadline);
+
  protected:
   MessageLoopImpl();
 
@@ -69,6 +75,9 @@ class MessageLoopImpl : public Wakeable,
 
   void FlushTasks(FlushType type);
 
+  void TraceQueueingDelays(
+      const std::array<fml::TimeDelta, kTaskPriorityCount>& delays) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(MessageLoopImpl);
 };
 
@@ -9,6 +9,14 @@
 
 namespace fml {
 
+namespace {
+
+size_t PriorityIndex(TaskPriority priority) {
+  return static_cast<size_t>(priority);
+}
+
+}  // namespace
+
 std::mutex MessageLoopTaskQueues::creation_mutex_;
 fml::RefPtr<MessageLoopTaskQueues> MessageLoopTaskQueues::instance_;
 
@@ -30,7 +38,8 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
   wakeable_mutexes_.push_back(std::make_unique<std::mutex>());
 
   task_observers_.push_back(TaskObservers());
-  delayed_tasks_.push_back(DelayedTaskQueue());
+  delayed_tasks_.push_back(PrioritizedTaskQueues());
+  wake_times_.push_back(std::nullopt);
   wakeables_.push_back(NULL);
 
   return loop_id;
@@ -44,20 +53,39 @@ MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
   std::scoped_lock lock(GetMutex(queue_id, MutexType::kTasks));
   delayed_tasks_[queue_id] = {};
+  wake_times_[queue_id] = std::nullopt;
 }
 
 void MessageLoopTaskQueues::RegisterTask(TaskQueueId queue_id,
                                          fml::closure task,
-                                         fml::TimePoint target_time) {
+                                         fml::TimePoint target_time,
+                                         TaskPriority priority) {
   std::scoped_lock lock(GetMutex(queue_id, MutexType::kTasks));
   size_t order = order_++;
-  delayed_tasks_[queue_id].push({order, std::move(task), target_time});
-  WakeUp(queue_id, delayed_tasks_[queue_id].top().GetTargetTime());
+  delayed_tasks_[queue_id][PriorityIndex(priority)].push(
+      {order, std::move(task), target_time, priority});
+  if (priority == TaskPriority::kIdle) {
+    return;
+  }
+  // Rearming the wake up is a system call on most platforms. It can be
+  // skipped if the loop is already set to wake up no later than this task is
+  // due, including when it is awake or about to wake up to flush.
+  const fml::TimePoint wake_time = GetNextWakeTime(queue_id);
+  const std::optional<fml::TimePoint>& armed_time = wake_times_[queue_id];
+  if (!armed_time ||
+      (wake_time < *armed_time && *armed_time > fml::TimePoint::Now())) {
+    WakeUp(queue_id, wake_time);
+  }
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) {
   std::scoped_lock lock(GetMutex(queue_id, MutexType::kTasks));
-  return !delayed_tasks_[queue_id].empty();
+  for (const auto& tasks : delayed_tasks_[queue_id]) {
+    if (!tasks.empty()) {
+      return true;
+    }
+  }
+  return false;
 }
 
 void MessageLoopTaskQueues::GetTasksToRunNow(
@@ -67,37 +95,105 @@ void MessageLoopTaskQueues::GetTasksToRunNow(
   std::scoped_lock lock(GetMutex(queue_id, MutexType::kTasks));
 
   const auto now = fml::TimePoint::Now();
-  DelayedTaskQueue& tasks = delayed_tasks_[queue_id];
 
-  while (!tasks.empty()) {
-    const auto& top = tasks.top();
-    if (top.GetTargetTime() > now) {
-      break;
+  for (auto priority : {TaskPriority::kFrameCritical, TaskPriority::kNormal}) {
+    DelayedTaskQueue& tasks = delayed_tasks_[queue_id][PriorityIndex(priority)];
+    while (!tasks.empty()) {
+      if (tasks.top().GetTargetTime() > now) {
+        break;
+      }
+      invocations.emplace_back(tasks.pop().TakeTask());
+      if (type == FlushType::kSingle) {
+        break;
+      }
     }
-    invocations.emplace_back(std::move(top.GetTask()));
-    tasks.pop();
-    if (type == FlushType::kSingle) {
+    if (type == FlushType::kSingle && !invocations.empty()) {
       break;
     }
   }
 
-  if (tasks.empty()) {
-    WakeUp(queue_id, fml::TimePoint::Max());
-  } else {
-    WakeUp(queue_id, tasks.top().GetTargetTime());
+  RearmWakeUp(queue_id);
+}
+
+std::optional<DelayedTask> MessageLoopTaskQueues::GetNextTaskToRun(
+    TaskQueueId queue_id,
+    fml::TimePoint flush_time) {
+  std::scoped_lock lock(GetMutex(queue_id, MutexType::kTasks));
+  PrioritizedTaskQueues& queues = delayed_tasks_[queue_id];
+
+  DelayedTaskQueue& frame_critical =
+      queues[PriorityIndex(TaskPriority::kFrameCritical)];
+  if (!frame_critical.empty() &&
+      frame_critical.top().GetTargetTime() <= fml::TimePoint::Now()) {
+    return frame_critical.pop();
+  }
+
+  DelayedTaskQueue& normal = queues[PriorityIndex(TaskPriority::kNormal)];
+  if (!normal.empty() && normal.top().GetTargetTime() <= flush_time) {
+    return normal.pop();
   }
+
+  return std::nullopt;
+}
+
+std::optional<DelayedTask> MessageLoopTaskQueues::GetIdleTaskToRunNow(
+    TaskQueueId queue_id) {
+  std::scoped_lock lock(GetMutex(queue_id, MutexType::kTasks));
+  DelayedTaskQueue& idle =
+      delayed_tasks_[queue_id][PriorityIndex(TaskPriority::kIdle)];
+  if (idle.empty() || idle.top().GetTargetTime() > fml::TimePoint::Now()) {
+    return std::nullopt;
+  }
+  return idle.pop();
+}
+
+void MessageLoopTaskQueues::ScheduleWakeUp(TaskQueueId queue_id) {
+  std::scoped_lock lock(GetMutex(queue_id, MutexType::kTasks));
+  RearmWakeUp(queue_id);
+}
+
+void MessageLoopTaskQueues::RearmWakeUp(TaskQueueId queue_id) {
+  const fml::TimePoint wake_time = GetNextWakeTime(queue_id);
+  std::optional<fml::TimePoint>& armed_time = wake_times_[queue_id];
+  // Wake ups do not repeat, so one that has passed has nothing left to cancel
+  // once there are no tasks. Otherwise the wake up may have fired already,
+  // even a little ahead of its time, so it is always rearmed.
+  if (wake_time == fml::TimePoint::Max() && armed_time &&
+      *armed_time <= fml::TimePoint::Now()) {
+    armed_time = wake_time;
+    return;
+  }
+  WakeUp(queue_id, wake_time);
+}
+
+fml::TimePoint MessageLoopTaskQueues::GetNextWakeTime(
+    TaskQueueId queue_id) const {
+  fml::TimePoint wake_time = fml::TimePoint::Max();
+  for (auto priority : {TaskPriority::kFrameCritical, TaskPriority::kNormal}) {
+    const DelayedTaskQueue& tasks =
+        delayed_tasks_[queue_id][PriorityIndex(priority)];
+    if (!tasks.empty() && tasks.top().GetTargetTime() < wake_time) {
+      wake_time = tasks.top().GetTargetTime();
+    }
+  }
+  return wake_time;
 }
 
 void MessageLoopTaskQueues::WakeUp(TaskQueueId queue_id, fml::TimePoint time) {
   std::scoped_lock lock(GetMutex(queue_id, MutexType::kWakeables));
   if (wakeables_[queue_id]) {
     wakeables_[queue_id]->WakeUp(time);
+    wake_times_[queue_id] = time;
   }
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) {
   std::scoped_lock lock(GetMutex(queue_id, MutexType::kTasks));
-  return delayed_tasks_[queue_id].size();
+  size_t count = 0;
+  for (const auto& tasks : delayed_tasks_[queue_id]) {
+    count += tasks.size();
+  }
+  return count;
 }
 
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
@@ -131,10 +227,14 @@ void MessageLoopTaskQueues::Swap(TaskQueueId primary, TaskQueueId secondary)
   std::mutex& t1 = GetMutex(primary, MutexType::kTasks);
   std::mutex& t2 = GetMutex(secondary, MutexType::kTasks);
 
-  std::scoped_lock(o1, o2, t1, t2);
+  std::scoped_lock lock(o1, o2, t1, t2);
 
   std::swap(task_observers_[primary], task_observers_[secondary]);
   std::swap(delayed_tasks_[primary], delayed_tasks_[secondary]);
+
+  // The loops keep their wakeables, so rearm them for the tasks they got.
+  WakeUp(primary, GetNextWakeTime(primary));
+  WakeUp(secondary, GetNextWakeTime(secondary));
 }
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
@@ -5,8 +5,10 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <array>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -14,6 +16,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/thread_annotations.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/wakeable.h"
 
 namespace fml {
@@ -41,16 +44,35 @@ class MessageLoopTaskQueues
 
   // Tasks methods.
 
+  // Only wakes the loop up if it would otherwise sleep past the task. Idle
+  // tasks do not wake the loop up.
   void RegisterTask(TaskQueueId queue_id,
                     fml::closure task,
-                    fml::TimePoint target_time);
+                    fml::TimePoint target_time,
+                    TaskPriority priority = TaskPriority::kNormal);
 
   bool HasPendingTasks(TaskQueueId queue_id);
 
+  // Gathers due frame critical tasks followed by due normal tasks.
   void GetTasksToRunNow(TaskQueueId queue_id,
                         FlushType type,
                         std::vector<fml::closure>& invocations);
 
+  // Removes the task that should run next. Frame critical tasks are returned
+  // as soon as they are due, so that they can overtake tasks that were
+  // already due when a flush started. Normal tasks are only returned if they
+  // were due by |flush_time|, which bounds the flush. Unlike
+  // |GetTasksToRunNow| this does not update the wake up time, the caller
+  // does that with |ScheduleWakeUp| once it is done taking tasks.
+  std::optional<DelayedTask> GetNextTaskToRun(TaskQueueId queue_id,
+                                              fml::TimePoint flush_time);
+
+  // Removes the idle task that should run next, if one is due.
+  std::optional<DelayedTask> GetIdleTaskToRunNow(TaskQueueId queue_id);
+
+  // Wakes the loop up when its next frame critical or normal task is due.
+  void ScheduleWakeUp(TaskQueueId queue_id);
+
   size_t GetNumPendingTasks(TaskQueueId queue_id);
 
   // Observers methods.
@@ -78,13 +100,24 @@ class MessageLoopTaskQueues
 
   using Mutexes = std::vector<std::unique_ptr<std::mutex>>;
   using TaskObservers = std::map<intptr_t, fml::closure>;
+  using PrioritizedTaskQueues =
+      std::array<DelayedTaskQueue, kTaskPriorityCount>;
 
   MessageLoopTaskQueues();
 
   ~MessageLoopTaskQueues();
 
+  // Called with the tasks mutex held.
   void WakeUp(TaskQueueId queue_id, fml::TimePoint time);
 
+  // Updates the wake up after tasks were taken. Called with the tasks mutex
+  // held.
+  void RearmWakeUp(TaskQueueId queue_id);
+
+  // The earliest target time of the frame critical and normal tasks. Called
+  // with the tasks mutex held.
+  fml::TimePoint GetNextWakeTime(TaskQueueId queue_id) const;
+
   std::mutex& GetMutex(TaskQueueId queue_id, MutexType type);
 
   static std::mutex creation_mutex_;
@@ -102,7 +135,10 @@ class MessageLoopTaskQueues
   // These are guarded by their corresponding `Mutexes`
   std::vector<Wakeable*> wakeables_;
   std::vector<TaskObservers> task_observers_;
-  std::vector<DelayedTaskQueue> delayed_tasks_;
+  std::vector<PrioritizedTaskQueues> delayed_tasks_;
+  // The time each loop was last asked to wake up at, guarded by the tasks
+  // mutex. Unset until the first wake up.
+  std::vector<std::optional<fml::TimePoint>> wake_times_;
 
   std::atomic_int order_;
 
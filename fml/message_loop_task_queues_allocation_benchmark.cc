@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/message_loop_task_queues.h"
+
+// Counts the allocations made by the benchmarks below. Replacing the global
+// allocation functions affects every benchmark linked with them, so these
+// benchmarks are built into an executable of their own.
+static std::atomic<size_t> g_allocation_count;
+
+void* operator new(size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+namespace fml {
+namespace benchmarking {
+
+// Posts and runs tasks that capture about as much as a typical engine task,
+// a couple of reference counted pointers and some values, which is more than
+// a |std::function| stores inline.
+static void BM_PostAndRunTasks(benchmark::State& state) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const auto queue_id = task_queue->CreateTaskQueue();
+
+  const int64_t batch_size = state.range(0);
+  auto weak_target = std::make_shared<int64_t>(0);
+  auto ref_target = std::make_shared<int64_t>(0);
+  const size_t allocations_before = g_allocation_count.load();
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < batch_size; i++) {
+      task_queue->RegisterTask(
+          queue_id,
+          [weak_target, ref_target, i]() { *weak_target += *ref_target + i; },
+          fml::TimePoint::Now());
+    }
+    const fml::TimePoint flush_time = fml::TimePoint::Now();
+    while (auto task = task_queue->GetNextTaskToRun(queue_id, flush_time)) {
+      task->GetTask()();
+    }
+  }
+  const size_t allocations = g_allocation_count.load() - allocations_before;
+
+  const int64_t tasks = state.iterations() * batch_size;
+  state.SetItemsProcessed(tasks);
+  state.counters["allocations_per_task"] =
+      tasks == 0 ? 0 : static_cast<double>(allocations) / tasks;
+}
+
+BENCHMARK(BM_PostAndRunTasks)->Arg(1)->Arg(64);
+
+}  // namespace benchmarking
+}  // namespace fml
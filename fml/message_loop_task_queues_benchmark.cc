@@ -9,6 +9,7 @@
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/wakeable.h"
 
 namespace fml {
 namespace benchmarking {
@@ -57,5 +58,42 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Every wake up rearms the timer of the loop, which is a system call on Linux
+// and Android.
+class CountingWakeable : public fml::Wakeable {
+ public:
+  void WakeUp(fml::TimePoint time_point) override { wake_ups++; }
+
+  size_t wake_ups = 0;
+};
+
+// A burst of immediate tasks, such as platform messages, posted to a loop that
+// then flushes them all.
+static void BM_RegisterImmediateTasks(benchmark::State& state) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const auto queue_id = task_queue->CreateTaskQueue();
+  CountingWakeable wakeable;
+  task_queue->SetWakeable(queue_id, &wakeable);
+
+  const int64_t burst_size = state.range(0);
+  std::vector<fml::closure> invocations;
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < burst_size; i++) {
+      task_queue->RegisterTask(
+          queue_id, [] {}, fml::TimePoint::Now());
+    }
+    invocations.clear();
+    task_queue->GetTasksToRunNow(queue_id, fml::FlushType::kAll, invocations);
+  }
+  task_queue->SetWakeable(queue_id, nullptr);
+
+  const int64_t posts = state.iterations() * burst_size;
+  state.SetItemsProcessed(posts);
+  state.counters["wake_ups_per_post"] =
+      posts == 0 ? 0 : static_cast<double>(wakeable.wake_ups) / posts;
+}
+
+BENCHMARK(BM_RegisterImmediateTasks)->Arg(1)->Arg(16)->Arg(256);
+
 }  // namespace benchmarking
 }  // namespace fml
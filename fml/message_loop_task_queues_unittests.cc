@@ -96,7 +96,7 @@ TEST(MessageLoopTaskQueue, AddRemoveNotifyObservers) {
   ASSERT_TRUE(test_val == 0);
 }
 
-TEST(MessageLoopTaskQueue, WakeUpIndependentOfTime) {
+TEST(MessageLoopTaskQueue, WakeUpOnlyWhenTheDeadlineMovesEarlier) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto queue_id = task_queue->CreateTaskQueue();
 
@@ -105,12 +105,44 @@ TEST(MessageLoopTaskQueue, WakeUpIndependentOfTime) {
       queue_id, new TestWakeable(
                     [&num_wakes](fml::TimePoint wake_time) { ++num_wakes; }));
 
-  task_queue->RegisterTask(
-      queue_id, []() {}, fml::TimePoint::Now());
+  const auto later = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
   task_queue->RegisterTask(
       queue_id, []() {}, fml::TimePoint::Max());
+  task_queue->RegisterTask(
+      queue_id, []() {}, later);
+  task_queue->RegisterTask(
+      queue_id, []() {}, later + fml::TimeDelta::FromSeconds(1));
+  ASSERT_EQ(num_wakes, 2);
+
+  task_queue->RegisterTask(
+      queue_id, []() {}, fml::TimePoint::Now());
+  ASSERT_EQ(num_wakes, 3);
+}
+
+TEST(MessageLoopTaskQueue, NoWakeUpWhileTheLoopIsDueToFlush) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  int num_wakes = 0;
+  task_queue->SetWakeable(
+      queue_id, new TestWakeable(
+                    [&num_wakes](fml::TimePoint wake_time) { ++num_wakes; }));
+
+  for (int i = 0; i < 100; i++) {
+    task_queue->RegisterTask(
+        queue_id, []() {}, fml::TimePoint::Now());
+  }
+  ASSERT_EQ(num_wakes, 1);
 
-  ASSERT_TRUE(num_wakes == 2);
+  std::vector<fml::closure> invocations;
+  task_queue->GetTasksToRunNow(queue_id, fml::FlushType::kAll, invocations);
+  ASSERT_EQ(invocations.size(), 100u);
+  // The wake up has passed and there is nothing left to wake up for.
+  ASSERT_EQ(num_wakes, 1);
+
+  task_queue->RegisterTask(
+      queue_id, []() {}, fml::TimePoint::Now());
+  ASSERT_EQ(num_wakes, 2);
 }
 
 TEST(MessageLoopTaskQueue, WakeUpWithMaxIfNoInvocations) {
@@ -152,3 +184,79 @@ TEST(MessageLoopTaskQueue, WokenUpWithNewerTime) {
 
   latch.Wait();
 }
+
+TEST(MessageLoopTaskQueue, FrameCriticalTasksRunFirst) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  std::vector<int> order;
+
+  const auto now = fml::TimePoint::Now();
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(1); }, now);
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(2); }, now,
+      fml::TaskPriority::kFrameCritical);
+
+  std::vector<fml::closure> invocations;
+  task_queue->GetTasksToRunNow(queue_id, fml::FlushType::kAll, invocations);
+  for (auto& invocation : invocations) {
+    invocation();
+  }
+  ASSERT_EQ(order, std::vector<int>({2, 1}));
+}
+
+TEST(MessageLoopTaskQueue, FrameCriticalTasksOvertakeAFlush) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  const auto flush_time = fml::TimePoint::Now();
+  task_queue->RegisterTask(
+      queue_id, []() {}, flush_time);
+  task_queue->RegisterTask(
+      queue_id, []() {}, flush_time);
+
+  auto task = task_queue->GetNextTaskToRun(queue_id, flush_time);
+  ASSERT_TRUE(task);
+  ASSERT_EQ(task->GetPriority(), fml::TaskPriority::kNormal);
+
+  // Posted while the flush is running, after it started.
+  task_queue->RegisterTask(
+      queue_id, []() {}, fml::TimePoint::Now(),
+      fml::TaskPriority::kFrameCritical);
+  task_queue->RegisterTask(
+      queue_id, []() {}, fml::TimePoint::Max());
+
+  task = task_queue->GetNextTaskToRun(queue_id, flush_time);
+  ASSERT_TRUE(task);
+  ASSERT_EQ(task->GetPriority(), fml::TaskPriority::kFrameCritical);
+  task = task_queue->GetNextTaskToRun(queue_id, flush_time);
+  ASSERT_TRUE(task);
+  ASSERT_EQ(task->GetPriority(), fml::TaskPriority::kNormal);
+  ASSERT_FALSE(task_queue->GetNextTaskToRun(queue_id, flush_time));
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_id), 1u);
+}
+
+TEST(MessageLoopTaskQueue, IdleTasksOnlyRunWhenAskedFor) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  int num_wakes = 0;
+  task_queue->SetWakeable(
+      queue_id, new TestWakeable(
+                    [&num_wakes](fml::TimePoint wake_time) { ++num_wakes; }));
+
+  task_queue->RegisterTask(
+      queue_id, []() {}, fml::TimePoint::Now(), fml::TaskPriority::kIdle);
+  ASSERT_EQ(num_wakes, 0);
+  ASSERT_TRUE(task_queue->HasPendingTasks(queue_id));
+
+  std::vector<fml::closure> invocations;
+  task_queue->GetTasksToRunNow(queue_id, fml::FlushType::kAll, invocations);
+  ASSERT_TRUE(invocations.empty());
+  ASSERT_FALSE(task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now()));
+
+  auto task = task_queue->GetIdleTaskToRunNow(queue_id);
+  ASSERT_TRUE(task);
+  ASSERT_EQ(task->GetPriority(), fml::TaskPriority::kIdle);
+  ASSERT_FALSE(task_queue->HasPendingTasks(queue_id));
+}
@@ -444,3 +444,50 @@ TEST(MessageLoop, TIME_SENSITIVE(DelayedTaskSwap)) {
   thread_1.join();
   thread_2.join();
 }
+
+TEST(MessageLoop, IdleTasksRunOnlyWithinTheDeadline) {
+  std::vector<int> order;
+  std::thread thread([&order]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    auto task_runner = loop.GetTaskRunner();
+    task_runner->PostTask([&order]() { order.push_back(1); },
+                          fml::TaskPriority::kIdle);
+    task_runner->PostTask([&order]() { order.push_back(2); },
+                          fml::TaskPriority::kIdle);
+    task_runner->PostTask([&order]() {
+      // No time left.
+      fml::MessageLoop::GetCurrent().RunIdleTasks(fml::TimePoint::Now());
+      order.push_back(3);
+    });
+    task_runner->PostTask([&order]() {
+      fml::MessageLoop::GetCurrent().RunIdleTasks(
+          fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10));
+      order.push_back(4);
+      fml::MessageLoop::GetCurrent().Terminate();
+    });
+    loop.Run();
+  });
+  thread.join();
+  ASSERT_EQ(order, std::vector<int>({3, 1, 2, 4}));
+}
+
+TEST(MessageLoop, FrameCriticalTasksRunAheadOfEarlierTasks) {
+  std::vector<int> order;
+  std::thread thread([&order]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    auto task_runner = loop.GetTaskRunner();
+    task_runner->PostTask([&order, task_runner]() {
+      order.push_back(1);
+      task_runner->PostTask([&order]() { order.push_back(4); });
+      task_runner->PostTask([&order]() { order.push_back(2); },
+                            fml::TaskPriority::kFrameCritical);
+    });
+    task_runner->PostTask([&order]() { order.push_back(3); });
+    task_runner->PostTask([]() { fml::MessageLoop::GetCurrent().Terminate(); });
+    loop.Run();
+  });
+  thread.join();
+  ASSERT_EQ(order, std::vector<int>({1, 2, 3, 4}));
+}
@@ -9,6 +9,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/fml/build_config.h"
@@ -46,12 +47,41 @@ static bool IsWritable(
   return false;
 }
 
+static bool HasAdvice(std::initializer_list<FileMapping::Advice> advice,
+                      FileMapping::Advice wanted) {
+  for (auto item : advice) {
+    if (item == wanted) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void AdviseMapping(void* mapping,
+                          size_t size,
+                          std::initializer_list<FileMapping::Advice> advice) {
+  if (HasAdvice(advice, FileMapping::Advice::kSequential)) {
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+  }
+#if defined(MADV_HUGEPAGE)
+  if (HasAdvice(advice, FileMapping::Advice::kHugePages)) {
+    // Only takes effect where the kernel supports huge pages for the page
+    // cache. Failure is not an error.
+    ::madvise(mapping, size, MADV_HUGEPAGE);
+  }
+#endif  // defined(MADV_HUGEPAGE)
+  if (HasAdvice(advice, FileMapping::Advice::kWillNeed)) {
+    ::madvise(mapping, size, MADV_WILLNEED);
+  }
+}
+
 Mapping::Mapping() = default;
 
 Mapping::~Mapping() = default;
 
 FileMapping::FileMapping(const fml::UniqueFD& handle,
-                         std::initializer_list<Protection> protection)
+                         std::initializer_list<Protection> protection,
+                         std::initializer_list<Advice> advice)
     : size_(0), mapping_(nullptr) {
   if (!handle.is_valid()) {
     return;
@@ -69,14 +99,23 @@ FileMapping::FileMapping(const fml::UniqueFD& handle,
 
   const auto is_writable = IsWritable(protection);
 
-  auto* mapping =
-      ::mmap(nullptr, stat_buffer.st_size, ToPosixProtectionFlags(protection),
-             is_writable ? MAP_SHARED : MAP_PRIVATE, handle.get(), 0);
+  int flags = is_writable ? MAP_SHARED : MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+  if (HasAdvice(advice, Advice::kPopulate)) {
+    flags |= MAP_POPULATE;
+  }
+#endif  // defined(MAP_POPULATE)
+
+  auto* mapping = ::mmap(nullptr, stat_buffer.st_size,
+                         ToPosixProtectionFlags(protection), flags,
+                         handle.get(), 0);
 
   if (mapping == MAP_FAILED) {
     return;
   }
 
+  AdviseMapping(mapping, stat_buffer.st_size, advice);
+
   mapping_ = static_cast<uint8_t*>(mapping);
   size_ = stat_buffer.st_size;
   if (is_writable) {
@@ -98,4 +137,17 @@ const uint8_t* FileMapping::GetMapping() const {
   return mapping_;
 }
 
+bool FileMapping::Prefetch(size_t offset, size_t length) const {
+  if (mapping_ == nullptr || offset >= size_) {
+    return false;
+  }
+  length = std::min(length, size_ - offset);
+
+  // madvise requires a page aligned start.
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  const size_t aligned_offset = offset - (offset % page_size);
+  return ::madvise(mapping_ + aligned_offset, length + offset - aligned_offset,
+                   MADV_WILLNEED) == 0;
+}
+
 }  // namespace fml
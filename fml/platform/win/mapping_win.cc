@@ -41,7 +41,8 @@ static bool IsExecutable(
 }
 
 FileMapping::FileMapping(const fml::UniqueFD& fd,
-                         std::initializer_list<Protection> protections)
+                         std::initializer_list<Protection> protections,
+                         std::initializer_list<Advice> advice)
     : size_(0), mapping_(nullptr) {
   if (!fd.is_valid()) {
     return;
@@ -109,4 +110,8 @@ const uint8_t* FileMapping::GetMapping() const {
   return mapping_;
 }
 
+bool FileMapping::Prefetch(size_t offset, size_t length) const {
+  return false;
+}
+
 }  // namespace fml
@@ -0,0 +1,31 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_PRIORITY_H_
+#define FLUTTER_FML_TASK_PRIORITY_H_
+
+#include <cstddef>
+
+namespace fml {
+
+// The order in which due tasks on a message loop are run.
+enum class TaskPriority {
+  // Tasks that a frame is waiting on, such as the start of a frame on vsync.
+  // These run ahead of any other due task, including tasks that were posted
+  // while the loop was already flushing. They should be short and must not
+  // repost themselves.
+  kFrameCritical,
+  // The default.
+  kNormal,
+  // Tasks that are only run while the loop is known to be idle, within the
+  // deadline passed to |MessageLoop::RunIdleTasks|. Loops that are never
+  // told about idle time never run these.
+  kIdle,
+};
+
+constexpr size_t kTaskPriorityCount = 3;
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_PRIORITY_H_
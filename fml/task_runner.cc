@@ -23,11 +23,21 @@ void TaskRunner::PostTask(fml::closure task) {
   loop_->PostTask(std::move(task), fml::TimePoint::Now());
 }
 
+void TaskRunner::PostTask(fml::closure task, TaskPriority priority) {
+  loop_->PostTask(std::move(task), fml::TimePoint::Now(), priority);
+}
+
 void TaskRunner::PostTaskForTime(fml::closure task,
                                  fml::TimePoint target_time) {
   loop_->PostTask(std::move(task), target_time);
 }
 
+void TaskRunner::PostTaskForTime(fml::closure task,
+                                 fml::TimePoint target_time,
+                                 TaskPriority priority) {
+  loop_->PostTask(std::move(task), target_time, priority);
+}
+
 void TaskRunner::PostDelayedTask(fml::closure task, fml::TimeDelta delay) {
   loop_->PostTask(std::move(task), fml::TimePoint::Now() + delay);
 }
@@ -9,6 +9,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace fml {
@@ -21,8 +22,14 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner> {
 
   virtual void PostTask(fml::closure task);
 
+  virtual void PostTask(fml::closure task, TaskPriority priority);
+
   virtual void PostTaskForTime(fml::closure task, fml::TimePoint target_time);
 
+  virtual void PostTaskForTime(fml::closure task,
+                               fml::TimePoint target_time,
+                               TaskPriority priority);
+
   virtual void PostDelayedTask(fml::closure task, fml::TimeDelta delay);
 
   virtual bool RunsTasksOnCurrentThread();
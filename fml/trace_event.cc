@@ -46,6 +46,11 @@ void TraceTimelineEvent(TraceArg category_group,
 }
 
 void TraceEvent0(TraceArg category_group, TraceArg name) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().Record(TracePhase::kBegin, category_group,
+                                        name);
+    return;
+  }
   Dart_TimelineEvent(name,                       // label
                      Dart_TimelineGetMicros(),   // timestamp0
                      0,                          // timestamp1_or_async_id
@@ -60,6 +65,12 @@ void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
                  TraceArg arg1_val) {
+  if (TraceRecorder::IsEnabled()) {
+    const TraceRecordArg args[] = {{arg1_name, arg1_val}};
+    TraceRecorder::GetInstance().Record(TracePhase::kBegin, category_group,
+                                        name, 0, args, 1);
+    return;
+  }
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   Dart_TimelineEvent(name,                       // label
@@ -78,6 +89,13 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
                  TraceArg arg2_val) {
+  if (TraceRecorder::IsEnabled()) {
+    const TraceRecordArg args[] = {{arg1_name, arg1_val},
+                                   {arg2_name, arg2_val}};
+    TraceRecorder::GetInstance().Record(TracePhase::kBegin, category_group,
+                                        name, 0, args, 2);
+    return;
+  }
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
   Dart_TimelineEvent(name,                       // label
@@ -91,6 +109,10 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().RecordEnd(name);
+    return;
+  }
   Dart_TimelineEvent(name,                      // label
                      Dart_TimelineGetMicros(),  // timestamp0
                      0,                         // timestamp1_or_async_id
@@ -111,6 +133,15 @@ void TraceEventAsyncComplete(TraceArg category_group,
     std::swap(begin, end);
   }
 
+  if (TraceRecorder::IsEnabled()) {
+    auto& recorder = TraceRecorder::GetInstance();
+    recorder.RecordAt(begin, TracePhase::kAsyncBegin, category_group, name,
+                      identifier);
+    recorder.RecordAt(end, TracePhase::kAsyncEnd, category_group, name,
+                      identifier);
+    return;
+  }
+
   Dart_TimelineEvent(name,                                   // label
                      begin.ToEpochDelta().ToMicroseconds(),  // timestamp0
                      identifier,                       // timestamp1_or_async_id
@@ -132,6 +163,11 @@ void TraceEventAsyncComplete(TraceArg category_group,
 void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceArg name,
                            TraceIDArg id) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().Record(TracePhase::kAsyncBegin, category_group,
+                                        name, id);
+    return;
+  }
   Dart_TimelineEvent(name,                             // label
                      Dart_TimelineGetMicros(),         // timestamp0
                      id,                               // timestamp1_or_async_id
@@ -145,6 +181,11 @@ void TraceEventAsyncBegin0(TraceArg category_group,
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().Record(TracePhase::kAsyncEnd, category_group,
+                                        name, id);
+    return;
+  }
   Dart_TimelineEvent(name,                           // label
                      Dart_TimelineGetMicros(),       // timestamp0
                      id,                             // timestamp1_or_async_id
@@ -160,6 +201,12 @@ void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceIDArg id,
                            TraceArg arg1_name,
                            TraceArg arg1_val) {
+  if (TraceRecorder::IsEnabled()) {
+    const TraceRecordArg args[] = {{arg1_name, arg1_val}};
+    TraceRecorder::GetInstance().Record(TracePhase::kAsyncBegin, category_group,
+                                        name, id, args, 1);
+    return;
+  }
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   Dart_TimelineEvent(name,                             // label
@@ -177,6 +224,12 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceIDArg id,
                          TraceArg arg1_name,
                          TraceArg arg1_val) {
+  if (TraceRecorder::IsEnabled()) {
+    const TraceRecordArg args[] = {{arg1_name, arg1_val}};
+    TraceRecorder::GetInstance().Record(TracePhase::kAsyncEnd, category_group,
+                                        name, id, args, 1);
+    return;
+  }
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   Dart_TimelineEvent(name,                           // label
@@ -190,6 +243,11 @@ void TraceEventAsyncEnd1(TraceArg category_group,
 }
 
 void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().Record(TracePhase::kInstant, category_group,
+                                        name);
+    return;
+  }
   Dart_TimelineEvent(name,                         // label
                      Dart_TimelineGetMicros(),     // timestamp0
                      0,                            // timestamp1_or_async_id
@@ -203,6 +261,11 @@ void TraceEventInstant0(TraceArg category_group, TraceArg name) {
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().Record(TracePhase::kFlowBegin, category_group,
+                                        name, id);
+    return;
+  }
   Dart_TimelineEvent(name,                            // label
                      Dart_TimelineGetMicros(),        // timestamp0
                      id,                              // timestamp1_or_async_id
@@ -216,6 +279,11 @@ void TraceEventFlowBegin0(TraceArg category_group,
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().Record(TracePhase::kFlowStep, category_group,
+                                        name, id);
+    return;
+  }
   Dart_TimelineEvent(name,                           // label
                      Dart_TimelineGetMicros(),       // timestamp0
                      id,                             // timestamp1_or_async_id
@@ -227,6 +295,11 @@ void TraceEventFlowStep0(TraceArg category_group,
 }
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().Record(TracePhase::kFlowEnd, category_group,
+                                        name, id);
+    return;
+  }
   Dart_TimelineEvent(name,                          // label
                      Dart_TimelineGetMicros(),      // timestamp0
                      id,                            // timestamp1_or_async_id
@@ -39,6 +39,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_recorder.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if !defined(OS_FUCHSIA) || defined(FUCHSIA_SDK)
@@ -171,6 +172,11 @@ void TraceCounter(TraceArg category,
                   TraceArg name,
                   TraceIDArg identifier,
                   Args... args) {
+  if (TraceRecorder::IsEnabled()) {
+    RecordTraceEvent(TracePhase::kCounter, category, name, identifier,
+                     args...);
+    return;
+  }
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, identifier, Dart_Timeline_Event_Counter,
                      split.first, split.second);
@@ -178,6 +184,10 @@ void TraceCounter(TraceArg category,
 
 template <typename... Args>
 void TraceEvent(TraceArg category, TraceArg name, Args... args) {
+  if (TraceRecorder::IsEnabled()) {
+    RecordTraceEvent(TracePhase::kBegin, category, name, 0, args...);
+    return;
+  }
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, 0, Dart_Timeline_Event_Begin, split.first,
                      split.second);
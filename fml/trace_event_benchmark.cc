@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
+
+namespace fml {
+namespace benchmarking {
+
+// Records an event without arguments into the ring buffer of each benchmark
+// thread.
+static void BM_TraceEventRecorded(benchmark::State& state) {
+  tracing::TraceRecorder::GetInstance().SetEnabledCategories("flutter");
+  while (state.KeepRunning()) {
+    TRACE_EVENT_INSTANT0("flutter", "Event");
+  }
+  state.SetItemsProcessed(state.iterations());
+  tracing::TraceRecorder::GetInstance().SetEnabledCategories("");
+}
+BENCHMARK(BM_TraceEventRecorded)->ThreadRange(1, 4);
+
+// Drops an event because its category is not enabled.
+static void BM_TraceEventInDisabledCategory(benchmark::State& state) {
+  tracing::TraceRecorder::GetInstance().SetEnabledCategories("skia");
+  while (state.KeepRunning()) {
+    TRACE_EVENT_INSTANT0("flutter", "Event");
+  }
+  state.SetItemsProcessed(state.iterations());
+  tracing::TraceRecorder::GetInstance().SetEnabledCategories("");
+}
+BENCHMARK(BM_TraceEventInDisabledCategory);
+
+// Records a counter with numeric values, like the raster cache reports each
+// frame.
+static void BM_TraceCounterRecorded(benchmark::State& state) {
+  tracing::TraceRecorder::GetInstance().SetEnabledCategories("flutter");
+  int64_t count = 0;
+  while (state.KeepRunning()) {
+    count++;
+    FML_TRACE_COUNTER("flutter", "Counter", 0, "Count", count, "MBytes",
+                      count * 1e-6, "Pending", static_cast<size_t>(count));
+  }
+  state.SetItemsProcessed(state.iterations());
+  tracing::TraceRecorder::GetInstance().SetEnabledCategories("");
+}
+BENCHMARK(BM_TraceCounterRecorded);
+
+// The work the same counter takes before it is handed to the Dart timeline,
+// which converts every value to a string.
+static void BM_TraceCounterTimelineArguments(benchmark::State& state) {
+  int64_t count = 0;
+  while (state.KeepRunning()) {
+    count++;
+    auto split = tracing::SplitArguments("Count", count, "MBytes",
+                                         count * 1e-6, "Pending",
+                                         static_cast<size_t>(count));
+    benchmark::DoNotOptimize(split);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TraceCounterTimelineArguments);
+
+}  // namespace benchmarking
+}  // namespace fml
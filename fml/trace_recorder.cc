@@ -0,0 +1,533 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include "flutter/fml/thread_local.h"
+
+namespace fml {
+namespace tracing {
+
+// The bytes of each record that hold copies of its string arguments.
+static constexpr size_t kRecordStringBytes = 56;
+
+struct TraceRecorder::EventRecord {
+  int64_t timestamp_nanos;
+  const char* category;
+  const char* name;
+  int64_t id;
+  uint32_t thread_id;
+  TracePhase phase;
+  uint8_t arg_count;
+  // The |string_value| of string arguments is not used. Their |uint_value| is
+  // the offset of the copy of the string in |strings| instead.
+  TraceRecordArg args[kMaxArgs];
+  char strings[kRecordStringBytes];
+};
+
+// A ring buffer of the records of one thread at a time. Only that thread
+// appends records, which it does without locks. Exports copy the records
+// while the thread may be appending more and discard the ones that could have
+// been overwritten while they were copied. The records are stored as relaxed
+// atomic words so that copying one while it is overwritten is not a data race.
+// Those are plain loads and stores on the CPUs the engine runs on.
+class TraceRecorder::ThreadBuffer {
+ public:
+  ThreadBuffer()
+      : slots_(new Slot[kRecordsPerThread]),
+        started_index_(0),
+        write_index_(0) {}
+
+  // Stores the first |size| bytes of |record|. The rest of the slot keeps
+  // what an older record left there, which exports do not look at.
+  void Write(const EventRecord& record, size_t size) {
+    const uint64_t index = write_index_.load(std::memory_order_relaxed);
+    started_index_.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t word_count = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    const char* bytes = reinterpret_cast<const char*>(&record);
+    Slot& slot = slots_[index % kRecordsPerThread];
+    for (size_t i = 0; i < word_count; i++) {
+      uint64_t word;
+      std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+      slot.words[i].store(word, std::memory_order_relaxed);
+    }
+
+    write_index_.store(index + 1, std::memory_order_release);
+  }
+
+  // Must be called with |buffers_mutex_| held.
+  void CopyRecords(std::vector<EventRecord>& records, bool clear) {
+    const uint64_t end = write_index_.load(std::memory_order_acquire);
+    const uint64_t begin = std::max(
+        read_index_, end > kRecordsPerThread ? end - kRecordsPerThread : 0);
+    const size_t first = records.size();
+    for (uint64_t i = begin; i < end; i++) {
+      const Slot& slot = slots_[i % kRecordsPerThread];
+      uint64_t words[kRecordWords];
+      for (size_t j = 0; j < kRecordWords; j++) {
+        words[j] = slot.words[j].load(std::memory_order_relaxed);
+      }
+      records.emplace_back();
+      std::memcpy(&records.back(), words, sizeof(EventRecord));
+    }
+
+    // Drop the records whose slots the thread started writing to since.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t started = started_index_.load(std::memory_order_relaxed);
+    const uint64_t oldest_intact =
+        started > kRecordsPerThread ? started - kRecordsPerThread : 0;
+    if (oldest_intact > begin) {
+      const size_t torn = std::min(oldest_intact - begin, end - begin);
+      records.erase(records.begin() + first, records.begin() + first + torn);
+    }
+
+    if (clear) {
+      read_index_ = end;
+    }
+  }
+
+  // Must be called with |buffers_mutex_| held.
+  void Clear() { read_index_ = write_index_.load(std::memory_order_acquire); }
+
+ private:
+  static constexpr size_t kRecordWords = sizeof(EventRecord) / sizeof(uint64_t);
+  static_assert(sizeof(EventRecord) % sizeof(uint64_t) == 0,
+                "Records must be stored as whole words.");
+  static_assert(std::is_trivially_copyable<EventRecord>::value,
+                "Records are copied as words.");
+
+  struct Slot {
+    std::atomic<uint64_t> words[kRecordWords];
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> started_index_;
+  std::atomic<uint64_t> write_index_;
+  uint64_t read_index_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+struct TraceRecorder::ThreadState {
+  uint32_t thread_id = 0;
+  ThreadBuffer* buffer = nullptr;
+
+  ~ThreadState() {
+    if (buffer != nullptr) {
+      TraceRecorder::GetInstance().ReleaseBuffer(buffer);
+    }
+  }
+};
+
+std::atomic_bool TraceRecorder::enabled_;
+
+TraceRecorder& TraceRecorder::GetInstance() {
+  // Leaked so that threads exiting during shutdown can still hand their
+  // buffers back.
+  static TraceRecorder* recorder = new TraceRecorder();
+  return *recorder;
+}
+
+TraceRecorder::TraceRecorder() : category_count_(0) {}
+
+TraceRecorder::~TraceRecorder() = default;
+
+void TraceRecorder::SetEnabledCategories(const std::string& categories) {
+  std::scoped_lock lock(categories_mutex_);
+  enabled_categories_.clear();
+  size_t start = 0;
+  while (start <= categories.size()) {
+    size_t end = categories.find(',', start);
+    if (end == std::string::npos) {
+      end = categories.size();
+    }
+    if (end > start) {
+      enabled_categories_.emplace_back(categories.substr(start, end - start));
+    }
+    start = end + 1;
+  }
+
+  const size_t count = category_count_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < count; i++) {
+    categories_[i].enabled.store(
+        MatchesEnabledCategories(
+            categories_[i].name.load(std::memory_order_relaxed)),
+        std::memory_order_relaxed);
+  }
+  enabled_.store(!enabled_categories_.empty(), std::memory_order_relaxed);
+}
+
+std::string TraceRecorder::GetEnabledCategories() const {
+  std::scoped_lock lock(categories_mutex_);
+  std::string categories;
+  for (const auto& category : enabled_categories_) {
+    if (!categories.empty()) {
+      categories += ',';
+    }
+    categories += category;
+  }
+  return categories;
+}
+
+bool TraceRecorder::MatchesEnabledCategories(const char* category) const {
+  for (const auto& enabled_category : enabled_categories_) {
+    if (enabled_category == "*" || enabled_category == category) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TraceRecorder::IsCategoryEnabled(const char* category) {
+  if (category == nullptr) {
+    category = "";
+  }
+
+  // Categories are looked up without locks once they have been seen.
+  const size_t count = category_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; i++) {
+    const char* name = categories_[i].name.load(std::memory_order_relaxed);
+    if (name == category || std::strcmp(name, category) == 0) {
+      return categories_[i].enabled.load(std::memory_order_relaxed);
+    }
+  }
+
+  std::scoped_lock lock(categories_mutex_);
+  const size_t new_count = category_count_.load(std::memory_order_relaxed);
+  for (size_t i = count; i < new_count; i++) {
+    if (std::strcmp(categories_[i].name.load(std::memory_order_relaxed),
+                    category) == 0) {
+      return categories_[i].enabled.load(std::memory_order_relaxed);
+    }
+  }
+  const bool enabled = MatchesEnabledCategories(category);
+  if (new_count < kMaxCategories) {
+    categories_[new_count].name.store(category, std::memory_order_relaxed);
+    categories_[new_count].enabled.store(enabled, std::memory_order_relaxed);
+    category_count_.store(new_count + 1, std::memory_order_release);
+  }
+  return enabled;
+}
+
+void TraceRecorder::Record(TracePhase phase,
+                           const char* category,
+                           const char* name,
+                           int64_t id,
+                           const TraceRecordArg* args,
+                           size_t arg_count) {
+  if (!IsEnabled() || !IsCategoryEnabled(category)) {
+    return;
+  }
+  Append(TimePoint::Now().ToEpochDelta().ToNanoseconds(), phase, category,
+         name, id, args, arg_count);
+}
+
+void TraceRecorder::RecordAt(TimePoint time,
+                             TracePhase phase,
+                             const char* category,
+                             const char* name,
+                             int64_t id,
+                             const TraceRecordArg* args,
+                             size_t arg_count) {
+  if (!IsEnabled() || !IsCategoryEnabled(category)) {
+    return;
+  }
+  Append(time.ToEpochDelta().ToNanoseconds(), phase, category, name, id, args,
+         arg_count);
+}
+
+void TraceRecorder::RecordEnd(const char* name) {
+  if (!IsEnabled()) {
+    return;
+  }
+  Append(TimePoint::Now().ToEpochDelta().ToNanoseconds(), TracePhase::kEnd,
+         nullptr, name, 0, nullptr, 0);
+}
+
+TraceRecorder::ThreadState& TraceRecorder::GetThreadState() {
+  FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadState> tls_thread_state;
+  ThreadState* state = tls_thread_state.get();
+  if (state == nullptr) {
+    state = new ThreadState();
+    {
+      std::scoped_lock lock(buffers_mutex_);
+      thread_names_.emplace_back();
+      state->thread_id = static_cast<uint32_t>(thread_names_.size());
+    }
+    tls_thread_state.reset(state);
+  }
+  return *state;
+}
+
+void TraceRecorder::SetCurrentThreadName(const std::string& name) {
+  TraceRecorder& recorder = GetInstance();
+  const uint32_t thread_id = recorder.GetThreadState().thread_id;
+  std::scoped_lock lock(recorder.buffers_mutex_);
+  recorder.thread_names_[thread_id - 1] = name;
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::AcquireBuffer() {
+  std::scoped_lock lock(buffers_mutex_);
+  if (!free_buffers_.empty()) {
+    ThreadBuffer* buffer = free_buffers_.back();
+    free_buffers_.pop_back();
+    return buffer;
+  }
+  buffers_.emplace_back(std::make_unique<ThreadBuffer>());
+  return buffers_.back().get();
+}
+
+void TraceRecorder::ReleaseBuffer(ThreadBuffer* buffer) {
+  // The records stay in the buffer until the thread that takes it over next
+  // overwrites them.
+  std::scoped_lock lock(buffers_mutex_);
+  free_buffers_.push_back(buffer);
+}
+
+void TraceRecorder::Append(int64_t timestamp_nanos,
+                           TracePhase phase,
+                           const char* category,
+                           const char* name,
+                           int64_t id,
+                           const TraceRecordArg* args,
+                           size_t arg_count) {
+  ThreadState& state = GetThreadState();
+  if (state.buffer == nullptr) {
+    state.buffer = AcquireBuffer();
+  }
+
+  size_t next_arg = 0;
+  do {
+    EventRecord record;
+    record.timestamp_nanos = timestamp_nanos;
+    record.category = category;
+    record.name = name;
+    record.id = id;
+    record.thread_id = state.thread_id;
+    record.phase = phase;
+    record.arg_count = std::min(arg_count - next_arg, kMaxArgs);
+
+    size_t string_offset = 0;
+    for (size_t i = 0; i < record.arg_count; i++) {
+      const TraceRecordArg& arg = args[next_arg + i];
+      TraceRecordArg& record_arg = record.args[i];
+      record_arg.name = arg.name;
+      record_arg.type = arg.type;
+      if (arg.type != TraceRecordArg::Type::kString) {
+        record_arg.uint_value = arg.uint_value;
+        continue;
+      }
+      // Strings that do not fit are truncated.
+      const char* value = arg.string_value == nullptr ? "" : arg.string_value;
+      const size_t available = kRecordStringBytes - string_offset;
+      if (available == 0) {
+        // Points at the terminator of the last string copied.
+        record_arg.uint_value = kRecordStringBytes - 1;
+        continue;
+      }
+      const size_t length = strnlen(value, available - 1);
+      std::memcpy(record.strings + string_offset, value, length);
+      record.strings[string_offset + length] = '\0';
+      record_arg.uint_value = string_offset;
+      string_offset += length + 1;
+    }
+    // Only the arguments and string bytes in use are stored.
+    const size_t size =
+        string_offset > 0
+            ? offsetof(EventRecord, strings) + string_offset
+            : offsetof(EventRecord, args) +
+                  record.arg_count * sizeof(TraceRecordArg);
+    state.buffer->Write(record, size);
+    next_arg += record.arg_count;
+    // The values of counters are spread over as many records as they need.
+    // Other events keep their first arguments only.
+  } while (phase == TracePhase::kCounter && next_arg < arg_count);
+}
+
+static void AppendJSONString(std::string& json, const char* string) {
+  json += '"';
+  if (string == nullptr) {
+    string = "";
+  }
+  for (const char* c = string; *c != '\0'; c++) {
+    switch (*c) {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+          json += escaped;
+        } else {
+          json += *c;
+        }
+    }
+  }
+  json += '"';
+}
+
+static void AppendJSONArg(std::string& json,
+                          const TraceRecordArg& arg,
+                          const char* strings) {
+  char number[32];
+  switch (arg.type) {
+    case TraceRecordArg::Type::kInt:
+      std::snprintf(number, sizeof(number), "%" PRId64, arg.int_value);
+      json += number;
+      break;
+    case TraceRecordArg::Type::kUint:
+      std::snprintf(number, sizeof(number), "%" PRIu64, arg.uint_value);
+      json += number;
+      break;
+    case TraceRecordArg::Type::kDouble:
+      if (std::isfinite(arg.double_value)) {
+        std::snprintf(number, sizeof(number), "%.17g", arg.double_value);
+        json += number;
+      } else {
+        json += "null";
+      }
+      break;
+    case TraceRecordArg::Type::kString:
+      AppendJSONString(json, strings + arg.uint_value);
+      break;
+  }
+}
+
+static bool HasID(TracePhase phase, int64_t id) {
+  switch (phase) {
+    case TracePhase::kAsyncBegin:
+    case TracePhase::kAsyncEnd:
+    case TracePhase::kFlowBegin:
+    case TracePhase::kFlowStep:
+    case TracePhase::kFlowEnd:
+      return true;
+    case TracePhase::kCounter:
+      return id != 0;
+    default:
+      return false;
+  }
+}
+
+std::string TraceRecorder::ExportChromeTrace(bool clear) {
+  std::vector<EventRecord> records;
+  std::vector<std::string> thread_names;
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+      buffer->CopyRecords(records, clear);
+    }
+    thread_names = thread_names_;
+  }
+
+  // A buffer holds the records of all the threads it has been handed to, one
+  // after the other.
+  std::stable_sort(records.begin(), records.end(),
+                   [](const EventRecord& a, const EventRecord& b) {
+                     return a.thread_id < b.thread_id;
+                   });
+
+  std::string json = "{\"traceEvents\":[";
+  bool first_event = true;
+  auto begin_event = [&json, &first_event]() {
+    if (!first_event) {
+      json += ',';
+    }
+    first_event = false;
+  };
+
+  std::vector<const char*> open_durations;
+  uint32_t thread_id = 0;
+  for (const auto& record : records) {
+    char buffer[128];
+    if (record.thread_id != thread_id) {
+      thread_id = record.thread_id;
+      open_durations.clear();
+      const std::string& thread_name = thread_names[thread_id - 1];
+      if (!thread_name.empty()) {
+        begin_event();
+        std::snprintf(buffer, sizeof(buffer),
+                      "{\"ph\":\"M\",\"pid\":0,\"tid\":%" PRIu32
+                      ",\"name\":\"thread_name\",\"args\":{\"name\":",
+                      thread_id);
+        json += buffer;
+        AppendJSONString(json, thread_name.c_str());
+        json += "}}";
+      }
+    }
+
+    // Only keep the ends of durations whose begin was recorded.
+    if (record.phase == TracePhase::kBegin) {
+      open_durations.push_back(record.name);
+    } else if (record.phase == TracePhase::kEnd) {
+      if (open_durations.empty() ||
+          std::strcmp(open_durations.back(), record.name) != 0) {
+        continue;
+      }
+      open_durations.pop_back();
+    }
+
+    begin_event();
+    json += "{\"name\":";
+    AppendJSONString(json, record.name);
+    if (record.category != nullptr) {
+      json += ",\"cat\":";
+      AppendJSONString(json, record.category);
+    }
+    std::snprintf(buffer, sizeof(buffer),
+                  ",\"ph\":\"%c\",\"ts\":%" PRId64 ".%03" PRId64
+                  ",\"pid\":0,\"tid\":%" PRIu32,
+                  static_cast<char>(record.phase),
+                  record.timestamp_nanos / 1000,
+                  record.timestamp_nanos % 1000, record.thread_id);
+    json += buffer;
+    if (HasID(record.phase, record.id)) {
+      std::snprintf(buffer, sizeof(buffer), ",\"id\":\"0x%" PRIx64 "\"",
+                    static_cast<uint64_t>(record.id));
+      json += buffer;
+    }
+    if (record.phase == TracePhase::kInstant) {
+      json += ",\"s\":\"t\"";
+    } else if (record.phase == TracePhase::kFlowEnd) {
+      json += ",\"bp\":\"e\"";
+    }
+    if (record.arg_count > 0) {
+      json += ",\"args\":{";
+      for (size_t i = 0; i < record.arg_count; i++) {
+        if (i > 0) {
+          json += ',';
+        }
+        AppendJSONString(json, record.args[i].name);
+        json += ':';
+        AppendJSONArg(json, record.args[i], record.strings);
+      }
+      json += '}';
+    }
+    json += '}';
+  }
+  json += "]}";
+  return json;
+}
+
+void TraceRecorder::Clear() {
+  std::scoped_lock lock(buffers_mutex_);
+  for (const auto& buffer : buffers_) {
+    buffer->Clear();
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,225 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+// The phase of a recorded event. The values are the phases of the Chrome
+// trace event format the events are exported in.
+enum class TracePhase : char {
+  kBegin = 'B',
+  kEnd = 'E',
+  kInstant = 'i',
+  kCounter = 'C',
+  kAsyncBegin = 'b',
+  kAsyncEnd = 'e',
+  kFlowBegin = 's',
+  kFlowStep = 't',
+  kFlowEnd = 'f',
+};
+
+// A named argument of a recorded event. Numbers are kept as numbers instead of
+// being converted to strings. String values are copied into the record, so
+// they only need to outlive the call that records them.
+struct TraceRecordArg {
+  enum class Type : uint8_t { kInt, kUint, kDouble, kString };
+
+  const char* name = nullptr;
+  Type type = Type::kInt;
+  union {
+    int64_t int_value;
+    uint64_t uint_value;
+    double double_value;
+    const char* string_value;
+  };
+
+  TraceRecordArg() : int_value(0) {}
+
+  template <typename T,
+            typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+  TraceRecordArg(const char* p_name, T value) : name(p_name) {
+    if (std::is_floating_point<T>::value) {
+      type = Type::kDouble;
+      double_value = static_cast<double>(value);
+    } else if (std::is_signed<T>::value) {
+      type = Type::kInt;
+      int_value = static_cast<int64_t>(value);
+    } else {
+      type = Type::kUint;
+      uint_value = static_cast<uint64_t>(value);
+    }
+  }
+
+  TraceRecordArg(const char* p_name, const char* value)
+      : name(p_name), type(Type::kString), string_value(value) {}
+
+  TraceRecordArg(const char* p_name, const std::string& value)
+      : name(p_name), type(Type::kString), string_value(value.c_str()) {}
+
+  TraceRecordArg(const char* p_name, TimePoint value)
+      : name(p_name),
+        type(Type::kInt),
+        int_value(value.ToEpochDelta().ToNanoseconds()) {}
+};
+
+// A low overhead, in process backend for the trace events of the engine.
+//
+// While a set of categories is enabled, the |TRACE_EVENT*| macros append
+// fixed size binary records to a ring buffer owned by the calling thread
+// instead of handing the events to the Dart timeline. Appending a record takes
+// no locks and allocates nothing, and events in disabled categories are
+// dropped after a single check. When a ring buffer is full, the oldest records
+// of that thread are overwritten. The records are only formatted when they are
+// exported in the Chrome trace event format, which both chrome://tracing and
+// the Perfetto UI open.
+//
+// Event names, categories and argument names are stored as pointers and must
+// be string literals, like for the rest of the tracing macros.
+class TraceRecorder {
+ public:
+  // The most arguments kept for an event. Counters with more values are split
+  // into several records, other events drop the arguments past this.
+  static constexpr size_t kMaxArgs = 4;
+
+  // The records kept for each thread.
+  static constexpr size_t kRecordsPerThread = 2048;
+
+  static TraceRecorder& GetInstance();
+
+  // Whether any category is enabled. While it is, trace events bypass the Dart
+  // timeline whether their own category is enabled or not.
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  // Enables the comma separated |categories|, like "flutter,skia", and
+  // disables all others. "*" enables every category and an empty string
+  // stops recording. Records already made are kept until exported.
+  void SetEnabledCategories(const std::string& categories);
+
+  std::string GetEnabledCategories() const;
+
+  bool IsCategoryEnabled(const char* category);
+
+  // Records an event on the ring buffer of the calling thread if |category|
+  // is enabled.
+  void Record(TracePhase phase,
+              const char* category,
+              const char* name,
+              int64_t id = 0,
+              const TraceRecordArg* args = nullptr,
+              size_t arg_count = 0);
+
+  // Records an event that happened at |time| instead of now.
+  void RecordAt(TimePoint time,
+                TracePhase phase,
+                const char* category,
+                const char* name,
+                int64_t id = 0,
+                const TraceRecordArg* args = nullptr,
+                size_t arg_count = 0);
+
+  // Records the end of the innermost duration event named |name| on the
+  // calling thread. Ends whose begin was not recorded, because its category
+  // was disabled or it was overwritten, are dropped on export.
+  void RecordEnd(const char* name);
+
+  // Returns the events recorded on all threads as a Chrome trace event format
+  // JSON object. If |clear| is true, the exported events are forgotten.
+  std::string ExportChromeTrace(bool clear);
+
+  // Forgets all recorded events.
+  void Clear();
+
+  // Names the calling thread in exported traces.
+  static void SetCurrentThreadName(const std::string& name);
+
+ private:
+  struct EventRecord;
+  class ThreadBuffer;
+  struct ThreadState;
+  struct Category {
+    std::atomic<const char*> name;
+    std::atomic_bool enabled;
+  };
+
+  static constexpr size_t kMaxCategories = 64;
+
+  static std::atomic_bool enabled_;
+
+  Category categories_[kMaxCategories] = {};
+  std::atomic_size_t category_count_;
+  mutable std::mutex categories_mutex_;
+  std::vector<std::string> enabled_categories_;
+
+  std::mutex buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  std::vector<ThreadBuffer*> free_buffers_;
+  std::vector<std::string> thread_names_;
+
+  TraceRecorder();
+
+  ~TraceRecorder();
+
+  bool MatchesEnabledCategories(const char* category) const;
+
+  ThreadState& GetThreadState();
+
+  ThreadBuffer* AcquireBuffer();
+
+  void ReleaseBuffer(ThreadBuffer* buffer);
+
+  void Append(int64_t timestamp_nanos,
+              TracePhase phase,
+              const char* category,
+              const char* name,
+              int64_t id,
+              const TraceRecordArg* args,
+              size_t arg_count);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceRecorder);
+};
+
+inline void CollectTraceRecordArgs(TraceRecordArg* args) {}
+
+template <typename Key, typename Value, typename... Args>
+void CollectTraceRecordArgs(TraceRecordArg* args,
+                            const Key& key,
+                            const Value& value,
+                            const Args&... rest) {
+  *args = TraceRecordArg(key, value);
+  CollectTraceRecordArgs(args + 1, rest...);
+}
+
+// Records an event with the alternating names and values in |args|.
+template <typename... Args>
+void RecordTraceEvent(TracePhase phase,
+                      const char* category,
+                      const char* name,
+                      int64_t id,
+                      const Args&... args) {
+  constexpr size_t arg_count = sizeof...(Args) / 2;
+  TraceRecordArg record_args[arg_count > 0 ? arg_count : 1];
+  CollectTraceRecordArgs(record_args, args...);
+  TraceRecorder::GetInstance().Record(phase, category, name, id, record_args,
+                                      arg_count);
+}
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
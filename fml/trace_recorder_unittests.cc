@@ -0,0 +1,172 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include <atomic>
+#include <string>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+static size_t CountOccurrences(const std::string& string,
+                               const std::string& substring) {
+  size_t count = 0;
+  for (size_t position = string.find(substring); position != std::string::npos;
+       position = string.find(substring, position + substring.size())) {
+    count++;
+  }
+  return count;
+}
+
+class TraceRecorderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TraceRecorder::GetInstance().SetEnabledCategories("flutter");
+    TraceRecorder::GetInstance().Clear();
+  }
+
+  void TearDown() override {
+    TraceRecorder::GetInstance().SetEnabledCategories("");
+    TraceRecorder::GetInstance().Clear();
+  }
+};
+
+TEST_F(TraceRecorderTest, RecordsEventsOfEnabledCategoriesOnly) {
+  ASSERT_TRUE(TraceRecorder::IsEnabled());
+  {
+    TRACE_EVENT0("flutter", "Recorded");
+    TRACE_EVENT0("skia", "Dropped");
+    TRACE_EVENT_INSTANT0("flutter", "Instant");
+  }
+
+  const std::string trace =
+      TraceRecorder::GetInstance().ExportChromeTrace(true);
+  ASSERT_EQ(trace.find("{\"traceEvents\":["), 0u);
+  ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Recorded\""), 2u);
+  ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Instant\""), 1u);
+  ASSERT_EQ(CountOccurrences(trace, "Dropped"), 0u);
+  // The end of the dropped event does not close the recorded one.
+  ASSERT_EQ(CountOccurrences(trace, "\"ph\":\"B\""), 1u);
+  ASSERT_EQ(CountOccurrences(trace, "\"ph\":\"E\""), 1u);
+
+  ASSERT_EQ(TraceRecorder::GetInstance().ExportChromeTrace(true),
+            "{\"traceEvents\":[]}");
+}
+
+TEST_F(TraceRecorderTest, StopsRecordingWhenAllCategoriesAreDisabled) {
+  TraceRecorder::GetInstance().SetEnabledCategories("");
+  ASSERT_FALSE(TraceRecorder::IsEnabled());
+  TRACE_EVENT_INSTANT0("flutter", "Dropped");
+
+  TraceRecorder::GetInstance().SetEnabledCategories("skia,flutter");
+  ASSERT_EQ(TraceRecorder::GetInstance().GetEnabledCategories(),
+            "skia,flutter");
+  TRACE_EVENT_INSTANT0("skia", "Recorded");
+
+  const std::string trace =
+      TraceRecorder::GetInstance().ExportChromeTrace(false);
+  ASSERT_EQ(CountOccurrences(trace, "Dropped"), 0u);
+  ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Recorded\""), 1u);
+}
+
+TEST_F(TraceRecorderTest, KeepsTheTypesOfArguments) {
+  FML_TRACE_COUNTER("flutter", "Counter", 0x2a, "Count", 3, "Ratio", 0.5,
+                    "Label", std::string("a \"b\""), "Size", 7u, "Delta", -2,
+                    "Time", TimePoint::FromEpochDelta(
+                                TimeDelta::FromNanoseconds(1000)));
+
+  const std::string trace =
+      TraceRecorder::GetInstance().ExportChromeTrace(true);
+  ASSERT_NE(trace.find("\"Count\":3"), std::string::npos);
+  ASSERT_NE(trace.find("\"Ratio\":0.5"), std::string::npos);
+  ASSERT_NE(trace.find("\"Label\":\"a \\\"b\\\"\""), std::string::npos);
+  ASSERT_NE(trace.find("\"Size\":7"), std::string::npos);
+  ASSERT_NE(trace.find("\"Delta\":-2"), std::string::npos);
+  ASSERT_NE(trace.find("\"Time\":1000"), std::string::npos);
+  // The six values do not fit in one record.
+  ASSERT_EQ(CountOccurrences(trace, "\"ph\":\"C\""), 2u);
+  ASSERT_EQ(CountOccurrences(trace, "\"id\":\"0x2a\""), 2u);
+}
+
+TEST_F(TraceRecorderTest, KeepsTheNewestRecordsWhenFull) {
+  const size_t count = TraceRecorder::kRecordsPerThread + 10;
+  for (size_t i = 0; i < count; i++) {
+    FML_TRACE_COUNTER("flutter", "Index", 0, "Value", i);
+  }
+
+  const std::string trace =
+      TraceRecorder::GetInstance().ExportChromeTrace(true);
+  ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Index\""),
+            TraceRecorder::kRecordsPerThread);
+  ASSERT_EQ(trace.find("\"Value\":9}"), std::string::npos);
+  ASSERT_NE(trace.find("\"Value\":10}"), std::string::npos);
+  ASSERT_NE(trace.find("\"Value\":" + std::to_string(count - 1) + "}"),
+            std::string::npos);
+}
+
+TEST_F(TraceRecorderTest, RecordsEachThreadSeparately) {
+  fml::Thread thread1("trace_recorder_1");
+  fml::Thread thread2("trace_recorder_2");
+  for (auto* thread : {&thread1, &thread2}) {
+    fml::AutoResetWaitableEvent latch;
+    thread->GetTaskRunner()->PostTask([&latch]() {
+      {
+        TRACE_EVENT0("flutter", "OnThread");
+      }
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+
+  const std::string trace =
+      TraceRecorder::GetInstance().ExportChromeTrace(true);
+  ASSERT_EQ(CountOccurrences(trace, "\"name\":\"OnThread\""), 4u);
+  ASSERT_EQ(CountOccurrences(trace, "\"name\":\"thread_name\""), 2u);
+  ASSERT_NE(trace.find("{\"name\":\"trace_recorder_1\"}"), std::string::npos);
+  ASSERT_NE(trace.find("{\"name\":\"trace_recorder_2\"}"), std::string::npos);
+}
+
+TEST_F(TraceRecorderTest, ExportsWhileThreadsRecord) {
+  static constexpr size_t kThreadCount = 2;
+  std::atomic_bool done = {false};
+  fml::Thread thread1("trace_recorder_1");
+  fml::Thread thread2("trace_recorder_2");
+  fml::CountDownLatch finished(kThreadCount);
+  for (auto* thread : {&thread1, &thread2}) {
+    thread->GetTaskRunner()->PostTask([&done, &finished]() {
+      // Wraps around the ring buffer many times during the exports.
+      for (size_t i = 0; !done.load(); i++) {
+        FML_TRACE_COUNTER("flutter", "Written", 0, "Index", i);
+        TRACE_EVENT_ASYNC_BEGIN1("flutter", "Labeled", i, "Label", "value");
+      }
+      finished.CountDown();
+    });
+  }
+
+  for (size_t i = 0; i < 20; i++) {
+    const std::string trace =
+        TraceRecorder::GetInstance().ExportChromeTrace(i % 2 == 0);
+    // Records overwritten while they were copied are dropped instead of
+    // being exported torn.
+    EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Labeled\""),
+              CountOccurrences(trace, "\"Label\":\"value\""));
+    EXPECT_LE(CountOccurrences(trace, "\"name\":\"Written\""),
+              kThreadCount * TraceRecorder::kRecordsPerThread);
+  }
+  done.store(true);
+  finished.Wait();
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
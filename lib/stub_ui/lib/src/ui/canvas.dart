@@ -948,6 +948,57 @@ class Canvas {
     throw UnimplementedError();
   }
 
+  /// Draws many rectangles that each have their own color and, optionally,
+  /// transform.
+  ///
+  /// Each rectangle is drawn as if by [drawRect] with `paint`, its color
+  /// replaced by the rectangle's color.
+  void drawRectInstances(Float32List positions, Float32List sizes,
+      Int32List colors, Float32List rstTransforms, Paint paint) {
+    assert(positions != null);
+    assert(sizes != null);
+    assert(colors != null);
+    assert(paint != null);
+
+    final int rectCount = colors.length;
+    if (positions.length != rectCount * 2) {
+      throw ArgumentError(
+          '"positions" length must be twice the length of "colors".');
+    }
+    if (sizes.length != rectCount * 2) {
+      throw ArgumentError(
+          '"sizes" length must be twice the length of "colors".');
+    }
+    if (rstTransforms != null && rstTransforms.length != rectCount * 4) {
+      throw ArgumentError(
+          'If non-null, "rstTransforms" length must be four times the length of "colors".');
+    }
+
+    for (int i = 0; i < rectCount; i += 1) {
+      final Paint rectPaint = Paint()
+        .._paintData = paint.webOnlyPaintData
+        .._frozen = true
+        ..color = Color(colors[i]);
+      final Rect rect = Rect.fromLTWH(positions[2 * i], positions[2 * i + 1],
+          sizes[2 * i], sizes[2 * i + 1]);
+      if (rstTransforms == null) {
+        drawRect(rect, rectPaint);
+        continue;
+      }
+      final double scos = rstTransforms[4 * i];
+      final double ssin = rstTransforms[4 * i + 1];
+      save();
+      transform(Float64List.fromList(<double>[
+        scos, ssin, 0.0, 0.0,
+        -ssin, scos, 0.0, 0.0,
+        0.0, 0.0, 1.0, 0.0,
+        rstTransforms[4 * i + 2], rstTransforms[4 * i + 3], 0.0, 1.0,
+      ]));
+      drawRect(rect, rectPaint);
+      restore();
+    }
+  }
+
   /// Draws a shadow for a [Path] representing the given material elevation.
   ///
   /// The `transparentOccluder` argument should be true if the occluding object
@@ -961,6 +1012,85 @@ class Canvas {
     assert(transparentOccluder != null);
     _canvas.drawShadow(path, color, elevation, transparentOccluder);
   }
+
+  /// Draws the primitives recorded in the given [DrawBatch], in the order they
+  /// were recorded, with the current transform and clip.
+  ///
+  /// The batch is not modified and can be drawn again.
+  void drawBatch(DrawBatch batch) {
+    assert(batch != null);
+    for (_DrawBatchCommand command in batch._commands) {
+      command(this);
+    }
+  }
+}
+
+typedef _DrawBatchCommand = void Function(Canvas canvas);
+
+/// A run of simple primitives to be drawn into a [Canvas] at once with
+/// [Canvas.drawBatch].
+///
+/// The paints are captured when the primitives are added, so changing a
+/// [Paint] afterwards does not affect primitives that were already added.
+class DrawBatch {
+  final List<_DrawBatchCommand> _commands = <_DrawBatchCommand>[];
+
+  /// Whether no primitives have been added since the batch was created or
+  /// last cleared.
+  bool get isEmpty => _commands.isEmpty;
+
+  /// Removes all the primitives from the batch.
+  void clear() {
+    _commands.clear();
+  }
+
+  /// Adds a rectangle, like [Canvas.drawRect].
+  void drawRect(Rect rect, Paint paint) {
+    assert(engine.rectIsValid(rect));
+    assert(paint != null);
+    final Paint snapshot = _snapshot(paint);
+    _commands.add((Canvas canvas) => canvas.drawRect(rect, snapshot));
+  }
+
+  /// Adds a rounded rectangle, like [Canvas.drawRRect].
+  void drawRRect(RRect rrect, Paint paint) {
+    assert(engine.rrectIsValid(rrect));
+    assert(paint != null);
+    final Paint snapshot = _snapshot(paint);
+    _commands.add((Canvas canvas) => canvas.drawRRect(rrect, snapshot));
+  }
+
+  /// Adds an oval, like [Canvas.drawOval].
+  void drawOval(Rect rect, Paint paint) {
+    assert(engine.rectIsValid(rect));
+    assert(paint != null);
+    final Paint snapshot = _snapshot(paint);
+    _commands.add((Canvas canvas) => canvas.drawOval(rect, snapshot));
+  }
+
+  /// Adds a circle, like [Canvas.drawCircle].
+  void drawCircle(Offset c, double radius, Paint paint) {
+    assert(engine.offsetIsValid(c));
+    assert(paint != null);
+    final Paint snapshot = _snapshot(paint);
+    _commands.add((Canvas canvas) => canvas.drawCircle(c, radius, snapshot));
+  }
+
+  /// Adds a line, like [Canvas.drawLine].
+  void drawLine(Offset p1, Offset p2, Paint paint) {
+    assert(engine.offsetIsValid(p1));
+    assert(engine.offsetIsValid(p2));
+    assert(paint != null);
+    final Paint snapshot = _snapshot(paint);
+    _commands.add((Canvas canvas) => canvas.drawLine(p1, p2, snapshot));
+  }
+
+  // Shares the paint's data until either paint is changed.
+  static Paint _snapshot(Paint paint) {
+    return Paint()
+      .._paintData = paint.webOnlyPaintData
+      .._frozen = true;
+  }
 }
 
 /// An object representing a sequence of recorded graphical operations.
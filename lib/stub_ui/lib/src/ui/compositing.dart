@@ -277,9 +277,11 @@ class SceneBuilder {
   /// The given filter is applied to the current contents of the scene prior to
   /// rasterizing the given objects.
   ///
+  /// The `downsampleFactor` is ignored on the web.
+  ///
   /// See [pop] for details about the operation stack.
   BackdropFilterEngineLayer pushBackdropFilter(ImageFilter filter,
-      {BackdropFilterEngineLayer oldLayer}) {
+      {BackdropFilterEngineLayer oldLayer, int downsampleFactor = 1}) {
     return _pushSurface(engine.PersistedBackdropFilter(oldLayer, filter));
   }
 
@@ -1109,6 +1109,33 @@ class IsolateNameServer {
     assert(name != null, "'name' cannot be null.");
     throw UnimplementedError();
   }
+
+  static bool removeSharedMessageChannel(String name) {
+    assert(name != null, "'name' cannot be null.");
+    throw UnimplementedError();
+  }
+}
+
+// TODO(flutter_web): probably dont implement this one.
+class SharedMessageChannel {
+  SharedMessageChannel(String name, {int capacity = 64 * 1024}) {
+    assert(name != null, "'name' cannot be null.");
+    throw UnimplementedError();
+  }
+
+  int get maxMessageSize => throw UnimplementedError();
+
+  bool send(ByteData message) {
+    throw UnimplementedError();
+  }
+
+  ByteData receive() {
+    throw UnimplementedError();
+  }
+
+  void setReceiveNotificationPort(dynamic port) {
+    throw UnimplementedError();
+  }
 }
 
 /// Various important time points in the lifetime of a frame.
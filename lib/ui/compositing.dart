@@ -405,16 +405,22 @@ class SceneBuilder extends NativeFieldWrapperClass2 {
   ///
   /// {@macro dart.ui.sceneBuilder.oldLayer}
   ///
+  /// If `downsampleFactor` is greater than one, the backdrop is shrunk by that
+  /// factor in each dimension before the filter is applied and the result is
+  /// scaled back up. This makes large blurs considerably cheaper at the cost of
+  /// some fidelity, and is intended for filters that blur the backdrop.
+  ///
   /// {@macro dart.ui.sceneBuilder.oldLayerVsRetained}
   ///
   /// See [pop] for details about the operation stack.
-  BackdropFilterEngineLayer pushBackdropFilter(ImageFilter filter, { BackdropFilterEngineLayer oldLayer }) {
+  BackdropFilterEngineLayer pushBackdropFilter(ImageFilter filter, { BackdropFilterEngineLayer oldLayer, int downsampleFactor = 1 }) {
+    assert(downsampleFactor != null && downsampleFactor >= 1);
     assert(_debugCheckCanBeUsedAsOldLayer(oldLayer, 'pushBackdropFilter'));
-    final BackdropFilterEngineLayer layer = BackdropFilterEngineLayer._(_pushBackdropFilter(filter));
+    final BackdropFilterEngineLayer layer = BackdropFilterEngineLayer._(_pushBackdropFilter(filter, downsampleFactor));
     assert(_debugPushLayer(layer));
     return layer;
   }
-  EngineLayer _pushBackdropFilter(ImageFilter filter) native 'SceneBuilder_pushBackdropFilter';
+  EngineLayer _pushBackdropFilter(ImageFilter filter, int downsampleFactor) native 'SceneBuilder_pushBackdropFilter';
 
   /// Pushes a shader mask operation onto the operation stack.
   ///
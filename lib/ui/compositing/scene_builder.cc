@@ -149,8 +149,11 @@ fml::RefPtr<EngineLayer> SceneBuilder::pushColorFilter(
   return EngineLayer::MakeRetained(layer);
 }
 
-fml::RefPtr<EngineLayer> SceneBuilder::pushBackdropFilter(ImageFilter* filter) {
-  auto layer = std::make_shared<flutter::BackdropFilterLayer>(filter->filter());
+fml::RefPtr<EngineLayer> SceneBuilder::pushBackdropFilter(
+    ImageFilter* filter,
+    int downsampleFactor) {
+  auto layer = std::make_shared<flutter::BackdropFilterLayer>(
+      filter->filter(), downsampleFactor);
   PushLayer(layer);
   return EngineLayer::MakeRetained(layer);
 }
@@ -50,7 +50,8 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
                                         int clipBehavior);
   fml::RefPtr<EngineLayer> pushOpacity(int alpha, double dx = 0, double dy = 0);
   fml::RefPtr<EngineLayer> pushColorFilter(const ColorFilter* color_filter);
-  fml::RefPtr<EngineLayer> pushBackdropFilter(ImageFilter* filter);
+  fml::RefPtr<EngineLayer> pushBackdropFilter(ImageFilter* filter,
+                                              int downsampleFactor);
   fml::RefPtr<EngineLayer> pushShaderMask(Shader* shader,
                                           double maskRectLeft,
                                           double maskRectRight,
@@ -9,6 +9,7 @@
 #include "flutter/lib/ui/compositing/scene_builder.h"
 #include "flutter/lib/ui/dart_runtime_hooks.h"
 #include "flutter/lib/ui/isolate_name_server/isolate_name_server_natives.h"
+#include "flutter/lib/ui/isolate_name_server/shared_message_channel_handle.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/color_filter.h"
@@ -92,6 +93,7 @@ void DartUI::InitForGlobal() {
     SceneBuilder::RegisterNatives(g_natives);
     SemanticsUpdate::RegisterNatives(g_natives);
     SemanticsUpdateBuilder::RegisterNatives(g_natives);
+    SharedMessageChannelHandle::RegisterNatives(g_natives);
     Vertices::RegisterNatives(g_natives);
     Window::RegisterNatives(g_natives);
 #if defined(OS_FUCHSIA)
@@ -102,6 +104,7 @@ void DartUI::InitForGlobal() {
     g_natives_secondary = new tonic::DartLibraryNatives();
     DartRuntimeHooks::RegisterNatives(g_natives_secondary);
     IsolateNameServerNatives::RegisterNatives(g_natives_secondary);
+    SharedMessageChannelHandle::RegisterNatives(g_natives_secondary);
   }
 }
 
@@ -70,10 +70,89 @@ class IsolateNameServer {
     return _removePortNameMapping(name);
   }
 
+  /// Removes the [SharedMessageChannel] with the given name.
+  ///
+  /// Returns true if the channel was removed, false if there was no channel
+  /// with that name. Endpoints that already opened the channel can keep using
+  /// it, but opening the name again creates a new channel.
+  ///
+  /// The `name` argument must not be null.
+  static bool removeSharedMessageChannel(String name) {
+    assert(name != null, "'name' cannot be null.");
+    return _removeSharedMessageChannel(name);
+  }
+
   static SendPort _lookupPortByName(String name)
       native 'IsolateNameServerNatives_LookupPortByName';
   static bool _registerPortWithName(SendPort port, String name)
       native 'IsolateNameServerNatives_RegisterPortWithName';
   static bool _removePortNameMapping(String name)
       native 'IsolateNameServerNatives_RemovePortNameMapping';
+  static bool _removeSharedMessageChannel(String name)
+      native 'IsolateNameServerNatives_RemoveSharedMessageChannel';
+}
+
+/// A bounded channel for streaming bytes, such as sensor readings or audio
+/// buffers, from one isolate or the host to another without going through the
+/// platform thread.
+///
+/// Messages are copied into memory shared by both ends and read from it
+/// directly. A channel has exactly one sender and one receiver, which may be
+/// in different isolates or in host code. Both ends find the channel by name
+/// through the [IsolateNameServer]. A [SharedMessageChannel] object becomes
+/// the sender the first time it sends and the receiver the first time it
+/// receives, and stays so until it is garbage collected.
+///
+/// Sending never blocks: when the channel is full, [send] returns false and
+/// the sender decides whether to drop or retry the message.
+class SharedMessageChannel extends NativeFieldWrapperClass2 {
+  /// Opens the channel registered with the given name, creating it if it does
+  /// not exist yet.
+  ///
+  /// The `capacity` is the number of bytes the channel can buffer and is only
+  /// used when the channel is created. Messages can be at most half as large.
+  /// Throws an [ArgumentError] if the capacity is not between 1 and 2^30.
+  ///
+  /// The `name` argument must not be null.
+  SharedMessageChannel(String name, {int capacity = 64 * 1024}) {
+    assert(name != null, "'name' cannot be null.");
+    assert(capacity != null && capacity > 0);
+    _constructor(name, capacity);
+  }
+  void _constructor(String name, int capacity)
+      native 'SharedMessageChannel_constructor';
+
+  /// The size in bytes of the largest message that can be sent.
+  int get maxMessageSize => _getMaxMessageSize();
+  int _getMaxMessageSize()
+      native 'SharedMessageChannelHandle_getMaxMessageSize';
+
+  /// Copies the message into the channel.
+  ///
+  /// Returns false if the channel does not have room for the message. Throws
+  /// an [ArgumentError] if the message is larger than [maxMessageSize], and a
+  /// [StateError] if another object is the sender of the channel.
+  bool send(ByteData message) {
+    assert(message != null, "'message' cannot be null.");
+    return _send(message);
+  }
+  bool _send(ByteData message) native 'SharedMessageChannelHandle_send';
+
+  /// Removes and returns the oldest message, or null if the channel is empty.
+  ///
+  /// Throws a [StateError] if another object is the receiver of the channel.
+  ByteData receive() native 'SharedMessageChannelHandle_receive';
+
+  /// Sets the port that is sent the size of a message when it arrives in a
+  /// channel that [receive] found empty.
+  ///
+  /// This allows the receiver to wait for messages on a [ReceivePort] instead
+  /// of polling. The receiver should call [receive] until it returns null each
+  /// time the port is notified. Passing null stops the notifications.
+  ///
+  /// Throws a [StateError] if another object is the receiver of the channel.
+  void setReceiveNotificationPort(SendPort port) =>
+      _setReadNotificationPort(port);
+  void _setReadNotificationPort(SendPort port)
+      native 'SharedMessageChannelHandle_setReadNotificationPort';
 }
@@ -4,45 +4,99 @@
 
 #include "flutter/lib/ui/isolate_name_server/isolate_name_server.h"
 
-namespace flutter {
+#include <thread>
 
-IsolateNameServer::IsolateNameServer() {}
+namespace flutter {
 
-IsolateNameServer::~IsolateNameServer() = default;
+IsolateNameServer::IsolateNameServer()
+    : port_mapping_(new PortMapping()) {}
 
-Dart_Port IsolateNameServer::LookupIsolatePortByName(const std::string& name) {
-  std::scoped_lock lock(mutex_);
-  return LookupIsolatePortByNameUnprotected(name);
+IsolateNameServer::~IsolateNameServer() {
+  delete port_mapping_.load();
 }
 
-Dart_Port IsolateNameServer::LookupIsolatePortByNameUnprotected(
-    const std::string& name) {
-  auto port_iterator = port_mapping_.find(name);
-  if (port_iterator != port_mapping_.end()) {
-    return port_iterator->second;
-  }
-  return ILLEGAL_PORT;
+// A lookup announces itself in the current epoch before reading the snapshot
+// so that a writer replacing the snapshot knows to wait for it.
+Dart_Port IsolateNameServer::LookupIsolatePortByName(
+    const std::string& name) const {
+  std::atomic_size_t& readers = readers_[reader_epoch_.load() % 2].count;
+  readers.fetch_add(1);
+
+  const PortMapping* port_mapping = port_mapping_.load();
+  auto port_iterator = port_mapping->find(name);
+  const Dart_Port port = port_iterator != port_mapping->end()
+                             ? port_iterator->second
+                             : ILLEGAL_PORT;
+
+  readers.fetch_sub(1);
+  return port;
 }
 
 bool IsolateNameServer::RegisterIsolatePortWithName(Dart_Port port,
                                                     const std::string& name) {
   std::scoped_lock lock(mutex_);
-  if (LookupIsolatePortByNameUnprotected(name) != ILLEGAL_PORT) {
+  const PortMapping& current = *port_mapping_.load();
+  if (current.count(name) != 0) {
     // Name is already registered.
     return false;
   }
-  port_mapping_[name] = port;
+  auto port_mapping = std::make_unique<PortMapping>(current);
+  (*port_mapping)[name] = port;
+  PublishPortMapping(std::move(port_mapping));
   return true;
 }
 
 bool IsolateNameServer::RemoveIsolateNameMapping(const std::string& name) {
   std::scoped_lock lock(mutex_);
-  auto port_iterator = port_mapping_.find(name);
-  if (port_iterator == port_mapping_.end()) {
+  const PortMapping& current = *port_mapping_.load();
+  if (current.count(name) == 0) {
     return false;
   }
-  port_mapping_.erase(port_iterator);
+  auto port_mapping = std::make_unique<PortMapping>(current);
+  port_mapping->erase(name);
+  PublishPortMapping(std::move(port_mapping));
   return true;
 }
 
+std::shared_ptr<SharedMessageChannel>
+IsolateNameServer::OpenSharedMessageChannel(const std::string& name,
+                                            size_t capacity) {
+  std::scoped_lock lock(mutex_);
+  auto found = shared_message_channels_.find(name);
+  if (found != shared_message_channels_.end()) {
+    return found->second;
+  }
+  auto channel = SharedMessageChannel::Create(capacity);
+  if (channel) {
+    shared_message_channels_[name] = channel;
+  }
+  return channel;
+}
+
+bool IsolateNameServer::RemoveSharedMessageChannel(const std::string& name) {
+  std::scoped_lock lock(mutex_);
+  return shared_message_channels_.erase(name) != 0;
+}
+
+void IsolateNameServer::PublishPortMapping(
+    std::unique_ptr<const PortMapping> port_mapping) {
+  std::unique_ptr<const PortMapping> previous(
+      port_mapping_.exchange(port_mapping.release()));
+  WaitForReaders();
+}
+
+// Any lookup that could still be reading the previous snapshot announced
+// itself before the exchange, in one of the two epochs. Advancing the epoch
+// before waiting on each count sends new lookups to the other count, so the
+// wait only covers lookups that were already in progress.
+void IsolateNameServer::WaitForReaders() {
+  for (size_t i = 0; i < 2; i++) {
+    const size_t epoch = reader_epoch_.fetch_add(1);
+    const std::atomic_size_t& readers = readers_[epoch % 2].count;
+    while (readers.load() != 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
 }  // namespace flutter
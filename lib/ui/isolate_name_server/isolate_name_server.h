@@ -5,16 +5,25 @@
 #ifndef FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_H_
 #define FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_H_
 
-#include <map>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/synchronization/thread_annotations.h"
+#include "flutter/lib/ui/isolate_name_server/shared_message_channel.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 
 namespace flutter {
 
+// Maps names to ports for every isolate in the VM.
+//
+// Lookups are far more frequent than registrations, so the mapping is an
+// immutable snapshot that lookups read without taking a lock. Registrations
+// and removals are serialized, publish a new snapshot and wait for the lookups
+// still reading the old one before freeing it.
 class IsolateNameServer {
  public:
   IsolateNameServer();
@@ -22,9 +31,8 @@ class IsolateNameServer {
   ~IsolateNameServer();
 
   // Looks up the Dart_Port associated with a given name. Returns ILLEGAL_PORT
-  // if the name does not exist.
-  Dart_Port LookupIsolatePortByName(const std::string& name)
-      FML_LOCKS_EXCLUDED(mutex_);
+  // if the name does not exist. Never blocks.
+  Dart_Port LookupIsolatePortByName(const std::string& name) const;
 
   // Registers a Dart_Port with a given name. Returns true if registration is
   // successful, false if the name entry already exists.
@@ -36,12 +44,41 @@ class IsolateNameServer {
   bool RemoveIsolateNameMapping(const std::string& name)
       FML_LOCKS_EXCLUDED(mutex_);
 
+  // Returns the shared message channel registered with the given name. If
+  // there is none, registers a new one with the given capacity in bytes, or
+  // returns nullptr if the capacity is larger than
+  // |SharedMessageChannel::kMaxCapacity|.
+  // Channels are opened once per endpoint, so this takes a lock.
+  std::shared_ptr<SharedMessageChannel> OpenSharedMessageChannel(
+      const std::string& name,
+      size_t capacity) FML_LOCKS_EXCLUDED(mutex_);
+
+  // Removes the shared message channel with the given name. Endpoints that
+  // already opened it keep using it. Returns false if there is no such
+  // channel.
+  bool RemoveSharedMessageChannel(const std::string& name)
+      FML_LOCKS_EXCLUDED(mutex_);
+
  private:
-  Dart_Port LookupIsolatePortByNameUnprotected(const std::string& name)
+  using PortMapping = std::unordered_map<std::string, Dart_Port>;
+
+  // The number of lookups in progress that started in a given epoch. Kept on
+  // separate cache lines so that readers of the two epochs do not contend.
+  struct alignas(64) ReaderCount {
+    std::atomic_size_t count = {0};
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<SharedMessageChannel>>
+      shared_message_channels_ FML_GUARDED_BY(mutex_);
+  std::atomic<const PortMapping*> port_mapping_;
+  std::atomic_size_t reader_epoch_ = {0};
+  mutable ReaderCount readers_[2];
+
+  void PublishPortMapping(std::unique_ptr<const PortMapping> port_mapping)
       FML_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
-  mutable std::mutex mutex_;
-  std::map<std::string, Dart_Port> port_mapping_ FML_GUARDED_BY(mutex_);
+  void WaitForReaders() FML_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   FML_DISALLOW_COPY_AND_ASSIGN(IsolateNameServer);
 };
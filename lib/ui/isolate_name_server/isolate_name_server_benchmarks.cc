@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/lib/ui/isolate_name_server/isolate_name_server.h"
+
+namespace flutter {
+
+static constexpr size_t kRegisteredPortCount = 64;
+
+static std::unique_ptr<IsolateNameServer> g_name_server;
+
+static std::string GetPortName(size_t index) {
+  return "background_isolate_" + std::to_string(index);
+}
+
+// Every thread looks up ports like isolates fanning out messages would. When
+// |churn| is set, the first thread also registers and removes a port every few
+// lookups, like isolates being spawned and shut down.
+static void LookupPortsConcurrently(benchmark::State& state, bool churn) {
+  if (state.thread_index == 0) {
+    g_name_server = std::make_unique<IsolateNameServer>();
+    for (size_t i = 0; i < kRegisteredPortCount; i++) {
+      FML_CHECK(g_name_server->RegisterIsolatePortWithName(i + 1,
+                                                           GetPortName(i)));
+    }
+  }
+
+  std::string names[kRegisteredPortCount];
+  for (size_t i = 0; i < kRegisteredPortCount; i++) {
+    names[i] = GetPortName(i);
+  }
+  const std::string churn_name =
+      "transient_isolate_" + std::to_string(state.thread_index);
+
+  size_t lookups = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(g_name_server->LookupIsolatePortByName(
+        names[lookups % kRegisteredPortCount]));
+    lookups++;
+    if (churn && state.thread_index == 0 && lookups % 1024 == 0) {
+      g_name_server->RegisterIsolatePortWithName(lookups, churn_name);
+      g_name_server->RemoveIsolateNameMapping(churn_name);
+    }
+  }
+  state.SetItemsProcessed(lookups);
+
+  if (state.thread_index == 0) {
+    g_name_server.reset();
+  }
+}
+
+static void BM_IsolateNameServerLookup(benchmark::State& state) {
+  LookupPortsConcurrently(state, false);
+}
+
+static void BM_IsolateNameServerLookupWithRegistrations(
+    benchmark::State& state) {
+  LookupPortsConcurrently(state, true);
+}
+
+BENCHMARK(BM_IsolateNameServerLookup)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_IsolateNameServerLookupWithRegistrations)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+}  // namespace flutter
@@ -52,10 +52,23 @@ Dart_Handle IsolateNameServerNatives::RemovePortNameMapping(
   return Dart_True();
 }
 
-#define FOR_EACH_BINDING(V)                         \
-  V(IsolateNameServerNatives, LookupPortByName)     \
-  V(IsolateNameServerNatives, RegisterPortWithName) \
-  V(IsolateNameServerNatives, RemovePortNameMapping)
+Dart_Handle IsolateNameServerNatives::RemoveSharedMessageChannel(
+    const std::string& name) {
+  auto name_server = UIDartState::Current()->GetIsolateNameServer();
+  if (!name_server) {
+    return Dart_False();
+  }
+  if (!name_server->RemoveSharedMessageChannel(name)) {
+    return Dart_False();
+  }
+  return Dart_True();
+}
+
+#define FOR_EACH_BINDING(V)                          \
+  V(IsolateNameServerNatives, LookupPortByName)      \
+  V(IsolateNameServerNatives, RegisterPortWithName)  \
+  V(IsolateNameServerNatives, RemovePortNameMapping) \
+  V(IsolateNameServerNatives, RemoveSharedMessageChannel)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK_STATIC)
 
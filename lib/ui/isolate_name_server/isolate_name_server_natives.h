@@ -20,6 +20,7 @@ class IsolateNameServerNatives {
   static Dart_Handle RegisterPortWithName(Dart_Handle port_handle,
                                           const std::string& name);
   static Dart_Handle RemovePortNameMapping(const std::string& name);
+  static Dart_Handle RemoveSharedMessageChannel(const std::string& name);
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 };
 
@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/lib/ui/isolate_name_server/isolate_name_server.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(IsolateNameServerTest, RegistersLooksUpAndRemovesPorts) {
+  IsolateNameServer server;
+  ASSERT_EQ(server.LookupIsolatePortByName("a"), ILLEGAL_PORT);
+
+  ASSERT_TRUE(server.RegisterIsolatePortWithName(1, "a"));
+  ASSERT_TRUE(server.RegisterIsolatePortWithName(2, "b"));
+  ASSERT_EQ(server.LookupIsolatePortByName("a"), 1);
+  ASSERT_EQ(server.LookupIsolatePortByName("b"), 2);
+
+  // Names are not replaced while they are registered.
+  ASSERT_FALSE(server.RegisterIsolatePortWithName(3, "a"));
+  ASSERT_EQ(server.LookupIsolatePortByName("a"), 1);
+
+  ASSERT_TRUE(server.RemoveIsolateNameMapping("a"));
+  ASSERT_FALSE(server.RemoveIsolateNameMapping("a"));
+  ASSERT_EQ(server.LookupIsolatePortByName("a"), ILLEGAL_PORT);
+  ASSERT_EQ(server.LookupIsolatePortByName("b"), 2);
+
+  ASSERT_TRUE(server.RegisterIsolatePortWithName(3, "a"));
+  ASSERT_EQ(server.LookupIsolatePortByName("a"), 3);
+}
+
+TEST(IsolateNameServerTest, LookupsRacingRemovalsSeeWholeSnapshots) {
+  IsolateNameServer server;
+  static constexpr Dart_Port kStablePort = 7;
+  static constexpr Dart_Port kChangingPort = 11;
+  static constexpr size_t kReaderCount = 4;
+  static constexpr size_t kIterations = 2000;
+  ASSERT_TRUE(server.RegisterIsolatePortWithName(kStablePort, "stable"));
+
+  std::atomic_bool done = {false};
+  std::atomic_size_t unexpected_lookups = {0};
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < kReaderCount; i++) {
+    readers.emplace_back([&]() {
+      while (!done.load()) {
+        // Every snapshot has the stable name, and the changing one is either
+        // registered with its port or absent.
+        const Dart_Port changing = server.LookupIsolatePortByName("changing");
+        if (server.LookupIsolatePortByName("stable") != kStablePort ||
+            (changing != ILLEGAL_PORT && changing != kChangingPort)) {
+          unexpected_lookups.fetch_add(1);
+        }
+      }
+    });
+  }
+
+  for (size_t i = 0; i < kIterations; i++) {
+    EXPECT_TRUE(server.RegisterIsolatePortWithName(kChangingPort, "changing"));
+    EXPECT_TRUE(server.RemoveIsolateNameMapping("changing"));
+  }
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(unexpected_lookups.load(), 0u);
+  ASSERT_EQ(server.LookupIsolatePortByName("changing"), ILLEGAL_PORT);
+  ASSERT_EQ(server.LookupIsolatePortByName("stable"), kStablePort);
+}
+
+}  // namespace testing
+}  // namespace flutter
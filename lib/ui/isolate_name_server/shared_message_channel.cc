@@ -0,0 +1,167 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/isolate_name_server/shared_message_channel.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// Each message is a header followed by its bytes, padded so that the next
+// header is aligned. A message never wraps around the end of the buffer.
+// Instead, the space up to the end is skipped and marked with
+// |kSkipToStart|.
+namespace {
+
+using MessageHeader = uint32_t;
+
+constexpr size_t kMessageAlignment = 8;
+constexpr MessageHeader kSkipToStart = ~MessageHeader{0};
+
+// The size of every message that fits in a channel must fit in its header.
+static_assert(SharedMessageChannel::kMaxCapacity / 2 < kSkipToStart,
+              "Message sizes must be representable in a message header.");
+
+size_t AlignUp(size_t value) {
+  return (value + kMessageAlignment - 1) & ~(kMessageAlignment - 1);
+}
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+std::shared_ptr<SharedMessageChannel> SharedMessageChannel::Create(
+    size_t capacity) {
+  if (capacity > kMaxCapacity) {
+    return nullptr;
+  }
+  // The capacity is a power of two so that offsets can be masked.
+  capacity = RoundUpToPowerOfTwo(std::max<size_t>(capacity, 64));
+  return std::shared_ptr<SharedMessageChannel>(
+      new SharedMessageChannel(capacity));
+}
+
+SharedMessageChannel::SharedMessageChannel(size_t capacity)
+    : capacity_(capacity), buffer_(new uint8_t[capacity]) {}
+
+SharedMessageChannel::~SharedMessageChannel() = default;
+
+size_t SharedMessageChannel::GetMaxMessageSize() const {
+  return capacity_ / 2 - sizeof(MessageHeader);
+}
+
+bool SharedMessageChannel::ClaimWriter() {
+  return !writer_claimed_.exchange(true);
+}
+
+void SharedMessageChannel::ReleaseWriter() {
+  writer_claimed_.store(false);
+}
+
+bool SharedMessageChannel::ClaimReader() {
+  return !reader_claimed_.exchange(true);
+}
+
+void SharedMessageChannel::ReleaseReader() {
+  reader_claimed_.store(false);
+}
+
+bool SharedMessageChannel::Write(const uint8_t* data, size_t size) {
+  if (size > GetMaxMessageSize()) {
+    return false;
+  }
+
+  const size_t record_size = AlignUp(sizeof(MessageHeader) + size);
+  size_t write_offset = write_offset_.load(std::memory_order_relaxed);
+  const size_t read_offset = read_offset_.load(std::memory_order_acquire);
+
+  const size_t position = write_offset & (capacity_ - 1);
+  const size_t space_to_end = capacity_ - position;
+  const size_t needed =
+      record_size <= space_to_end ? record_size : space_to_end + record_size;
+  if (write_offset - read_offset + needed > capacity_) {
+    return false;
+  }
+
+  if (record_size > space_to_end) {
+    std::memcpy(buffer_.get() + position, &kSkipToStart, sizeof(MessageHeader));
+    write_offset += space_to_end;
+  }
+
+  uint8_t* record = buffer_.get() + (write_offset & (capacity_ - 1));
+  const MessageHeader header = static_cast<MessageHeader>(size);
+  std::memcpy(record, &header, sizeof(header));
+  if (size > 0) {
+    std::memcpy(record + sizeof(header), data, size);
+  }
+  write_offset_.store(write_offset + record_size, std::memory_order_release);
+
+  // Pairs with the reader announcing that it is waiting before it checks for
+  // messages one last time, so that either the reader sees this message or
+  // this writer sees the reader waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (reader_waiting_.load(std::memory_order_relaxed) &&
+      reader_waiting_.exchange(false)) {
+    const Dart_Port port = notification_port_.load();
+    if (port != ILLEGAL_PORT) {
+      Dart_PostInteger(port, size);
+    }
+  }
+  return true;
+}
+
+bool SharedMessageChannel::Read(const MessageReader& reader) {
+  size_t read_offset = read_offset_.load(std::memory_order_relaxed);
+  size_t write_offset = write_offset_.load(std::memory_order_acquire);
+
+  if (read_offset == write_offset) {
+    reader_waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    write_offset = write_offset_.load(std::memory_order_acquire);
+    if (read_offset == write_offset) {
+      return false;
+    }
+  }
+
+  size_t position = read_offset & (capacity_ - 1);
+  MessageHeader header;
+  std::memcpy(&header, buffer_.get() + position, sizeof(header));
+  if (header == kSkipToStart) {
+    read_offset += capacity_ - position;
+    position = 0;
+    std::memcpy(&header, buffer_.get(), sizeof(header));
+  }
+
+  // The header is only trusted once the whole record is known to lie in
+  // bytes the writer has published, without wrapping around the buffer.
+  // Writers racing each other can leave anything in the buffer.
+  const size_t available = write_offset - read_offset;
+  const size_t record_size = AlignUp(sizeof(header) + header);
+  if (available > capacity_ || header > GetMaxMessageSize() ||
+      record_size > available || record_size > capacity_ - position) {
+    FML_LOG(ERROR) << "Malformed message in SharedMessageChannel.";
+    return false;
+  }
+
+  const uint8_t* record = buffer_.get() + position;
+  reader(record + sizeof(header), header);
+
+  read_offset_.store(read_offset + record_size, std::memory_order_release);
+  return true;
+}
+
+void SharedMessageChannel::SetReadNotificationPort(Dart_Port port) {
+  notification_port_.store(port);
+}
+
+}  // namespace flutter
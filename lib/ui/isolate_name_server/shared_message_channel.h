@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_SHARED_MESSAGE_CHANNEL_H_
+#define FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_SHARED_MESSAGE_CHANNEL_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace flutter {
+
+// A bounded queue of byte messages in memory shared by one writer and one
+// reader, which may be any combination of isolates and host threads.
+//
+// Messages are copied once into a ring buffer and read in place, without
+// locks or thread hops. Writing never blocks: a full channel rejects the
+// message and the writer decides whether to drop or retry it. Channels are
+// found by name through |IsolateNameServer|.
+class SharedMessageChannel {
+ public:
+  // The largest capacity of a channel, in bytes.
+  static constexpr size_t kMaxCapacity = size_t{1} << 30;
+
+  // The capacity is rounded up to a power of two. The largest message is half
+  // the capacity so that a message can always be written once the channel has
+  // been drained. Returns nullptr if |capacity| is larger than |kMaxCapacity|.
+  static std::shared_ptr<SharedMessageChannel> Create(size_t capacity);
+
+  ~SharedMessageChannel();
+
+  size_t GetCapacity() const { return capacity_; }
+
+  size_t GetMaxMessageSize() const;
+
+  // A channel has at most one writer and one reader at a time. An endpoint
+  // claims a side before it writes or reads, and releases it when it is done
+  // with the channel. Returns false if the side is already claimed.
+  bool ClaimWriter();
+  void ReleaseWriter();
+  bool ClaimReader();
+  void ReleaseReader();
+
+  // Must only be called by the writer. Returns false if the message is too
+  // large or the channel does not have room for it.
+  bool Write(const uint8_t* data, size_t size);
+
+  using MessageReader = std::function<void(const uint8_t* data, size_t size)>;
+
+  // Must only be called by the reader. Hands the oldest message to |reader|,
+  // which may only access it for the duration of the call, and removes it.
+  // Returns false if the channel is empty, or if the oldest message is
+  // malformed because the channel was misused by several writers.
+  bool Read(const MessageReader& reader);
+
+  // When the reader finds the channel empty, the next write posts the size
+  // of its message to |port|. This lets an isolate sleep until there is data
+  // instead of polling. Pass ILLEGAL_PORT to stop notifications.
+  void SetReadNotificationPort(Dart_Port port);
+
+ private:
+  const size_t capacity_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  // Monotonically increasing byte offsets. Each is only written by one side
+  // and kept on its own cache line.
+  alignas(64) std::atomic_size_t write_offset_ = {0};
+  alignas(64) std::atomic_size_t read_offset_ = {0};
+  alignas(64) std::atomic_bool reader_waiting_ = {false};
+  std::atomic<Dart_Port> notification_port_ = {ILLEGAL_PORT};
+  std::atomic_bool writer_claimed_ = {false};
+  std::atomic_bool reader_claimed_ = {false};
+
+  explicit SharedMessageChannel(size_t capacity);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedMessageChannel);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_SHARED_MESSAGE_CHANNEL_H_
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/lib/ui/isolate_name_server/shared_message_channel.h"
+#include "flutter/lib/ui/window/platform_message.h"
+
+namespace flutter {
+
+// Streams messages from a background isolate to the platform the way
+// platform messages travel today: copied into a |PlatformMessage| and posted
+// from the background thread to the UI thread and on to the platform thread.
+static void BM_PlatformMessageHopThroughput(benchmark::State& state) {
+  fml::Thread ui_thread("ui");
+  fml::Thread platform_thread("platform");
+  auto ui_task_runner = ui_thread.GetTaskRunner();
+  auto platform_task_runner = platform_thread.GetTaskRunner();
+
+  const std::vector<uint8_t> payload(state.range(0), 0x42);
+  std::atomic_size_t received = {0};
+  size_t sent = 0;
+  while (state.KeepRunning()) {
+    auto message = fml::MakeRefCounted<PlatformMessage>(
+        "flutter/stream", std::vector<uint8_t>(payload), nullptr);
+    ui_task_runner->PostTask([message, platform_task_runner, &received]() {
+      platform_task_runner->PostTask([message, &received]() {
+        benchmark::DoNotOptimize(message->data().data());
+        received.fetch_add(1, std::memory_order_relaxed);
+      });
+    });
+    sent++;
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  ui_task_runner->PostTask([&]() {
+    platform_task_runner->PostTask([&latch]() { latch.Signal(); });
+  });
+  latch.Wait();
+  FML_CHECK(received.load() == sent);
+  state.SetBytesProcessed(sent * payload.size());
+}
+
+// Streams the same messages through a |SharedMessageChannel| read by the
+// platform thread directly.
+static void BM_SharedMessageChannelThroughput(benchmark::State& state) {
+  auto channel = SharedMessageChannel::Create(256 * 1024);
+  const std::vector<uint8_t> payload(state.range(0), 0x42);
+
+  std::atomic_bool done = {false};
+  size_t received = 0;
+  std::thread platform_thread([&]() {
+    auto reader = [&received](const uint8_t* data, size_t) {
+      benchmark::DoNotOptimize(data);
+      received++;
+    };
+    while (true) {
+      if (channel->Read(reader)) {
+        continue;
+      }
+      if (done.load(std::memory_order_acquire)) {
+        // The writer finished before this read, so this drains the rest.
+        while (channel->Read(reader)) {
+        }
+        break;
+      }
+      std::this_thread::yield();
+    }
+  });
+
+  size_t sent = 0;
+  while (state.KeepRunning()) {
+    while (!channel->Write(payload.data(), payload.size())) {
+      std::this_thread::yield();
+    }
+    sent++;
+  }
+
+  done.store(true, std::memory_order_release);
+  platform_thread.join();
+  FML_CHECK(received == sent);
+  state.SetBytesProcessed(sent * payload.size());
+}
+
+BENCHMARK(BM_PlatformMessageHopThroughput)
+    ->RangeMultiplier(8)
+    ->Range(64, 32 * 1024)
+    ->UseRealTime();
+BENCHMARK(BM_SharedMessageChannelThroughput)
+    ->RangeMultiplier(8)
+    ->Range(64, 32 * 1024)
+    ->UseRealTime();
+
+}  // namespace flutter
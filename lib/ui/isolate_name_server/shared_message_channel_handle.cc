@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/isolate_name_server/shared_message_channel_handle.h"
+
+#include <cstring>
+#include <string>
+
+#include "flutter/lib/ui/isolate_name_server/isolate_name_server.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/dart_args.h"
+#include "third_party/tonic/dart_binding_macros.h"
+#include "third_party/tonic/dart_library_natives.h"
+
+namespace flutter {
+
+static void ThrowError(const char* type, const std::string& message) {
+  Dart_Handle error_type =
+      Dart_GetType(Dart_LookupLibrary(tonic::ToDart("dart:core")),
+                   tonic::ToDart(type), 0, nullptr);
+  Dart_Handle arguments[] = {tonic::ToDart(message)};
+  Dart_ThrowException(Dart_New(error_type, Dart_Null(), 1, arguments));
+}
+
+static void SharedMessageChannel_constructor(Dart_NativeArguments args) {
+  DartCallConstructor(&SharedMessageChannelHandle::Create, args);
+}
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, SharedMessageChannelHandle);
+
+#define FOR_EACH_BINDING(V)                              \
+  V(SharedMessageChannelHandle, send)                    \
+  V(SharedMessageChannelHandle, receive)                 \
+  V(SharedMessageChannelHandle, setReadNotificationPort) \
+  V(SharedMessageChannelHandle, getMaxMessageSize)
+
+FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
+
+void SharedMessageChannelHandle::RegisterNatives(
+    tonic::DartLibraryNatives* natives) {
+  natives->Register({{"SharedMessageChannel_constructor",
+                      SharedMessageChannel_constructor, 3, true},
+                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+}
+
+fml::RefPtr<SharedMessageChannelHandle> SharedMessageChannelHandle::Create(
+    std::string name,
+    int64_t capacity) {
+  if (capacity <= 0 ||
+      static_cast<uint64_t>(capacity) > SharedMessageChannel::kMaxCapacity) {
+    ThrowError("ArgumentError",
+               "SharedMessageChannel capacity must be between 1 and " +
+                   std::to_string(SharedMessageChannel::kMaxCapacity) +
+                   " bytes, but was " + std::to_string(capacity) + ".");
+    return nullptr;
+  }
+  auto name_server = UIDartState::Current()->GetIsolateNameServer();
+  // Without a name server the channel cannot be shared, but it still works
+  // within the isolate.
+  auto channel = name_server
+                     ? name_server->OpenSharedMessageChannel(name, capacity)
+                     : SharedMessageChannel::Create(capacity);
+  return fml::MakeRefCounted<SharedMessageChannelHandle>(std::move(channel));
+}
+
+SharedMessageChannelHandle::SharedMessageChannelHandle(
+    std::shared_ptr<SharedMessageChannel> channel)
+    : channel_(std::move(channel)) {}
+
+SharedMessageChannelHandle::~SharedMessageChannelHandle() {
+  if (is_writer_) {
+    channel_->ReleaseWriter();
+  }
+  if (is_reader_) {
+    channel_->ReleaseReader();
+  }
+}
+
+bool SharedMessageChannelHandle::ClaimWriter() {
+  if (is_writer_) {
+    return true;
+  }
+  if (!channel_->ClaimWriter()) {
+    ThrowError("StateError", "SharedMessageChannel already has a sender.");
+    return false;
+  }
+  is_writer_ = true;
+  return true;
+}
+
+bool SharedMessageChannelHandle::ClaimReader() {
+  if (is_reader_) {
+    return true;
+  }
+  if (!channel_->ClaimReader()) {
+    ThrowError("StateError", "SharedMessageChannel already has a receiver.");
+    return false;
+  }
+  is_reader_ = true;
+  return true;
+}
+
+bool SharedMessageChannelHandle::send(const tonic::DartByteData& message) {
+  if (!ClaimWriter()) {
+    return false;
+  }
+  if (message.length_in_bytes() > channel_->GetMaxMessageSize()) {
+    ThrowError("ArgumentError",
+               "SharedMessageChannel messages must be at most " +
+                   std::to_string(channel_->GetMaxMessageSize()) +
+                   " bytes, but was " +
+                   std::to_string(message.length_in_bytes()) + ".");
+    return false;
+  }
+  return channel_->Write(static_cast<const uint8_t*>(message.data()),
+                         message.length_in_bytes());
+}
+
+Dart_Handle SharedMessageChannelHandle::receive() {
+  if (!ClaimReader()) {
+    return Dart_Null();
+  }
+  Dart_Handle result = Dart_Null();
+  channel_->Read([&result](const uint8_t* data, size_t size) {
+    result = Dart_NewTypedData(Dart_TypedData_kByteData, size);
+    if (Dart_IsError(result) || size == 0) {
+      return;
+    }
+    Dart_TypedData_Type type;
+    void* bytes = nullptr;
+    intptr_t num_bytes = 0;
+    FML_CHECK(!Dart_IsError(
+        Dart_TypedDataAcquireData(result, &type, &bytes, &num_bytes)));
+    std::memcpy(bytes, data, num_bytes);
+    Dart_TypedDataReleaseData(result);
+  });
+  return result;
+}
+
+void SharedMessageChannelHandle::setReadNotificationPort(
+    Dart_Handle send_port) {
+  if (!ClaimReader()) {
+    return;
+  }
+  Dart_Port port = ILLEGAL_PORT;
+  if (!Dart_IsNull(send_port)) {
+    Dart_SendPortGetId(send_port, &port);
+  }
+  channel_->SetReadNotificationPort(port);
+}
+
+int SharedMessageChannelHandle::getMaxMessageSize() {
+  return channel_->GetMaxMessageSize();
+}
+
+}  // namespace flutter
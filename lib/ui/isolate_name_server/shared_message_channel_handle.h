@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_SHARED_MESSAGE_CHANNEL_HANDLE_H_
+#define FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_SHARED_MESSAGE_CHANNEL_HANDLE_H_
+
+#include <memory>
+#include <string>
+
+#include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/isolate_name_server/shared_message_channel.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
+
+namespace tonic {
+class DartLibraryNatives;
+}  // namespace tonic
+
+namespace flutter {
+
+// The Dart object for one endpoint of a |SharedMessageChannel|. The endpoint
+// becomes the writer of the channel the first time it sends and the reader
+// the first time it receives, and gives up both when it is collected.
+class SharedMessageChannelHandle
+    : public RefCountedDartWrappable<SharedMessageChannelHandle> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(SharedMessageChannelHandle);
+
+ public:
+  ~SharedMessageChannelHandle() override;
+
+  static fml::RefPtr<SharedMessageChannelHandle> Create(std::string name,
+                                                        int64_t capacity);
+
+  bool send(const tonic::DartByteData& message);
+
+  Dart_Handle receive();
+
+  void setReadNotificationPort(Dart_Handle send_port);
+
+  int getMaxMessageSize();
+
+  static void RegisterNatives(tonic::DartLibraryNatives* natives);
+
+ private:
+  std::shared_ptr<SharedMessageChannel> channel_;
+  bool is_writer_ = false;
+  bool is_reader_ = false;
+
+  explicit SharedMessageChannelHandle(
+      std::shared_ptr<SharedMessageChannel> channel);
+
+  // Throw a StateError and return false if another endpoint holds the side.
+  bool ClaimWriter();
+  bool ClaimReader();
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_SHARED_MESSAGE_CHANNEL_HANDLE_H_
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "flutter/lib/ui/isolate_name_server/isolate_name_server.h"
+#include "flutter/lib/ui/isolate_name_server/shared_message_channel.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static std::vector<uint8_t> ReadMessage(SharedMessageChannel& channel) {
+  std::vector<uint8_t> message;
+  EXPECT_TRUE(channel.Read([&message](const uint8_t* data, size_t size) {
+    message.assign(data, data + size);
+  }));
+  return message;
+}
+
+TEST(SharedMessageChannelTest, MessagesAreReadInOrderAcrossTheWrap) {
+  auto channel = SharedMessageChannel::Create(256);
+  ASSERT_EQ(channel->GetCapacity(), 256u);
+
+  // Messages of a size that does not divide the capacity eventually have to
+  // skip the end of the buffer.
+  for (uint8_t i = 0; i < 100; i++) {
+    std::vector<uint8_t> message(37, i);
+    ASSERT_TRUE(channel->Write(message.data(), message.size()));
+    ASSERT_EQ(ReadMessage(*channel), message);
+  }
+  ASSERT_FALSE(channel->Read([](const uint8_t*, size_t) {}));
+}
+
+TEST(SharedMessageChannelTest, RejectsMessagesThatDoNotFit) {
+  auto channel = SharedMessageChannel::Create(256);
+
+  std::vector<uint8_t> too_large(channel->GetMaxMessageSize() + 1);
+  ASSERT_FALSE(channel->Write(too_large.data(), too_large.size()));
+
+  std::vector<uint8_t> largest(channel->GetMaxMessageSize(), 7);
+  ASSERT_TRUE(channel->Write(largest.data(), largest.size()));
+  ASSERT_TRUE(channel->Write(largest.data(), largest.size()));
+  ASSERT_FALSE(channel->Write(largest.data(), 1));
+
+  ASSERT_EQ(ReadMessage(*channel), largest);
+  ASSERT_TRUE(channel->Write(largest.data(), 1));
+}
+
+TEST(SharedMessageChannelTest, RejectsCapacitiesThatAreTooLarge) {
+  ASSERT_FALSE(
+      SharedMessageChannel::Create(SharedMessageChannel::kMaxCapacity + 1));
+  ASSERT_FALSE(SharedMessageChannel::Create(SIZE_MAX));
+
+  IsolateNameServer name_server;
+  ASSERT_FALSE(name_server.OpenSharedMessageChannel(
+      "sensors", SharedMessageChannel::kMaxCapacity + 1));
+  ASSERT_FALSE(name_server.RemoveSharedMessageChannel("sensors"));
+}
+
+TEST(SharedMessageChannelTest, StreamsBetweenThreads) {
+  auto channel = SharedMessageChannel::Create(4096);
+  constexpr uint32_t kMessageCount = 100000;
+
+  std::thread writer([channel]() {
+    for (uint32_t i = 0; i < kMessageCount;) {
+      if (channel->Write(reinterpret_cast<const uint8_t*>(&i), sizeof(i))) {
+        i++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  for (uint32_t expected = 0; expected < kMessageCount;) {
+    channel->Read([&expected](const uint8_t* data, size_t size) {
+      ASSERT_EQ(size, sizeof(expected));
+      uint32_t value;
+      memcpy(&value, data, sizeof(value));
+      ASSERT_EQ(value, expected);
+      expected++;
+    });
+  }
+  writer.join();
+}
+
+TEST(SharedMessageChannelTest, EachSideHasOneEndpointAtATime) {
+  auto channel = SharedMessageChannel::Create(256);
+
+  ASSERT_TRUE(channel->ClaimWriter());
+  ASSERT_FALSE(channel->ClaimWriter());
+  // Claiming one side does not claim the other.
+  ASSERT_TRUE(channel->ClaimReader());
+  ASSERT_FALSE(channel->ClaimReader());
+
+  channel->ReleaseWriter();
+  ASSERT_TRUE(channel->ClaimWriter());
+  ASSERT_FALSE(channel->ClaimReader());
+  channel->ReleaseReader();
+  ASSERT_TRUE(channel->ClaimReader());
+}
+
+TEST(SharedMessageChannelTest, IsFoundByName) {
+  IsolateNameServer name_server;
+  auto channel = name_server.OpenSharedMessageChannel("sensors", 1024);
+  ASSERT_EQ(name_server.OpenSharedMessageChannel("sensors", 64), channel);
+  ASSERT_NE(name_server.OpenSharedMessageChannel("audio", 1024), channel);
+
+  ASSERT_TRUE(name_server.RemoveSharedMessageChannel("sensors"));
+  ASSERT_FALSE(name_server.RemoveSharedMessageChannel("sensors"));
+  ASSERT_NE(name_server.OpenSharedMessageChannel("sensors", 1024), channel);
+}
+
+}  // namespace testing
+}  // namespace flutter
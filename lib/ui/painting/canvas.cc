@@ -8,8 +8,10 @@
 #include <math.h>
 
 #include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/lib/ui/painting/draw_batch.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/matrix.h"
+#include "flutter/lib/ui/painting/rect_instances.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/window.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -19,6 +21,7 @@
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 using tonic::ToDart;
 
@@ -58,9 +61,11 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawImageRect)          \
   V(Canvas, drawImageNine)          \
   V(Canvas, drawPicture)            \
+  V(Canvas, drawBatch)              \
   V(Canvas, drawPoints)             \
   V(Canvas, drawVertices)           \
   V(Canvas, drawAtlas)              \
+  V(Canvas, drawRectInstances)      \
   V(Canvas, drawShadow)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
@@ -350,6 +355,36 @@ void Canvas::drawPicture(Picture* picture) {
   canvas_->drawPicture(picture->picture().get());
 }
 
+// Returns false if the batch is malformed. Kept separate from
+// Canvas::drawBatch so that nothing needs destroying when that throws.
+static bool DrawBatch(SkCanvas* canvas,
+                      Dart_Handle paint_objects,
+                      Dart_Handle commands) {
+  // Unwrap all the paint objects first, as the VM cannot be entered while the
+  // commands are acquired.
+  intptr_t length = 0;
+  if (Dart_IsError(Dart_ListLength(paint_objects, &length)) ||
+      length % Paint::kObjectCount != 0)
+    return false;
+  std::vector<PaintObjects> objects(length / Paint::kObjectCount);
+  for (size_t i = 0; i < objects.size(); i++) {
+    if (!Paint::UnwrapObjects(paint_objects, i * Paint::kObjectCount,
+                              &objects[i]))
+      return false;
+  }
+
+  tonic::DartByteData data(commands);
+  return ReplayDrawBatch(canvas, static_cast<const uint32_t*>(data.data()),
+                         data.length_in_bytes() / sizeof(uint32_t), objects);
+}
+
+void Canvas::drawBatch(Dart_Handle paint_objects, Dart_Handle commands) {
+  if (!canvas_)
+    return;
+  if (!DrawBatch(canvas_, paint_objects, commands))
+    Dart_ThrowException(ToDart("Canvas.drawBatch called with malformed data."));
+}
+
 void Canvas::drawPoints(const Paint& paint,
                         const PaintData& paint_data,
                         SkCanvas::PointMode point_mode,
@@ -410,6 +445,27 @@ void Canvas::drawAtlas(const Paint& paint,
       paint.paint());
 }
 
+void Canvas::drawRectInstances(const Paint& paint,
+                               const PaintData& paint_data,
+                               const tonic::Float32List& positions,
+                               const tonic::Float32List& sizes,
+                               const tonic::Int32List& colors,
+                               const tonic::Float32List& transforms) {
+  if (!canvas_)
+    return;
+
+  // The lengths are checked in painting.dart.
+  const size_t count = colors.num_elements();
+  FML_DCHECK(positions.num_elements() == 2 * count);
+  FML_DCHECK(sizes.num_elements() == 2 * count);
+  FML_DCHECK(!transforms.data() || transforms.num_elements() == 4 * count);
+
+  DrawRectInstances(canvas_, *paint.paint(), count, positions.data(),
+                    sizes.data(),
+                    reinterpret_cast<const SkColor*>(colors.data()),
+                    transforms.data());
+}
+
 void Canvas::drawShadow(const CanvasPath* path,
                         SkColor color,
                         double elevation,
@@ -135,6 +135,10 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                      const PaintData& paint_data);
   void drawPicture(Picture* picture);
 
+  // The commands are in the format of |DrawBatchOp|, and |paint_objects| is
+  // the concatenated objects of the paints they set.
+  void drawBatch(Dart_Handle paint_objects, Dart_Handle commands);
+
   // The paint argument is first for the following functions because Paint
   // unwraps a number of C++ objects. Once we create a view unto a
   // Float32List, we cannot re-enter the VM to unwrap objects. That means we
@@ -159,6 +163,13 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                  SkBlendMode blend_mode,
                  const tonic::Float32List& cull_rect);
 
+  void drawRectInstances(const Paint& paint,
+                         const PaintData& paint_data,
+                         const tonic::Float32List& positions,
+                         const tonic::Float32List& sizes,
+                         const tonic::Int32List& colors,
+                         const tonic::Float32List& transforms);
+
   void drawShadow(const CanvasPath* path,
                   SkColor color,
                   double elevation,
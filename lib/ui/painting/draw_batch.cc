@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/draw_batch.h"
+
+#include <cstring>
+
+#include "third_party/skia/include/core/SkRRect.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kPaintDataWordCount = Paint::kDataByteCount / 4;
+
+// The number of operand words of each opcode.
+size_t GetOperandCount(DrawBatchOp op) {
+  switch (op) {
+    case DrawBatchOp::kSetPaint:
+      return 1 + kPaintDataWordCount;
+    case DrawBatchOp::kDrawRect:
+    case DrawBatchOp::kDrawOval:
+    case DrawBatchOp::kDrawLine:
+      return 4;
+    case DrawBatchOp::kDrawRRect:
+      return 12;
+    case DrawBatchOp::kDrawCircle:
+      return 3;
+  }
+  return 0;
+}
+
+float ReadFloat(const uint32_t* word) {
+  float value;
+  std::memcpy(&value, word, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+bool ReplayDrawBatch(SkCanvas* canvas,
+                     const uint32_t* commands,
+                     size_t word_count,
+                     const std::vector<PaintObjects>& paint_objects) {
+  static const PaintObjects kNoObjects;
+
+  Paint paint;
+  size_t index = 0;
+  while (index < word_count) {
+    const DrawBatchOp op = static_cast<DrawBatchOp>(commands[index]);
+    const size_t operand_count = GetOperandCount(op);
+    if (operand_count == 0 || word_count - index - 1 < operand_count) {
+      return false;
+    }
+    const uint32_t* operands = commands + index + 1;
+    index += 1 + operand_count;
+
+    if (op == DrawBatchOp::kSetPaint) {
+      const int32_t objects_index = static_cast<int32_t>(operands[0]);
+      if (objects_index >= static_cast<int64_t>(paint_objects.size())) {
+        return false;
+      }
+      paint = Paint(
+          objects_index < 0 ? kNoObjects : paint_objects[objects_index],
+          operands + 1);
+      continue;
+    }
+
+    const SkPaint* sk_paint = paint.paint();
+    if (!sk_paint) {
+      return false;
+    }
+
+    float values[12];
+    for (size_t i = 0; i < operand_count; i++) {
+      values[i] = ReadFloat(operands + i);
+    }
+
+    switch (op) {
+      case DrawBatchOp::kDrawRect:
+        canvas->drawRect(
+            SkRect::MakeLTRB(values[0], values[1], values[2], values[3]),
+            *sk_paint);
+        break;
+      case DrawBatchOp::kDrawRRect: {
+        const SkVector radii[4] = {{values[4], values[5]},
+                                   {values[6], values[7]},
+                                   {values[8], values[9]},
+                                   {values[10], values[11]}};
+        SkRRect rrect;
+        rrect.setRectRadii(
+            SkRect::MakeLTRB(values[0], values[1], values[2], values[3]),
+            radii);
+        canvas->drawRRect(rrect, *sk_paint);
+        break;
+      }
+      case DrawBatchOp::kDrawOval:
+        canvas->drawOval(
+            SkRect::MakeLTRB(values[0], values[1], values[2], values[3]),
+            *sk_paint);
+        break;
+      case DrawBatchOp::kDrawCircle:
+        canvas->drawCircle(values[0], values[1], values[2], *sk_paint);
+        break;
+      case DrawBatchOp::kDrawLine:
+        canvas->drawLine(values[0], values[1], values[2], values[3],
+                         *sk_paint);
+        break;
+      case DrawBatchOp::kSetPaint:
+        break;
+    }
+  }
+  return true;
+}
+
+}  // namespace flutter
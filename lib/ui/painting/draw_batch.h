@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DRAW_BATCH_H_
+#define FLUTTER_LIB_UI_PAINTING_DRAW_BATCH_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/lib/ui/painting/paint.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flutter {
+
+// The commands a DrawBatch in painting.dart records. Each command is a 32-bit
+// opcode followed by its 32-bit operands, floats unless noted otherwise.
+//
+// Must be kept in sync with the DrawBatch constants in painting.dart.
+enum class DrawBatchOp : uint32_t {
+  // The index of the paint's objects as an int32, or -1 if it has none,
+  // followed by |Paint::kDataByteCount| bytes encoded like Paint._data. Sets
+  // the paint of the draw commands that follow.
+  kSetPaint = 0,
+  // left, top, right, bottom
+  kDrawRect = 1,
+  // left, top, right, bottom, then the x and y radii of the top left, top
+  // right, bottom right and bottom left corners.
+  kDrawRRect = 2,
+  // left, top, right, bottom
+  kDrawOval = 3,
+  // x, y, radius
+  kDrawCircle = 4,
+  // x1, y1, x2, y2
+  kDrawLine = 5,
+};
+
+// Draws the |word_count| words of commands in |commands| into |canvas|.
+// |paint_objects| holds the objects of the paints they set.
+//
+// Returns false if a command is malformed. The commands before it will have
+// been drawn.
+bool ReplayDrawBatch(SkCanvas* canvas,
+                     const uint32_t* commands,
+                     size_t word_count,
+                     const std::vector<PaintObjects>& paint_objects);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DRAW_BATCH_H_
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/lib/ui/painting/draw_batch.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+
+static constexpr size_t kPaintDataWordCount = Paint::kDataByteCount / 4;
+
+// Paint._data stores the color xor'd with its default.
+static void SetColor(uint32_t* paint_data, uint32_t color) {
+  paint_data[1] = color ^ 0xFF000000;
+}
+
+static void AppendFloat(std::vector<uint32_t>* commands, float value) {
+  uint32_t word;
+  std::memcpy(&word, &value, sizeof(word));
+  commands->push_back(word);
+}
+
+// A scatter plot: |rect_count| small rectangles in runs of |run_length| that
+// share a color.
+static std::vector<uint32_t> CreateScatterPlot(size_t rect_count,
+                                               size_t run_length) {
+  std::vector<uint32_t> commands;
+  uint32_t paint_data[kPaintDataWordCount] = {};
+  for (size_t i = 0; i < rect_count; i++) {
+    if (i % run_length == 0) {
+      SetColor(paint_data, 0xFF000000 | ((i / run_length) * 0x1F3D5B));
+      commands.push_back(static_cast<uint32_t>(DrawBatchOp::kSetPaint));
+      commands.push_back(static_cast<uint32_t>(-1));
+      commands.insert(commands.end(), paint_data,
+                      paint_data + kPaintDataWordCount);
+    }
+    const float x = (i * 7) % 1000;
+    const float y = (i * 13) % 1000;
+    commands.push_back(static_cast<uint32_t>(DrawBatchOp::kDrawRect));
+    AppendFloat(&commands, x);
+    AppendFloat(&commands, y);
+    AppendFloat(&commands, x + 4);
+    AppendFloat(&commands, y + 4);
+  }
+  return commands;
+}
+
+// Draws like Canvas.drawRect does for each rectangle, decoding its paint
+// every time. This leaves out the cost of the call from Dart, which the batch
+// saves as well.
+static void BM_DrawRectsOneByOne(benchmark::State& state) {
+  const size_t rect_count = state.range(0);
+  const PaintObjects objects;
+  uint32_t paint_data[kPaintDataWordCount] = {};
+  while (state.KeepRunning()) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(1000, 1000);
+    for (size_t i = 0; i < rect_count; i++) {
+      SetColor(paint_data, 0xFF000000 | ((i / state.range(1)) * 0x1F3D5B));
+      const float x = (i * 7) % 1000;
+      const float y = (i * 13) % 1000;
+      const Paint paint(objects, paint_data);
+      canvas->drawRect(SkRect::MakeLTRB(x, y, x + 4, y + 4), *paint.paint());
+    }
+    benchmark::DoNotOptimize(recorder.finishRecordingAsPicture());
+  }
+  state.SetItemsProcessed(state.iterations() * rect_count);
+}
+
+static void BM_DrawRectsBatched(benchmark::State& state) {
+  const std::vector<uint32_t> commands =
+      CreateScatterPlot(state.range(0), state.range(1));
+  const std::vector<PaintObjects> objects;
+  while (state.KeepRunning()) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(1000, 1000);
+    ReplayDrawBatch(canvas, commands.data(), commands.size(), objects);
+    benchmark::DoNotOptimize(recorder.finishRecordingAsPicture());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Rectangle counts and the number of consecutive rectangles sharing a paint.
+BENCHMARK(BM_DrawRectsOneByOne)
+    ->Args({50000, 1})
+    ->Args({50000, 1000})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DrawRectsBatched)
+    ->Args({50000, 1})
+    ->Args({50000, 1000})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/draw_batch.h"
+
+#include <cstring>
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+namespace testing {
+
+static void AppendSetPaint(std::vector<uint32_t>* commands,
+                           int32_t objects_index) {
+  commands->push_back(static_cast<uint32_t>(DrawBatchOp::kSetPaint));
+  commands->push_back(static_cast<uint32_t>(objects_index));
+  commands->insert(commands->end(), Paint::kDataByteCount / 4, 0);
+}
+
+static void AppendDrawCircle(std::vector<uint32_t>* commands) {
+  const float operands[] = {10, 10, 5};
+  commands->push_back(static_cast<uint32_t>(DrawBatchOp::kDrawCircle));
+  for (float operand : operands) {
+    uint32_t word;
+    std::memcpy(&word, &operand, sizeof(word));
+    commands->push_back(word);
+  }
+}
+
+static bool Replay(const std::vector<uint32_t>& commands,
+                   const std::vector<PaintObjects>& objects,
+                   int* draw_count) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(100, 100);
+  const bool result =
+      ReplayDrawBatch(canvas, commands.data(), commands.size(), objects);
+  *draw_count = recorder.finishRecordingAsPicture()->approximateOpCount();
+  return result;
+}
+
+TEST(DrawBatchTest, DrawsEachCommand) {
+  std::vector<uint32_t> commands;
+  AppendSetPaint(&commands, -1);
+  AppendDrawCircle(&commands);
+  AppendDrawCircle(&commands);
+  AppendSetPaint(&commands, 0);
+  AppendDrawCircle(&commands);
+
+  int draw_count = 0;
+  ASSERT_TRUE(Replay(commands, std::vector<PaintObjects>(1), &draw_count));
+  ASSERT_EQ(draw_count, 3);
+}
+
+TEST(DrawBatchTest, RejectsMalformedCommands) {
+  int draw_count = 0;
+
+  // No paint.
+  std::vector<uint32_t> commands;
+  AppendDrawCircle(&commands);
+  ASSERT_FALSE(Replay(commands, {}, &draw_count));
+
+  // Missing objects.
+  commands.clear();
+  AppendSetPaint(&commands, 1);
+  ASSERT_FALSE(Replay(commands, std::vector<PaintObjects>(1), &draw_count));
+
+  // Truncated operands.
+  commands.clear();
+  AppendSetPaint(&commands, -1);
+  AppendDrawCircle(&commands);
+  commands.pop_back();
+  ASSERT_FALSE(Replay(commands, {}, &draw_count));
+
+  // Unknown opcode.
+  commands.clear();
+  commands.push_back(99);
+  ASSERT_FALSE(Replay(commands, {}, &draw_count));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/image.h"
 
+#include <atomic>
+
 #include "flutter/lib/ui/painting/image_encoding.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
@@ -24,13 +26,38 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Image);
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
+static std::atomic_size_t gLiveImageCount;
+static std::atomic_size_t gLiveImageBytes;
+
+static void AddLiveImage(const sk_sp<SkImage>& image) {
+  if (image) {
+    gLiveImageCount++;
+    gLiveImageBytes += image->imageInfo().computeMinByteSize();
+  }
+}
+
+static void RemoveLiveImage(const sk_sp<SkImage>& image) {
+  if (image) {
+    gLiveImageCount--;
+    gLiveImageBytes -= image->imageInfo().computeMinByteSize();
+  }
+}
+
 void CanvasImage::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
 CanvasImage::CanvasImage() = default;
 
-CanvasImage::~CanvasImage() = default;
+CanvasImage::~CanvasImage() {
+  RemoveLiveImage(image_.get());
+}
+
+void CanvasImage::set_image(flutter::SkiaGPUObject<SkImage> image) {
+  RemoveLiveImage(image_.get());
+  image_ = std::move(image);
+  AddLiveImage(image_.get());
+}
 
 Dart_Handle CanvasImage::toByteData(int format, Dart_Handle callback) {
   return EncodeImage(this, format, callback);
@@ -51,4 +78,12 @@ size_t CanvasImage::GetAllocationSize() {
   }
 }
 
+size_t CanvasImage::GetLiveImageCount() {
+  return gLiveImageCount;
+}
+
+size_t CanvasImage::GetLiveImageBytes() {
+  return gLiveImageBytes;
+}
+
 }  // namespace flutter
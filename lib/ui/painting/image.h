@@ -35,12 +35,15 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
   void dispose();
 
   sk_sp<SkImage> image() const { return image_.get(); }
-  void set_image(flutter::SkiaGPUObject<SkImage> image) {
-    image_ = std::move(image);
-  }
+  void set_image(flutter::SkiaGPUObject<SkImage> image);
 
   size_t GetAllocationSize() override;
 
+  // The number of images alive in the process and the bytes their pixels
+  // take up, wherever they are stored.
+  static size_t GetLiveImageCount();
+  static size_t GetLiveImageBytes();
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
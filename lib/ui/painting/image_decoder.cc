@@ -329,6 +329,11 @@ void ImageDecoder::Decode(ImageDescriptor descriptor, ImageResult callback) {
       }));
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+ImageDecoder::GetConcurrentTaskRunner() const {
+  return concurrent_task_runner_;
+}
+
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
@@ -8,15 +8,19 @@
 #include <utility>
 
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/pixel_kernels.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
 #include "third_party/tonic/dart_persistent_value.h"
 #include "third_party/tonic/logging/dart_invoke.h"
 #include "third_party/tonic/typed_data/typed_list.h"
@@ -28,13 +32,6 @@ using tonic::ToDart;
 namespace flutter {
 namespace {
 
-// This must be kept in sync with the enum in painting.dart
-enum ImageByteFormat {
-  kRawRGBA,
-  kRawUnmodified,
-  kPNG,
-};
-
 void InvokeDataCallback(std::unique_ptr<DartPersistentValue> callback,
                         sk_sp<SkData> buffer) {
   std::shared_ptr<tonic::DartState> dart_state = callback->dart_state().lock();
@@ -96,6 +93,11 @@ sk_sp<SkImage> ConvertToRasterImageIfNecessary(sk_sp<SkImage> image,
   return snapshot->makeRasterImage();
 }
 
+bool Is8888(SkColorType color_type) {
+  return color_type == kRGBA_8888_SkColorType ||
+         color_type == kBGRA_8888_SkColorType;
+}
+
 sk_sp<SkData> CopyImageByteData(sk_sp<SkImage> raster_image,
                                 SkColorType color_type) {
   FML_DCHECK(raster_image);
@@ -107,53 +109,81 @@ sk_sp<SkData> CopyImageByteData(sk_sp<SkImage> raster_image,
     return nullptr;
   }
 
-  // The color types already match. No need to swizzle. Return early.
+  // The color types already match. No need to swizzle. The pixels of a raster
+  // image never change, so they are handed out as they are, with the data
+  // keeping the image alive.
   if (pixmap.colorType() == color_type) {
-    return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
+    return SkData::MakeWithProc(
+        pixmap.addr(), pixmap.computeByteSize(),
+        [](const void* pixels, void* image) {
+          static_cast<SkImage*>(image)->unref();
+        },
+        raster_image.release());
   }
 
-  // Perform swizzle if the type doesnt match the specification.
-  auto surface = SkSurface::MakeRaster(
-      SkImageInfo::Make(raster_image->width(), raster_image->height(),
-                        color_type, kPremul_SkAlphaType, nullptr));
+  const SkImageInfo info =
+      SkImageInfo::Make(pixmap.width(), pixmap.height(), color_type,
+                        kPremul_SkAlphaType, pixmap.refColorSpace());
+  sk_sp<SkData> data = SkData::MakeUninitialized(info.computeMinByteSize());
+
+  // Converting between RGBA and BGRA only swaps two channels, which the
+  // engine's pixel kernels do straight into the result.
+  if (Is8888(pixmap.colorType()) && Is8888(color_type) &&
+      pixmap.alphaType() != kUnknown_SkAlphaType) {
+    auto* pixels = static_cast<uint32_t*>(data->writable_data());
+    for (int y = 0; y < pixmap.height(); y++) {
+      uint32_t* row = pixels + y * pixmap.width();
+      SwapRedAndBlue(row, pixmap.addr32(0, y), pixmap.width());
+      if (pixmap.alphaType() == kUnpremul_SkAlphaType) {
+        Premultiply(row, row, pixmap.width());
+      }
+    }
+    return data;
+  }
 
-  if (!surface) {
-    FML_LOG(ERROR) << "Could not setup the surface for swizzle.";
+  if (!pixmap.readPixels(info, data->writable_data(), info.minRowBytes())) {
+    FML_LOG(ERROR) << "Could not swizzle the pixels of the raster image.";
     return nullptr;
   }
 
-  surface->writePixels(pixmap, 0, 0);
+  return data;
+}
 
-  if (!surface->peekPixels(&pixmap)) {
-    FML_LOG(ERROR) << "Pixel address is not available.";
+// Encodes with the fastest zlib level and without row filtering. This is
+// several times faster than the default PNG encoding at the cost of larger
+// output.
+sk_sp<SkData> EncodeFastPNG(const sk_sp<SkImage>& raster_image) {
+  SkPixmap pixmap;
+  if (!raster_image->peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Could not read pixels from the raster image.";
     return nullptr;
   }
 
-  return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
-}
-
-sk_sp<SkData> EncodeImage(sk_sp<SkImage> p_image,
-                          GrContext* context,
-                          ImageByteFormat format) {
-  TRACE_EVENT0("flutter", __FUNCTION__);
+  SkPngEncoder::Options options;
+  options.fFilterFlags = SkPngEncoder::FilterFlag::kNone;
+  options.fZLibLevel = 1;
 
-  // Check validity of the image.
-  if (p_image == nullptr) {
-    FML_LOG(ERROR) << "Image was null.";
+  SkDynamicMemoryWStream stream;
+  if (!SkPngEncoder::Encode(&stream, pixmap, options)) {
     return nullptr;
   }
+  return stream.detachAsData();
+}
 
-  auto dimensions = p_image->dimensions();
+// The CPU bound part of the encode. |image| must not be texture backed.
+sk_sp<SkData> EncodeRasterImage(sk_sp<SkImage> image, ImageByteFormat format) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
 
-  if (dimensions.isEmpty()) {
-    FML_LOG(ERROR) << "Image dimensions were empty.";
+  if (image == nullptr) {
+    FML_LOG(ERROR) << "Could not create a raster copy of the image.";
     return nullptr;
   }
 
-  auto raster_image = ConvertToRasterImageIfNecessary(p_image, context);
+  // Lazily decoded images are decoded here rather than on the IO thread.
+  auto raster_image = image->makeRasterImage();
 
   if (raster_image == nullptr) {
-    FML_LOG(ERROR) << "Could not create a raster copy of the image.";
+    FML_LOG(ERROR) << "Could not decode the image.";
     return nullptr;
   }
 
@@ -168,6 +198,15 @@ sk_sp<SkData> EncodeImage(sk_sp<SkImage> p_image,
       }
       return png_image;
     } break;
+    case kPNGFast: {
+      auto png_image = EncodeFastPNG(raster_image);
+
+      if (png_image == nullptr) {
+        FML_LOG(ERROR) << "Could not convert raster image to PNG.";
+        return nullptr;
+      }
+      return png_image;
+    } break;
     case kRawRGBA: {
       return CopyImageByteData(raster_image, kRGBA_8888_SkColorType);
     } break;
@@ -180,22 +219,81 @@ sk_sp<SkData> EncodeImage(sk_sp<SkImage> p_image,
   return nullptr;
 }
 
-void EncodeImageAndInvokeDataCallback(
-    std::unique_ptr<DartPersistentValue> callback,
-    sk_sp<SkImage> image,
-    GrContext* context,
-    fml::RefPtr<fml::TaskRunner> ui_task_runner,
-    ImageByteFormat format) {
-  sk_sp<SkData> encoded = EncodeImage(std::move(image), context, format);
-
-  ui_task_runner->PostTask(
-      fml::MakeCopyable([callback = std::move(callback), encoded]() mutable {
-        InvokeDataCallback(std::move(callback), std::move(encoded));
-      }));
+void EncodeRasterImageAndInvokeCallback(
+    sk_sp<SkImage> raster_image,
+    ImageByteFormat format,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& encoding_task_runner,
+    fml::RefPtr<fml::TaskRunner> callback_task_runner,
+    std::function<void(sk_sp<SkData>)> callback) {
+  auto encode = [raster_image = std::move(raster_image),                  //
+                 format,                                                  //
+                 callback_task_runner = std::move(callback_task_runner),  //
+                 callback = std::move(callback)                           //
+  ]() mutable {
+    sk_sp<SkData> encoded = EncodeRasterImage(std::move(raster_image), format);
+    callback_task_runner->PostTask(
+        [callback = std::move(callback), encoded = std::move(encoded)]() {
+          callback(std::move(encoded));
+        });
+  };
+
+  if (encoding_task_runner) {
+    encoding_task_runner->PostTask(std::move(encode));
+  } else {
+    // Only reached on the IO task runner. See |EncodeImageAsync|.
+    encode();
+  }
 }
 
 }  // namespace
 
+void EncodeImageAsync(
+    sk_sp<SkImage> image,
+    ImageByteFormat format,
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    fml::WeakPtr<GrContext> resource_context,
+    std::shared_ptr<fml::ConcurrentTaskRunner> encoding_task_runner,
+    fml::RefPtr<fml::TaskRunner> callback_task_runner,
+    std::function<void(sk_sp<SkData>)> callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+
+  // Check validity of the image.
+  if (image == nullptr || image->dimensions().isEmpty()) {
+    FML_LOG(ERROR) << "Image was null or its dimensions were empty.";
+    callback_task_runner->PostTask(
+        [callback = std::move(callback)]() { callback(nullptr); });
+    return;
+  }
+
+  // Only texture backed images need the IO thread (and its resource context)
+  // to be read back. Without a worker pool, the IO thread encodes the image as
+  // well so that the calling thread is never blocked by the encode.
+  if (!image->isTextureBacked() && encoding_task_runner) {
+    EncodeRasterImageAndInvokeCallback(std::move(image), format,
+                                       encoding_task_runner,
+                                       std::move(callback_task_runner),
+                                       std::move(callback));
+    return;
+  }
+
+  io_task_runner->PostTask([image = std::move(image),                        //
+                            format,                                          //
+                            resource_context = std::move(resource_context),  //
+                            encoding_task_runner =
+                                std::move(encoding_task_runner),  //
+                            callback_task_runner =
+                                std::move(callback_task_runner),  //
+                            callback = std::move(callback)        //
+  ]() mutable {
+    auto raster_image = ConvertToRasterImageIfNecessary(std::move(image),
+                                                        resource_context.get());
+    EncodeRasterImageAndInvokeCallback(std::move(raster_image), format,
+                                       encoding_task_runner,
+                                       std::move(callback_task_runner),
+                                       std::move(callback));
+  });
+}
+
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
                         int format,
                         Dart_Handle callback_handle) {
@@ -211,22 +309,19 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
       tonic::DartState::Current(), callback_handle);
 
   const auto& task_runners = UIDartState::Current()->GetTaskRunners();
-  auto context = UIDartState::Current()->GetResourceContext();
-
-  task_runners.GetIOTaskRunner()->PostTask(
-      fml::MakeCopyable([callback = std::move(callback),                   //
-                         image = canvas_image->image(),                    //
-                         context = std::move(context),                     //
-                         ui_task_runner = task_runners.GetUITaskRunner(),  //
-                         image_format                                      //
-  ]() mutable {
-        EncodeImageAndInvokeDataCallback(std::move(callback),        //
-                                         std::move(image),           //
-                                         context.get(),              //
-                                         std::move(ui_task_runner),  //
-                                         image_format                //
-        );
-      }));
+  auto image_decoder = UIDartState::Current()->GetImageDecoder();
+
+  EncodeImageAsync(
+      canvas_image->image(),                         //
+      image_format,                                  //
+      task_runners.GetIOTaskRunner(),                //
+      UIDartState::Current()->GetResourceContext(),  //
+      image_decoder ? image_decoder->GetConcurrentTaskRunner() : nullptr,
+      task_runners.GetUITaskRunner(),  //
+      fml::MakeCopyable(
+          [callback = std::move(callback)](sk_sp<SkData> encoded) mutable {
+            InvokeDataCallback(std::move(callback), std::move(encoded));
+          }));
 
   return Dart_Null();
 }
@@ -5,16 +5,50 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_H_
 
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/gpu/GrContext.h"
 #include "third_party/tonic/dart_library_natives.h"
 
 namespace flutter {
 
 class CanvasImage;
 
+// This must be kept in sync with the enum in painting.dart
+enum ImageByteFormat {
+  kRawRGBA,
+  kRawUnmodified,
+  kPNG,
+  kPNGFast,
+};
+
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
                         int format,
                         Dart_Handle callback_handle);
 
+// Encodes |image| in |format| and invokes |callback| on |callback_task_runner|
+// with the encoded bytes, or null on failure.
+//
+// Texture backed images are first read back on |io_task_runner| using
+// |resource_context|. The CPU bound conversion to the requested format then
+// runs on |encoding_task_runner|, so that encodes run in parallel and do not
+// hold up texture uploads on the IO task runner. If |encoding_task_runner| is
+// null, the image is encoded on the IO task runner.
+void EncodeImageAsync(
+    sk_sp<SkImage> image,
+    ImageByteFormat format,
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    fml::WeakPtr<GrContext> resource_context,
+    std::shared_ptr<fml::ConcurrentTaskRunner> encoding_task_runner,
+    fml::RefPtr<fml::TaskRunner> callback_task_runner,
+    std::function<void(sk_sp<SkData>)> callback);
+
 }  // namespace flutter
 
 #endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_H_
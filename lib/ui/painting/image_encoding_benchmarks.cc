@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <chrono>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/lib/ui/painting/image_encoding.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+
+namespace flutter {
+
+static constexpr size_t kConcurrentEncodes = 4;
+
+static sk_sp<SkImage> CreateScreenshotImage() {
+  auto surface = SkSurface::MakeRasterN32Premul(1080, 1920);
+  SkCanvas* canvas = surface->getCanvas();
+
+  const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+  const SkPoint points[] = {SkPoint::Make(0, 0), SkPoint::Make(1080, 1920)};
+  SkPaint background;
+  background.setShader(SkGradientShader::MakeLinear(
+      points, colors, nullptr, 3, SkTileMode::kClamp));
+  canvas->drawPaint(background);
+
+  SkPaint stroke;
+  stroke.setAntiAlias(true);
+  stroke.setStyle(SkPaint::kStroke_Style);
+  stroke.setStrokeWidth(2.0);
+  for (int y = 0; y < 1920; y += 48) {
+    for (int x = 0; x < 1080; x += 48) {
+      canvas->drawCircle(x + 24, y + 24, 18, stroke);
+    }
+  }
+
+  return surface->makeImageSnapshot();
+}
+
+// Measures how long a trivial task posted to the IO task runner has to wait
+// while |kConcurrentEncodes| screenshots are being encoded. This is the delay
+// seen by image decodes and texture uploads that share the IO thread.
+static void BM_ImageEncodingIOLatency(benchmark::State& state,
+                                      ImageByteFormat format,
+                                      bool use_encoding_pool) {
+  fml::Thread io_thread("io");
+  fml::Thread callback_thread("ui");
+  std::shared_ptr<fml::ConcurrentMessageLoop> encoding_loop;
+  std::shared_ptr<fml::ConcurrentTaskRunner> encoding_task_runner;
+  if (use_encoding_pool) {
+    encoding_loop = fml::ConcurrentMessageLoop::Create();
+    encoding_task_runner = encoding_loop->GetTaskRunner();
+  }
+
+  auto io_task_runner = io_thread.GetTaskRunner();
+  auto callback_task_runner = callback_thread.GetTaskRunner();
+  auto image = CreateScreenshotImage();
+
+  while (state.KeepRunning()) {
+    fml::CountDownLatch encodes_done(kConcurrentEncodes);
+    for (size_t i = 0; i < kConcurrentEncodes; i++) {
+      // Encodes are requested from the IO thread so that, without a pool,
+      // the encode runs there just like it did before the pool existed.
+      io_task_runner->PostTask([&, image]() {
+        EncodeImageAsync(image, format, io_task_runner, {},
+                         encoding_task_runner, callback_task_runner,
+                         [&encodes_done](sk_sp<SkData> encoded) {
+                           FML_CHECK(encoded);
+                           encodes_done.CountDown();
+                         });
+      });
+    }
+
+    fml::AutoResetWaitableEvent io_task_ran;
+    const auto posted = std::chrono::high_resolution_clock::now();
+    io_task_runner->PostTask([&io_task_ran]() { io_task_ran.Signal(); });
+    io_task_ran.Wait();
+    const auto latency = std::chrono::high_resolution_clock::now() - posted;
+    state.SetIterationTime(
+        std::chrono::duration_cast<std::chrono::duration<double>>(latency)
+            .count());
+
+    encodes_done.Wait();
+  }
+}
+
+BENCHMARK_CAPTURE(BM_ImageEncodingIOLatency, PNGOnIOThread, kPNG, false)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageEncodingIOLatency, PNGOnPool, kPNG, true)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageEncodingIOLatency, PNGFastOnPool, kPNGFast, true)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Wall time of encoding |kConcurrentEncodes| screenshots end to end.
+static void BM_ImageEncodingThroughput(benchmark::State& state,
+                                       ImageByteFormat format,
+                                       bool use_encoding_pool) {
+  fml::Thread io_thread("io");
+  fml::Thread callback_thread("ui");
+  std::shared_ptr<fml::ConcurrentMessageLoop> encoding_loop;
+  std::shared_ptr<fml::ConcurrentTaskRunner> encoding_task_runner;
+  if (use_encoding_pool) {
+    encoding_loop = fml::ConcurrentMessageLoop::Create();
+    encoding_task_runner = encoding_loop->GetTaskRunner();
+  }
+
+  auto io_task_runner = io_thread.GetTaskRunner();
+  auto callback_task_runner = callback_thread.GetTaskRunner();
+  auto image = CreateScreenshotImage();
+
+  while (state.KeepRunning()) {
+    fml::CountDownLatch encodes_done(kConcurrentEncodes);
+    for (size_t i = 0; i < kConcurrentEncodes; i++) {
+      io_task_runner->PostTask([&, image]() {
+        EncodeImageAsync(image, format, io_task_runner, {},
+                         encoding_task_runner, callback_task_runner,
+                         [&encodes_done](sk_sp<SkData> encoded) {
+                           FML_CHECK(encoded);
+                           encodes_done.CountDown();
+                         });
+      });
+    }
+    encodes_done.Wait();
+  }
+}
+
+BENCHMARK_CAPTURE(BM_ImageEncodingThroughput, PNGOnIOThread, kPNG, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageEncodingThroughput, PNGOnPool, kPNG, true)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageEncodingThroughput, PNGFastOnPool, kPNGFast, true)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageEncodingThroughput, RawRGBAOnPool, kRawRGBA, true)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageEncodingThroughput,
+                  RawUnmodifiedOnPool,
+                  kRawUnmodified,
+                  true)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
@@ -5,17 +5,16 @@
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "third_party/dart/runtime/include/dart_api.h"
-#include "third_party/skia/include/core/SkPixelRef.h"
 #include "third_party/tonic/logging/dart_invoke.h"
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::unique_ptr<SkCodec> codec)
-    : codec_(std::move(codec)),
-      frameCount_(codec_->getFrameCount()),
-      repetitionCount_(codec_->getRepetitionCount()),
-      nextFrameIndex_(0) {}
+MultiFrameCodec::MultiFrameCodec(std::unique_ptr<SkCodec> codec,
+                                 MultiFrameDecoder::Options options)
+    : decoder_(std::make_shared<MultiFrameDecoder>(std::move(codec),
+                                                   std::move(options))) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
@@ -37,123 +36,6 @@ static void InvokeNextFrameCallback(
   }
 }
 
-// Copied the source bitmap to the destination. If this cannot occur due to
-// running out of memory or the image info not being compatible, returns false.
-static bool CopyToBitmap(SkBitmap* dst,
-                         SkColorType dstColorType,
-                         const SkBitmap& src) {
-  SkPixmap srcPM;
-  if (!src.peekPixels(&srcPM)) {
-    return false;
-  }
-
-  SkBitmap tmpDst;
-  SkImageInfo dstInfo = srcPM.info().makeColorType(dstColorType);
-  if (!tmpDst.setInfo(dstInfo)) {
-    return false;
-  }
-
-  if (!tmpDst.tryAllocPixels()) {
-    return false;
-  }
-
-  SkPixmap dstPM;
-  if (!tmpDst.peekPixels(&dstPM)) {
-    return false;
-  }
-
-  if (!srcPM.readPixels(dstPM)) {
-    return false;
-  }
-
-  dst->swap(tmpDst);
-  return true;
-}
-
-sk_sp<SkImage> MultiFrameCodec::GetNextFrameImage(
-    fml::WeakPtr<GrContext> resourceContext) {
-  SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = codec_->getInfo().makeColorType(kN32_SkColorType);
-  if (info.alphaType() == kUnpremul_SkAlphaType) {
-    info = info.makeAlphaType(kPremul_SkAlphaType);
-  }
-  bitmap.allocPixels(info);
-
-  SkCodec::Options options;
-  options.fFrameIndex = nextFrameIndex_;
-  SkCodec::FrameInfo frameInfo;
-  codec_->getFrameInfo(nextFrameIndex_, &frameInfo);
-  const int requiredFrameIndex = frameInfo.fRequiredFrame;
-  if (requiredFrameIndex != SkCodec::kNoFrame) {
-    if (lastRequiredFrame_ == nullptr) {
-      FML_LOG(ERROR) << "Frame " << nextFrameIndex_ << " depends on frame "
-                     << requiredFrameIndex
-                     << " and no required frames are cached.";
-      return nullptr;
-    } else if (lastRequiredFrameIndex_ != requiredFrameIndex) {
-      FML_DLOG(INFO) << "Required frame " << requiredFrameIndex
-                     << " is not cached. Using " << lastRequiredFrameIndex_
-                     << " instead";
-    }
-
-    if (lastRequiredFrame_->getPixels() &&
-        CopyToBitmap(&bitmap, lastRequiredFrame_->colorType(),
-                     *lastRequiredFrame_)) {
-      options.fPriorFrame = requiredFrameIndex;
-    }
-  }
-
-  if (SkCodec::kSuccess != codec_->getPixels(info, bitmap.getPixels(),
-                                             bitmap.rowBytes(), &options)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
-    return nullptr;
-  }
-
-  // Hold onto this if we need it to decode future frames.
-  if (frameInfo.fDisposalMethod == SkCodecAnimation::DisposalMethod::kKeep) {
-    lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
-  }
-
-  if (resourceContext) {
-    SkPixmap pixmap(bitmap.info(), bitmap.pixelRef()->pixels(),
-                    bitmap.pixelRef()->rowBytes());
-    // This indicates that we do not want a "linear blending" decode.
-    sk_sp<SkColorSpace> dstColorSpace = nullptr;
-    return SkImage::MakeCrossContextFromPixmap(resourceContext.get(), pixmap,
-                                               true, dstColorSpace.get());
-  } else {
-    // Defer decoding until time of draw later on the GPU thread. Can happen
-    // when GL operations are currently forbidden such as in the background
-    // on iOS.
-    return SkImage::MakeFromBitmap(bitmap);
-  }
-}
-
-void MultiFrameCodec::GetNextFrameAndInvokeCallback(
-    std::unique_ptr<DartPersistentValue> callback,
-    fml::RefPtr<fml::TaskRunner> ui_task_runner,
-    fml::WeakPtr<GrContext> resourceContext,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
-    size_t trace_id) {
-  fml::RefPtr<FrameInfo> frameInfo = NULL;
-  sk_sp<SkImage> skImage = GetNextFrameImage(resourceContext);
-  if (skImage) {
-    fml::RefPtr<CanvasImage> image = CanvasImage::Create();
-    image->set_image({skImage, std::move(unref_queue)});
-    SkCodec::FrameInfo skFrameInfo;
-    codec_->getFrameInfo(nextFrameIndex_, &skFrameInfo);
-    frameInfo =
-        fml::MakeRefCounted<FrameInfo>(std::move(image), skFrameInfo.fDuration);
-  }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
-
-  ui_task_runner->PostTask(fml::MakeCopyable(
-      [callback = std::move(callback), frameInfo, trace_id]() mutable {
-        InvokeNextFrameCallback(frameInfo, std::move(callback), trace_id);
-      }));
-}
-
 Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   static size_t trace_counter = 1;
   const size_t trace_id = trace_counter++;
@@ -166,26 +48,52 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
 
   const auto& task_runners = dart_state->GetTaskRunners();
 
-  task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+  // Frames are decoded on the worker pool shared with the image decoder and
+  // only uploaded on the IO thread.
+  std::shared_ptr<fml::ConcurrentTaskRunner> decode_task_runner;
+  if (auto image_decoder = dart_state->GetImageDecoder()) {
+    decode_task_runner = image_decoder->GetConcurrentTaskRunner();
+  }
+
+  auto result = fml::MakeCopyable(
       [callback = std::make_unique<DartPersistentValue>(
            tonic::DartState::Current(), callback_handle),
-       this, trace_id, ui_task_runner = task_runners.GetUITaskRunner(),
-       queue = UIDartState::Current()->GetSkiaUnrefQueue(),
-       context = dart_state->GetResourceContext()]() mutable {
-        GetNextFrameAndInvokeCallback(std::move(callback),
-                                      std::move(ui_task_runner), context,
-                                      std::move(queue), trace_id);
-      }));
+       trace_id, ui_task_runner = task_runners.GetUITaskRunner(),
+       queue = dart_state->GetSkiaUnrefQueue()](sk_sp<SkImage> skImage,
+                                                int duration) mutable {
+        fml::RefPtr<FrameInfo> frameInfo = NULL;
+        if (skImage) {
+          fml::RefPtr<CanvasImage> image = CanvasImage::Create();
+          image->set_image({std::move(skImage), std::move(queue)});
+          frameInfo =
+              fml::MakeRefCounted<FrameInfo>(std::move(image), duration);
+        }
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [callback = std::move(callback), frameInfo, trace_id]() mutable {
+              InvokeNextFrameCallback(frameInfo, std::move(callback),
+                                      trace_id);
+            }));
+      });
+
+  task_runners.GetIOTaskRunner()->PostTask(
+      [decoder = decoder_, io_task_runner = task_runners.GetIOTaskRunner(),
+       decode_task_runner = std::move(decode_task_runner),
+       context = dart_state->GetResourceContext(),
+       result = std::move(result)]() mutable {
+        decoder->GetNextFrame(std::move(io_task_runner),
+                              std::move(decode_task_runner), context,
+                              std::move(result));
+      });
 
   return Dart_Null();
 }
 
 int MultiFrameCodec::frameCount() const {
-  return frameCount_;
+  return decoder_->frame_count();
 }
 
 int MultiFrameCodec::repetitionCount() const {
-  return repetitionCount_;
+  return decoder_->repetition_count();
 }
 
 }  // namespace flutter
@@ -0,0 +1,286 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkPixelRef.h"
+
+namespace flutter {
+
+static SkImageInfo MakeDecodeInfo(const SkCodec& codec) {
+  SkImageInfo info = codec.getInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    info = info.makeAlphaType(kPremul_SkAlphaType);
+  }
+  return info;
+}
+
+static size_t LookAheadLimit(const MultiFrameDecoder::Options& options,
+                             size_t frame_bytes) {
+  const size_t frames_in_budget =
+      frame_bytes == 0 ? options.look_ahead_frames
+                       : options.max_look_ahead_bytes / frame_bytes;
+  return std::max<size_t>(1, std::min(options.look_ahead_frames,
+                                      frames_in_budget));
+}
+
+static bool ShouldCacheAllFrames(const MultiFrameDecoder::Options& options,
+                                 size_t frame_bytes,
+                                 int frame_count) {
+  return options.max_fully_cached_bytes > 0 &&
+         frame_bytes * frame_count <= options.max_fully_cached_bytes;
+}
+
+MultiFrameDecoder::MultiFrameDecoder(std::unique_ptr<SkCodec> codec,
+                                     Options options)
+    : codec_(std::move(codec)),
+      frame_info_(codec_->getFrameInfo()),
+      frame_count_(codec_->getFrameCount()),
+      repetition_count_(codec_->getRepetitionCount()),
+      decode_info_(MakeDecodeInfo(*codec_)),
+      look_ahead_limit_(
+          LookAheadLimit(options, decode_info_.computeMinByteSize())),
+      cache_all_frames_(ShouldCacheAllFrames(options,
+                                             decode_info_.computeMinByteSize(),
+                                             frame_count_)) {
+  if (cache_all_frames_) {
+    cached_frames_.resize(frame_count_);
+  }
+}
+
+MultiFrameDecoder::~MultiFrameDecoder() = default;
+
+bool MultiFrameDecoder::IsFullyCached() const {
+  std::scoped_lock lock(mutex_);
+  return IsFullyCachedLocked();
+}
+
+bool MultiFrameDecoder::IsFullyCachedLocked() const {
+  return cache_all_frames_ &&
+         cached_frame_count_ == static_cast<size_t>(frame_count_);
+}
+
+bool MultiFrameDecoder::ShouldDecodeLocked() const {
+  if (cache_all_frames_) {
+    // The cache is bounded by |max_fully_cached_bytes|, so there is no point
+    // waiting for the animation to reach a frame before decoding it.
+    return !IsFullyCachedLocked();
+  }
+  return ready_frames_.size() < look_ahead_limit_;
+}
+
+void MultiFrameDecoder::ScheduleDecodeLocked() {
+  if (decode_scheduled_ || !ShouldDecodeLocked()) {
+    return;
+  }
+  decode_scheduled_ = true;
+
+  auto decode = [decoder = shared_from_this()]() { decoder->DecodeAhead(); };
+  if (decode_task_runner_) {
+    decode_task_runner_->PostTask(std::move(decode));
+  } else {
+    io_task_runner_->PostTask(std::move(decode));
+  }
+}
+
+void MultiFrameDecoder::ScheduleServeLocked() {
+  if (serve_scheduled_ || pending_requests_.empty()) {
+    return;
+  }
+  serve_scheduled_ = true;
+  io_task_runner_->PostTask(
+      [decoder = shared_from_this()]() { decoder->ServePendingRequests(); });
+}
+
+void MultiFrameDecoder::GetNextFrame(
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    std::shared_ptr<fml::ConcurrentTaskRunner> decode_task_runner,
+    fml::WeakPtr<GrContext> resource_context,
+    FrameResult result) {
+  FML_DCHECK(io_task_runner->RunsTasksOnCurrentThread());
+  {
+    std::scoped_lock lock(mutex_);
+    io_task_runner_ = std::move(io_task_runner);
+    decode_task_runner_ = std::move(decode_task_runner);
+    resource_context_ = std::move(resource_context);
+    pending_requests_.emplace_back(std::move(result));
+  }
+  ServePendingRequests();
+}
+
+void MultiFrameDecoder::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameDecoder::DecodeAhead");
+  while (true) {
+    int index = 0;
+    SkBitmap bitmap;
+    {
+      std::scoped_lock lock(mutex_);
+      if (!ShouldDecodeLocked()) {
+        decode_scheduled_ = false;
+        return;
+      }
+      index = next_decode_index_;
+      if (!bitmap_pool_.empty()) {
+        bitmap = std::move(bitmap_pool_.back());
+        bitmap_pool_.pop_back();
+      }
+    }
+
+    DecodedFrame frame = DecodeFrame(index, std::move(bitmap));
+
+    std::scoped_lock lock(mutex_);
+    next_decode_index_ = (index + 1) % frame_count_;
+    if (cache_all_frames_) {
+      // Cached frames are never written to again so images made from them
+      // may share their pixels.
+      if (!frame.bitmap.isNull()) {
+        frame.bitmap.setImmutable();
+      }
+      cached_frames_[index] = std::move(frame);
+      cached_frame_count_++;
+    } else {
+      ready_frames_.emplace_back(std::move(frame));
+    }
+    ScheduleServeLocked();
+  }
+}
+
+MultiFrameDecoder::DecodedFrame MultiFrameDecoder::DecodeFrame(
+    int index,
+    SkBitmap bitmap) {
+  TRACE_EVENT1("flutter", "MultiFrameDecoder::DecodeFrame", "frame",
+               std::to_string(index).c_str());
+  DecodedFrame result;
+  result.index = index;
+
+  if (bitmap.isNull() && !bitmap.tryAllocPixels(decode_info_)) {
+    FML_LOG(ERROR) << "Could not allocate pixels for frame " << index;
+    return result;
+  }
+
+  SkCodec::Options options;
+  options.fFrameIndex = index;
+  const SkCodec::FrameInfo& frame_info = frame_info_[index];
+  const int required_frame_index = frame_info.fRequiredFrame;
+  if (required_frame_index != SkCodec::kNoFrame) {
+    if (last_required_frame_.isNull()) {
+      FML_LOG(ERROR) << "Frame " << index << " depends on frame "
+                     << required_frame_index
+                     << " and no required frames are cached.";
+      return result;
+    } else if (last_required_frame_index_ != required_frame_index) {
+      FML_DLOG(INFO) << "Required frame " << required_frame_index
+                     << " is not cached. Using " << last_required_frame_index_
+                     << " instead";
+    }
+
+    // The pooled bitmap already has the right size and color type, so this is
+    // a plain copy without an allocation.
+    if (last_required_frame_.getPixels() &&
+        last_required_frame_.readPixels(bitmap.pixmap())) {
+      options.fPriorFrame = required_frame_index;
+    }
+  }
+
+  if (SkCodec::kSuccess != codec_->getPixels(decode_info_, bitmap.getPixels(),
+                                             bitmap.rowBytes(), &options)) {
+    FML_LOG(ERROR) << "Could not getPixels for frame " << index;
+    return result;
+  }
+
+  // Hold onto this if we need it to decode future frames. This shares the
+  // pixels of the decoded frame rather than copying them.
+  if (frame_info.fDisposalMethod == SkCodecAnimation::DisposalMethod::kKeep) {
+    last_required_frame_ = bitmap;
+    last_required_frame_index_ = index;
+  }
+
+  result.bitmap = std::move(bitmap);
+  return result;
+}
+
+static sk_sp<SkImage> UploadFrame(const SkBitmap& bitmap,
+                                  GrContext* resource_context) {
+  if (resource_context) {
+    SkPixmap pixmap(bitmap.info(), bitmap.pixelRef()->pixels(),
+                    bitmap.pixelRef()->rowBytes());
+    // This indicates that we do not want a "linear blending" decode.
+    sk_sp<SkColorSpace> dstColorSpace = nullptr;
+    return SkImage::MakeCrossContextFromPixmap(resource_context, pixmap, true,
+                                               dstColorSpace.get());
+  } else {
+    // Defer decoding until time of draw later on the GPU thread. Can happen
+    // when GL operations are currently forbidden such as in the background
+    // on iOS.
+    return SkImage::MakeFromBitmap(bitmap);
+  }
+}
+
+void MultiFrameDecoder::ServePendingRequests() {
+  {
+    std::scoped_lock lock(mutex_);
+    serve_scheduled_ = false;
+  }
+
+  while (true) {
+    FrameResult result;
+    DecodedFrame frame;
+    fml::WeakPtr<GrContext> resource_context;
+    {
+      std::scoped_lock lock(mutex_);
+      if (pending_requests_.empty()) {
+        break;
+      }
+      if (cache_all_frames_) {
+        const DecodedFrame& cached = cached_frames_[next_deliver_index_];
+        if (cached.index < 0) {
+          break;
+        }
+        frame = cached;
+      } else {
+        if (ready_frames_.empty()) {
+          break;
+        }
+        frame = std::move(ready_frames_.front());
+        ready_frames_.pop_front();
+      }
+      next_deliver_index_ = (next_deliver_index_ + 1) % frame_count_;
+      result = std::move(pending_requests_.front());
+      pending_requests_.pop_front();
+      resource_context = resource_context_;
+    }
+
+    sk_sp<SkImage> image;
+    if (!frame.bitmap.isNull()) {
+      image = UploadFrame(frame.bitmap, resource_context.get());
+    }
+    result(std::move(image), frame_info_[frame.index].fDuration);
+
+    if (!cache_all_frames_) {
+      RecycleBitmap(std::move(frame.bitmap));
+    }
+  }
+
+  // Whatever was just handed out is replaced by decoding further ahead.
+  std::scoped_lock lock(mutex_);
+  ScheduleDecodeLocked();
+}
+
+void MultiFrameDecoder::RecycleBitmap(SkBitmap bitmap) {
+  // The decode task may still be holding on to the pixels as the required
+  // frame of the next frame. Those bitmaps are released instead.
+  if (bitmap.isNull() || !bitmap.pixelRef()->unique()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (bitmap_pool_.size() < look_ahead_limit_) {
+    bitmap_pool_.emplace_back(std::move(bitmap));
+  }
+}
+
+}  // namespace flutter
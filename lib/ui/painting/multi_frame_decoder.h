@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/gpu/GrContext.h"
+
+namespace flutter {
+
+// Decodes the frames of an animated image ahead of the time they are
+// requested.
+//
+// Frames are decoded in order on a concurrent (worker) task runner into a
+// small pool of recycled bitmaps and handed out in order on the IO task runner,
+// where they are uploaded to the resource context. At most
+// |Options::look_ahead_frames| decoded frames (and no more than
+// |Options::max_look_ahead_bytes|) are kept waiting. Animations small enough to
+// fit in |Options::max_fully_cached_bytes| are decoded exactly once and their
+// frames are kept for subsequent loops.
+class MultiFrameDecoder
+    : public std::enable_shared_from_this<MultiFrameDecoder> {
+ public:
+  struct Options {
+    // The number of frames decoded ahead of the next requested frame.
+    size_t look_ahead_frames = 2;
+    // The upper bound on memory used by frames decoded ahead. At least one
+    // frame is always decoded ahead.
+    size_t max_look_ahead_bytes = 16 * 1024 * 1024;
+    // Animations whose frames together fit within this many bytes keep all
+    // their decoded frames after the first loop. Zero disables the cache.
+    size_t max_fully_cached_bytes = 2 * 1024 * 1024;
+  };
+
+  // Invoked on the IO task runner with the next frame, or with a null image if
+  // the frame could not be decoded. The duration is in milliseconds.
+  using FrameResult = std::function<void(sk_sp<SkImage> image, int duration)>;
+
+  MultiFrameDecoder(std::unique_ptr<SkCodec> codec, Options options);
+
+  ~MultiFrameDecoder();
+
+  int frame_count() const { return frame_count_; }
+
+  int repetition_count() const { return repetition_count_; }
+
+  // Whether all frames are held decoded and no more decoding will take place.
+  bool IsFullyCached() const;
+
+  // Requests the next frame in the animation. Must be called on
+  // |io_task_runner|. If |decode_task_runner| is null, frames are decoded on
+  // the IO task runner.
+  void GetNextFrame(
+      fml::RefPtr<fml::TaskRunner> io_task_runner,
+      std::shared_ptr<fml::ConcurrentTaskRunner> decode_task_runner,
+      fml::WeakPtr<GrContext> resource_context,
+      FrameResult result);
+
+ private:
+  struct DecodedFrame {
+    // -1 for cache entries that have not been decoded yet.
+    int index = -1;
+    // Null if the frame could not be decoded.
+    SkBitmap bitmap;
+  };
+
+  // Only accessed by the (serialized) decode task.
+  const std::unique_ptr<SkCodec> codec_;
+  const std::vector<SkCodec::FrameInfo> frame_info_;
+  const int frame_count_;
+  const int repetition_count_;
+  const SkImageInfo decode_info_;
+  const size_t look_ahead_limit_;
+  const bool cache_all_frames_;
+
+  // The last decoded frame that's required to decode any subsequent frames.
+  // Only accessed by the decode task.
+  SkBitmap last_required_frame_;
+  int last_required_frame_index_ = -1;
+
+  mutable std::mutex mutex_;
+  fml::RefPtr<fml::TaskRunner> io_task_runner_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> decode_task_runner_;
+  fml::WeakPtr<GrContext> resource_context_;
+  std::deque<FrameResult> pending_requests_;
+  std::deque<DecodedFrame> ready_frames_;
+  std::vector<SkBitmap> bitmap_pool_;
+  // Only populated if |cache_all_frames_|.
+  std::vector<DecodedFrame> cached_frames_;
+  size_t cached_frame_count_ = 0;
+  int next_decode_index_ = 0;
+  int next_deliver_index_ = 0;
+  bool decode_scheduled_ = false;
+  bool serve_scheduled_ = false;
+
+  bool IsFullyCachedLocked() const;
+
+  bool ShouldDecodeLocked() const;
+
+  void ScheduleDecodeLocked();
+
+  void ScheduleServeLocked();
+
+  // Decodes frames until enough are waiting. Runs on the decode task runner.
+  void DecodeAhead();
+
+  DecodedFrame DecodeFrame(int index, SkBitmap bitmap);
+
+  // Hands out decoded frames to pending requests. Runs on the IO task runner.
+  void ServePendingRequests();
+
+  void RecycleBitmap(SkBitmap bitmap);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MultiFrameDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
@@ -0,0 +1,196 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/thread.h"
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+static constexpr size_t kConcurrentAnimations = 20;
+static constexpr int kAnimationSize = 200;
+static constexpr int kAnimationFrameCount = 24;
+static constexpr auto kFrameInterval = std::chrono::milliseconds(16);
+
+// Appends |pixels| as GIF image data using 9 bit literal codes only. The output
+// is larger than a real encoder's but takes the same decoding path.
+static void AppendUncompressedGIFImageData(std::vector<uint8_t>* gif,
+                                           const std::vector<uint8_t>& pixels) {
+  constexpr uint32_t kClearCode = 256;
+  constexpr uint32_t kEndCode = 257;
+
+  std::vector<uint8_t> data;
+  uint32_t bits = 0;
+  uint32_t bit_count = 0;
+  auto write_code = [&](uint32_t code) {
+    bits |= code << bit_count;
+    bit_count += 9;
+    while (bit_count >= 8) {
+      data.push_back(bits & 0xFF);
+      bits >>= 8;
+      bit_count -= 8;
+    }
+  };
+
+  write_code(kClearCode);
+  size_t literals = 0;
+  for (uint8_t pixel : pixels) {
+    // Reset the code table before it would need 10 bit codes.
+    if (literals == 254) {
+      write_code(kClearCode);
+      literals = 0;
+    }
+    write_code(pixel);
+    literals++;
+  }
+  write_code(kEndCode);
+  if (bit_count > 0) {
+    data.push_back(bits & 0xFF);
+  }
+
+  gif->push_back(8);  // LZW minimum code size.
+  for (size_t offset = 0; offset < data.size(); offset += 255) {
+    size_t length = std::min<size_t>(255, data.size() - offset);
+    gif->push_back(length);
+    gif->insert(gif->end(), data.begin() + offset,
+                data.begin() + offset + length);
+  }
+  gif->push_back(0);
+}
+
+// An animation of a square moving over a full background. Every frame after
+// the first depends on the previous one, like most animated GIFs.
+static sk_sp<SkData> CreateAnimatedGIF(int seed) {
+  auto append16 = [](std::vector<uint8_t>* gif, int value) {
+    gif->push_back(value & 0xFF);
+    gif->push_back((value >> 8) & 0xFF);
+  };
+
+  std::vector<uint8_t> gif = {'G', 'I', 'F', '8', '9', 'a'};
+  append16(&gif, kAnimationSize);
+  append16(&gif, kAnimationSize);
+  gif.insert(gif.end(), {0xF7, 0, 0});  // 256 entry global color table.
+  for (int i = 0; i < 256; i++) {
+    gif.insert(gif.end(), {static_cast<uint8_t>(i),
+                           static_cast<uint8_t>((i * 3 + seed) & 0xFF),
+                           static_cast<uint8_t>(255 - i)});
+  }
+  const char loop[] = "\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00";
+  gif.insert(gif.end(), loop, loop + sizeof(loop) - 1);
+
+  const int square = kAnimationSize / 4;
+  for (int frame = 0; frame < kAnimationFrameCount; frame++) {
+    const bool first = frame == 0;
+    const int x = first ? 0 : (frame * 7) % (kAnimationSize - square);
+    const int y = first ? 0 : (frame * 5) % (kAnimationSize - square);
+    const int size = first ? kAnimationSize : square;
+
+    // Graphic control extension: keep the frame, 20ms delay.
+    gif.insert(gif.end(), {0x21, 0xF9, 0x04, 1 << 2, 2, 0, 0, 0});
+    gif.push_back(0x2C);
+    append16(&gif, x);
+    append16(&gif, y);
+    append16(&gif, size);
+    append16(&gif, size);
+    gif.push_back(0);
+
+    std::vector<uint8_t> pixels(size * size);
+    for (size_t i = 0; i < pixels.size(); i++) {
+      pixels[i] = (i / size + i % size + frame + seed) & 0xFF;
+    }
+    AppendUncompressedGIFImageData(&gif, pixels);
+  }
+  gif.push_back(0x3B);
+
+  return SkData::MakeWithCopy(gif.data(), gif.size());
+}
+
+// Plays |kConcurrentAnimations| animations at once. Every iteration is one
+// animation tick in which each animation asks for its next frame, and the
+// reported time is how long it took until all of them had it. Ticks are spaced
+// by a frame interval so that look-ahead decoding has a chance to run.
+static void BM_MultiFrameDecoderConcurrentAnimations(
+    benchmark::State& state,
+    bool use_decode_pool,
+    size_t look_ahead_frames) {
+  fml::Thread io_thread("io");
+  auto io_task_runner = io_thread.GetTaskRunner();
+  std::shared_ptr<fml::ConcurrentMessageLoop> decode_loop;
+  std::shared_ptr<fml::ConcurrentTaskRunner> decode_task_runner;
+  if (use_decode_pool) {
+    decode_loop = fml::ConcurrentMessageLoop::Create();
+    decode_task_runner = decode_loop->GetTaskRunner();
+  }
+
+  MultiFrameDecoder::Options options;
+  options.look_ahead_frames = look_ahead_frames;
+  options.max_fully_cached_bytes = 0;
+
+  std::vector<std::shared_ptr<MultiFrameDecoder>> decoders;
+  for (size_t i = 0; i < kConcurrentAnimations; i++) {
+    auto codec = SkCodec::MakeFromData(CreateAnimatedGIF(i));
+    FML_CHECK(codec);
+    FML_CHECK(codec->getFrameCount() == kAnimationFrameCount);
+    decoders.emplace_back(
+        std::make_shared<MultiFrameDecoder>(std::move(codec), options));
+  }
+
+  while (state.KeepRunning()) {
+    const auto tick_start = std::chrono::high_resolution_clock::now();
+
+    fml::CountDownLatch frames_received(kConcurrentAnimations);
+    for (const auto& decoder : decoders) {
+      io_task_runner->PostTask([&, decoder]() {
+        decoder->GetNextFrame(io_task_runner, decode_task_runner, {},
+                              [&](sk_sp<SkImage> image, int duration) {
+                                FML_CHECK(image);
+                                frames_received.CountDown();
+                              });
+      });
+    }
+    frames_received.Wait();
+
+    const auto tick_end = std::chrono::high_resolution_clock::now();
+    state.SetIterationTime(
+        std::chrono::duration_cast<std::chrono::duration<double>>(tick_end -
+                                                                  tick_start)
+            .count());
+
+    std::this_thread::sleep_until(tick_start + kFrameInterval);
+  }
+}
+
+// Approximates decoding on the IO thread as frames are requested.
+BENCHMARK_CAPTURE(BM_MultiFrameDecoderConcurrentAnimations,
+                  IOThreadLookAhead1,
+                  false,
+                  1)
+    ->Iterations(120)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_MultiFrameDecoderConcurrentAnimations,
+                  PoolLookAhead1,
+                  true,
+                  1)
+    ->Iterations(120)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_MultiFrameDecoderConcurrentAnimations,
+                  PoolLookAhead3,
+                  true,
+                  3)
+    ->Iterations(120)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
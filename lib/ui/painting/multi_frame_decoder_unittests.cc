@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
+#include "flutter/testing/testing.h"
+#include "flutter/testing/thread_test.h"
+
+namespace flutter {
+namespace testing {
+
+using MultiFrameDecoderTest = ThreadTest;
+
+// A 32x32 GIF with four frames of 50, 60, 70 and 80 milliseconds. All but the
+// first frame only cover part of the image and depend on the frame before.
+static constexpr char kAnimatedFixture[] = "AnimatedSquares.gif";
+static const std::vector<int> kFixtureDurations = {50, 60, 70, 80};
+
+static std::unique_ptr<SkCodec> OpenFixtureCodec(const char* name) {
+  auto fixtures_directory =
+      fml::OpenDirectory(GetFixturesPath(), false, fml::FilePermission::kRead);
+  auto mapping = fml::FileMapping::CreateReadOnly(fixtures_directory, name);
+  if (!mapping) {
+    return nullptr;
+  }
+  return SkCodec::MakeFromData(
+      SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize()));
+}
+
+// Requests |count| frames one after the other, like an animation would, and
+// returns their durations. Frames that fail to decode are recorded as -1.
+static std::vector<int> GetFrames(
+    const std::shared_ptr<MultiFrameDecoder>& decoder,
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    std::shared_ptr<fml::ConcurrentTaskRunner> decode_task_runner,
+    size_t count) {
+  std::vector<int> durations;
+  for (size_t i = 0; i < count; i++) {
+    fml::AutoResetWaitableEvent latch;
+    io_task_runner->PostTask([&]() {
+      decoder->GetNextFrame(
+          io_task_runner, decode_task_runner, {},
+          [&](sk_sp<SkImage> image, int duration) {
+            EXPECT_TRUE(io_task_runner->RunsTasksOnCurrentThread());
+            durations.push_back(image ? duration : -1);
+            latch.Signal();
+          });
+    });
+    latch.Wait();
+  }
+  return durations;
+}
+
+TEST_F(MultiFrameDecoderTest, FramesAreDeliveredInOrderAndLoop) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto io_task_runner = CreateNewThread("io");
+
+  auto codec = OpenFixtureCodec(kAnimatedFixture);
+  ASSERT_TRUE(codec);
+  MultiFrameDecoder::Options options;
+  options.max_fully_cached_bytes = 0;
+  auto decoder =
+      std::make_shared<MultiFrameDecoder>(std::move(codec), options);
+  ASSERT_EQ(decoder->frame_count(), 4);
+
+  auto durations =
+      GetFrames(decoder, io_task_runner, loop->GetTaskRunner(), 10);
+  std::vector<int> expected;
+  for (size_t i = 0; i < 10; i++) {
+    expected.push_back(kFixtureDurations[i % kFixtureDurations.size()]);
+  }
+  ASSERT_EQ(durations, expected);
+  ASSERT_FALSE(decoder->IsFullyCached());
+}
+
+TEST_F(MultiFrameDecoderTest, CanDecodeOnTheIOTaskRunner) {
+  auto io_task_runner = CreateNewThread("io");
+
+  auto codec = OpenFixtureCodec(kAnimatedFixture);
+  ASSERT_TRUE(codec);
+  auto decoder = std::make_shared<MultiFrameDecoder>(
+      std::move(codec), MultiFrameDecoder::Options{});
+
+  auto durations = GetFrames(decoder, io_task_runner, nullptr, 4);
+  ASSERT_EQ(durations, kFixtureDurations);
+}
+
+TEST_F(MultiFrameDecoderTest, SmallAnimationsAreFullyCached) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto io_task_runner = CreateNewThread("io");
+
+  auto codec = OpenFixtureCodec(kAnimatedFixture);
+  ASSERT_TRUE(codec);
+  auto decoder = std::make_shared<MultiFrameDecoder>(
+      std::move(codec), MultiFrameDecoder::Options{});
+
+  auto durations =
+      GetFrames(decoder, io_task_runner, loop->GetTaskRunner(), 8);
+  ASSERT_EQ(durations.size(), 8u);
+  ASSERT_EQ(durations[7], kFixtureDurations[3]);
+  ASSERT_TRUE(decoder->IsFullyCached());
+}
+
+}  // namespace testing
+}  // namespace flutter
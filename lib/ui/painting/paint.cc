@@ -32,13 +32,15 @@ constexpr int kMaskFilterIndex = 9;
 constexpr int kMaskFilterBlurStyleIndex = 10;
 constexpr int kMaskFilterSigmaIndex = 11;
 constexpr int kInvertColorIndex = 12;
-constexpr size_t kDataByteCount = 52;  // 4 * (last index + 1)
+static_assert(Paint::kDataByteCount == 4 * (kInvertColorIndex + 1),
+              "kDataByteCount must cover the last index");
 
 // Indices for objects.
 constexpr int kShaderIndex = 0;
 constexpr int kColorFilterIndex = 1;
 constexpr int kImageFilterIndex = 2;
-constexpr int kObjectCount = 3;  // One larger than largest object index.
+static_assert(Paint::kObjectCount == kImageFilterIndex + 1,
+              "kObjectCount must be one larger than the largest object index");
 
 // Must be kept in sync with the default in painting.dart.
 constexpr uint32_t kColorDefault = 0xFF000000;
@@ -69,42 +71,63 @@ Paint::Paint(Dart_Handle paint_objects, Dart_Handle paint_data) {
   if (is_null_)
     return;
 
-  Dart_Handle values[kObjectCount];
+  PaintObjects objects;
   if (!Dart_IsNull(paint_objects)) {
     FML_DCHECK(Dart_IsList(paint_objects));
     intptr_t length = 0;
     Dart_ListLength(paint_objects, &length);
 
     FML_CHECK(length == kObjectCount);
-    if (Dart_IsError(Dart_ListGetRange(paint_objects, 0, kObjectCount, values)))
+    if (!UnwrapObjects(paint_objects, 0, &objects))
       return;
+  }
 
-    Dart_Handle shader = values[kShaderIndex];
-    if (!Dart_IsNull(shader)) {
-      Shader* decoded = tonic::DartConverter<Shader*>::FromDart(shader);
-      paint_.setShader(decoded->shader());
-    }
+  tonic::DartByteData byte_data(paint_data);
+  FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
+  Decode(objects, byte_data.data());
+}
 
-    Dart_Handle color_filter = values[kColorFilterIndex];
-    if (!Dart_IsNull(color_filter)) {
-      ColorFilter* decoded_color_filter =
-          tonic::DartConverter<ColorFilter*>::FromDart(color_filter);
-      paint_.setColorFilter(decoded_color_filter->filter());
-    }
+Paint::Paint(const PaintObjects& objects, const void* paint_data) {
+  is_null_ = false;
+  Decode(objects, paint_data);
+}
 
-    Dart_Handle image_filter = values[kImageFilterIndex];
-    if (!Dart_IsNull(image_filter)) {
-      ImageFilter* decoded =
-          tonic::DartConverter<ImageFilter*>::FromDart(image_filter);
-      paint_.setImageFilter(decoded->filter());
-    }
+bool Paint::UnwrapObjects(Dart_Handle list,
+                          intptr_t start,
+                          PaintObjects* objects) {
+  Dart_Handle values[kObjectCount];
+  if (Dart_IsError(Dart_ListGetRange(list, start, kObjectCount, values)))
+    return false;
+
+  Dart_Handle shader = values[kShaderIndex];
+  if (!Dart_IsNull(shader)) {
+    Shader* decoded = tonic::DartConverter<Shader*>::FromDart(shader);
+    objects->shader = decoded->shader();
   }
 
-  tonic::DartByteData byte_data(paint_data);
-  FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
+  Dart_Handle color_filter = values[kColorFilterIndex];
+  if (!Dart_IsNull(color_filter)) {
+    ColorFilter* decoded_color_filter =
+        tonic::DartConverter<ColorFilter*>::FromDart(color_filter);
+    objects->color_filter = decoded_color_filter->filter();
+  }
+
+  Dart_Handle image_filter = values[kImageFilterIndex];
+  if (!Dart_IsNull(image_filter)) {
+    ImageFilter* decoded =
+        tonic::DartConverter<ImageFilter*>::FromDart(image_filter);
+    objects->image_filter = decoded->filter();
+  }
+  return true;
+}
+
+void Paint::Decode(const PaintObjects& objects, const void* paint_data) {
+  paint_.setShader(objects.shader);
+  paint_.setColorFilter(objects.color_filter);
+  paint_.setImageFilter(objects.image_filter);
 
-  const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
+  const uint32_t* uint_data = static_cast<const uint32_t*>(paint_data);
+  const float* float_data = static_cast<const float*>(paint_data);
 
   paint_.setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
 
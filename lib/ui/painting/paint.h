@@ -5,21 +5,52 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PAINT_H_
 #define FLUTTER_LIB_UI_PAINTING_PAINT_H_
 
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
 #include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkShader.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
 namespace flutter {
 
+// The objects of a Paint that cannot be encoded as data, unwrapped from their
+// Dart wrappers.
+struct PaintObjects {
+  sk_sp<SkShader> shader;
+  sk_sp<SkColorFilter> color_filter;
+  sk_sp<SkImageFilter> image_filter;
+};
+
 class Paint {
  public:
+  // The size of Paint._data in painting.dart.
+  static constexpr size_t kDataByteCount = 52;
+
+  // The number of entries in Paint._objects in painting.dart.
+  static constexpr intptr_t kObjectCount = 3;
+
   Paint() = default;
   Paint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
+  // |paint_data| must hold |kDataByteCount| bytes encoded like Paint._data.
+  // This does not call into the VM, so it can be used while typed data is
+  // acquired.
+  Paint(const PaintObjects& objects, const void* paint_data);
+
+  // Unwraps the |kObjectCount| objects of a paint starting at |start| in
+  // |list|, which is a Paint._objects list or several of them concatenated.
+  // Returns false if they could not be read.
+  static bool UnwrapObjects(Dart_Handle list,
+                            intptr_t start,
+                            PaintObjects* objects);
+
   const SkPaint* paint() const { return is_null_ ? nullptr : &paint_; }
 
  private:
   friend struct tonic::DartConverter<Paint>;
 
+  void Decode(const PaintObjects& objects, const void* paint_data);
+
   SkPaint paint_;
   bool is_null_ = true;
 };
@@ -0,0 +1,209 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/rect_instances.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkVertices.h"
+
+namespace flutter {
+
+namespace {
+
+// SkVertices indices are 16 bits, and each rectangle takes four vertices.
+constexpr size_t kMaxRectsPerMesh =
+    (std::numeric_limits<uint16_t>::max() + 1) / 4;
+
+// The number of independent minimums and maximums kept while computing
+// bounds. Must be even.
+constexpr size_t kBoundsLaneCount = 8;
+
+// Writes the corners of rectangle |index| in clockwise order.
+void GetCorners(size_t index,
+                const float* positions,
+                const float* sizes,
+                const float* transforms,
+                SkPoint corners[4]) {
+  const float left = positions[2 * index];
+  const float top = positions[2 * index + 1];
+  const float right = left + sizes[2 * index];
+  const float bottom = top + sizes[2 * index + 1];
+  corners[0] = {left, top};
+  corners[1] = {right, top};
+  corners[2] = {right, bottom};
+  corners[3] = {left, bottom};
+  if (transforms) {
+    const float* xform = transforms + 4 * index;
+    for (int i = 0; i < 4; i++) {
+      const SkPoint p = corners[i];
+      corners[i] = {xform[0] * p.x() - xform[1] * p.y() + xform[2],
+                    xform[1] * p.x() + xform[0] * p.y() + xform[3]};
+    }
+  }
+}
+
+// Whether drawing the rectangles as meshes looks the same as drawing them one
+// by one. Meshes are not antialiased, the vertex colors stand in for the
+// paint's, and filters would apply to the mesh as a whole, so the paint can
+// only fill with a plain color.
+bool CanDrawAsMeshes(const SkPaint& paint) {
+  return paint.getStyle() == SkPaint::kFill_Style && !paint.isAntiAlias() &&
+         !paint.getShader() && !paint.getMaskFilter() &&
+         !paint.getPathEffect() && !paint.getImageFilter();
+}
+
+void DrawMeshes(SkCanvas* canvas,
+                const SkPaint& paint,
+                size_t count,
+                const float* positions,
+                const float* sizes,
+                const SkColor* colors,
+                const float* transforms) {
+  // The vertex colors are used as they are.
+  SkPaint mesh_paint = paint;
+  mesh_paint.setColor(SK_ColorBLACK);
+
+  for (size_t start = 0; start < count; start += kMaxRectsPerMesh) {
+    const size_t rect_count = std::min(count - start, kMaxRectsPerMesh);
+    SkVertices::Builder builder(SkVertices::kTriangles_VertexMode,
+                                rect_count * 4, rect_count * 6,
+                                SkVertices::kHasColors_BuilderFlag);
+    if (!builder.isValid())
+      return;
+
+    SkPoint* vertex_positions = builder.positions();
+    SkColor* vertex_colors = builder.colors();
+    uint16_t* indices = builder.indices();
+    for (size_t i = 0; i < rect_count; i++) {
+      GetCorners(start + i, positions, sizes, transforms,
+                 vertex_positions + 4 * i);
+      std::fill_n(vertex_colors + 4 * i, 4, colors[start + i]);
+      const uint16_t first = 4 * i;
+      uint16_t* rect_indices = indices + 6 * i;
+      rect_indices[0] = first;
+      rect_indices[1] = first + 1;
+      rect_indices[2] = first + 2;
+      rect_indices[3] = first + 2;
+      rect_indices[4] = first + 3;
+      rect_indices[5] = first;
+    }
+    canvas->drawVertices(builder.detach(), SkBlendMode::kDst, mesh_paint);
+  }
+}
+
+void DrawOneByOne(SkCanvas* canvas,
+                  const SkPaint& paint,
+                  size_t count,
+                  const float* positions,
+                  const float* sizes,
+                  const SkColor* colors,
+                  const float* transforms) {
+  SkPaint rect_paint = paint;
+  for (size_t i = 0; i < count; i++) {
+    rect_paint.setColor(colors[i]);
+    const SkRect rect =
+        SkRect::MakeXYWH(positions[2 * i], positions[2 * i + 1], sizes[2 * i],
+                         sizes[2 * i + 1]);
+    if (!transforms) {
+      canvas->drawRect(rect, rect_paint);
+      continue;
+    }
+    const float* xform = transforms + 4 * i;
+    SkMatrix matrix;
+    matrix.setRSXform(SkRSXform::Make(xform[0], xform[1], xform[2], xform[3]));
+    canvas->save();
+    canvas->concat(matrix);
+    canvas->drawRect(rect, rect_paint);
+    canvas->restore();
+  }
+}
+
+}  // namespace
+
+SkRect ComputeRectInstancesBounds(size_t count,
+                                  const float* positions,
+                                  const float* sizes,
+                                  const float* transforms) {
+  if (count == 0)
+    return SkRect::MakeEmpty();
+
+  // Even lanes accumulate x values and odd lanes y values.
+  float low[kBoundsLaneCount];
+  float high[kBoundsLaneCount];
+  std::fill_n(low, kBoundsLaneCount, std::numeric_limits<float>::infinity());
+  std::fill_n(high, kBoundsLaneCount, -std::numeric_limits<float>::infinity());
+
+  if (!transforms) {
+    // The positions and sizes are pairs of x and y, so they can be handled as
+    // one run of values. Keeping a separate minimum and maximum per lane
+    // rather than one per axis lets the compiler vectorize the main loop.
+    const size_t value_count = 2 * count;
+    size_t i = 0;
+    for (; i + kBoundsLaneCount <= value_count; i += kBoundsLaneCount) {
+      for (size_t lane = 0; lane < kBoundsLaneCount; lane++) {
+        const float start = positions[i + lane];
+        const float end = start + sizes[i + lane];
+        low[lane] = std::min(low[lane], std::min(start, end));
+        high[lane] = std::max(high[lane], std::max(start, end));
+      }
+    }
+    for (; i < value_count; i++) {
+      const float start = positions[i];
+      const float end = start + sizes[i];
+      low[i % 2] = std::min(low[i % 2], std::min(start, end));
+      high[i % 2] = std::max(high[i % 2], std::max(start, end));
+    }
+  } else {
+    SkPoint corners[4];
+    for (size_t i = 0; i < count; i++) {
+      GetCorners(i, positions, sizes, transforms, corners);
+      for (const SkPoint& corner : corners) {
+        low[0] = std::min(low[0], corner.x());
+        low[1] = std::min(low[1], corner.y());
+        high[0] = std::max(high[0], corner.x());
+        high[1] = std::max(high[1], corner.y());
+      }
+    }
+  }
+
+  for (size_t lane = 2; lane < kBoundsLaneCount; lane++) {
+    low[lane % 2] = std::min(low[lane % 2], low[lane]);
+    high[lane % 2] = std::max(high[lane % 2], high[lane]);
+  }
+  return SkRect::MakeLTRB(low[0], low[1], high[0], high[1]);
+}
+
+void DrawRectInstances(SkCanvas* canvas,
+                       const SkPaint& paint,
+                       size_t count,
+                       const float* positions,
+                       const float* sizes,
+                       const SkColor* colors,
+                       const float* transforms) {
+  TRACE_EVENT0("flutter", "DrawRectInstances");
+  if (count == 0)
+    return;
+
+  // Skip the whole set at once when it is out of view.
+  if (paint.canComputeFastBounds()) {
+    SkRect storage;
+    const SkRect& bounds = paint.computeFastBounds(
+        ComputeRectInstancesBounds(count, positions, sizes, transforms),
+        &storage);
+    if (canvas->quickReject(bounds))
+      return;
+  }
+
+  if (CanDrawAsMeshes(paint)) {
+    DrawMeshes(canvas, paint, count, positions, sizes, colors, transforms);
+  } else {
+    DrawOneByOne(canvas, paint, count, positions, sizes, colors, transforms);
+  }
+}
+
+}  // namespace flutter
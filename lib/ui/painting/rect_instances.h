@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_RECT_INSTANCES_H_
+#define FLUTTER_LIB_UI_PAINTING_RECT_INSTANCES_H_
+
+#include <cstddef>
+
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flutter {
+
+// Draws |count| rectangles given as separate arrays: |positions| and |sizes|
+// hold an x, y pair per rectangle for its top left corner and its width and
+// height, |colors| one color per rectangle, and |transforms|, which can be
+// null, an RSTransform (scos, ssin, tx, ty) per rectangle applied to it.
+//
+// Each rectangle is drawn with |paint|, its color replaced by the rectangle's.
+// When the paint allows it, the rectangles are drawn as a few triangle meshes
+// rather than one by one.
+void DrawRectInstances(SkCanvas* canvas,
+                       const SkPaint& paint,
+                       size_t count,
+                       const float* positions,
+                       const float* sizes,
+                       const SkColor* colors,
+                       const float* transforms);
+
+// Returns the bounds of the rectangles, as passed to |DrawRectInstances|.
+SkRect ComputeRectInstancesBounds(size_t count,
+                                  const float* positions,
+                                  const float* sizes,
+                                  const float* transforms);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_RECT_INSTANCES_H_
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/lib/ui/painting/rect_instances.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+
+// A heat map of |count| pixel aligned cells on a 1000 wide grid.
+struct HeatMap {
+  explicit HeatMap(size_t count)
+      : positions(2 * count), sizes(2 * count), colors(count) {
+    for (size_t i = 0; i < count; i++) {
+      positions[2 * i] = (i % 1000) * 4;
+      positions[2 * i + 1] = (i / 1000) * 4;
+      sizes[2 * i] = 4;
+      sizes[2 * i + 1] = 4;
+      colors[i] = 0xFF000000 | ((i * 0x1F3D5B) & 0xFFFFFF);
+    }
+  }
+
+  std::vector<float> positions;
+  std::vector<float> sizes;
+  std::vector<SkColor> colors;
+};
+
+// What the engine does for a drawRect call per cell, leaving out the cost of
+// the calls from Dart.
+static void BM_RectInstancesOneByOne(benchmark::State& state) {
+  const HeatMap map(state.range(0));
+  SkPaint paint;
+  while (state.KeepRunning()) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(4000, 4000);
+    for (size_t i = 0; i < map.colors.size(); i++) {
+      paint.setColor(map.colors[i]);
+      canvas->drawRect(
+          SkRect::MakeXYWH(map.positions[2 * i], map.positions[2 * i + 1],
+                           map.sizes[2 * i], map.sizes[2 * i + 1]),
+          paint);
+    }
+    benchmark::DoNotOptimize(recorder.finishRecordingAsPicture());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_RectInstancesMeshes(benchmark::State& state) {
+  const HeatMap map(state.range(0));
+  SkPaint paint;
+  while (state.KeepRunning()) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(4000, 4000);
+    DrawRectInstances(canvas, paint, map.colors.size(), map.positions.data(),
+                      map.sizes.data(), map.colors.data(), nullptr);
+    benchmark::DoNotOptimize(recorder.finishRecordingAsPicture());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_RectInstancesBounds(benchmark::State& state) {
+  const HeatMap map(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(ComputeRectInstancesBounds(
+        map.colors.size(), map.positions.data(), map.sizes.data(), nullptr));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RectInstancesOneByOne)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RectInstancesMeshes)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RectInstancesBounds)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
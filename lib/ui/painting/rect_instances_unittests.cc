@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/rect_instances.h"
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+namespace testing {
+
+// Returns the number of draws recorded for |count| 1x1 rectangles in a row.
+static int CountDraws(size_t count, const SkPaint& paint) {
+  std::vector<float> positions(2 * count);
+  std::vector<float> sizes(2 * count, 1);
+  std::vector<SkColor> colors(count, SK_ColorRED);
+  for (size_t i = 0; i < count; i++) {
+    positions[2 * i] = i % 100;
+    positions[2 * i + 1] = i / 100;
+  }
+
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(1000, 1000);
+  DrawRectInstances(canvas, paint, count, positions.data(), sizes.data(),
+                    colors.data(), nullptr);
+  return recorder.finishRecordingAsPicture()->approximateOpCount();
+}
+
+TEST(RectInstancesTest, ComputesBounds) {
+  const float positions[] = {10, 20, 50, 60};
+  const float sizes[] = {5, -5, 10, 10};
+  ASSERT_EQ(ComputeRectInstancesBounds(2, positions, sizes, nullptr),
+            SkRect::MakeLTRB(10, 15, 60, 70));
+
+  // Rotated a quarter turn and moved right by 100.
+  const float transforms[] = {0, 1, 100, 0, 0, 1, 100, 0};
+  ASSERT_EQ(ComputeRectInstancesBounds(2, positions, sizes, transforms),
+            SkRect::MakeLTRB(30, 10, 85, 60));
+}
+
+TEST(RectInstancesTest, PlainFillsAreDrawnAsMeshes) {
+  SkPaint paint;
+  // Two meshes, as one can only hold 16384 rectangles.
+  ASSERT_EQ(CountDraws(20000, paint), 2);
+
+  paint.setAntiAlias(true);
+  ASSERT_EQ(CountDraws(20000, paint), 20000);
+
+  paint.setAntiAlias(false);
+  paint.setStyle(SkPaint::kStroke_Style);
+  ASSERT_EQ(CountDraws(100, paint), 100);
+}
+
+}  // namespace testing
+}  // namespace flutter
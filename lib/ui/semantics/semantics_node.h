@@ -80,6 +80,12 @@ struct SemanticsNode {
 
   SemanticsNode(const SemanticsNode& other);
 
+  SemanticsNode(SemanticsNode&& other);
+
+  SemanticsNode& operator=(const SemanticsNode& other);
+
+  SemanticsNode& operator=(SemanticsNode&& other);
+
   ~SemanticsNode();
 
   bool HasAction(SemanticsAction action) const;
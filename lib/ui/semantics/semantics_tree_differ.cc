@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_tree_differ.h"
+
+#include <cmath>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// The id of the root node, whose descendants make up the tree.
+constexpr int32_t kRootSemanticsNodeId = 0;
+
+// Unset scroll positions are NaN, which must compare equal to themselves.
+bool DoublesAreEqual(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// Ordered roughly from the cheapest and most likely to change fields to the
+// most expensive.
+bool NodesAreEqual(const SemanticsNode& a, const SemanticsNode& b) {
+  return a.flags == b.flags && a.actions == b.actions && a.rect == b.rect &&
+         DoublesAreEqual(a.scrollPosition, b.scrollPosition) &&
+         a.textSelectionBase == b.textSelectionBase &&
+         a.textSelectionExtent == b.textSelectionExtent &&
+         a.platformViewId == b.platformViewId &&
+         a.scrollChildren == b.scrollChildren &&
+         a.scrollIndex == b.scrollIndex &&
+         DoublesAreEqual(a.scrollExtentMax, b.scrollExtentMax) &&
+         DoublesAreEqual(a.scrollExtentMin, b.scrollExtentMin) &&
+         a.elevation == b.elevation && a.thickness == b.thickness &&
+         a.textDirection == b.textDirection && a.label == b.label &&
+         a.value == b.value && a.hint == b.hint &&
+         a.increasedValue == b.increasedValue &&
+         a.decreasedValue == b.decreasedValue && a.transform == b.transform &&
+         a.childrenInTraversalOrder == b.childrenInTraversalOrder &&
+         a.childrenInHitTestOrder == b.childrenInHitTestOrder &&
+         a.customAccessibilityActions == b.customAccessibilityActions;
+}
+
+bool ActionsAreEqual(const CustomAccessibilityAction& a,
+                     const CustomAccessibilityAction& b) {
+  return a.overrideId == b.overrideId && a.label == b.label &&
+         a.hint == b.hint;
+}
+
+}  // namespace
+
+SemanticsTreeDiffer::SemanticsTreeDiffer() = default;
+
+SemanticsTreeDiffer::~SemanticsTreeDiffer() = default;
+
+bool SemanticsTreeDiffer::Diff(SemanticsNodeUpdates& nodes,
+                               CustomAccessibilityActionUpdates& actions) {
+  TRACE_EVENT0("flutter", "SemanticsTreeDiffer::Diff");
+
+  // Nodes can only leave the tree when the children of a node change.
+  bool children_changed = false;
+  for (auto node = nodes.begin(); node != nodes.end();) {
+    auto sent = sent_nodes_.find(node->first);
+    if (sent == sent_nodes_.end()) {
+      sent_nodes_.emplace(node->first, node->second);
+      ++node;
+      continue;
+    }
+    if (NodesAreEqual(sent->second, node->second)) {
+      node = nodes.erase(node);
+      continue;
+    }
+    children_changed = children_changed ||
+                       sent->second.childrenInTraversalOrder !=
+                           node->second.childrenInTraversalOrder;
+    sent->second = node->second;
+    ++node;
+  }
+
+  if (children_changed) {
+    RemoveUnreachableNodes();
+  }
+
+  for (auto action = actions.begin(); action != actions.end();) {
+    auto sent = sent_actions_.find(action->first);
+    if (sent != sent_actions_.end() &&
+        ActionsAreEqual(sent->second, action->second)) {
+      action = actions.erase(action);
+      continue;
+    }
+    sent_actions_[action->first] = action->second;
+    ++action;
+  }
+
+  return !nodes.empty() || !actions.empty();
+}
+
+void SemanticsTreeDiffer::Reset() {
+  sent_nodes_.clear();
+  sent_actions_.clear();
+}
+
+// Mirrors how the platform views prune their trees.
+void SemanticsTreeDiffer::RemoveUnreachableNodes() {
+  TRACE_EVENT0("flutter", "SemanticsTreeDiffer::RemoveUnreachableNodes");
+  std::unordered_set<int32_t> reachable;
+  reachable.reserve(sent_nodes_.size());
+  std::vector<int32_t> pending = {kRootSemanticsNodeId};
+  while (!pending.empty()) {
+    const int32_t id = pending.back();
+    pending.pop_back();
+    auto node = sent_nodes_.find(id);
+    if (node == sent_nodes_.end() || !reachable.insert(id).second) {
+      continue;
+    }
+    pending.insert(pending.end(),
+                   node->second.childrenInTraversalOrder.begin(),
+                   node->second.childrenInTraversalOrder.end());
+  }
+
+  if (reachable.size() == sent_nodes_.size()) {
+    return;
+  }
+  for (auto node = sent_nodes_.begin(); node != sent_nodes_.end();) {
+    if (reachable.count(node->first) == 0) {
+      node = sent_nodes_.erase(node);
+    } else {
+      ++node;
+    }
+  }
+}
+
+}  // namespace flutter
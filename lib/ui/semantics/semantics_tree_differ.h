@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_DIFFER_H_
+#define FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_DIFFER_H_
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/semantics_node.h"
+
+namespace flutter {
+
+// Remembers the semantics tree last sent to the platform and removes the
+// nodes and custom actions that have not changed from later updates.
+//
+// Platform views apply updates on top of the tree they already have, so an
+// unchanged node does not need to be copied to the platform thread or
+// processed there again. Nodes that are no longer reachable from the root are
+// dropped by the platform and are forgotten here too, so that they are sent
+// again if they reappear.
+class SemanticsTreeDiffer {
+ public:
+  SemanticsTreeDiffer();
+
+  ~SemanticsTreeDiffer();
+
+  // Removes the entries that match what was last sent and records the rest as
+  // sent. Returns false if nothing is left to send.
+  bool Diff(SemanticsNodeUpdates& nodes,
+            CustomAccessibilityActionUpdates& actions);
+
+  // Forgets the sent tree. Must be called whenever the platform discards its
+  // tree, for example when semantics are disabled.
+  void Reset();
+
+  size_t GetSentNodeCount() const { return sent_nodes_.size(); }
+
+ private:
+  SemanticsNodeUpdates sent_nodes_;
+  CustomAccessibilityActionUpdates sent_actions_;
+
+  void RemoveUnreachableNodes();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SemanticsTreeDiffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_DIFFER_H_
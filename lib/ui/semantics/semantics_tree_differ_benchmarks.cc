@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/lib/ui/semantics/semantics_tree_differ.h"
+
+namespace flutter {
+
+// A data table: a root with one node per cell.
+static SemanticsNodeUpdates CreateTable(size_t cell_count, size_t frame) {
+  SemanticsNodeUpdates nodes;
+  SemanticsNode& root = nodes[0];
+  root.label = "Table";
+  root.rect = SkRect::MakeWH(1000, cell_count * 10);
+  for (size_t i = 1; i <= cell_count; i++) {
+    SemanticsNode& cell = nodes[i];
+    cell.id = i;
+    cell.flags = static_cast<int32_t>(SemanticsFlags::kIsButton);
+    cell.actions = static_cast<int32_t>(SemanticsAction::kTap);
+    cell.label = "Row " + std::to_string(i / 10) + " column " +
+                 std::to_string(i % 10);
+    // One cell in a hundred shows a live value.
+    cell.value = i % 100 == 0 ? std::to_string(frame) : "42";
+    cell.rect = SkRect::MakeXYWH((i % 10) * 100, (i / 10) * 10, 100, 10);
+    root.childrenInTraversalOrder.push_back(i);
+    root.childrenInHitTestOrder.push_back(i);
+  }
+  return nodes;
+}
+
+// Stands in for the platform view handing each node to the platform, like
+// the buffers the Android embedder fills for its accessibility bridge.
+static size_t SendToPlatform(const SemanticsNodeUpdates& nodes) {
+  std::vector<uint8_t> buffer;
+  for (const auto& entry : nodes) {
+    const SemanticsNode& node = entry.second;
+    const int32_t header[] = {node.id, node.flags, node.actions,
+                              static_cast<int32_t>(node.label.size()),
+                              static_cast<int32_t>(node.value.size())};
+    const size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(header) + sizeof(SkRect) +
+                  node.label.size() + node.value.size());
+    uint8_t* out = buffer.data() + offset;
+    std::memcpy(out, header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, &node.rect, sizeof(SkRect));
+    out += sizeof(SkRect);
+    std::memcpy(out, node.label.data(), node.label.size());
+    out += node.label.size();
+    std::memcpy(out, node.value.data(), node.value.size());
+  }
+  return buffer.size();
+}
+
+static void RunSemanticsFrames(benchmark::State& state, bool diff) {
+  const size_t cell_count = state.range(0);
+  SemanticsTreeDiffer differ;
+  size_t frame = 0;
+  size_t sent_nodes = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    auto nodes = CreateTable(cell_count, frame++);
+    CustomAccessibilityActionUpdates actions;
+    state.ResumeTiming();
+
+    if (diff) {
+      differ.Diff(nodes, actions);
+    }
+    sent_nodes += nodes.size();
+    benchmark::DoNotOptimize(SendToPlatform(nodes));
+  }
+  state.counters["sent_nodes_per_frame"] =
+      frame == 0 ? 0 : static_cast<double>(sent_nodes) / frame;
+}
+
+static void BM_SemanticsUpdateFullTree(benchmark::State& state) {
+  RunSemanticsFrames(state, false);
+}
+
+static void BM_SemanticsUpdateDiffed(benchmark::State& state) {
+  RunSemanticsFrames(state, true);
+}
+
+BENCHMARK(BM_SemanticsUpdateFullTree)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SemanticsUpdateDiffed)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_tree_differ.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static SemanticsNode CreateNode(int32_t id,
+                                std::string label,
+                                std::vector<int32_t> children = {}) {
+  SemanticsNode node;
+  node.id = id;
+  node.label = std::move(label);
+  node.rect = SkRect::MakeLTRB(0, id * 10, 100, id * 10 + 10);
+  node.childrenInTraversalOrder = children;
+  node.childrenInHitTestOrder = children;
+  return node;
+}
+
+static SemanticsNodeUpdates CreateTree(const std::string& label) {
+  SemanticsNodeUpdates nodes;
+  nodes[0] = CreateNode(0, "root", {1, 2});
+  nodes[1] = CreateNode(1, label);
+  nodes[2] = CreateNode(2, "two");
+  return nodes;
+}
+
+TEST(SemanticsTreeDifferTest, OnlyChangedNodesAreSent) {
+  SemanticsTreeDiffer differ;
+  CustomAccessibilityActionUpdates actions;
+
+  auto nodes = CreateTree("one");
+  ASSERT_TRUE(differ.Diff(nodes, actions));
+  ASSERT_EQ(nodes.size(), 3u);
+
+  nodes = CreateTree("one");
+  ASSERT_FALSE(differ.Diff(nodes, actions));
+  ASSERT_TRUE(nodes.empty());
+
+  nodes = CreateTree("uno");
+  ASSERT_TRUE(differ.Diff(nodes, actions));
+  ASSERT_EQ(nodes.size(), 1u);
+  ASSERT_EQ(nodes.count(1), 1u);
+}
+
+TEST(SemanticsTreeDifferTest, UnsetScrollPositionsAreEqual) {
+  SemanticsTreeDiffer differ;
+  CustomAccessibilityActionUpdates actions;
+
+  auto nodes = CreateTree("one");
+  ASSERT_TRUE(std::isnan(nodes[1].scrollPosition));
+  ASSERT_TRUE(differ.Diff(nodes, actions));
+  nodes = CreateTree("one");
+  ASSERT_FALSE(differ.Diff(nodes, actions));
+}
+
+TEST(SemanticsTreeDifferTest, RemovedNodesAreSentWhenTheyReappear) {
+  SemanticsTreeDiffer differ;
+  CustomAccessibilityActionUpdates actions;
+
+  auto nodes = CreateTree("one");
+  ASSERT_TRUE(differ.Diff(nodes, actions));
+  ASSERT_EQ(differ.GetSentNodeCount(), 3u);
+
+  // The platform removes node 2 along with its parent's reference to it.
+  nodes.clear();
+  nodes[0] = CreateNode(0, "root", {1});
+  ASSERT_TRUE(differ.Diff(nodes, actions));
+  ASSERT_EQ(differ.GetSentNodeCount(), 2u);
+
+  nodes = CreateTree("one");
+  ASSERT_TRUE(differ.Diff(nodes, actions));
+  ASSERT_EQ(nodes.size(), 2u);
+  ASSERT_EQ(nodes.count(0), 1u);
+  ASSERT_EQ(nodes.count(2), 1u);
+}
+
+TEST(SemanticsTreeDifferTest, ResetSendsTheWholeTree) {
+  SemanticsTreeDiffer differ;
+  CustomAccessibilityActionUpdates actions;
+
+  auto nodes = CreateTree("one");
+  ASSERT_TRUE(differ.Diff(nodes, actions));
+  differ.Reset();
+  nodes = CreateTree("one");
+  ASSERT_TRUE(differ.Diff(nodes, actions));
+  ASSERT_EQ(nodes.size(), 3u);
+}
+
+TEST(SemanticsTreeDifferTest, OnlyChangedCustomActionsAreSent) {
+  SemanticsTreeDiffer differ;
+  SemanticsNodeUpdates nodes;
+
+  CustomAccessibilityActionUpdates actions;
+  actions[7].id = 7;
+  actions[7].label = "archive";
+  auto sent_actions = actions;
+  ASSERT_TRUE(differ.Diff(nodes, sent_actions));
+  ASSERT_EQ(sent_actions.size(), 1u);
+
+  sent_actions = actions;
+  ASSERT_FALSE(differ.Diff(nodes, sent_actions));
+
+  actions[7].label = "delete";
+  sent_actions = actions;
+  ASSERT_TRUE(differ.Diff(nodes, sent_actions));
+  ASSERT_EQ(sent_actions.size(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
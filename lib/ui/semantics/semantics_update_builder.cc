@@ -85,11 +85,11 @@ void SemanticsUpdateBuilder::updateNode(
   node.rect = SkRect::MakeLTRB(left, top, right, bottom);
   node.elevation = elevation;
   node.thickness = thickness;
-  node.label = label;
-  node.hint = hint;
-  node.value = value;
-  node.increasedValue = increasedValue;
-  node.decreasedValue = decreasedValue;
+  node.label = std::move(label);
+  node.hint = std::move(hint);
+  node.value = std::move(value);
+  node.increasedValue = std::move(increasedValue);
+  node.decreasedValue = std::move(decreasedValue);
   node.textDirection = textDirection;
   node.transform.setColMajord(transform.data());
   node.childrenInTraversalOrder =
@@ -102,7 +102,7 @@ void SemanticsUpdateBuilder::updateNode(
   node.customAccessibilityActions = std::vector<int32_t>(
       localContextActions.data(),
       localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
+  nodes_[id] = std::move(node);
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
@@ -112,9 +112,9 @@ void SemanticsUpdateBuilder::updateCustomAction(int id,
   CustomAccessibilityAction action;
   action.id = id;
   action.overrideId = overrideId;
-  action.label = label;
-  action.hint = hint;
-  actions_[id] = action;
+  action.label = std::move(label);
+  action.hint = std::move(hint);
+  actions_[id] = std::move(action);
 }
 
 fml::RefPtr<SemanticsUpdate> SemanticsUpdateBuilder::build() {
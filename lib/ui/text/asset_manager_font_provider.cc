@@ -5,6 +5,9 @@
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "rapidjson/document.h"
+#include "rapidjson/rapidjson.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkString.h"
@@ -28,11 +31,13 @@ AssetManagerFontProvider::~AssetManagerFontProvider() = default;
 
 // |FontAssetProvider|
 size_t AssetManagerFontProvider::GetFamilyCount() const {
+  RegisterPendingManifest();
   return family_names_.size();
 }
 
 // |FontAssetProvider|
 std::string AssetManagerFontProvider::GetFamilyName(int index) const {
+  RegisterPendingManifest();
   FML_DCHECK(index >= 0 && static_cast<size_t>(index) < family_names_.size());
   return family_names_[index];
 }
@@ -40,6 +45,7 @@ std::string AssetManagerFontProvider::GetFamilyName(int index) const {
 // |FontAssetProvider|
 SkFontStyleSet* AssetManagerFontProvider::MatchFamily(
     const std::string& family_name) {
+  RegisterPendingManifest();
   auto found = registered_families_.find(CanonicalFamilyName(family_name));
   if (found == registered_families_.end()) {
     return nullptr;
@@ -50,6 +56,79 @@ SkFontStyleSet* AssetManagerFontProvider::MatchFamily(
 
 void AssetManagerFontProvider::RegisterAsset(std::string family_name,
                                              std::string asset) {
+  RegisterFamilyAsset(family_name, asset);
+}
+
+void AssetManagerFontProvider::RegisterManifest(std::string manifest_asset) {
+  RegisterPendingManifest();
+  pending_manifest_ = std::move(manifest_asset);
+}
+
+void AssetManagerFontProvider::RegisterPendingManifest() const {
+  if (pending_manifest_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "AssetManagerFontProvider::RegisterPendingManifest");
+
+  std::string manifest_asset;
+  std::swap(manifest_asset, pending_manifest_);
+
+  std::unique_ptr<fml::Mapping> manifest_mapping =
+      asset_manager_->GetAsMapping(manifest_asset);
+  if (manifest_mapping == nullptr) {
+    FML_DLOG(WARNING) << "Could not find the font manifest in the asset store.";
+    return;
+  }
+
+  rapidjson::Document document;
+  static_assert(sizeof(decltype(document)::Ch) == sizeof(uint8_t), "");
+  document.Parse(reinterpret_cast<const decltype(document)::Ch*>(
+                     manifest_mapping->GetMapping()),
+                 manifest_mapping->GetSize());
+
+  if (document.HasParseError()) {
+    FML_DLOG(WARNING) << "Error parsing the font manifest in the asset store.";
+    return;
+  }
+
+  // Structure described in https://flutter.io/custom-fonts/
+
+  if (!document.IsArray()) {
+    return;
+  }
+
+  for (const auto& family : document.GetArray()) {
+    auto family_name = family.FindMember("family");
+    if (family_name == family.MemberEnd() || !family_name->value.IsString()) {
+      continue;
+    }
+
+    auto family_fonts = family.FindMember("fonts");
+    if (family_fonts == family.MemberEnd() || !family_fonts->value.IsArray()) {
+      continue;
+    }
+
+    for (const auto& family_font : family_fonts->value.GetArray()) {
+      if (!family_font.IsObject()) {
+        continue;
+      }
+
+      auto font_asset = family_font.FindMember("asset");
+      if (font_asset == family_font.MemberEnd() ||
+          !font_asset->value.IsString()) {
+        continue;
+      }
+
+      // TODO: Handle weights and styles.
+      RegisterFamilyAsset(family_name->value.GetString(),
+                          font_asset->value.GetString());
+    }
+  }
+}
+
+void AssetManagerFontProvider::RegisterFamilyAsset(
+    const std::string& family_name,
+    const std::string& asset) const {
   std::string canonical_name = CanonicalFamilyName(family_name);
   auto family_it = registered_families_.find(canonical_name);
 
@@ -119,7 +198,9 @@ SkTypeface* AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern) {
     if (asset.typeface && asset.typeface->fontStyle() == pattern)
       return SkRef(asset.typeface.get());
 
-  return SkRef(assets_[0].typeface.get());
+  // Typefaces are only loaded when first used, so the first one may not have
+  // been created yet.
+  return createTypeface(0);
 }
 
 AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(std::string a)
@@ -64,6 +64,12 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
   void RegisterAsset(std::string family_name, std::string asset);
 
+  // Registers the families listed in the font manifest (see
+  // https://flutter.dev/custom-fonts/) found at |manifest_asset|. The manifest
+  // is only read and parsed once the provider is first queried, so that
+  // startup does not pay for fonts before text is laid out.
+  void RegisterManifest(std::string manifest_asset);
+
   // |FontAssetProvider|
   size_t GetFamilyCount() const override;
 
@@ -75,9 +81,17 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
  private:
   std::shared_ptr<AssetManager> asset_manager_;
-  std::unordered_map<std::string, sk_sp<AssetManagerFontStyleSet>>
+  // Families are registered from the pending manifest on first use, which may
+  // be in a const query.
+  mutable std::string pending_manifest_;
+  mutable std::unordered_map<std::string, sk_sp<AssetManagerFontStyleSet>>
       registered_families_;
-  std::vector<std::string> family_names_;
+  mutable std::vector<std::string> family_names_;
+
+  void RegisterPendingManifest() const;
+
+  void RegisterFamilyAsset(const std::string& family_name,
+                           const std::string& asset) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontProvider);
 };
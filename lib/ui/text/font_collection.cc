@@ -4,14 +4,15 @@
 
 #include "flutter/lib/ui/text/font_collection.h"
 
+#include <cstdlib>
 #include <mutex>
+#include <sstream>
+#include <utility>
 
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/window.h"
 #include "flutter/runtime/test_font_data.h"
-#include "rapidjson/document.h"
-#include "rapidjson/rapidjson.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/core/SkStream.h"
@@ -69,63 +70,126 @@ std::shared_ptr<txt::FontCollection> FontCollection::GetFontCollection() const {
 
 void FontCollection::RegisterFonts(
     std::shared_ptr<AssetManager> asset_manager) {
-  std::unique_ptr<fml::Mapping> manifest_mapping =
-      asset_manager->GetAsMapping("FontManifest.json");
-  if (manifest_mapping == nullptr) {
-    FML_DLOG(WARNING) << "Could not find the font manifest in the asset store.";
-    return;
-  }
+  auto font_provider =
+      std::make_unique<AssetManagerFontProvider>(asset_manager);
 
-  rapidjson::Document document;
-  static_assert(sizeof(decltype(document)::Ch) == sizeof(uint8_t), "");
-  document.Parse(reinterpret_cast<const decltype(document)::Ch*>(
-                     manifest_mapping->GetMapping()),
-                 manifest_mapping->GetSize());
+  // The manifest is parsed and the typefaces are loaded once text first asks
+  // for a family.
+  font_provider->RegisterManifest("FontManifest.json");
 
-  if (document.HasParseError()) {
-    FML_DLOG(WARNING) << "Error parsing the font manifest in the asset store.";
-    return;
-  }
+  collection_->SetAssetFontManager(
+      sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
+}
 
-  // Structure described in https://flutter.io/custom-fonts/
+// The fallback cache is a list of lines of the form "<code point in hex>
+// <tab> <locale> <tab> <family name>". The locale may be empty.
+static txt::FontCollection::FallbackFontHints ParseFallbackFontCache(
+    const fml::Mapping& cache) {
+  txt::FontCollection::FallbackFontHints entries;
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(cache.GetMapping()),
+                  cache.GetSize()));
+  std::string line;
+  while (std::getline(stream, line)) {
+    const size_t locale_start = line.find('\t');
+    if (locale_start == std::string::npos || locale_start == 0) {
+      continue;
+    }
+    const size_t family_start = line.find('\t', locale_start + 1);
+    if (family_start == std::string::npos || family_start + 1 == line.size()) {
+      continue;
+    }
+    char* end = nullptr;
+    const unsigned long code_point = std::strtoul(line.c_str(), &end, 16);
+    if (end != line.c_str() + locale_start) {
+      continue;
+    }
+    entries[std::make_pair(
+        line.substr(locale_start + 1, family_start - locale_start - 1),
+        static_cast<uint32_t>(code_point))] = line.substr(family_start + 1);
+  }
+  return entries;
+}
 
-  if (!document.IsArray()) {
-    return;
+static std::unique_ptr<fml::Mapping> SerializeFallbackFontCache(
+    const txt::FontCollection::FallbackFontHints& entries) {
+  std::ostringstream stream;
+  for (const auto& entry : entries) {
+    stream << std::hex << entry.first.second << '\t' << entry.first.first
+           << '\t' << entry.second << '\n';
   }
+  const std::string serialized = stream.str();
+  return std::make_unique<fml::DataMapping>(
+      std::vector<uint8_t>(serialized.begin(), serialized.end()));
+}
 
-  auto font_provider =
-      std::make_unique<AssetManagerFontProvider>(asset_manager);
+// How long matches are collected before the fallback cache is written.
+static constexpr fml::TimeDelta kFallbackFontCacheWriteDelay =
+    fml::TimeDelta::FromSeconds(2);
 
-  for (const auto& family : document.GetArray()) {
-    auto family_name = family.FindMember("family");
-    if (family_name == family.MemberEnd() || !family_name->value.IsString()) {
-      continue;
-    }
+namespace {
 
-    auto family_fonts = family.FindMember("fonts");
-    if (family_fonts == family.MemberEnd() || !family_fonts->value.IsArray()) {
-      continue;
-    }
+// The fallback matches of the current run. Outlives the font collection if a
+// write is still pending when it is collected.
+struct FallbackFontCache {
+  std::mutex mutex;
+  txt::FontCollection::FallbackFontHints entries;
+  bool write_pending = false;
+};
 
-    for (const auto& family_font : family_fonts->value.GetArray()) {
-      if (!family_font.IsObject()) {
-        continue;
-      }
+}  // namespace
+
+void FontCollection::SetupFallbackFontCache(
+    std::unique_ptr<fml::Mapping> cache,
+    FallbackFontCacheWriter writer,
+    fml::RefPtr<fml::TaskRunner> writer_task_runner) {
+  auto fallback_cache = std::make_shared<FallbackFontCache>();
+  if (cache != nullptr && cache->GetMapping() != nullptr) {
+    fallback_cache->entries = ParseFallbackFontCache(*cache);
+  }
 
-      auto font_asset = family_font.FindMember("asset");
-      if (font_asset == family_font.MemberEnd() ||
-          !font_asset->value.IsString()) {
-        continue;
-      }
+  collection_->SetFallbackFontHints(fallback_cache->entries);
 
-      // TODO: Handle weights and styles.
-      font_provider->RegisterAsset(family_name->value.GetString(),
-                                   font_asset->value.GetString());
-    }
+  if (!writer) {
+    return;
   }
 
-  collection_->SetAssetFontManager(
-      sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
+  auto write = [fallback_cache, writer = std::move(writer)]() {
+    std::unique_ptr<fml::Mapping> serialized;
+    {
+      std::scoped_lock lock(fallback_cache->mutex);
+      fallback_cache->write_pending = false;
+      serialized = SerializeFallbackFontCache(fallback_cache->entries);
+    }
+    writer(std::move(serialized));
+  };
+
+  collection_->SetFallbackFontListener(
+      [fallback_cache, write = std::move(write),
+       writer_task_runner = std::move(writer_task_runner)](
+          uint32_t ch, const std::string& locale,
+          const std::string& family_name) {
+        {
+          std::scoped_lock lock(fallback_cache->mutex);
+          auto& entry = fallback_cache->entries[std::make_pair(locale, ch)];
+          if (entry == family_name) {
+            return;
+          }
+          entry = family_name;
+          if (writer_task_runner) {
+            if (fallback_cache->write_pending) {
+              return;
+            }
+            fallback_cache->write_pending = true;
+          }
+        }
+        if (writer_task_runner) {
+          writer_task_runner->PostDelayedTask(write,
+                                              kFallbackFontCacheWriteDelay);
+        } else {
+          write();
+        }
+      });
 }
 
 void FontCollection::RegisterTestFonts() {
@@ -5,12 +5,14 @@
 #ifndef FLUTTER_LIB_UI_TEXT_FONT_COLLECTION_H_
 #define FLUTTER_LIB_UI_TEXT_FONT_COLLECTION_H_
 
+#include <functional>
 #include <memory>
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "txt/font_collection.h"
 
 namespace tonic {
@@ -31,6 +33,20 @@ class FontCollection {
 
   void RegisterFonts(std::shared_ptr<AssetManager> asset_manager);
 
+  using FallbackFontCacheWriter =
+      std::function<void(std::unique_ptr<fml::Mapping> cache)>;
+
+  // Seeds font fallback with the characters an earlier run had to find
+  // fallback fonts for, so that they skip the slow match against every
+  // installed font. |writer| is handed the updated cache on
+  // |writer_task_runner| a while after a new character is matched, so that
+  // the matches made while laying out a screen of text are written at once.
+  // If |writer_task_runner| is null, |writer| is invoked for every match.
+  void SetupFallbackFontCache(
+      std::unique_ptr<fml::Mapping> cache,
+      FallbackFontCacheWriter writer,
+      fml::RefPtr<fml::TaskRunner> writer_task_runner = nullptr);
+
   void RegisterTestFonts();
 
   void LoadFontFromList(const uint8_t* font_data,
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/lib/ui/text/font_collection.h"
+#include "flutter/runtime/test_font_data.h"
+#include "txt/paragraph.h"
+#include "txt/paragraph_builder_txt.h"
+
+namespace flutter {
+
+// An app that bundles many font families but only uses one of them for its
+// first frame.
+static std::shared_ptr<AssetManager> CreateFontAssetManager(
+    size_t family_count) {
+  auto font_stream = GetTestFontData();
+  std::vector<uint8_t> font_data(font_stream->getLength());
+  font_stream->read(font_data.data(), font_data.size());
+
+  PackedAssetBundleBuilder builder;
+  std::ostringstream manifest;
+  manifest << "[";
+  for (size_t i = 0; i < family_count; i++) {
+    const std::string asset = "fonts/font_" + std::to_string(i) + ".ttf";
+    builder.AddAsset(asset, std::make_unique<fml::DataMapping>(font_data));
+    manifest << (i == 0 ? "" : ",") << R"({"family":"Family)" << i
+             << R"(","fonts":[{"asset":")" << asset << R"("}]})";
+  }
+  manifest << "]";
+  const std::string manifest_string = manifest.str();
+  builder.AddAsset("FontManifest.json",
+                   std::make_unique<fml::DataMapping>(std::vector<uint8_t>(
+                       manifest_string.begin(), manifest_string.end())));
+
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::make_unique<PackedAssetBundle>(
+      std::make_unique<fml::DataMapping>(builder.Build())));
+  return asset_manager;
+}
+
+// Registers the fonts and lays out a paragraph that needs a fallback font,
+// which is the work done before the first frame that shows text.
+static void LayoutFirstParagraph(
+    const std::shared_ptr<AssetManager>& asset_manager,
+    std::unique_ptr<fml::Mapping> fallback_cache,
+    FontCollection::FallbackFontCacheWriter writer) {
+  FontCollection font_collection;
+  font_collection.RegisterFonts(asset_manager);
+  font_collection.SetupFallbackFontCache(std::move(fallback_cache),
+                                         std::move(writer));
+
+  txt::TextStyle text_style;
+  text_style.font_families = {"Family0"};
+  txt::ParagraphBuilderTxt builder(txt::ParagraphStyle(),
+                                   font_collection.GetFontCollection());
+  builder.PushStyle(text_style);
+  builder.AddText(u"Hello 字 अ");
+  builder.Pop();
+  auto paragraph = builder.Build();
+  paragraph->Layout(300);
+  benchmark::DoNotOptimize(paragraph->GetHeight());
+}
+
+static void BM_FontCollectionTimeToFirstText(benchmark::State& state) {
+  auto asset_manager = CreateFontAssetManager(state.range(0));
+  while (state.KeepRunning()) {
+    LayoutFirstParagraph(asset_manager, nullptr, nullptr);
+  }
+}
+
+static void BM_FontCollectionTimeToFirstTextWithFallbackCache(
+    benchmark::State& state) {
+  auto asset_manager = CreateFontAssetManager(state.range(0));
+
+  // Record the fallback matches made by an earlier run.
+  std::unique_ptr<fml::Mapping> cache;
+  LayoutFirstParagraph(asset_manager, nullptr,
+                       [&cache](std::unique_ptr<fml::Mapping> updated_cache) {
+                         cache = std::move(updated_cache);
+                       });
+  FML_CHECK(cache);
+  const std::vector<uint8_t> cache_data(
+      cache->GetMapping(), cache->GetMapping() + cache->GetSize());
+
+  while (state.KeepRunning()) {
+    LayoutFirstParagraph(asset_manager,
+                         std::make_unique<fml::DataMapping>(cache_data),
+                         nullptr);
+  }
+}
+
+BENCHMARK(BM_FontCollectionTimeToFirstText)
+    ->Arg(1)
+    ->Arg(50)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FontCollectionTimeToFirstTextWithFallbackCache)
+    ->Arg(1)
+    ->Arg(50)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/runtime/dart_isolate.h"
 
+#include <atomic>
 #include <cstdlib>
 #include <tuple>
 
@@ -15,6 +16,7 @@
 #include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
+#include "flutter/runtime/start_up.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -166,9 +168,11 @@ bool DartIsolate::Initialize(Dart_Isolate dart_isolate, bool is_root_isolate) {
     return false;
   }
 
+  // Isolates created in an existing group only get their data once they have
+  // been initialized.
   auto* isolate_data = static_cast<std::shared_ptr<DartIsolate>*>(
-      Dart_IsolateGroupData(dart_isolate));
-  if (isolate_data->get() != this) {
+      Dart_IsolateData(dart_isolate));
+  if (isolate_data != nullptr && isolate_data->get() != this) {
     return false;
   }
 
@@ -178,7 +182,8 @@ bool DartIsolate::Initialize(Dart_Isolate dart_isolate, bool is_root_isolate) {
   // We are entering a new scope (for the first time since initialization) and
   // we want to restore the current scope to null when we exit out of this
   // method. This balances the implicit Dart_EnterIsolate call made by
-  // Dart_CreateIsolateGroup (which calls the Initialize).
+  // Dart_CreateIsolateGroup (which calls the Initialize), or made by the VM
+  // before invoking |DartIsolateInitializeCallback|.
   Dart_ExitIsolate();
 
   tonic::DartIsolateScope scope(isolate());
@@ -456,6 +461,23 @@ bool DartIsolate::MarkIsolateRunnable() {
   return true;
 }
 
+// Reports the time from the engine's entry to the first invocation of a main
+// entrypoint in this process as a timeline event.
+static void TraceTimeToMain() {
+  static std::atomic_bool reported(false);
+  if (engine_main_enter_ts == 0 || reported.exchange(true)) {
+    return;
+  }
+  Dart_TimelineEvent("FlutterEngineTimeToMain",     // label
+                     engine_main_enter_ts,          // timestamp0
+                     Dart_TimelineGetMicros(),      // timestamp1_or_async_id
+                     Dart_Timeline_Event_Duration,  // event type
+                     0,                             // argument_count
+                     nullptr,                       // argument_names
+                     nullptr                        // argument_values
+  );
+}
+
 FML_WARN_UNUSED_RESULT
 static bool InvokeMainEntrypoint(Dart_Handle user_entrypoint_function,
                                  Dart_Handle args) {
@@ -473,6 +495,8 @@ static bool InvokeMainEntrypoint(Dart_Handle user_entrypoint_function,
     return false;
   }
 
+  TraceTimeToMain();
+
   if (tonic::LogIfError(tonic::DartInvokeField(
           Dart_LookupLibrary(tonic::ToDart("dart:ui")), "_runMainZoned",
           {start_main_isolate_function, user_entrypoint_function, args}))) {
@@ -701,28 +725,9 @@ DartIsolate::CreateDartVMAndEmbedderObjectPair(
 
   if (!is_root_isolate) {
     auto* raw_embedder_isolate = embedder_isolate.release();
-
-    TaskRunners null_task_runners(advisory_script_uri, nullptr, nullptr,
-                                  nullptr, nullptr);
-
-    // Copy most fields from the parent to the child.
-    embedder_isolate = std::make_unique<std::shared_ptr<DartIsolate>>(
-        std::make_shared<DartIsolate>(
-            (*raw_embedder_isolate)->GetSettings(),         // settings
-            (*raw_embedder_isolate)->GetIsolateSnapshot(),  // isolate_snapshot
-            (*raw_embedder_isolate)->GetSharedSnapshot(),   // shared_snapshot
-            null_task_runners,                              // task_runners
-            fml::WeakPtr<SnapshotDelegate>{},               // snapshot_delegate
-            fml::WeakPtr<IOManager>{},                      // io_manager
-            fml::WeakPtr<ImageDecoder>{},                   // io_manager
-            advisory_script_uri,         // advisory_script_uri
-            advisory_script_entrypoint,  // advisory_script_entrypoint
-            (*raw_embedder_isolate)->child_isolate_preparer_,    // preparer
-            (*raw_embedder_isolate)->isolate_create_callback_,   // on create
-            (*raw_embedder_isolate)->isolate_shutdown_callback_  // on shutdown
-            )
-
-    );
+    embedder_isolate =
+        CreateChildEmbedderIsolate(**raw_embedder_isolate, advisory_script_uri,
+                                   advisory_script_entrypoint);
   }
 
   // Create the Dart VM isolate and give it the embedder object as the baton.
@@ -742,21 +747,10 @@ DartIsolate::CreateDartVMAndEmbedderObjectPair(
     return {nullptr, {}};
   }
 
-  if (!(*embedder_isolate)->Initialize(isolate, is_root_isolate)) {
-    *error = strdup("Embedder could not initialize the Dart isolate.");
-    FML_DLOG(ERROR) << *error;
-    return {nullptr, {}};
-  }
-
-  if (!(*embedder_isolate)->LoadLibraries(is_root_isolate)) {
-    *error =
-        strdup("Embedder could not load libraries in the new Dart isolate.");
-    FML_DLOG(ERROR) << *error;
+  if (!InitializeIsolate(**embedder_isolate, isolate, is_root_isolate, error)) {
     return {nullptr, {}};
   }
 
-  auto weak_embedder_isolate = (*embedder_isolate)->GetWeakIsolatePtr();
-
   // Root isolates will be setup by the engine and the service isolate (which is
   // also a root isolate) by the utility routines in the VM. However, secondary
   // isolates will be run by the VM if they are marked as runnable.
@@ -770,17 +764,122 @@ DartIsolate::CreateDartVMAndEmbedderObjectPair(
     }
   }
 
+  auto weak_embedder_isolate = (*embedder_isolate)->GetWeakIsolatePtr();
+
   // The ownership of the embedder object is controlled by the Dart VM. So the
   // only reference returned to the caller is weak.
   embedder_isolate.release();
   return {isolate, weak_embedder_isolate};
 }
 
+// |Dart_InitializeIsolateCallback|
+bool DartIsolate::DartIsolateInitializeCallback(
+    std::shared_ptr<DartIsolate>** child_isolate_data,
+    char** error) {
+  TRACE_EVENT0("flutter", "DartIsolate::DartIsolateInitializeCallback");
+  Dart_Isolate isolate = Dart_CurrentIsolate();
+  if (isolate == nullptr) {
+    *error = strdup("Isolate should be available in initialize callback.");
+    FML_DLOG(ERROR) << *error;
+    return false;
+  }
+
+  // The VM spawned the isolate in the group of the isolate that created the
+  // group, sharing its program and snapshots.
+  auto* group_embedder_isolate = static_cast<std::shared_ptr<DartIsolate>*>(
+      Dart_CurrentIsolateGroupData());
+  auto embedder_isolate = CreateChildEmbedderIsolate(
+      **group_embedder_isolate,
+      (*group_embedder_isolate)->GetAdvisoryScriptURI().c_str(),
+      (*group_embedder_isolate)->GetAdvisoryScriptEntrypoint().c_str());
+
+  bool prepared = InitializeIsolate(**embedder_isolate, isolate, false, error);
+  // The program was loaded when the group was created, so like precompiled
+  // code, the isolate only needs to be marked runnable.
+  if (prepared &&
+      !(*embedder_isolate)->PrepareForRunningFromPrecompiledCode()) {
+    *error = strdup("Could not prepare the child isolate to run.");
+    FML_DLOG(ERROR) << *error;
+    prepared = false;
+  }
+
+  // |Initialize| exits the isolate, but the VM expects it to still be entered,
+  // including when it has to shut the isolate down.
+  if (Dart_CurrentIsolate() == nullptr) {
+    Dart_EnterIsolate(isolate);
+  }
+
+  if (!prepared) {
+    return false;
+  }
+
+  // The ownership of the embedder object is controlled by the Dart VM.
+  *child_isolate_data = embedder_isolate.release();
+  return true;
+}
+
+std::unique_ptr<std::shared_ptr<DartIsolate>>
+DartIsolate::CreateChildEmbedderIsolate(
+    const DartIsolate& parent,
+    const char* advisory_script_uri,
+    const char* advisory_script_entrypoint) {
+  TaskRunners null_task_runners(advisory_script_uri, nullptr, nullptr, nullptr,
+                                nullptr);
+
+  // Copy most fields from the parent to the child.
+  return std::make_unique<std::shared_ptr<DartIsolate>>(
+      std::make_shared<DartIsolate>(
+          parent.GetSettings(),               // settings
+          parent.GetIsolateSnapshot(),        // isolate_snapshot
+          parent.GetSharedSnapshot(),         // shared_snapshot
+          null_task_runners,                  // task_runners
+          fml::WeakPtr<SnapshotDelegate>{},   // snapshot_delegate
+          fml::WeakPtr<IOManager>{},          // io_manager
+          fml::WeakPtr<ImageDecoder>{},       // io_manager
+          advisory_script_uri,                // advisory_script_uri
+          advisory_script_entrypoint,         // advisory_script_entrypoint
+          parent.child_isolate_preparer_,     // preparer
+          parent.isolate_create_callback_,    // on create
+          parent.isolate_shutdown_callback_   // on shutdown
+          ));
+}
+
+bool DartIsolate::InitializeIsolate(DartIsolate& embedder_isolate,
+                                    Dart_Isolate isolate,
+                                    bool is_root_isolate,
+                                    char** error) {
+  if (!embedder_isolate.Initialize(isolate, is_root_isolate)) {
+    *error = strdup("Embedder could not initialize the Dart isolate.");
+    FML_DLOG(ERROR) << *error;
+    return false;
+  }
+
+  if (!embedder_isolate.LoadLibraries(is_root_isolate)) {
+    *error =
+        strdup("Embedder could not load libraries in the new Dart isolate.");
+    FML_DLOG(ERROR) << *error;
+    return false;
+  }
+
+  return true;
+}
+
 // |Dart_IsolateShutdownCallback|
 void DartIsolate::DartIsolateShutdownCallback(
     std::shared_ptr<DartIsolate>* isolate_group_data,
     std::shared_ptr<DartIsolate>* isolate_data) {
-  isolate_group_data->get()->OnShutdownCallback();
+  isolate_data->get()->OnShutdownCallback();
+}
+
+// |Dart_IsolateCleanupCallback|
+void DartIsolate::DartIsolateCleanupCallback(
+    std::shared_ptr<DartIsolate>* isolate_group_data,
+    std::shared_ptr<DartIsolate>* isolate_data) {
+  // The isolate that created the group shares its data with the group, which
+  // is deleted with the group.
+  if (isolate_data != isolate_group_data) {
+    delete isolate_data;
+  }
 }
 
 // |Dart_IsolateGroupCleanupCallback|
@@ -174,6 +174,21 @@ class DartIsolate : public UIDartState {
       Dart_IsolateFlags* flags,
       char** error);
 
+  // |Dart_InitializeIsolateCallback|
+  static bool DartIsolateInitializeCallback(
+      std::shared_ptr<DartIsolate>** child_isolate_data,
+      char** error);
+
+  static std::unique_ptr<std::shared_ptr<DartIsolate>>
+  CreateChildEmbedderIsolate(const DartIsolate& parent,
+                             const char* advisory_script_uri,
+                             const char* advisory_script_entrypoint);
+
+  static bool InitializeIsolate(DartIsolate& embedder_isolate,
+                                Dart_Isolate isolate,
+                                bool is_root_isolate,
+                                char** error);
+
   static std::pair<Dart_Isolate /* vm */,
                    std::weak_ptr<DartIsolate> /* embedder */>
   CreateDartVMAndEmbedderObjectPair(
@@ -191,6 +206,11 @@ class DartIsolate : public UIDartState {
       std::shared_ptr<DartIsolate>* isolate_group_data,
       std::shared_ptr<DartIsolate>* isolate_data);
 
+  // |Dart_IsolateCleanupCallback|
+  static void DartIsolateCleanupCallback(
+      std::shared_ptr<DartIsolate>* isolate_group_data,
+      std::shared_ptr<DartIsolate>* isolate_data);
+
   // |Dart_IsolateGroupCleanupCallback|
   static void DartIsolateGroupCleanupCallback(
       std::shared_ptr<DartIsolate>* isolate_group_data);
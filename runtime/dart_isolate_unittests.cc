@@ -384,6 +384,43 @@ TEST_F(DartIsolateTest, CanLaunchSecondaryIsolates) {
   latch.Wait();
 }
 
+TEST_F(DartIsolateTest, CanLaunchSecondaryIsolatesInTheRootIsolateGroup) {
+  if (DartVM::IsRunningPrecompiledCode()) {
+    // The VM only spawns isolates into an existing group in JIT modes.
+    GTEST_SKIP();
+  }
+  fml::CountDownLatch latch(3);
+  void* secondary_group_data = nullptr;
+  AddNativeCallback("NotifyNative",
+                    CREATE_NATIVE_ENTRY(([&latch](Dart_NativeArguments args) {
+                      latch.CountDown();
+                    })));
+  AddNativeCallback(
+      "PassMessage",
+      CREATE_NATIVE_ENTRY(([&latch, &secondary_group_data](
+                               Dart_NativeArguments args) {
+        secondary_group_data = Dart_CurrentIsolateGroupData();
+        latch.CountDown();
+      })));
+  auto settings = CreateSettingsForFixture();
+  settings.enable_isolate_groups = true;
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, GetThreadTaskRunner(),
+                                      "testCanLaunchSecondaryIsolate", {});
+  ASSERT_TRUE(isolate);
+  ASSERT_EQ(isolate->get()->GetPhase(), DartIsolate::Phase::Running);
+
+  latch.Wait();
+
+  void* root_group_data = nullptr;
+  ASSERT_TRUE(isolate->RunInIsolateScope([&root_group_data]() {
+    root_group_data = Dart_CurrentIsolateGroupData();
+    return true;
+  }));
+  ASSERT_NE(root_group_data, nullptr);
+  ASSERT_EQ(secondary_group_data, root_group_data);
+}
+
 TEST_F(DartIsolateTest, CanRecieveArguments) {
   fml::AutoResetWaitableEvent latch;
   AddNativeCallback("NotifyNative",
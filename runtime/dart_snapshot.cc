@@ -6,6 +6,7 @@
 
 #include <sstream>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
@@ -20,13 +21,19 @@ const char* DartSnapshot::kIsolateDataSymbol = "kDartIsolateSnapshotData";
 const char* DartSnapshot::kIsolateInstructionsSymbol =
     "kDartIsolateSnapshotInstructions";
 
+// Snapshots are needed in full during startup. The data is deserialized front
+// to back and the instructions benefit from fewer TLB misses.
 static std::unique_ptr<const fml::Mapping> GetFileMapping(
     const std::string& path,
     bool executable) {
   if (executable) {
-    return fml::FileMapping::CreateReadExecute(path);
+    return fml::FileMapping::CreateReadExecute(
+        path, {fml::FileMapping::Advice::kWillNeed,
+               fml::FileMapping::Advice::kHugePages});
   } else {
-    return fml::FileMapping::CreateReadOnly(path);
+    return fml::FileMapping::CreateReadOnly(
+        path, {fml::FileMapping::Advice::kWillNeed,
+               fml::FileMapping::Advice::kSequential});
   }
 }
 
@@ -196,4 +203,18 @@ const uint8_t* DartSnapshot::GetInstructionsMapping() const {
   return instructions_ ? instructions_->GetMapping() : nullptr;
 }
 
+void DartSnapshot::Prefetch(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker) const {
+  if (!worker || !IsValid()) {
+    return;
+  }
+  worker->PostTask([data = data_, instructions = instructions_]() {
+    TRACE_EVENT0("flutter", "DartSnapshot::Prefetch");
+    fml::PageInMapping(*data);
+    if (instructions) {
+      fml::PageInMapping(*instructions);
+    }
+  });
+}
+
 }  // namespace flutter
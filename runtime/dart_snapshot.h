@@ -9,6 +9,7 @@
 #include <string>
 
 #include "flutter/common/settings.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 
@@ -37,6 +38,10 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
 
   const uint8_t* GetInstructionsMapping() const;
 
+  // Pages the snapshot in on |worker| so that it is resident by the time an
+  // isolate is created from it.
+  void Prefetch(const std::shared_ptr<fml::ConcurrentTaskRunner>& worker) const;
+
  private:
   std::shared_ptr<const fml::Mapping> data_;
   std::shared_ptr<const fml::Mapping> instructions_;
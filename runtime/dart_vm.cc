@@ -86,6 +86,10 @@ static const char* kDartDisableServiceAuthCodesArgs[]{
     "--disable-service-auth-codes",
 };
 
+static const char* kDartIsolateGroupsArgs[]{
+    "--enable-isolate-groups",
+};
+
 static const char* kDartTraceStartupArgs[]{
     "--timeline_streams=Compiler,Dart,Debugger,Embedder,GC,Isolate,VM",
 };
@@ -327,6 +331,11 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
                 fml::size(kDartDisableServiceAuthCodesArgs));
   }
 
+  if (settings_.enable_isolate_groups) {
+    PushBackAll(&args, kDartIsolateGroupsArgs,
+                fml::size(kDartIsolateGroupsArgs));
+  }
+
   if (settings_.endless_trace_buffer || settings_.trace_startup) {
     // If we are tracing startup, make sure the trace buffer is endless so we
     // don't lose early traces.
@@ -360,6 +369,10 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
 
   DartUI::InitForGlobal();
 
+  // The isolate snapshot is only needed once the root isolate is created, so
+  // it is read while the VM snapshot is being loaded.
+  vm_data_->GetIsolateSnapshot()->Prefetch(GetConcurrentWorkerTaskRunner());
+
   {
     TRACE_EVENT0("flutter", "Dart_Initialize");
     Dart_InitializeParams params = {};
@@ -369,9 +382,14 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
         vm_data_->GetVMSnapshot().GetInstructionsMapping();
     params.create_group = reinterpret_cast<decltype(params.create_group)>(
         DartIsolate::DartIsolateGroupCreateCallback);
+    params.initialize_isolate =
+        reinterpret_cast<decltype(params.initialize_isolate)>(
+            DartIsolate::DartIsolateInitializeCallback);
     params.shutdown_isolate =
         reinterpret_cast<decltype(params.shutdown_isolate)>(
             DartIsolate::DartIsolateShutdownCallback);
+    params.cleanup_isolate = reinterpret_cast<decltype(params.cleanup_isolate)>(
+        DartIsolate::DartIsolateCleanupCallback);
     params.cleanup_group = reinterpret_cast<decltype(params.cleanup_group)>(
         DartIsolate::DartIsolateGroupCleanupCallback);
     params.thread_exit = ThreadExitCallback;
@@ -218,6 +218,10 @@ bool RuntimeController::SetSemanticsEnabled(bool enabled) {
   return false;
 }
 
+bool RuntimeController::GetSemanticsEnabled() const {
+  return window_data_.semantics_enabled;
+}
+
 bool RuntimeController::SetAccessibilityFeatures(int32_t flags) {
   window_data_.accessibility_feature_flags_ = flags;
   if (auto* window = GetWindowIfAvailable()) {
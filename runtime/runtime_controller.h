@@ -56,6 +56,8 @@ class RuntimeController final : public WindowClient {
 
   bool SetSemanticsEnabled(bool enabled);
 
+  bool GetSemanticsEnabled() const;
+
   bool SetAccessibilityFeatures(int32_t flags);
 
   bool BeginFrame(fml::TimePoint frame_time);
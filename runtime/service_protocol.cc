@@ -32,6 +32,13 @@ const std::string_view ServiceProtocol::kSetAssetBundlePathExtensionName =
     "_flutter.setAssetBundlePath";
 const std::string_view ServiceProtocol::kGetDisplayRefreshRateExtensionName =
     "_flutter.getDisplayRefreshRate";
+const std::string_view ServiceProtocol::kGetMemoryUsageExtensionName =
+    "_flutter.getMemoryUsage";
+const std::string_view
+    ServiceProtocol::kSetNativeTraceCategoriesExtensionName =
+        "_flutter.setNativeTraceCategories";
+const std::string_view ServiceProtocol::kGetNativeTraceExtensionName =
+    "_flutter.getNativeTrace";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -49,6 +56,9 @@ ServiceProtocol::ServiceProtocol()
           kFlushUIThreadTasksExtensionName,
           kSetAssetBundlePathExtensionName,
           kGetDisplayRefreshRateExtensionName,
+          kGetMemoryUsageExtensionName,
+          kSetNativeTraceCategoriesExtensionName,
+          kGetNativeTraceExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -28,6 +28,9 @@ class ServiceProtocol {
   static const std::string_view kFlushUIThreadTasksExtensionName;
   static const std::string_view kSetAssetBundlePathExtensionName;
   static const std::string_view kGetDisplayRefreshRateExtensionName;
+  static const std::string_view kGetMemoryUsageExtensionName;
+  static const std::string_view kSetNativeTraceCategoriesExtensionName;
+  static const std::string_view kGetNativeTraceExtensionName;
 
   class Handler {
    public:
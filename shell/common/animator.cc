@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
@@ -17,11 +19,17 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// Paced frames are timed by extrapolating the last vsync received from the
+// waiter. The display clock drifts from ours, so the waiter is asked again
+// after this many frames.
+constexpr int64_t kMaxExtrapolatedFrameCount = 60;
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
                    TaskRunners task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   bool enable_predictive_pacing)
     : delegate_(delegate),
       task_runners_(std::move(task_runners)),
       waiter_(std::move(waiter)),
@@ -42,6 +50,8 @@ Animator::Animator(Delegate& delegate,
       frame_scheduled_(false),
       notify_idle_task_id_(0),
       dimension_change_pending_(false),
+      pacer_(enable_predictive_pacing ? std::make_unique<FramePacer>()
+                                      : nullptr),
       weak_factory_(this) {}
 
 Animator::~Animator() = default;
@@ -80,6 +90,13 @@ void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
       });
 }
 
+void Animator::RecordFrameTiming(const FrameTiming& timing) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (pacer_) {
+    pacer_->AddFrameTiming(timing);
+  }
+}
+
 // This Parity is used by the timeline component to correctly align
 // GPU Workloads events with their respective Framework Workload.
 const char* Animator::FrameParity() {
@@ -132,7 +149,11 @@ void Animator::BeginFrame(fml::TimePoint frame_start_time,
   {
     TRACE_EVENT2("flutter", "Framework Workload", "mode", "basic", "frame",
                  FrameParity());
+    // Frames are rendered from within the begin frame callback, and only
+    // those are measured.
+    build_start_time_ = fml::TimePoint::Now();
     delegate_.OnAnimatorBeginFrame(last_begin_frame_time_);
+    build_start_time_ = fml::TimePoint();
   }
 
   if (!frame_scheduled_) {
@@ -160,7 +181,7 @@ void Animator::BeginFrame(fml::TimePoint frame_start_time,
                                                  100000);
           }
         },
-        kNotifyIdleTaskWaitTime);
+        GetNotifyIdleTaskWaitTime());
   }
 }
 
@@ -176,6 +197,11 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
     layer_tree->RecordBuildTime(last_begin_frame_time_);
   }
 
+  if (pacer_ && build_start_time_ != fml::TimePoint()) {
+    pacer_->AddBuildDuration(fml::TimePoint::Now() - build_start_time_);
+    build_start_time_ = fml::TimePoint();
+  }
+
   // Commit the pending continuation.
   producer_continuation_.Complete(std::move(layer_tree));
 
@@ -224,10 +250,16 @@ void Animator::RequestFrame(bool regenerate_layer_tree) {
 }
 
 void Animator::AwaitVSync() {
+  if (pacer_ && SchedulePacedFrame()) {
+    return;
+  }
+
   waiter_->AsyncWaitForVsync(
       [self = weak_factory_.GetWeakPtr()](fml::TimePoint frame_start_time,
                                           fml::TimePoint frame_target_time) {
         if (self) {
+          self->last_vsync_time_ = frame_start_time;
+          self->vsync_interval_ = frame_target_time - frame_start_time;
           if (self->CanReuseLastLayerTree()) {
             self->DrawLastLayerTree();
           } else {
@@ -236,7 +268,83 @@ void Animator::AwaitVSync() {
         }
       });
 
-  delegate_.OnAnimatorNotifyIdle(dart_frame_deadline_);
+  if (pacer_ && vsync_interval_ > fml::TimeDelta::Zero()) {
+    // The previous frame's deadline has passed if the UI thread was idle for
+    // more than a frame, while the next vsync is when the idle period ends.
+    delegate_.OnAnimatorNotifyIdle(
+        FxlToDartOrEarlier(GetNextVsyncTime(fml::TimePoint::Now())));
+  } else {
+    delegate_.OnAnimatorNotifyIdle(dart_frame_deadline_);
+  }
+}
+
+// Starts the next frame when it is predicted to finish building in time
+// instead of always at a vsync. A frame whose vsync was missed by less than
+// the predicted slack still starts right away rather than a whole frame
+// later, and frames that take most of the interval to build start ahead of
+// their vsync so that the UI thread builds them while the GPU thread
+// rasterizes the previous one. Either way the frame time is that of the vsync
+// the frame is for.
+bool Animator::SchedulePacedFrame() {
+  if (!pacer_->CanPace(vsync_interval_)) {
+    return false;
+  }
+
+  const fml::TimePoint now = fml::TimePoint::Now();
+  if (now - last_vsync_time_ > vsync_interval_ * kMaxExtrapolatedFrameCount) {
+    return false;
+  }
+
+  // A frame is never paced for the vsync of an earlier one. That includes a
+  // frame that found the pipeline full, which is retried a vsync later rather
+  // than right away.
+  const fml::TimePoint last_frame_start_time =
+      std::max(last_begin_frame_time_, last_paced_frame_start_time_);
+  const fml::TimeDelta slack = pacer_->GetBuildSlack(vsync_interval_);
+  fml::TimePoint frame_start_time = GetNextVsyncTime(now - slack);
+  if (!(last_frame_start_time < frame_start_time)) {
+    frame_start_time =
+        GetNextVsyncTime(last_frame_start_time + vsync_interval_ / 2);
+  }
+  last_paced_frame_start_time_ = frame_start_time;
+  const fml::TimePoint frame_target_time = frame_start_time + vsync_interval_;
+  const fml::TimePoint begin_time =
+      std::max(now, frame_start_time + std::min(slack, fml::TimeDelta::Zero()));
+
+  task_runners_.GetUITaskRunner()->PostTaskForTime(
+      [self = weak_factory_.GetWeakPtr(), frame_start_time,
+       frame_target_time]() {
+        if (!self) {
+          return;
+        }
+        if (self->CanReuseLastLayerTree()) {
+          self->DrawLastLayerTree();
+        } else {
+          TRACE_EVENT0("flutter", "Animator::PacedFrame");
+          self->BeginFrame(frame_start_time, frame_target_time);
+        }
+      },
+      begin_time, fml::TaskPriority::kFrameCritical);
+
+  delegate_.OnAnimatorNotifyIdle(FxlToDartOrEarlier(begin_time));
+  return true;
+}
+
+// The first vsync at or after |after|, extrapolated from the last one.
+fml::TimePoint Animator::GetNextVsyncTime(fml::TimePoint after) const {
+  fml::TimeDelta offset = (last_vsync_time_ - after) % vsync_interval_;
+  if (offset < fml::TimeDelta::Zero()) {
+    offset = offset + vsync_interval_;
+  }
+  return after + offset;
+}
+
+fml::TimeDelta Animator::GetNotifyIdleTaskWaitTime() const {
+  if (pacer_ && vsync_interval_ > fml::TimeDelta::Zero()) {
+    // One more millisecond than three frames at the actual refresh rate.
+    return vsync_interval_ * 3 + fml::TimeDelta::FromMilliseconds(1);
+  }
+  return kNotifyIdleTaskWaitTime;
 }
 
 }  // namespace flutter
@@ -12,6 +12,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_pacer.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -40,9 +41,14 @@ class Animator final {
     virtual void OnAnimatorDrawLastLayerTree() = 0;
   };
 
+  /// When |enable_predictive_pacing| is set, the animator predicts frame
+  /// durations from the timings passed to |RecordFrameTiming|. It starts
+  /// building frames ahead of the vsync when they are predicted to miss it,
+  /// and tells the delegate exactly how long it will be idle.
   Animator(Delegate& delegate,
            TaskRunners task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           bool enable_predictive_pacing = false);
 
   ~Animator();
 
@@ -62,6 +68,10 @@ class Animator final {
   // will be ended during the next |BeginFrame|.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  // Called on the UI thread with the timings of every rasterized frame. Only
+  // used for predictive pacing.
+  void RecordFrameTiming(const FrameTiming& timing);
+
  private:
   using LayerTreePipeline = Pipeline<flutter::LayerTree>;
 
@@ -73,6 +83,12 @@ class Animator final {
 
   void AwaitVSync();
 
+  bool SchedulePacedFrame();
+
+  fml::TimePoint GetNextVsyncTime(fml::TimePoint after) const;
+
+  fml::TimeDelta GetNotifyIdleTaskWaitTime() const;
+
   const char* FrameParity();
 
   Delegate& delegate_;
@@ -92,6 +108,12 @@ class Animator final {
   bool dimension_change_pending_;
   SkISize last_layer_tree_size_;
   std::deque<uint64_t> trace_flow_ids_;
+  std::unique_ptr<FramePacer> pacer_;
+  fml::TimePoint build_start_time_;
+  // The frame time of the last paced frame, whether or not it began.
+  fml::TimePoint last_paced_frame_start_time_;
+  fml::TimePoint last_vsync_time_;
+  fml::TimeDelta vsync_interval_;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/common/vsync_waiter_fallback.h"
+
+namespace flutter {
+
+static void Spin(fml::TimeDelta duration) {
+  const fml::TimePoint end = fml::TimePoint::Now() + duration;
+  while (fml::TimePoint::Now() < end) {
+  }
+}
+
+// An app that animates continuously on a simulated 120Hz display. Frames take
+// around |mean_build| to build, varying by up to a quarter either way, and
+// |raster| to rasterize.
+class SimulatedApp final : public Animator::Delegate {
+ public:
+  SimulatedApp(TaskRunners task_runners,
+               fml::TimeDelta mean_build,
+               fml::TimeDelta raster,
+               size_t frame_count)
+      : task_runners_(std::move(task_runners)),
+        mean_build_(mean_build),
+        raster_(raster),
+        frame_count_(frame_count) {}
+
+  // Returns the fraction of vsyncs that did not get a new frame.
+  double Run(bool enable_predictive_pacing) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(), [this, enable_predictive_pacing]() {
+          animator_ = std::make_unique<Animator>(
+              *this, task_runners_,
+              std::make_unique<VsyncWaiterFallback>(task_runners_,
+                                                    kFrameInterval),
+              enable_predictive_pacing);
+          animator_->RequestFrame();
+        });
+    done_.Wait();
+
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
+                                      [this, &latch]() {
+                                        animator_.reset();
+                                        latch.Signal();
+                                      });
+    latch.Wait();
+
+    const double vsyncs =
+        (last_raster_finish_ - first_raster_finish_).ToSecondsF() /
+        kFrameInterval.ToSecondsF();
+    return 1.0 - (frame_count_ - 1) / vsyncs;
+  }
+
+  // |Animator::Delegate|
+  void OnAnimatorBeginFrame(fml::TimePoint frame_time) override {
+    if (++frames_begun_ < frame_count_) {
+      animator_->RequestFrame();
+    }
+    // A cheap deterministic sequence in [-1, 1).
+    seed_ = seed_ * 1103515245 + 12345;
+    const double jitter = ((seed_ >> 16) % 2048) / 1024.0 - 1.0;
+    Spin(fml::TimeDelta::FromNanoseconds(mean_build_.ToNanoseconds() *
+                                         (1.0 + jitter / 4)));
+    animator_->Render(std::make_unique<LayerTree>());
+  }
+
+  // |Animator::Delegate|
+  void OnAnimatorNotifyIdle(int64_t deadline) override {}
+
+  // |Animator::Delegate|
+  void OnAnimatorDraw(fml::RefPtr<Pipeline<LayerTree>> pipeline) override {
+    task_runners_.GetGPUTaskRunner()->PostTask([this, pipeline]() {
+      auto result = pipeline->Consume([this](std::unique_ptr<LayerTree>) {
+        FrameTiming timing;
+        timing.Set(FrameTiming::kRasterStart, fml::TimePoint::Now());
+        Spin(raster_);
+        timing.Set(FrameTiming::kRasterFinish, fml::TimePoint::Now());
+        OnFrameRasterized(timing);
+      });
+      (void)result;
+    });
+  }
+
+  // |Animator::Delegate|
+  void OnAnimatorDrawLastLayerTree() override {}
+
+ private:
+  static constexpr fml::TimeDelta kFrameInterval =
+      fml::TimeDelta::FromSecondsF(1.0 / 120.0);
+
+  const TaskRunners task_runners_;
+  const fml::TimeDelta mean_build_;
+  const fml::TimeDelta raster_;
+  const size_t frame_count_;
+  std::unique_ptr<Animator> animator_;
+  size_t frames_begun_ = 0;
+  uint32_t seed_ = 1;
+  size_t frames_rasterized_ = 0;
+  fml::TimePoint first_raster_finish_;
+  fml::TimePoint last_raster_finish_;
+  fml::ManualResetWaitableEvent done_;
+
+  // Called on the GPU thread.
+  void OnFrameRasterized(const FrameTiming& timing) {
+    task_runners_.GetUITaskRunner()->PostTask([this, timing]() {
+      if (animator_) {
+        animator_->RecordFrameTiming(timing);
+      }
+    });
+    const fml::TimePoint finish = timing.Get(FrameTiming::kRasterFinish);
+    if (frames_rasterized_++ == 0) {
+      first_raster_finish_ = finish;
+    }
+    last_raster_finish_ = finish;
+    if (frames_rasterized_ == frame_count_) {
+      done_.Signal();
+    }
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SimulatedApp);
+};
+
+// Two seconds of animation per iteration. Reports the share of vsyncs that
+// were missed.
+static void RunSimulatedFrames(benchmark::State& state,
+                               bool enable_predictive_pacing) {
+  ThreadHost thread_host("io.flutter.bench.", ThreadHost::Type::Platform |
+                                                  ThreadHost::Type::GPU |
+                                                  ThreadHost::Type::UI |
+                                                  ThreadHost::Type::IO);
+  TaskRunners task_runners("animator_bench",
+                           thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.gpu_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  double missed_vsyncs = 0;
+  size_t runs = 0;
+  while (state.KeepRunning()) {
+    SimulatedApp app(task_runners,
+                     fml::TimeDelta::FromMicroseconds(state.range(0)),
+                     fml::TimeDelta::FromMilliseconds(4), 240);
+    missed_vsyncs += app.Run(enable_predictive_pacing);
+    runs++;
+  }
+  state.counters["missed_vsyncs"] = runs == 0 ? 0 : missed_vsyncs / runs;
+}
+
+static void BM_AnimatorVsyncPacing(benchmark::State& state) {
+  RunSimulatedFrames(state, false);
+}
+
+static void BM_AnimatorPredictivePacing(benchmark::State& state) {
+  RunSimulatedFrames(state, true);
+}
+
+// Mean build times in microseconds, against an 8.3ms frame interval.
+BENCHMARK(BM_AnimatorVsyncPacing)
+    ->Arg(4000)
+    ->Arg(7000)
+    ->Iterations(5)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_AnimatorPredictivePacing)
+    ->Arg(4000)
+    ->Arg(7000)
+    ->Iterations(5)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace flutter
@@ -13,17 +13,22 @@
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/lib/snapshot/snapshot.h"
+#include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/persistent_cache.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/shell.h"
+#include "minikin/Layout.h"
 #include "rapidjson/document.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace flutter {
@@ -35,6 +40,8 @@ static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kSettingsChannel[] = "flutter/settings";
 static constexpr char kIsolateChannel[] = "flutter/isolate";
 
+static constexpr char kFallbackFontCacheFileName[] = "font_fallback_cache";
+
 Engine::Engine(Delegate& delegate,
                DartVM& vm,
                fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -83,6 +90,24 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
 
+void Engine::CollectMemoryUsage(MemoryUsage& usage) const {
+  // Decoded images are only released once the framework drops them.
+  usage.Add("decodedImages", CanvasImage::GetLiveImageBytes(),
+            CanvasImage::GetLiveImageCount(), 0, false);
+  usage.Add("fontCache", SkGraphics::GetFontCacheUsed(),
+            SkGraphics::GetFontCacheCountUsed(),
+            SkGraphics::GetFontCacheLimit());
+  size_t layout_count = 0;
+  size_t layout_bytes = 0;
+  minikin::Layout::getCacheUsage(&layout_count, &layout_bytes);
+  usage.Add("textLayoutCache", layout_bytes, layout_count);
+}
+
+void Engine::NotifyLowMemoryWarning() {
+  minikin::Layout::purgeCaches();
+  SkGraphics::PurgeFontCache();
+}
+
 bool Engine::UpdateAssetManager(
     std::shared_ptr<AssetManager> new_asset_manager) {
   if (asset_manager_ == new_asset_manager) {
@@ -100,6 +125,17 @@ bool Engine::UpdateAssetManager(
 
   if (settings_.use_test_fonts) {
     font_collection_.RegisterTestFonts();
+  } else {
+    // Text is laid out on this thread, so the fallback matches it makes are
+    // also collected and written from here.
+    font_collection_.SetupFallbackFontCache(
+        PersistentCache::GetCacheForProcess()->LoadFile(
+            kFallbackFontCacheFileName),
+        [](std::unique_ptr<fml::Mapping> cache) {
+          PersistentCache::GetCacheForProcess()->StoreFile(
+              kFallbackFontCacheFileName, std::move(cache));
+        },
+        fml::MessageLoop::GetCurrent().GetTaskRunner());
   }
 
   return true;
@@ -112,6 +148,9 @@ bool Engine::Restart(RunConfiguration configuration) {
     return false;
   }
   delegate_.OnPreEngineRestart();
+  // The new isolate sends its whole tree, which shares no history with what
+  // the platform was sent before.
+  semantics_differ_.Reset();
   runtime_controller_ = runtime_controller_->Clone();
   UpdateAssetManager(nullptr);
   return Run(std::move(configuration)) == Engine::RunStatus::Success;
@@ -223,6 +262,14 @@ void Engine::NotifyIdle(int64_t deadline) {
   TRACE_EVENT1("flutter", "Engine::NotifyIdle", "deadline_now_delta",
                std::to_string(deadline - Dart_TimelineGetMicros()).c_str());
   runtime_controller_->NotifyIdle(deadline);
+
+  // Whatever time the VM leaves goes to idle tasks on the UI task runner.
+  if (fml::MessageLoop::IsInitializedForCurrentThread()) {
+    const int64_t remaining_micros = deadline - Dart_TimelineGetMicros();
+    fml::MessageLoop::GetCurrent().RunIdleTasks(
+        fml::TimePoint::Now() +
+        fml::TimeDelta::FromMicroseconds(remaining_micros));
+  }
 }
 
 std::pair<bool, uint32_t> Engine::GetUIIsolateReturnCode() {
@@ -392,9 +439,25 @@ void Engine::DispatchSemanticsAction(int id,
 }
 
 void Engine::SetSemanticsEnabled(bool enabled) {
+  // The platform view starts over with a new tree when semantics are enabled.
+  semantics_differ_.Reset();
   runtime_controller_->SetSemanticsEnabled(enabled);
 }
 
+void Engine::ResetSemantics() {
+  semantics_differ_.Reset();
+  if (runtime_controller_->GetSemanticsEnabled()) {
+    // The framework discards its semantics tree when semantics are disabled
+    // and sends all of a new one once they are enabled again.
+    runtime_controller_->SetSemanticsEnabled(false);
+    runtime_controller_->SetSemanticsEnabled(true);
+  }
+}
+
+void Engine::RecordFrameTiming(const FrameTiming& timing) {
+  animator_->RecordFrameTiming(timing);
+}
+
 void Engine::SetAccessibilityFeatures(int32_t flags) {
   runtime_controller_->SetAccessibilityFeatures(flags);
 }
@@ -434,6 +497,9 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
 
 void Engine::UpdateSemantics(SemanticsNodeUpdates update,
                              CustomAccessibilityActionUpdates actions) {
+  if (!semantics_differ_.Diff(update, actions)) {
+    return;
+  }
   delegate_.OnEngineUpdateSemantics(std::move(update), std::move(actions));
 }
 
@@ -15,6 +15,7 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/semantics/semantics_tree_differ.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -23,6 +24,7 @@
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/runtime/runtime_delegate.h"
 #include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/memory_usage.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/shell_io_manager.h"
@@ -314,6 +316,21 @@ class Engine final : public RuntimeDelegate {
   ///
   fml::WeakPtr<Engine> GetWeakPtr() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the memory held by decoded images and by the font and
+  ///             text layout caches to `usage`. These are shared by all
+  ///             engines in the process.
+  ///
+  /// @param      usage  The memory usage to add to.
+  ///
+  void CollectMemoryUsage(MemoryUsage& usage) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Purges the font and text layout caches. Decoded images are
+  ///             owned by the application and are not affected.
+  ///
+  void NotifyLowMemoryWarning();
+
   //----------------------------------------------------------------------------
   /// @brief      Moves the root isolate to the `DartIsolate::Phase::Running`
   ///             phase on a successful call to this method.
@@ -680,6 +697,27 @@ class Engine final : public RuntimeDelegate {
   ///
   void SetSemanticsEnabled(bool enabled);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the embedder discarded the
+  ///             accessibility tree it was sent, for example because the
+  ///             platform objects holding it were recreated. If semantics are
+  ///             enabled, the framework sends the whole tree again instead of
+  ///             only the nodes that changed. This call originates in the
+  ///             platform view and is forwarded to the engine here on the UI
+  ///             task runner by the shell.
+  ///
+  void ResetSemantics();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine of the timings of a frame that has been
+  ///             rasterized. The shell forwards these here on the UI task
+  ///             runner when predictive frame pacing is enabled so that the
+  ///             animator can predict the durations of upcoming frames.
+  ///
+  /// @param[in]  timing  The build and raster timestamps of the frame.
+  ///
+  void RecordFrameTiming(const FrameTiming& timing);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has expressed an opinion
   ///             about where the flags to set on the accessibility tree. This
@@ -714,6 +752,7 @@ class Engine final : public RuntimeDelegate {
   bool have_surface_;
   FontCollection font_collection_;
   ImageDecoder image_decoder_;
+  SemanticsTreeDiffer semantics_differ_;
   fml::WeakPtrFactory<Engine> weak_factory_;
 
   // |RuntimeDelegate|
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:io';
 import 'dart:isolate';
 import 'dart:ui';
 
@@ -33,6 +34,36 @@ void onBeginFrameMain() {
 @pragma('vm:entry-point')
 void emptyMain() {}
 
+void notifyIsolatesSpawned(int microseconds, int rssGrowth) native 'NotifyIsolatesSpawned';
+
+// Stands in for a worker isolate: reports in, then waits to be killed.
+void spawnedIsolateMain(SendPort reports) {
+  final ReceivePort keepAlive = ReceivePort();
+  reports.send(keepAlive.sendPort);
+}
+
+// Spawns |isolateCount| isolates, then reports how long it took for all of
+// them to start running and how much the process grew.
+@pragma('vm:entry-point')
+Future<void> spawnIsolatesMain(List<String> args) async {
+  final int isolateCount = int.parse(args[0]);
+  final int rssBefore = ProcessInfo.currentRss;
+  final Stopwatch stopwatch = Stopwatch()..start();
+  final ReceivePort reports = ReceivePort();
+  final List<Isolate> isolates = <Isolate>[];
+  for (int i = 0; i < isolateCount; i++) {
+    isolates.add(await Isolate.spawn(spawnedIsolateMain, reports.sendPort));
+  }
+  await reports.take(isolateCount).length;
+  final int microseconds = stopwatch.elapsedMicroseconds;
+  final int rssGrowth = ProcessInfo.currentRss - rssBefore;
+  for (final Isolate isolate in isolates) {
+    isolate.kill(priority: Isolate.immediate);
+  }
+  reports.close();
+  notifyIsolatesSpawned(microseconds, rssGrowth);
+}
+
 @pragma('vm:entry-point')
 void dummyReportTimingsMain() {
   window.onReportTimings = (List<FrameTiming> timings) {};
@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_pacer.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+namespace {
+
+// Fewer samples than this are too noisy to act on.
+constexpr size_t kMinSampleCount = 8;
+
+// The share of recent frames the prediction should cover.
+constexpr double kPredictionPercentile = 0.9;
+
+// The part of the frame interval kept free for the prediction being wrong.
+constexpr int64_t kSafetyMarginDivisor = 8;
+
+}  // namespace
+
+FramePacer::FramePacer() = default;
+
+FramePacer::~FramePacer() = default;
+
+void FramePacer::AddBuildDuration(fml::TimeDelta duration) {
+  build_durations_.Add(duration);
+}
+
+void FramePacer::AddFrameTiming(const FrameTiming& timing) {
+  raster_durations_.Add(timing.Get(FrameTiming::kRasterFinish) -
+                        timing.Get(FrameTiming::kRasterStart));
+}
+
+fml::TimeDelta FramePacer::PredictBuildDuration() const {
+  return build_durations_.Predict();
+}
+
+fml::TimeDelta FramePacer::PredictRasterDuration() const {
+  return raster_durations_.Predict();
+}
+
+bool FramePacer::CanPace(fml::TimeDelta frame_interval) const {
+  if (frame_interval <= fml::TimeDelta::Zero() ||
+      PredictBuildDuration() == fml::TimeDelta::Zero() ||
+      PredictRasterDuration() == fml::TimeDelta::Zero()) {
+    return false;
+  }
+  return PredictRasterDuration() <= frame_interval;
+}
+
+fml::TimeDelta FramePacer::GetBuildSlack(fml::TimeDelta frame_interval) const {
+  const fml::TimeDelta budget =
+      frame_interval - frame_interval / kSafetyMarginDivisor;
+  // Starting more than half a frame early would build against input that is
+  // too stale.
+  return std::max(budget - PredictBuildDuration(),
+                  fml::TimeDelta::Zero() - frame_interval / 2);
+}
+
+void FramePacer::Samples::Add(fml::TimeDelta duration) {
+  durations_[next_] = duration;
+  next_ = (next_ + 1) % kCapacity;
+  count_ = std::min(count_ + 1, kCapacity);
+}
+
+fml::TimeDelta FramePacer::Samples::Predict() const {
+  if (count_ < kMinSampleCount) {
+    return fml::TimeDelta::Zero();
+  }
+  std::array<fml::TimeDelta, kCapacity> sorted = durations_;
+  const size_t index = (count_ - 1) * kPredictionPercentile;
+  std::nth_element(sorted.begin(), sorted.begin() + index,
+                   sorted.begin() + count_);
+  return sorted[index];
+}
+
+}  // namespace flutter
@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_PACER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_PACER_H_
+
+#include <array>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// Predicts how long the next frame will take to build and rasterize from
+/// recent frames, and from that when the |Animator| should start building it.
+///
+/// Predictions are a high percentile of the recent samples rather than their
+/// mean so that pacing follows what most frames need.
+class FramePacer {
+ public:
+  FramePacer();
+
+  ~FramePacer();
+
+  /// The time from the UI thread starting to build a frame to it being
+  /// handed to the rasterizer. |FrameTiming::kBuildStart| is the vsync the
+  /// frame was built for rather than when building started, so the animator
+  /// measures this itself.
+  void AddBuildDuration(fml::TimeDelta duration);
+
+  /// Only the raster phases of |timing| are used.
+  void AddFrameTiming(const FrameTiming& timing);
+
+  /// Returns zero until enough frames have been sampled.
+  fml::TimeDelta PredictBuildDuration() const;
+
+  /// Returns zero until enough frames have been sampled.
+  fml::TimeDelta PredictRasterDuration() const;
+
+  /// Whether predictions are available and pacing frames by them can help.
+  /// It cannot when rasterization does not keep up with |frame_interval|, as
+  /// frames then wait in the pipeline however early they are built.
+  bool CanPace(fml::TimeDelta frame_interval) const;
+
+  /// How long after its vsync a frame can start building and still be
+  /// predicted to finish in time for rasterization to start one
+  /// |frame_interval| later, with some time to spare. Negative when frames
+  /// have to start ahead of their vsync.
+  fml::TimeDelta GetBuildSlack(fml::TimeDelta frame_interval) const;
+
+ private:
+  class Samples {
+   public:
+    void Add(fml::TimeDelta duration);
+
+    fml::TimeDelta Predict() const;
+
+   private:
+    static constexpr size_t kCapacity = 32;
+
+    std::array<fml::TimeDelta, kCapacity> durations_;
+    size_t count_ = 0;
+    size_t next_ = 0;
+  };
+
+  Samples build_durations_;
+  Samples raster_durations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FramePacer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_PACER_H_
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_pacer.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr fml::TimeDelta kFrameInterval =
+    fml::TimeDelta::FromMicroseconds(8000);
+
+static void AddFrames(FramePacer& pacer,
+                      size_t count,
+                      fml::TimeDelta build,
+                      fml::TimeDelta raster) {
+  for (size_t i = 0; i < count; i++) {
+    pacer.AddBuildDuration(build);
+    FrameTiming timing;
+    timing.Set(FrameTiming::kRasterStart, fml::TimePoint());
+    timing.Set(FrameTiming::kRasterFinish, fml::TimePoint() + raster);
+    pacer.AddFrameTiming(timing);
+  }
+}
+
+TEST(FramePacerTest, DoesNotPaceWithoutEnoughSamples) {
+  FramePacer pacer;
+  AddFrames(pacer, 2, fml::TimeDelta::FromMilliseconds(2),
+            fml::TimeDelta::FromMilliseconds(2));
+  ASSERT_FALSE(pacer.CanPace(kFrameInterval));
+}
+
+TEST(FramePacerTest, PredictsTheSlowerFrames) {
+  FramePacer pacer;
+  AddFrames(pacer, 27, fml::TimeDelta::FromMilliseconds(2),
+            fml::TimeDelta::FromMilliseconds(3));
+  AddFrames(pacer, 5, fml::TimeDelta::FromMilliseconds(6),
+            fml::TimeDelta::FromMilliseconds(3));
+  ASSERT_TRUE(pacer.CanPace(kFrameInterval));
+  ASSERT_EQ(pacer.PredictBuildDuration(), fml::TimeDelta::FromMilliseconds(6));
+  ASSERT_EQ(pacer.PredictRasterDuration(),
+            fml::TimeDelta::FromMilliseconds(3));
+  // 7ms of the 8ms interval are budgeted for building.
+  ASSERT_EQ(pacer.GetBuildSlack(kFrameInterval),
+            fml::TimeDelta::FromMilliseconds(1));
+}
+
+TEST(FramePacerTest, SlowFramesStartAheadOfTheirVsync) {
+  FramePacer pacer;
+  AddFrames(pacer, 32, fml::TimeDelta::FromMilliseconds(9),
+            fml::TimeDelta::FromMilliseconds(3));
+  ASSERT_EQ(pacer.GetBuildSlack(kFrameInterval),
+            fml::TimeDelta::FromMilliseconds(-2));
+
+  AddFrames(pacer, 32, fml::TimeDelta::FromMilliseconds(20),
+            fml::TimeDelta::FromMilliseconds(3));
+  ASSERT_EQ(pacer.GetBuildSlack(kFrameInterval),
+            fml::TimeDelta::FromMilliseconds(-4));
+}
+
+TEST(FramePacerTest, DoesNotPaceWhenRasterizationIsTooSlow) {
+  FramePacer pacer;
+  AddFrames(pacer, 32, fml::TimeDelta::FromMilliseconds(9),
+            fml::TimeDelta::FromMilliseconds(12));
+  ASSERT_FALSE(pacer.CanPace(kFrameInterval));
+}
+
+}  // namespace testing
+}  // namespace flutter
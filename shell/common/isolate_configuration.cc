@@ -5,6 +5,7 @@
 #include "flutter/shell/common/isolate_configuration.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_vm.h"
 
 namespace flutter {
@@ -68,11 +69,17 @@ class KernelListIsolateConfiguration final : public IsolateConfiguration {
       return false;
     }
 
+    // The remaining pieces continue to be fetched while each one is loaded.
     for (size_t i = 0; i < kernel_pieces_.size(); i++) {
       bool last_piece = i + 1 == kernel_pieces_.size();
 
-      if (!isolate.PrepareForRunningFromKernel(kernel_pieces_[i].get(),
-                                               last_piece)) {
+      std::unique_ptr<const fml::Mapping> piece;
+      {
+        TRACE_EVENT0("flutter", "IsolateConfiguration::WaitForKernelPiece");
+        piece = kernel_pieces_[i].get();
+      }
+
+      if (!isolate.PrepareForRunningFromKernel(std::move(piece), last_piece)) {
         return false;
       }
     }
@@ -113,6 +120,40 @@ static std::vector<std::string> ParseKernelListPaths(
   return kernel_pieces_paths;
 }
 
+using KernelFetch = std::function<std::unique_ptr<const fml::Mapping>()>;
+
+// Asset mappings are populated lazily, so the fetch also pages the kernel in.
+// Otherwise the reads would happen on the UI thread while the VM loads it.
+static std::unique_ptr<const fml::Mapping> FetchAndPageInKernel(
+    const KernelFetch& fetch) {
+  TRACE_EVENT0("flutter", "IsolateConfiguration::FetchKernelPiece");
+  auto mapping = fetch();
+  if (mapping) {
+    fml::PageInMapping(*mapping);
+  }
+  return mapping;
+}
+
+// Fetches on the worker if one is available and on a thread of its own if not,
+// so that the caller never waits for the kernel to be read.
+static std::future<std::unique_ptr<const fml::Mapping>> FetchKernelPiece(
+    KernelFetch fetch,
+    fml::RefPtr<fml::TaskRunner> io_worker) {
+  if (!io_worker) {
+    return std::async(std::launch::async, FetchAndPageInKernel,
+                      std::move(fetch));
+  }
+
+  std::promise<std::unique_ptr<const fml::Mapping>> fetch_promise;
+  auto fetch_future = fetch_promise.get_future();
+  io_worker->PostTask(
+      fml::MakeCopyable([fetch = std::move(fetch),
+                         fetch_promise = std::move(fetch_promise)]() mutable {
+        fetch_promise.set_value(FetchAndPageInKernel(fetch));
+      }));
+  return fetch_future;
+}
+
 static std::vector<std::future<std::unique_ptr<const fml::Mapping>>>
 PrepareKernelMappings(std::vector<std::string> kernel_pieces_paths,
                       std::shared_ptr<AssetManager> asset_manager,
@@ -121,21 +162,11 @@ PrepareKernelMappings(std::vector<std::string> kernel_pieces_paths,
   std::vector<std::future<std::unique_ptr<const fml::Mapping>>> fetch_futures;
 
   for (const auto& kernel_pieces_path : kernel_pieces_paths) {
-    std::promise<std::unique_ptr<const fml::Mapping>> fetch_promise;
-    fetch_futures.push_back(fetch_promise.get_future());
-    auto fetch_task =
-        fml::MakeCopyable([asset_manager, kernel_pieces_path,
-                           fetch_promise = std::move(fetch_promise)]() mutable {
-          fetch_promise.set_value(
-              asset_manager->GetAsMapping(kernel_pieces_path));
-        });
-    // Fulfill the promise on the worker if one is available or the current
-    // thread if one is not.
-    if (io_worker) {
-      io_worker->PostTask(fetch_task);
-    } else {
-      fetch_task();
-    }
+    fetch_futures.push_back(FetchKernelPiece(
+        [asset_manager, kernel_pieces_path]() {
+          return asset_manager->GetAsMapping(kernel_pieces_path);
+        },
+        io_worker));
   }
 
   return fetch_futures;
@@ -155,7 +186,15 @@ std::unique_ptr<IsolateConfiguration> IsolateConfiguration::InferFromSettings(
   }
 
   if (settings.application_kernels) {
-    return CreateForKernelList(settings.application_kernels());
+    std::vector<std::future<std::unique_ptr<const fml::Mapping>>> pieces;
+    for (auto& kernel : settings.application_kernels()) {
+      pieces.push_back(FetchKernelPiece(
+          fml::MakeCopyable([kernel = std::move(kernel)]() mutable {
+            return std::move(kernel);
+          }),
+          io_worker));
+    }
+    return CreateForKernelList(std::move(pieces));
   }
 
   if (settings.application_kernel_asset.empty() &&
@@ -165,12 +204,19 @@ std::unique_ptr<IsolateConfiguration> IsolateConfiguration::InferFromSettings(
     return nullptr;
   }
 
-  // Running from kernel snapshot.
+  // Running from kernel snapshot. Mapping the kernel is cheap, reading it is
+  // not, so only the latter is left to the worker.
   {
-    std::unique_ptr<fml::Mapping> kernel =
+    std::unique_ptr<const fml::Mapping> kernel =
         asset_manager->GetAsMapping(settings.application_kernel_asset);
     if (kernel) {
-      return CreateForKernel(std::move(kernel));
+      std::vector<std::future<std::unique_ptr<const fml::Mapping>>> pieces;
+      pieces.push_back(FetchKernelPiece(
+          fml::MakeCopyable([kernel = std::move(kernel)]() mutable {
+            return std::move(kernel);
+          }),
+          io_worker));
+      return CreateForKernelList(std::move(pieces));
     }
   }
 
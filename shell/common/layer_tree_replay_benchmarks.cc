@@ -0,0 +1,222 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays captured layer trees (see the --capture-layer-trees switch) through
+// the compositor and the software backend with the raster cache enabled.
+//
+//   FLUTTER_LAYER_TREE_CAPTURES=<file>[:<file>...] layer_tree_replay_benchmarks
+//
+// A synthetic scrolling list is always replayed as well. Each iteration
+// rasterizes one frame of the capture and the label reports the distribution
+// of the frame raster times.
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/layer_tree_serialization.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/message_loop.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/shell/gpu/gpu_surface_software.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+class ReplaySoftwareDelegate : public GPUSurfaceSoftwareDelegate {
+ public:
+  // |GPUSurfaceSoftwareDelegate|
+  sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) override {
+    if (!backing_store_ || backing_store_->width() != size.width() ||
+        backing_store_->height() != size.height()) {
+      backing_store_ =
+          SkSurface::MakeRasterN32Premul(size.width(), size.height());
+    }
+    return backing_store_;
+  }
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStore(sk_sp<SkSurface> backing_store) override {
+    return backing_store != nullptr;
+  }
+
+ private:
+  sk_sp<SkSurface> backing_store_;
+};
+
+// A list of cards scrolling by. The card pictures are shared between frames
+// like the pictures of retained layers in an application.
+static sk_sp<SkData> CreateSyntheticCapture(
+    fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+  const SkISize frame_size = SkISize::Make(1080, 1920);
+  const int card_height = 240;
+  const int card_count = 40;
+
+  std::vector<sk_sp<SkPicture>> cards;
+  for (int i = 0; i < card_count; i++) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(
+        SkRect::MakeWH(frame_size.width(), card_height));
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SkColorSetRGB(0x40 + i * 4, 0x80, 0xC0 - i * 4));
+    canvas->drawRRect(
+        SkRRect::MakeRectXY(SkRect::MakeXYWH(16, 8, frame_size.width() - 32,
+                                             card_height - 16),
+                            16, 16),
+        paint);
+    paint.setColor(SK_ColorWHITE);
+    for (int line = 0; line < 5; line++) {
+      canvas->drawRect(SkRect::MakeXYWH(48, 40 + line * 36,
+                                        frame_size.width() - 96 - line * 80,
+                                        20),
+                       paint);
+    }
+    cards.push_back(recorder.finishRecordingAsPicture());
+  }
+
+  SkDynamicMemoryWStream stream;
+  LayerTreeWriter writer(&stream);
+  for (int frame = 0; frame < 120; frame++) {
+    auto root = std::make_shared<ContainerLayer>();
+    auto scroll = std::make_shared<TransformLayer>(
+        SkMatrix::MakeTrans(0, -frame * 24.0f));
+    for (int i = 0; i < card_count; i++) {
+      scroll->Add(std::make_shared<PictureLayer>(
+          SkPoint::Make(0, i * card_height),
+          SkiaGPUObject<SkPicture>{cards[i], unref_queue}, false, false));
+    }
+    root->Add(scroll);
+
+    LayerTree tree;
+    tree.set_frame_size(frame_size);
+    tree.set_root_layer(root);
+    FML_CHECK(writer.WriteFrame(tree));
+  }
+  return stream.detachAsData();
+}
+
+static std::string FormatMillis(double seconds) {
+  return std::to_string(seconds * 1e3).substr(0, 6) + "ms";
+}
+
+static void BM_ReplayLayerTrees(benchmark::State& state, sk_sp<SkData> data) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(),
+      fml::TimeDelta::FromMilliseconds(8));
+
+  if (!data) {
+    data = CreateSyntheticCapture(unref_queue);
+  }
+
+  std::vector<std::unique_ptr<LayerTree>> frames;
+  {
+    SkMemoryStream stream(data);
+    LayerTreeReader reader(&stream, unref_queue);
+    while (auto frame = reader.ReadFrame()) {
+      frames.push_back(std::move(frame));
+    }
+    if (!reader.is_valid() || frames.empty()) {
+      state.SkipWithError("Could not read the layer tree capture.");
+      return;
+    }
+  }
+
+  ReplaySoftwareDelegate delegate;
+  GPUSurfaceSoftware surface(&delegate);
+  CompositorContext compositor_context;
+
+  std::vector<double> frame_times;
+  size_t frame_index = 0;
+  while (state.KeepRunning()) {
+    LayerTree& tree = *frames[frame_index];
+    frame_index = (frame_index + 1) % frames.size();
+
+    const fml::TimePoint start = fml::TimePoint::Now();
+    auto frame = surface.AcquireFrame(tree.frame_size());
+    FML_CHECK(frame);
+    {
+      auto compositor_frame = compositor_context.AcquireFrame(
+          nullptr, frame->SkiaCanvas(), nullptr,
+          surface.GetRootTransformation(), false);
+      compositor_frame->Raster(tree, false);
+    }
+    FML_CHECK(frame->Submit());
+    const double seconds = (fml::TimePoint::Now() - start).ToSecondsF();
+
+    state.SetIterationTime(seconds);
+    frame_times.push_back(seconds);
+  }
+
+  if (!frame_times.empty()) {
+    std::sort(frame_times.begin(), frame_times.end());
+    auto percentile = [&frame_times](double p) {
+      return frame_times[std::min(frame_times.size() - 1,
+                                  static_cast<size_t>(p * frame_times.size()))];
+    };
+    state.SetLabel("frames=" + std::to_string(frames.size()) +
+                   " p50=" + FormatMillis(percentile(0.5)) +
+                   " p90=" + FormatMillis(percentile(0.9)) +
+                   " p99=" + FormatMillis(percentile(0.99)) +
+                   " max=" + FormatMillis(frame_times.back()));
+  }
+
+  frames.clear();
+  unref_queue->Drain();
+}
+
+static void BM_ReplaySyntheticLayerTrees(benchmark::State& state) {
+  BM_ReplayLayerTrees(state, nullptr);
+}
+BENCHMARK(BM_ReplaySyntheticLayerTrees)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Registers a benchmark for each capture listed in the environment.
+static bool RegisterCaptureBenchmarks() {
+  const char* captures = std::getenv("FLUTTER_LAYER_TREE_CAPTURES");
+  if (captures == nullptr) {
+    return false;
+  }
+
+  std::string remaining(captures);
+  while (!remaining.empty()) {
+    const size_t separator = remaining.find(':');
+    const std::string path = remaining.substr(0, separator);
+    remaining = separator == std::string::npos
+                    ? std::string()
+                    : remaining.substr(separator + 1);
+    if (path.empty()) {
+      continue;
+    }
+
+    auto mapping = fml::FileMapping::CreateReadOnly(path);
+    if (!mapping || mapping->GetSize() == 0) {
+      FML_LOG(ERROR) << "Could not read the layer tree capture at " << path;
+      continue;
+    }
+    auto data = SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize());
+    benchmark::RegisterBenchmark(("BM_ReplayLayerTrees/" + path).c_str(),
+                                 BM_ReplayLayerTrees, std::move(data))
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+  }
+  return true;
+}
+
+static const bool capture_benchmarks_registered BENCHMARK_UNUSED =
+    RegisterCaptureBenchmarks();
+
+}  // namespace flutter
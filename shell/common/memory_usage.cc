@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_usage.h"
+
+#include <utility>
+
+namespace flutter {
+
+MemoryUsage::MemoryUsage() = default;
+
+MemoryUsage::~MemoryUsage() = default;
+
+void MemoryUsage::Add(std::string name,
+                      size_t bytes,
+                      size_t entries,
+                      size_t budget_bytes,
+                      bool trimmable) {
+  SubsystemMemoryUsage usage;
+  usage.name = std::move(name);
+  usage.bytes = bytes;
+  usage.entries = entries;
+  usage.budget_bytes = budget_bytes;
+  usage.trimmable = trimmable;
+  subsystems_.push_back(std::move(usage));
+}
+
+const std::vector<SubsystemMemoryUsage>& MemoryUsage::GetSubsystems() const {
+  return subsystems_;
+}
+
+size_t MemoryUsage::GetTotalBytes() const {
+  size_t total = 0;
+  for (const auto& subsystem : subsystems_) {
+    total += subsystem.bytes;
+  }
+  return total;
+}
+
+size_t MemoryUsage::GetTrimmableBytes() const {
+  size_t total = 0;
+  for (const auto& subsystem : subsystems_) {
+    if (subsystem.trimmable) {
+      total += subsystem.bytes;
+    }
+  }
+  return total;
+}
+
+MemoryBudget::MemoryBudget(size_t budget_bytes)
+    : budget_bytes_(budget_bytes), low_water_bytes_(budget_bytes / 10 * 9) {}
+
+MemoryBudget::~MemoryBudget() = default;
+
+bool MemoryBudget::ShouldTrim(size_t trimmable_bytes) {
+  if (trimmed_) {
+    // A trim that freed nothing leaves the caches above the low-water mark,
+    // so they are not trimmed again until they shrink by other means.
+    if (trimmable_bytes >= low_water_bytes_) {
+      return false;
+    }
+    trimmed_ = false;
+  }
+  if (trimmable_bytes <= budget_bytes_) {
+    return false;
+  }
+  trimmed_ = true;
+  return true;
+}
+
+}  // namespace flutter
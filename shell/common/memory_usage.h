@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_USAGE_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_USAGE_H_
+
+#include <string>
+#include <vector>
+
+namespace flutter {
+
+/// The memory held by one engine subsystem, as reported by the subsystem.
+struct SubsystemMemoryUsage {
+  std::string name;
+  size_t bytes = 0;
+  size_t entries = 0;
+  /// The bytes the subsystem holds at most before evicting entries by itself,
+  /// or zero if it is not bounded by size.
+  size_t budget_bytes = 0;
+  /// Whether a low memory warning releases the memory of the subsystem. The
+  /// memory of the others is held by live objects, like the images the
+  /// framework holds on to.
+  bool trimmable = true;
+};
+
+/// A snapshot of the memory held by the subsystems of a shell. Caches that
+/// are shared by all shells in the process, like the text layout cache, are
+/// reported by each shell.
+class MemoryUsage {
+ public:
+  MemoryUsage();
+
+  ~MemoryUsage();
+
+  void Add(std::string name,
+           size_t bytes,
+           size_t entries,
+           size_t budget_bytes = 0,
+           bool trimmable = true);
+
+  const std::vector<SubsystemMemoryUsage>& GetSubsystems() const;
+
+  size_t GetTotalBytes() const;
+
+  /// The bytes held by the subsystems that a low memory warning trims.
+  size_t GetTrimmableBytes() const;
+
+ private:
+  std::vector<SubsystemMemoryUsage> subsystems_;
+};
+
+/// Decides when the trimmable caches of a shell are over its memory budget.
+/// Once they have been trimmed, they are only trimmed again after they have
+/// dropped below a low-water mark of 90% of the budget. Otherwise caches that
+/// a trim cannot shrink, or that refill right after one, would be trimmed on
+/// every check.
+class MemoryBudget {
+ public:
+  explicit MemoryBudget(size_t budget_bytes);
+
+  ~MemoryBudget();
+
+  /// Whether caches holding |trimmable_bytes| should be trimmed now. Records
+  /// the trim when it returns true.
+  bool ShouldTrim(size_t trimmable_bytes);
+
+ private:
+  const size_t budget_bytes_;
+  const size_t low_water_bytes_;
+  bool trimmed_ = false;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_USAGE_H_
@@ -180,6 +180,32 @@ void PersistentCache::DumpSkp(const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+std::unique_ptr<fml::Mapping> PersistentCache::LoadFile(
+    const std::string& file_name) const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+  auto file = fml::OpenFile(*cache_directory_, file_name.c_str(), false,
+                            fml::FilePermission::kRead);
+  if (!file.is_valid()) {
+    return nullptr;
+  }
+  auto mapping = std::make_unique<fml::FileMapping>(file);
+  if (mapping->GetSize() == 0) {
+    return nullptr;
+  }
+  return mapping;
+}
+
+void PersistentCache::StoreFile(const std::string& file_name,
+                                std::unique_ptr<fml::Mapping> data) {
+  if (is_read_only_ || !IsValid() || data == nullptr) {
+    return;
+  }
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_, file_name,
+                       std::move(data));
+}
+
 void PersistentCache::AddWorkerTaskRunner(
     fml::RefPtr<fml::TaskRunner> task_runner) {
   std::scoped_lock lock(worker_task_runners_mutex_);
@@ -10,6 +10,7 @@
 #include <set>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/thread_annotations.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
@@ -45,6 +46,13 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   bool StoredNewShaders() const { return stored_new_shaders_; }
   void ResetStoredNewShaders() { stored_new_shaders_ = false; }
   void DumpSkp(const SkData& data);
+
+  // Reads and writes files that belong to the engine rather than to Skia in
+  // the cache directory. Returns null if the file does not exist or is empty.
+  std::unique_ptr<fml::Mapping> LoadFile(const std::string& file_name) const;
+  void StoreFile(const std::string& file_name,
+                 std::unique_ptr<fml::Mapping> data);
+
   bool IsDumpingSkp() const { return is_dumping_skp_; }
   void SetIsDumpingSkp(bool value) { is_dumping_skp_ = value; }
 
@@ -51,6 +51,10 @@ void PlatformView::SetSemanticsEnabled(bool enabled) {
   delegate_.OnPlatformViewSetSemanticsEnabled(enabled);
 }
 
+void PlatformView::ResetSemantics() {
+  delegate_.OnPlatformViewResetSemantics();
+}
+
 void PlatformView::SetAccessibilityFeatures(int32_t flags) {
   delegate_.OnPlatformViewSetAccessibilityFeatures(flags);
 }
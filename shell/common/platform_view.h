@@ -148,6 +148,14 @@ class PlatformView {
     ///
     virtual void OnPlatformViewSetSemanticsEnabled(bool enabled) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate that the embedder discarded the
+    ///             accessibility tree it was sent and needs all of it again.
+    ///             This information needs to be forwarded to the root isolate
+    ///             running on the UI thread.
+    ///
+    virtual void OnPlatformViewResetSemantics() = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Notifies the delegate that the embedder has expressed an
     ///             opinion about the features to enable in the accessibility
@@ -311,6 +319,17 @@ class PlatformView {
   ///
   virtual void SetSemanticsEnabled(bool enabled);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the embedder to notify the engine that it discarded
+  ///             the accessibility tree it was sent, for example because the
+  ///             platform objects that held it were recreated. Updates are
+  ///             sent as differences from the tree the platform was last
+  ///             sent, so without this call the new tree would only receive
+  ///             the nodes that change from now on. If semantics are enabled,
+  ///             the whole tree is sent again.
+  ///
+  void ResetSemantics();
+
   //----------------------------------------------------------------------------
   /// @brief      Used by the embedder to specify the features to enable in the
   ///             accessibility tree generated by the isolate. This information
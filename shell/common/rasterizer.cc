@@ -69,6 +69,7 @@ void Rasterizer::Teardown() {
 }
 
 void Rasterizer::NotifyLowMemoryWarning() const {
+  compositor_context_->raster_cache().Clear();
   if (!surface_) {
     FML_DLOG(INFO) << "Rasterizer::PurgeCaches called with no surface.";
     return;
@@ -81,6 +82,24 @@ void Rasterizer::NotifyLowMemoryWarning() const {
   context->freeGpuResources();
 }
 
+void Rasterizer::CollectMemoryUsage(MemoryUsage& usage) const {
+  const RasterCache& raster_cache = compositor_context_->raster_cache();
+  usage.Add("rasterCache", raster_cache.EstimateByteSize(),
+            raster_cache.GetCachedEntriesCount());
+
+  GrContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (!context) {
+    return;
+  }
+  int resource_count = 0;
+  size_t resource_bytes = 0;
+  context->getResourceCacheUsage(&resource_count, &resource_bytes);
+  size_t max_resource_bytes = 0;
+  context->getResourceCacheLimits(nullptr, &max_resource_bytes);
+  usage.Add("gpuResourceCache", resource_bytes, resource_count,
+            max_resource_bytes);
+}
+
 flutter::TextureRegistry* Rasterizer::GetTextureRegistry() {
   return &compositor_context_->texture_registry();
 }
@@ -188,6 +207,15 @@ void Rasterizer::DoDraw(std::unique_ptr<flutter::LayerTree> layer_tree) {
 
   if (DrawToSurface(*layer_tree) == RasterStatus::kSuccess) {
     last_layer_tree_ = std::move(layer_tree);
+
+    if (layer_tree_capture_writer_) {
+      if (!layer_tree_capture_writer_->WriteFrame(*last_layer_tree_)) {
+        FML_LOG(ERROR) << "Could not capture the layer tree. Capturing stops.";
+        SetLayerTreeCaptureStream(nullptr);
+      } else {
+        layer_tree_capture_stream_->flush();
+      }
+    }
   }
 
   if (persistent_cache->IsDumpingSkp() &&
@@ -397,6 +425,16 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
   return Rasterizer::Screenshot{data, layer_tree->frame_size()};
 }
 
+void Rasterizer::SetLayerTreeCaptureStream(std::unique_ptr<SkWStream> stream) {
+  FML_DCHECK(task_runners_.GetGPUTaskRunner()->RunsTasksOnCurrentThread());
+  layer_tree_capture_writer_.reset();
+  layer_tree_capture_stream_ = std::move(stream);
+  if (layer_tree_capture_stream_) {
+    layer_tree_capture_writer_ =
+        std::make_unique<LayerTreeWriter>(layer_tree_capture_stream_.get());
+  }
+}
+
 void Rasterizer::SetNextFrameCallback(fml::closure callback) {
   next_frame_callback_ = callback;
 }
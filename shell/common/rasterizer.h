@@ -11,10 +11,12 @@
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/layer_tree_serialization.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/memory_usage.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/surface.h"
 
@@ -46,11 +48,17 @@ class Rasterizer final : public SnapshotDelegate {
 
   void Teardown();
 
-  // Frees up Skia GPU resources.
+  // Clears the raster cache and frees up Skia GPU resources.
   //
   // This method must be called from the GPU task runner.
   void NotifyLowMemoryWarning() const;
 
+  // Adds the memory held by the raster cache and the Skia GPU resource cache
+  // to |usage|.
+  //
+  // This method must be called from the GPU task runner.
+  void CollectMemoryUsage(MemoryUsage& usage) const;
+
   fml::WeakPtr<Rasterizer> GetWeakPtr() const;
 
   fml::WeakPtr<SnapshotDelegate> GetSnapshotDelegate() const;
@@ -84,6 +92,12 @@ class Rasterizer final : public SnapshotDelegate {
 
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  // Appends every layer tree that is drawn from now on to |stream|, in the
+  // format read by |LayerTreeReader|. Pass null to stop capturing.
+  //
+  // This method must be called from the GPU task runner.
+  void SetLayerTreeCaptureStream(std::unique_ptr<SkWStream> stream);
+
   // Sets a callback that will be executed after the next frame is submitted to
   // the surface on the GPU task runner.
   void SetNextFrameCallback(fml::closure callback);
@@ -101,6 +115,8 @@ class Rasterizer final : public SnapshotDelegate {
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
   std::unique_ptr<flutter::LayerTree> last_layer_tree_;
   fml::closure next_frame_callback_;
+  std::unique_ptr<SkWStream> layer_tree_capture_stream_;
+  std::unique_ptr<LayerTreeWriter> layer_tree_capture_writer_;
   fml::WeakPtrFactory<Rasterizer> weak_factory_;
 
   // |SnapshotDelegate|
@@ -7,22 +7,31 @@
 #include <sstream>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/fml/file.h"
 #include "flutter/runtime/dart_vm.h"
 
 namespace flutter {
 
+// Assets found in a pack are served from it without touching the file system.
+// The directory is still consulted for anything the pack does not contain.
+static void PushAssetDirectory(AssetManager* asset_manager,
+                               fml::UniqueFD directory) {
+  asset_manager->PushBack(PackedAssetBundle::OpenInDirectory(directory));
+  asset_manager->PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(directory)));
+}
+
 RunConfiguration RunConfiguration::InferFromSettings(
     const Settings& settings,
     fml::RefPtr<fml::TaskRunner> io_worker) {
   auto asset_manager = std::make_shared<AssetManager>();
 
-  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::Duplicate(settings.assets_dir)));
+  PushAssetDirectory(asset_manager.get(), fml::Duplicate(settings.assets_dir));
 
-  asset_manager->PushBack(
-      std::make_unique<DirectoryAssetBundle>(fml::OpenDirectory(
-          settings.assets_path.c_str(), false, fml::FilePermission::kRead)));
+  PushAssetDirectory(asset_manager.get(),
+                     fml::OpenDirectory(settings.assets_path.c_str(), false,
+                                        fml::FilePermission::kRead));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
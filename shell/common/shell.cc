@@ -19,6 +19,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/start_up.h"
@@ -29,6 +30,7 @@
 #include "flutter/shell/common/vsync_waiter.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/skia/include/core/SkGraphics.h"
+#include "third_party/skia/include/core/SkStream.h"
 #include "third_party/tonic/common/log.h"
 
 namespace flutter {
@@ -125,8 +127,9 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().enable_predictive_frame_pacing);
 
         engine = std::make_unique<Engine>(*shell,                        //
                                           *shell->GetDartVM(),           //
@@ -278,6 +281,8 @@ Shell::Shell(DartVMRef vm, TaskRunners task_runners, Settings settings)
     : task_runners_(std::move(task_runners)),
       settings_(std::move(settings)),
       vm_(std::move(vm)),
+      memory_budget_(std::make_shared<MemoryBudget>(
+          static_cast<size_t>(settings_.memory_budget_mb) * 1024 * 1024)),
       weak_factory_(this) {
   FML_CHECK(vm_) << "Must have access to VM to create a shell.";
   FML_DCHECK(task_runners_.IsValid());
@@ -312,6 +317,19 @@ Shell::Shell(DartVMRef vm, TaskRunners task_runners, Settings settings)
           task_runners_.GetUITaskRunner(),
           std::bind(&Shell::OnServiceProtocolGetDisplayRefreshRate, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetMemoryUsageExtensionName] =
+      {task_runners_.GetPlatformTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetMemoryUsage, this,
+                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kSetNativeTraceCategoriesExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolSetNativeTraceCategories, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetNativeTraceExtensionName] =
+      {task_runners_.GetPlatformTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetNativeTrace, this,
+                 std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -373,10 +391,85 @@ void Shell::NotifyLowMemoryWarning() const {
           rasterizer->NotifyLowMemoryWarning();
         }
       });
+  task_runners_.GetUITaskRunner()->PostTask([engine = weak_engine_]() {
+    if (engine) {
+      engine->NotifyLowMemoryWarning();
+    }
+  });
   // The IO Manager uses resource cache limits of 0, so it is not necessary
   // to purge them.
 }
 
+MemoryUsage Shell::GetMemoryUsage() {
+  TRACE_EVENT0("flutter", "Shell::GetMemoryUsage");
+  MemoryUsage usage;
+  fml::AutoResetWaitableEvent latch;
+
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetGPUTaskRunner(),
+      [&usage, &latch, rasterizer = weak_rasterizer_]() {
+        if (rasterizer) {
+          rasterizer->CollectMemoryUsage(usage);
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetIOTaskRunner(),
+      [&usage, &latch, io_manager = io_manager_->GetWeakPtr()]() {
+        if (io_manager) {
+          io_manager->CollectMemoryUsage(usage);
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [&usage, &latch, engine = weak_engine_]() {
+        if (engine) {
+          engine->CollectMemoryUsage(usage);
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+
+  return usage;
+}
+
+// Only the subsystems that a low memory warning trims count against the
+// budget, or memory held by live objects would trigger a warning after every
+// check. Their usage is gathered on the GPU and then the UI thread instead of
+// blocking any thread on the others. |memory_budget_| keeps a trim that does
+// not bring the caches well under the budget from repeating every second.
+void Shell::CheckMemoryBudget() {
+  FML_DCHECK(task_runners_.GetGPUTaskRunner()->RunsTasksOnCurrentThread());
+  TRACE_EVENT0("flutter", "Shell::CheckMemoryBudget");
+  MemoryUsage usage;
+  if (weak_rasterizer_) {
+    weak_rasterizer_->CollectMemoryUsage(usage);
+  }
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [usage, engine = weak_engine_, memory_budget = memory_budget_,
+       platform_task_runner = task_runners_.GetPlatformTaskRunner(),
+       shell = weak_factory_.GetWeakPtr()]() mutable {
+        if (!engine) {
+          return;
+        }
+        engine->CollectMemoryUsage(usage);
+        if (!memory_budget->ShouldTrim(usage.GetTrimmableBytes())) {
+          return;
+        }
+        platform_task_runner->PostTask([shell]() {
+          if (shell) {
+            shell->NotifyLowMemoryWarning();
+          }
+        });
+      });
+}
+
 bool Shell::IsSetup() const {
   return is_setup_;
 }
@@ -414,6 +507,18 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   PersistentCache::GetCacheForProcess()->SetIsDumpingSkp(
       settings_.dump_skp_on_shader_compilation);
 
+  if (!settings_.layer_tree_capture_path.empty()) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetGPUTaskRunner(),
+        [rasterizer = weak_rasterizer_,
+         path = settings_.layer_tree_capture_path]() {
+          if (rasterizer) {
+            rasterizer->SetLayerTreeCaptureStream(
+                std::make_unique<SkFILEWStream>(path.c_str()));
+          }
+        });
+  }
+
   return true;
 }
 
@@ -678,6 +783,18 @@ void Shell::OnPlatformViewSetSemanticsEnabled(bool enabled) {
       });
 }
 
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewResetSemantics() {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()] {
+    if (engine) {
+      engine->ResetSemantics();
+    }
+  });
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewSetAccessibilityFeatures(int32_t flags) {
   FML_DCHECK(is_setup_);
@@ -936,6 +1053,27 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (settings_.enable_predictive_frame_pacing) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_, timing]() {
+          if (engine) {
+            engine->RecordFrameTiming(timing);
+          }
+        });
+  }
+
+  // Memory only grows while frames are produced, so the budget is checked
+  // after frames, at most once a second.
+  if (settings_.memory_budget_mb > 0) {
+    const fml::TimePoint raster_finish =
+        timing.Get(FrameTiming::kRasterFinish);
+    if (raster_finish - last_memory_budget_check_ >=
+        fml::TimeDelta::FromSeconds(1)) {
+      last_memory_budget_check_ = raster_finish;
+      CheckMemoryBudget();
+    }
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1176,6 +1314,88 @@ bool Shell::OnServiceProtocolGetDisplayRefreshRate(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  const MemoryUsage usage = GetMemoryUsage();
+  const uint64_t budget_bytes =
+      static_cast<uint64_t>(settings_.memory_budget_mb) * 1024 * 1024;
+
+  auto& allocator = response.GetAllocator();
+  response.SetObject();
+  response.AddMember("type", "MemoryUsage", allocator);
+  response.AddMember("totalBytes",
+                     static_cast<uint64_t>(usage.GetTotalBytes()), allocator);
+  response.AddMember("budgetBytes", budget_bytes, allocator);
+  rapidjson::Value subsystems(rapidjson::kArrayType);
+  for (const auto& subsystem : usage.GetSubsystems()) {
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember("name", rapidjson::Value(subsystem.name, allocator).Move(),
+                    allocator);
+    value.AddMember("bytes", static_cast<uint64_t>(subsystem.bytes),
+                    allocator);
+    value.AddMember("entries", static_cast<uint64_t>(subsystem.entries),
+                    allocator);
+    value.AddMember("budgetBytes",
+                    static_cast<uint64_t>(subsystem.budget_bytes), allocator);
+    value.AddMember("trimmable", subsystem.trimmable, allocator);
+    subsystems.PushBack(value, allocator);
+  }
+  response.AddMember("subsystems", subsystems, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolSetNativeTraceCategories(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (params.count("categories") == 0) {
+    ServiceProtocolParameterError(response,
+                                  "'categories' parameter is missing.");
+    return false;
+  }
+
+  auto& recorder = fml::tracing::TraceRecorder::GetInstance();
+  recorder.SetEnabledCategories(std::string{params.at("categories")});
+
+  auto& allocator = response.GetAllocator();
+  response.SetObject();
+  response.AddMember("type", "Success", allocator);
+  response.AddMember(
+      "categories",
+      rapidjson::Value(recorder.GetEnabledCategories(), allocator).Move(),
+      allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetNativeTrace(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  const bool clear = params.count("clear") != 0 && params.at("clear") == "true";
+  const std::string trace =
+      fml::tracing::TraceRecorder::GetInstance().ExportChromeTrace(clear);
+
+  rapidjson::Document trace_document(&response.GetAllocator());
+  trace_document.Parse(trace.c_str());
+  if (trace_document.HasParseError() || !trace_document.IsObject() ||
+      !trace_document.HasMember("traceEvents")) {
+    ServiceProtocolFailureError(response, "Could not export the trace.");
+    return false;
+  }
+
+  auto& allocator = response.GetAllocator();
+  response.SetObject();
+  response.AddMember("type", "NativeTrace", allocator);
+  response.AddMember("traceEvents", trace_document["traceEvents"], allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
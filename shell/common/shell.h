@@ -6,6 +6,7 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <memory>
 #include <string_view>
 #include <unordered_map>
 
@@ -28,6 +29,7 @@
 #include "flutter/runtime/service_protocol.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/memory_usage.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell_io_manager.h"
@@ -214,10 +216,22 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             warning. The shell will attempt to purge caches. The raster
+  ///             cache, the GPU resource cache and the font and text layout
+  ///             caches are purged.
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the memory held by each subsystem of the shell.
+  ///             This waits for the GPU, IO and UI task runners in turn, so
+  ///             it must not be called from a thread that one of them waits
+  ///             on. It is available to tooling through the
+  ///             `_flutter.getMemoryUsage` service protocol method.
+  ///
+  /// @return     The memory usage of each subsystem.
+  ///
+  MemoryUsage GetMemoryUsage();
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -293,6 +307,15 @@ class Shell final : public PlatformView::Delegate,
   // ui.Window.onReportTimings.
   bool frame_timings_report_scheduled_ = false;
 
+  // When the memory budget was last checked after a frame. Only used on the
+  // GPU thread.
+  fml::TimePoint last_memory_budget_check_;
+
+  // Whether the memory usage gathered by |CheckMemoryBudget| calls for a trim.
+  // Shared with the tasks that finish the checks, and only used on the UI
+  // thread.
+  const std::shared_ptr<MemoryBudget> memory_budget_;
+
   // Vector of FrameTiming::kCount * n timestamps for n frames whose timings
   // have not been reported yet. Vector of ints instead of FrameTiming is stored
   // here for easier conversions to Dart objects.
@@ -348,6 +371,9 @@ class Shell final : public PlatformView::Delegate,
   // |PlatformView::Delegate|
   void OnPlatformViewSetSemanticsEnabled(bool enabled) override;
 
+  // |PlatformView::Delegate|
+  void OnPlatformViewResetSemantics() override;
+
   // |shell:PlatformView::Delegate|
   void OnPlatformViewSetAccessibilityFeatures(int32_t flags) override;
 
@@ -445,6 +471,26 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document& response);
 
+  // Service protocol handler
+  bool OnServiceProtocolGetMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
+  // Service protocol handler
+  bool OnServiceProtocolSetNativeTraceCategories(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
+  // Service protocol handler
+  bool OnServiceProtocolGetNativeTrace(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
+  // Trims caches if the ones that can be trimmed hold more memory than
+  // |Settings| memory_budget_mb allows. Called on the GPU thread, and does not
+  // wait on the other threads.
+  void CheckMemoryBudget();
+
   fml::WeakPtrFactory<Shell> weak_factory_;
 
   friend class testing::ShellTest;
@@ -4,16 +4,24 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
+#include "flutter/testing/test_dart_native_resolver.h"
 #include "flutter/testing/testing.h"
+#include "third_party/tonic/converter/dart_converter.h"
 
 namespace flutter {
 
+// When |run_main| is set, startup also covers launching the root isolate and
+// invoking its main entrypoint.
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
-                                    bool measure_shutdown) {
+                                    bool measure_shutdown,
+                                    bool run_main = false) {
   auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
                                        fml::FilePermission::kRead);
   std::unique_ptr<Shell> shell;
@@ -44,6 +52,10 @@ static void StartupAndShutdownShell(benchmark::State& state,
                                                    "isolate_snapshot_instr");
       };
 
+    } else if (run_main) {
+      // Let the run configuration fetch the kernel like it would for an app.
+      settings.assets_path = testing::GetFixturesPath();
+      settings.application_kernel_asset = "kernel_blob.bin";
     } else {
       settings.application_kernels = [&]() {
         std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
@@ -53,6 +65,15 @@ static void StartupAndShutdownShell(benchmark::State& state,
       };
     }
 
+    // Inferred before the shell is created so that the kernel is fetched while
+    // the shell starts up.
+    std::unique_ptr<RunConfiguration> run_configuration;
+    if (run_main) {
+      run_configuration = std::make_unique<RunConfiguration>(
+          RunConfiguration::InferFromSettings(settings));
+      run_configuration->SetEntrypoint("emptyMain");
+    }
+
     thread_host = std::make_unique<ThreadHost>(
         "io.flutter.bench.", ThreadHost::Type::Platform |
                                  ThreadHost::Type::GPU | ThreadHost::Type::IO |
@@ -72,6 +93,20 @@ static void StartupAndShutdownShell(benchmark::State& state,
         [](Shell& shell) {
           return std::make_unique<Rasterizer>(shell, shell.GetTaskRunners());
         });
+    FML_CHECK(shell);
+
+    if (run_configuration) {
+      fml::AutoResetWaitableEvent latch;
+      fml::TaskRunner::RunNowOrPostTask(
+          shell->GetTaskRunners().GetUITaskRunner(),
+          fml::MakeCopyable([&latch, engine = shell->GetEngine(),
+                             configuration = std::move(run_configuration)]() {
+            FML_CHECK(engine->Run(std::move(*configuration)) ==
+                      Engine::RunStatus::Success);
+            latch.Signal();
+          }));
+      latch.Wait();
+    }
   }
 
   FML_CHECK(shell);
@@ -109,4 +144,121 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+static void BM_ShellTimeToMain(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    StartupAndShutdownShell(state, true, false, true);
+  }
+}
+
+BENCHMARK(BM_ShellTimeToMain);
+
+// Runs |spawnIsolatesMain| in a new shell, which spawns |state.range(0)|
+// isolates. Reports the time until they all run, and the growth of the
+// process per spawned isolate.
+static void BM_ShellSpawnIsolates(benchmark::State& state,
+                                  bool enable_isolate_groups) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  const int64_t isolate_count = state.range(0);
+  int64_t total_rss_growth = 0;
+  while (state.KeepRunning()) {
+    auto native_resolver = std::make_shared<testing::TestDartNativeResolver>();
+    fml::AutoResetWaitableEvent spawned;
+    int64_t microseconds = 0;
+    int64_t rss_growth = 0;
+    native_resolver->AddNativeCallback(
+        "NotifyIsolatesSpawned",
+        CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+          microseconds = tonic::DartConverter<int64_t>::FromDart(
+              Dart_GetNativeArgument(args, 0));
+          rss_growth = tonic::DartConverter<int64_t>::FromDart(
+              Dart_GetNativeArgument(args, 1));
+          spawned.Signal();
+        })));
+
+    Settings settings = {};
+    settings.task_observer_add = [](intptr_t, fml::closure) {};
+    settings.task_observer_remove = [](intptr_t) {};
+    // The VM is set up for isolate groups or not when it starts.
+    settings.leak_vm = false;
+    settings.enable_isolate_groups = enable_isolate_groups;
+    settings.dart_entrypoint_args = {std::to_string(isolate_count)};
+    settings.root_isolate_create_callback = [native_resolver]() {
+      native_resolver->SetNativeResolverForIsolate();
+    };
+    if (DartVM::IsRunningPrecompiledCode()) {
+      settings.vm_snapshot_data = [&]() {
+        return fml::FileMapping::CreateReadOnly(assets_dir, "vm_snapshot_data");
+      };
+      settings.isolate_snapshot_data = [&]() {
+        return fml::FileMapping::CreateReadOnly(assets_dir,
+                                                "isolate_snapshot_data");
+      };
+      settings.vm_snapshot_instr = [&]() {
+        return fml::FileMapping::CreateReadExecute(assets_dir,
+                                                   "vm_snapshot_instr");
+      };
+      settings.isolate_snapshot_instr = [&]() {
+        return fml::FileMapping::CreateReadExecute(assets_dir,
+                                                   "isolate_snapshot_instr");
+      };
+    } else {
+      settings.assets_path = testing::GetFixturesPath();
+      settings.application_kernel_asset = "kernel_blob.bin";
+    }
+
+    auto run_configuration = RunConfiguration::InferFromSettings(settings);
+    run_configuration.SetEntrypoint("spawnIsolatesMain");
+
+    ThreadHost thread_host("io.flutter.bench.", ThreadHost::Type::Platform |
+                                                    ThreadHost::Type::GPU |
+                                                    ThreadHost::Type::IO |
+                                                    ThreadHost::Type::UI);
+    TaskRunners task_runners("test",
+                             thread_host.platform_thread->GetTaskRunner(),
+                             thread_host.gpu_thread->GetTaskRunner(),
+                             thread_host.ui_thread->GetTaskRunner(),
+                             thread_host.io_thread->GetTaskRunner());
+    auto shell = Shell::Create(
+        std::move(task_runners), settings,
+        [](Shell& shell) {
+          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+        },
+        [](Shell& shell) {
+          return std::make_unique<Rasterizer>(shell, shell.GetTaskRunners());
+        });
+    FML_CHECK(shell);
+
+    fml::TaskRunner::RunNowOrPostTask(
+        shell->GetTaskRunners().GetUITaskRunner(),
+        fml::MakeCopyable([engine = shell->GetEngine(),
+                           configuration = std::move(run_configuration)]() {
+          FML_CHECK(engine->Run(std::move(configuration)) ==
+                    Engine::RunStatus::Success);
+        }));
+    spawned.Wait();
+
+    state.SetIterationTime(microseconds / 1000000.0);
+    total_rss_growth += rss_growth;
+
+    shell.reset();
+  }
+  state.counters["rss_bytes_per_isolate"] =
+      state.iterations() == 0
+          ? 0
+          : static_cast<double>(total_rss_growth) /
+                (state.iterations() * isolate_count);
+}
+
+BENCHMARK_CAPTURE(BM_ShellSpawnIsolates, Separate, false)
+    ->Arg(6)
+    ->Iterations(10)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ShellSpawnIsolates, InRootIsolateGroup, true)
+    ->Arg(6)
+    ->Iterations(10)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
 }  // namespace flutter
@@ -91,6 +91,18 @@ fml::WeakPtr<ShellIOManager> ShellIOManager::GetWeakPtr() {
   return weak_factory_.GetWeakPtr();
 }
 
+void ShellIOManager::CollectMemoryUsage(MemoryUsage& usage) const {
+  if (!resource_context_) {
+    return;
+  }
+  int resource_count = 0;
+  size_t resource_bytes = 0;
+  resource_context_->getResourceCacheUsage(&resource_count, &resource_bytes);
+  // The cache is not purged by low memory warnings, see
+  // |Shell::NotifyLowMemoryWarning|.
+  usage.Add("ioResourceCache", resource_bytes, resource_count, 0, false);
+}
+
 // |IOManager|
 fml::WeakPtr<GrContext> ShellIOManager::GetResourceContext() const {
   return resource_context_weak_factory_
@@ -11,6 +11,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/shell/common/memory_usage.h"
 #include "third_party/skia/include/gpu/GrContext.h"
 
 namespace flutter {
@@ -42,6 +43,10 @@ class ShellIOManager final : public IOManager {
 
   fml::WeakPtr<ShellIOManager> GetWeakPtr();
 
+  // Adds the memory held by the resource context to |usage|. This includes
+  // the images uploaded from the IO thread.
+  void CollectMemoryUsage(MemoryUsage& usage) const;
+
   // |IOManager|
   fml::WeakPtr<IOManager> GetWeakIOManager() const override;
 
@@ -7,6 +7,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <set>
 
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -600,5 +601,65 @@ TEST_F(ShellTest, WaitForFirstFrameInlined) {
   ASSERT_FALSE(event.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(1000)));
 }
 
+TEST_F(ShellTest, ReportsMemoryUsageOfEachSubsystem) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  const MemoryUsage usage = shell->GetMemoryUsage();
+  std::set<std::string> names;
+  size_t total_bytes = 0;
+  size_t trimmable_bytes = 0;
+  for (const auto& subsystem : usage.GetSubsystems()) {
+    names.insert(subsystem.name);
+    total_bytes += subsystem.bytes;
+    if (subsystem.trimmable) {
+      trimmable_bytes += subsystem.bytes;
+    }
+    // The memory of live images is not trimmed by the engine.
+    ASSERT_EQ(subsystem.trimmable, subsystem.name != "decodedImages" &&
+                                       subsystem.name != "ioResourceCache");
+  }
+  ASSERT_EQ(names.count("rasterCache"), 1u);
+  ASSERT_EQ(names.count("decodedImages"), 1u);
+  ASSERT_EQ(names.count("fontCache"), 1u);
+  ASSERT_EQ(names.count("textLayoutCache"), 1u);
+  ASSERT_EQ(usage.GetTotalBytes(), total_bytes);
+  ASSERT_EQ(usage.GetTrimmableBytes(), trimmable_bytes);
+
+  shell->NotifyLowMemoryWarning();
+  ASSERT_EQ(shell->GetMemoryUsage().GetSubsystems().size(),
+            usage.GetSubsystems().size());
+}
+
+TEST(MemoryBudgetTest, TrimsAgainOnlyBelowLowWaterMark) {
+  MemoryBudget budget(1000);
+  ASSERT_FALSE(budget.ShouldTrim(0));
+  ASSERT_FALSE(budget.ShouldTrim(1000));
+  ASSERT_TRUE(budget.ShouldTrim(1001));
+
+  // A trim that freed nothing, or too little, is not repeated.
+  ASSERT_FALSE(budget.ShouldTrim(1001));
+  ASSERT_FALSE(budget.ShouldTrim(5000));
+  ASSERT_FALSE(budget.ShouldTrim(900));
+
+  // Dropping below 90% of the budget re-arms the trim.
+  ASSERT_FALSE(budget.ShouldTrim(899));
+  ASSERT_FALSE(budget.ShouldTrim(1000));
+  ASSERT_TRUE(budget.ShouldTrim(1001));
+  ASSERT_FALSE(budget.ShouldTrim(1001));
+
+  // Growing back over the budget between checks trims right away.
+  ASSERT_TRUE(MemoryBudget(1000).ShouldTrim(2000));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -23,6 +23,13 @@ class SurfaceFrame {
 
   SurfaceFrame(sk_sp<SkSurface> surface, SubmitCallback submit_callback);
 
+  /// Creates a frame whose draw calls are issued on |canvas| instead of the
+  /// canvas of |surface|. This is used by surfaces that record the frame and
+  /// play it back into |surface| in the submit callback.
+  SurfaceFrame(sk_sp<SkSurface> surface,
+               SkCanvas* canvas,
+               SubmitCallback submit_callback);
+
   ~SurfaceFrame();
 
   bool Submit();
@@ -34,6 +41,7 @@ class SurfaceFrame {
  private:
   bool submitted_;
   sk_sp<SkSurface> surface_;
+  SkCanvas* canvas_ = nullptr;
   SubmitCallback submit_callback_;
 
   bool PerformSubmit();
@@ -229,6 +229,20 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_predictive_frame_pacing = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePredictiveFramePacing));
+
+  settings.enable_isolate_groups =
+      command_line.HasOption(FlagForSwitch(Switch::EnableIsolateGroups));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::MemoryBudgetMB))) {
+    if (!GetSwitchValue(command_line, Switch::MemoryBudgetMB,
+                        &settings.memory_budget_mb)) {
+      FML_LOG(INFO) << "Memory budget specified was malformed. Will default to "
+                    << settings.memory_budget_mb;
+    }
+  }
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -330,6 +344,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.dump_skp_on_shader_compilation =
       command_line.HasOption(FlagForSwitch(Switch::DumpSkpOnShaderCompilation));
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::CaptureLayerTrees),
+                              &settings.layer_tree_capture_path);
+
   return settings;
 }
 
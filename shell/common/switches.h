@@ -87,6 +87,11 @@ DEF_SWITCH(EnableDartProfiling,
            "enable-dart-profiling",
            "Enable Dart profiling. Profiling information can be viewed from "
            "the observatory.")
+DEF_SWITCH(EnableIsolateGroups,
+           "enable-isolate-groups",
+           "Spawn isolates into the group of the isolate that spawned them. "
+           "Isolates in a group share the program loaded from the snapshots, "
+           "which makes spawning them faster and cheaper in memory.")
 DEF_SWITCH(EndlessTraceBuffer,
            "endless-trace-buffer",
            "Enable an endless trace buffer. The default is a ring buffer. "
@@ -98,6 +103,16 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful"
            "when testing Flutter on emulators. By default, Flutter will"
            "attempt to either use OpenGL or Vulkan.")
+DEF_SWITCH(EnablePredictiveFramePacing,
+           "enable-predictive-frame-pacing",
+           "Predict how long frames take to build and rasterize from recent "
+           "frames. Frames predicted to miss their vsync are started early, "
+           "and idle time is reported to the Dart VM precisely.")
+DEF_SWITCH(MemoryBudgetMB,
+           "memory-budget-mb",
+           "Trim the raster cache, the GPU resource cache and the font and "
+           "text layout caches whenever the memory held by the engine grows "
+           "past this many megabytes. There is no budget by default.")
 DEF_SWITCH(SkiaDeterministicRendering,
            "skia-deterministic-rendering",
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out"
@@ -129,6 +144,11 @@ DEF_SWITCH(DumpSkpOnShaderCompilation,
            "Automatically dump the skp that triggers new shader compilations. "
            "This is useful for writing custom ShaderWarmUp to reduce jank. "
            "By default, this is not enabled to reduce the overhead. ")
+DEF_SWITCH(CaptureLayerTrees,
+           "capture-layer-trees",
+           "Append every rasterized layer tree to the file at the specified "
+           "path so that the frames can be replayed by the layer tree replay "
+           "benchmarks. Textures and platform views are not captured.")
 DEF_SWITCH(
     TraceSystrace,
     "trace-systrace",
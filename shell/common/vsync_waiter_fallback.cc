@@ -20,20 +20,19 @@ static fml::TimePoint SnapToNextTick(fml::TimePoint value,
 
 }  // namespace
 
-VsyncWaiterFallback::VsyncWaiterFallback(TaskRunners task_runners)
-    : VsyncWaiter(std::move(task_runners)), phase_(fml::TimePoint::Now()) {}
+VsyncWaiterFallback::VsyncWaiterFallback(TaskRunners task_runners,
+                                         fml::TimeDelta frame_interval)
+    : VsyncWaiter(std::move(task_runners)),
+      frame_interval_(frame_interval),
+      phase_(fml::TimePoint::Now()) {}
 
 VsyncWaiterFallback::~VsyncWaiterFallback() = default;
 
 // |VsyncWaiter|
 void VsyncWaiterFallback::AwaitVSync() {
-  constexpr fml::TimeDelta kSingleFrameInterval =
-      fml::TimeDelta::FromSecondsF(1.0 / 60.0);
+  auto next = SnapToNextTick(fml::TimePoint::Now(), phase_, frame_interval_);
 
-  auto next =
-      SnapToNextTick(fml::TimePoint::Now(), phase_, kSingleFrameInterval);
-
-  FireCallback(next, next + kSingleFrameInterval);
+  FireCallback(next, next + frame_interval_);
 }
 
 }  // namespace flutter
@@ -12,14 +12,18 @@
 
 namespace flutter {
 
-/// A |VsyncWaiter| that will fire at 60 fps irrespective of the vsync.
+/// A |VsyncWaiter| that will fire at 60 fps (or every |frame_interval|)
+/// irrespective of the vsync.
 class VsyncWaiterFallback final : public VsyncWaiter {
  public:
-  VsyncWaiterFallback(TaskRunners task_runners);
+  VsyncWaiterFallback(TaskRunners task_runners,
+                      fml::TimeDelta frame_interval =
+                          fml::TimeDelta::FromSecondsF(1.0 / 60.0));
 
   ~VsyncWaiterFallback() override;
 
  private:
+  const fml::TimeDelta frame_interval_;
   fml::TimePoint phase_;
 
   // |VsyncWaiter|
@@ -4,8 +4,14 @@
 
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
+
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace flutter {
 
@@ -14,8 +20,19 @@ GPUSurfaceSoftwareDelegate::GetExternalViewEmbedder() {
   return nullptr;
 }
 
+size_t GPUSurfaceSoftwareDelegate::GetRasterTileCount() const {
+  return 1;
+}
+
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate)
-    : delegate_(delegate), weak_factory_(this) {}
+    : delegate_(delegate),
+      raster_tile_count_(delegate_ ? delegate_->GetRasterTileCount() : 1),
+      weak_factory_(this) {
+  if (raster_tile_count_ > 1) {
+    tile_worker_loop_ =
+        fml::ConcurrentMessageLoop::Create(raster_tile_count_ - 1);
+  }
+}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
 
@@ -45,9 +62,36 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
-  // irrespective of surface scaling.
-  SkCanvas* canvas = backing_store->getCanvas();
-  canvas->resetMatrix();
+  // irrespective of surface scaling. This applies to the tiled path as well,
+  // which draws into the backing store directly when it cannot be tiled.
+  backing_store->getCanvas()->resetMatrix();
+
+  if (IsTiled()) {
+    // Record the frame once. The recording is played back into each tile of
+    // the backing store concurrently when the frame is submitted.
+    auto recorder = std::make_shared<SkPictureRecorder>();
+    SkCanvas* recording_canvas = recorder->beginRecording(
+        SkRect::MakeWH(size.width(), size.height()));
+
+    SurfaceFrame::SubmitCallback on_submit =
+        [self = weak_factory_.GetWeakPtr(), recorder](
+            const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
+      auto picture = recorder->finishRecordingAsPicture();
+
+      // If the surface itself went away, there is nothing more to do.
+      if (!self || !self->IsValid() || canvas == nullptr || !picture) {
+        return false;
+      }
+
+      auto backing_store = surface_frame.SkiaSurface();
+      self->RasterizeTiles(*picture, *backing_store);
+
+      return self->delegate_->PresentBackingStore(std::move(backing_store));
+    };
+
+    return std::make_unique<SurfaceFrame>(backing_store, recording_canvas,
+                                          on_submit);
+  }
 
   SurfaceFrame::SubmitCallback on_submit =
       [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
@@ -65,6 +109,76 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
   return std::make_unique<SurfaceFrame>(backing_store, on_submit);
 }
 
+bool GPUSurfaceSoftware::IsTiled() const {
+  return tile_worker_loop_ != nullptr;
+}
+
+static void RasterizeTile(const SkPicture& picture,
+                          const SkPixmap& pixmap,
+                          const SkIRect& tile) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTile");
+  SkPixmap tile_pixmap;
+  if (!pixmap.extractSubset(&tile_pixmap, tile)) {
+    return;
+  }
+
+  auto canvas = SkCanvas::MakeRasterDirect(tile_pixmap.info(),
+                                           tile_pixmap.writable_addr(),
+                                           tile_pixmap.rowBytes());
+  if (!canvas) {
+    return;
+  }
+
+  // Pixels outside the tile are clipped by the size of the tile canvas itself.
+  canvas->translate(-tile.x(), -tile.y());
+  canvas->drawPicture(&picture);
+}
+
+void GPUSurfaceSoftware::RasterizeTiles(const SkPicture& picture,
+                                        SkSurface& backing_store) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTiles");
+
+  SkPixmap pixmap;
+  if (!backing_store.peekPixels(&pixmap)) {
+    // The backing store is not directly addressable. Fall back to rendering the
+    // whole frame on this thread.
+    FML_DLOG(WARNING) << "Could not peek the pixels of the software backing "
+                         "store. Rasterizing without tiles.";
+    SkCanvas* canvas = backing_store.getCanvas();
+    canvas->resetMatrix();
+    canvas->drawPicture(&picture);
+    canvas->flush();
+    return;
+  }
+
+  const int tile_count = std::min<int>(raster_tile_count_, pixmap.height());
+  if (tile_count <= 0) {
+    return;
+  }
+  const int tile_height = (pixmap.height() + tile_count - 1) / tile_count;
+
+  std::vector<SkIRect> tiles;
+  for (int y = 0; y < pixmap.height(); y += tile_height) {
+    tiles.push_back(SkIRect::MakeXYWH(
+        0, y, pixmap.width(), std::min(tile_height, pixmap.height() - y)));
+  }
+
+  // The GPU thread rasterizes the first tile itself so that it is not just idly
+  // waiting on the workers.
+  fml::CountDownLatch latch(tiles.size() - 1);
+  auto task_runner = tile_worker_loop_->GetTaskRunner();
+  for (size_t i = 1; i < tiles.size(); ++i) {
+    task_runner->PostTask([&picture, &pixmap, tile = tiles[i], &latch]() {
+      RasterizeTile(picture, pixmap, tile);
+      latch.CountDown();
+    });
+  }
+
+  RasterizeTile(picture, pixmap, tiles[0]);
+
+  latch.Wait();
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -6,9 +6,11 @@
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
 #include "flutter/flow/embedded_views.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/common/surface.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
@@ -20,6 +22,13 @@ class GPUSurfaceSoftwareDelegate {
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
 
   virtual flutter::ExternalViewEmbedder* GetExternalViewEmbedder();
+
+  // The number of horizontal tiles the backing store is split into during
+  // rasterization. If this is greater than one, the frame is first recorded
+  // into a picture and the tiles are then rasterized in parallel on a
+  // dedicated worker pool. The default of one renders directly into the
+  // backing store on the GPU thread.
+  virtual size_t GetRasterTileCount() const;
 };
 
 class GPUSurfaceSoftware : public Surface {
@@ -45,8 +54,16 @@ class GPUSurfaceSoftware : public Surface {
 
  private:
   GPUSurfaceSoftwareDelegate* delegate_;
+  const size_t raster_tile_count_;
+  // Only created when the delegate requests more than one raster tile. The GPU
+  // thread rasterizes one of the tiles itself.
+  std::shared_ptr<fml::ConcurrentMessageLoop> tile_worker_loop_;
   fml::WeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
 
+  bool IsTiled() const;
+
+  void RasterizeTiles(const SkPicture& picture, SkSurface& backing_store);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
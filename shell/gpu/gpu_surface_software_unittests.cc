@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <memory>
+
+#include "flutter/shell/gpu/gpu_surface_software.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+
+namespace flutter {
+namespace testing {
+
+class TestSoftwareSurfaceDelegate : public GPUSurfaceSoftwareDelegate {
+ public:
+  explicit TestSoftwareSurfaceDelegate(size_t raster_tile_count)
+      : raster_tile_count_(raster_tile_count) {}
+
+  sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) override {
+    if (!backing_store_ || backing_store_->width() != size.width() ||
+        backing_store_->height() != size.height()) {
+      backing_store_ =
+          SkSurface::MakeRasterN32Premul(size.width(), size.height());
+    }
+    return backing_store_;
+  }
+
+  bool PresentBackingStore(sk_sp<SkSurface> backing_store) override {
+    presented_count_++;
+    return backing_store == backing_store_;
+  }
+
+  size_t GetRasterTileCount() const override { return raster_tile_count_; }
+
+  sk_sp<SkSurface> backing_store() const { return backing_store_; }
+
+  size_t presented_count() const { return presented_count_; }
+
+ private:
+  const size_t raster_tile_count_;
+  sk_sp<SkSurface> backing_store_;
+  size_t presented_count_ = 0;
+};
+
+// Draws content that is anti-aliased across the tile boundaries and depends on
+// the device position of every pixel.
+static void DrawFrame(SkCanvas* canvas, const SkISize& size) {
+  canvas->clear(SK_ColorWHITE);
+
+  const SkPoint points[] = {SkPoint::Make(0, 0),
+                            SkPoint::Make(size.width(), size.height())};
+  const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+  SkPaint gradient;
+  gradient.setShader(SkGradientShader::MakeLinear(points, colors, nullptr, 2,
+                                                  SkTileMode::kClamp));
+  canvas->drawRect(SkRect::MakeXYWH(10.5, 10.5, size.width() - 21,
+                                    size.height() - 21),
+                   gradient);
+
+  SkPaint circle;
+  circle.setAntiAlias(true);
+  circle.setColor(SK_ColorGREEN);
+  canvas->save();
+  canvas->translate(size.width() / 2.0, size.height() / 2.0);
+  canvas->rotate(30);
+  canvas->drawCircle(0, 0, size.height() / 3.0, circle);
+  canvas->restore();
+}
+
+static sk_sp<SkImage> RenderFrame(GPUSurfaceSoftware& surface,
+                                  TestSoftwareSurfaceDelegate& delegate,
+                                  const SkISize& size) {
+  // Leave a transformation on the canvas of the backing store, like a previous
+  // user of the surface may have. Neither path may render with it.
+  if (auto backing_store = delegate.backing_store()) {
+    backing_store->getCanvas()->translate(13, 7);
+  }
+
+  auto frame = surface.AcquireFrame(size);
+  if (!frame) {
+    return nullptr;
+  }
+  DrawFrame(frame->SkiaCanvas(), size);
+  if (!frame->Submit()) {
+    return nullptr;
+  }
+  return delegate.backing_store()->makeImageSnapshot();
+}
+
+static bool HaveSamePixels(const sk_sp<SkImage>& a, const sk_sp<SkImage>& b) {
+  SkPixmap a_pixmap, b_pixmap;
+  if (!a->peekPixels(&a_pixmap) || !b->peekPixels(&b_pixmap) ||
+      a_pixmap.info() != b_pixmap.info()) {
+    return false;
+  }
+  for (int y = 0; y < a_pixmap.height(); y++) {
+    if (::memcmp(a_pixmap.addr(0, y), b_pixmap.addr(0, y),
+                 a_pixmap.info().minRowBytes()) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(GPUSurfaceSoftwareTest, TiledFramesMatchUntiledFrames) {
+  const auto size = SkISize::Make(301, 203);
+
+  TestSoftwareSurfaceDelegate untiled_delegate(1);
+  GPUSurfaceSoftware untiled_surface(&untiled_delegate);
+  TestSoftwareSurfaceDelegate tiled_delegate(4);
+  GPUSurfaceSoftware tiled_surface(&tiled_delegate);
+
+  // The second frame reuses the backing stores of the first.
+  for (size_t i = 0; i < 2; i++) {
+    auto untiled = RenderFrame(untiled_surface, untiled_delegate, size);
+    auto tiled = RenderFrame(tiled_surface, tiled_delegate, size);
+    ASSERT_TRUE(untiled);
+    ASSERT_TRUE(tiled);
+    ASSERT_TRUE(HaveSamePixels(untiled, tiled));
+  }
+
+  ASSERT_EQ(untiled_delegate.presented_count(), 2u);
+  ASSERT_EQ(tiled_delegate.presented_count(), 2u);
+}
+
+TEST(GPUSurfaceSoftwareTest, TilesAreClampedToTheHeightOfTheFrame) {
+  const auto size = SkISize::Make(64, 3);
+
+  TestSoftwareSurfaceDelegate untiled_delegate(1);
+  GPUSurfaceSoftware untiled_surface(&untiled_delegate);
+  TestSoftwareSurfaceDelegate tiled_delegate(8);
+  GPUSurfaceSoftware tiled_surface(&tiled_delegate);
+
+  auto untiled = RenderFrame(untiled_surface, untiled_delegate, size);
+  auto tiled = RenderFrame(tiled_surface, tiled_delegate, size);
+  ASSERT_TRUE(untiled);
+  ASSERT_TRUE(tiled);
+  ASSERT_TRUE(HaveSamePixels(untiled, tiled));
+}
+
+}  // namespace testing
+}  // namespace flutter
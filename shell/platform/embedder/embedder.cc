@@ -29,6 +29,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/shell/common/persistent_cache.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
@@ -81,8 +82,15 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
+  const bool has_embedder_backing_stores =
+      SAFE_ACCESS(software_config, backing_store_acquire_callback, nullptr) !=
+          nullptr &&
+      SAFE_ACCESS(software_config, backing_store_present_callback, nullptr) !=
+          nullptr;
+
   if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+          nullptr &&
+      !has_embedder_backing_stores) {
     return false;
   }
 
@@ -216,23 +224,57 @@ InferSoftwarePlatformViewCreationCallback(
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+
+  std::function<bool(const void*, size_t, size_t)>
+      software_present_backing_store = nullptr;
+  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) !=
+      nullptr) {
+    software_present_backing_store =
+        [ptr = config->software.surface_present_callback, user_data](
+            const void* allocation, size_t row_bytes, size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
+
+  std::function<bool(const SkISize&, FlutterSoftwareBackingStore*)>
+      software_acquire_embedder_backing_store = nullptr;
+  std::function<bool(const FlutterSoftwareBackingStore*)>
+      software_present_embedder_backing_store = nullptr;
+  if (SAFE_ACCESS(software_config, backing_store_acquire_callback, nullptr) !=
+          nullptr &&
+      SAFE_ACCESS(software_config, backing_store_present_callback, nullptr) !=
+          nullptr) {
+    software_acquire_embedder_backing_store =
+        [ptr = config->software.backing_store_acquire_callback, user_data](
+            const SkISize& size,
+            FlutterSoftwareBackingStore* backing_store) -> bool {
+      return ptr(user_data, size.width(), size.height(), backing_store);
+    };
+    software_present_embedder_backing_store =
+        [ptr = config->software.backing_store_present_callback, user_data](
+            const FlutterSoftwareBackingStore* backing_store) -> bool {
+      return ptr(user_data, backing_store);
+    };
+  }
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,           // optional
+          software_acquire_embedder_backing_store,  // optional
+          software_present_embedder_backing_store,  // optional
       };
 
-  return [software_dispatch_table,
+  size_t raster_tile_count =
+      SAFE_ACCESS(software_config, raster_tile_count, 1);
+
+  return [software_dispatch_table, raster_tile_count,
           platform_dispatch_table](flutter::Shell& shell) {
     return std::make_unique<flutter::PlatformViewEmbedder>(
         shell,                    // delegate
         shell.GetTaskRunners(),   // task runners
         software_dispatch_table,  // software dispatch table
+        raster_tile_count,        // raster tile count
         platform_dispatch_table   // platform dispatch table
     );
   };
@@ -265,6 +307,11 @@ struct _FlutterPlatformMessageResponseHandle {
   fml::RefPtr<flutter::PlatformMessage> message;
 };
 
+struct _FlutterSharedMessageChannel {
+  std::shared_ptr<flutter::SharedMessageChannel> channel;
+  FlutterSharedMessageChannelRole role;
+};
+
 void PopulateSnapshotMappingCallbacks(const FlutterProjectArgs* args,
                                       flutter::Settings& settings) {
   // There are no ownership concerns here as all mappings are owned by the
@@ -601,26 +648,8 @@ FlutterEngineResult FlutterEngineRun(size_t version,
     return LOG_EMBEDDER_ERROR(kInvalidArguments);
   }
 
-  // Step 1: Create the engine.
-  auto embedder_engine =
-      std::make_unique<flutter::EmbedderEngine>(std::move(thread_host),    //
-                                                std::move(task_runners),   //
-                                                settings,                  //
-                                                on_create_platform_view,   //
-                                                on_create_rasterizer,      //
-                                                external_texture_callback  //
-      );
-
-  if (!embedder_engine->IsValid()) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments);
-  }
-
-  // Step 2: Setup the rendering surface.
-  if (!embedder_engine->NotifyCreated()) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments);
-  }
-
-  // Step 3: Run the engine.
+  // Step 0: Infer the run configuration. This starts fetching the kernel in the
+  // background so that it overlaps with the creation of the engine.
   auto run_configuration =
       flutter::RunConfiguration::InferFromSettings(settings);
 
@@ -642,6 +671,26 @@ FlutterEngineResult FlutterEngineRun(size_t version,
     return LOG_EMBEDDER_ERROR(kInvalidArguments);
   }
 
+  // Step 1: Create the engine.
+  auto embedder_engine =
+      std::make_unique<flutter::EmbedderEngine>(std::move(thread_host),    //
+                                                std::move(task_runners),   //
+                                                settings,                  //
+                                                on_create_platform_view,   //
+                                                on_create_rasterizer,      //
+                                                external_texture_callback  //
+      );
+
+  if (!embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  // Step 2: Setup the rendering surface.
+  if (!embedder_engine->NotifyCreated()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  // Step 3: Run the engine.
   if (!embedder_engine->Run(std::move(run_configuration))) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments);
   }
@@ -1032,6 +1081,25 @@ void FlutterEngineTraceEventInstant(const char* name) {
   fml::tracing::TraceEventInstant0("flutter", name);
 }
 
+void FlutterEngineTraceSetNativeCategories(const char* categories) {
+  fml::tracing::TraceRecorder::GetInstance().SetEnabledCategories(
+      categories == nullptr ? "" : categories);
+}
+
+FlutterEngineResult FlutterEngineTraceCopyNativeEvents(
+    bool clear,
+    FlutterNativeTraceCallback callback,
+    void* user_data) {
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  const std::string trace =
+      fml::tracing::TraceRecorder::GetInstance().ExportChromeTrace(clear);
+  callback(trace.c_str(), trace.size(), user_data);
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEnginePostRenderThreadTask(FlutterEngine engine,
                                                       VoidCallback callback,
                                                       void* baton) {
@@ -1061,3 +1129,114 @@ FlutterEngineResult FlutterEngineRunTask(FlutterEngine engine,
              ? kSuccess
              : LOG_EMBEDDER_ERROR(kInvalidArguments);
 }
+
+FlutterEngineResult FlutterEngineGetMemoryUsage(
+    FlutterEngine engine,
+    FlutterSubsystemMemoryUsageCallback callback,
+    void* user_data) {
+  if (engine == nullptr || callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  flutter::MemoryUsage usage;
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->GetMemoryUsage(
+          usage)) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency);
+  }
+
+  for (const auto& subsystem : usage.GetSubsystems()) {
+    FlutterSubsystemMemoryUsage embedder_usage = {};
+    embedder_usage.struct_size = sizeof(FlutterSubsystemMemoryUsage);
+    embedder_usage.name = subsystem.name.c_str();
+    embedder_usage.bytes = subsystem.bytes;
+    embedder_usage.entries = subsystem.entries;
+    embedder_usage.budget_bytes = subsystem.budget_bytes;
+    callback(&embedder_usage, user_data);
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineOpenSharedMessageChannel(
+    FlutterEngine engine,
+    const char* name,
+    size_t capacity,
+    FlutterSharedMessageChannelRole role,
+    FlutterSharedMessageChannel* channel_out) {
+  if (engine == nullptr || name == nullptr || capacity == 0 ||
+      channel_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  auto channel =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine)
+          ->OpenSharedMessageChannel(name, capacity);
+  if (!channel) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  switch (role) {
+    case kFlutterSharedMessageChannelSender:
+      if (!channel->ClaimWriter()) {
+        return LOG_EMBEDDER_ERROR(kInvalidArguments);
+      }
+      break;
+    case kFlutterSharedMessageChannelReceiver:
+      if (!channel->ClaimReader()) {
+        return LOG_EMBEDDER_ERROR(kInvalidArguments);
+      }
+      break;
+    default:
+      return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  *channel_out = new _FlutterSharedMessageChannel{std::move(channel), role};
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSharedMessageChannelWrite(
+    FlutterSharedMessageChannel channel,
+    const uint8_t* message,
+    size_t message_size,
+    bool* written_out) {
+  if (channel == nullptr || (message_size != 0 && message == nullptr) ||
+      written_out == nullptr ||
+      channel->role != kFlutterSharedMessageChannelSender ||
+      message_size > channel->channel->GetMaxMessageSize()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  *written_out = channel->channel->Write(message, message_size);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSharedMessageChannelRead(
+    FlutterSharedMessageChannel channel,
+    FlutterDataCallback callback,
+    void* user_data,
+    bool* read_out) {
+  if (channel == nullptr || callback == nullptr || read_out == nullptr ||
+      channel->role != kFlutterSharedMessageChannelReceiver) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  *read_out = channel->channel->Read(
+      [callback, user_data](const uint8_t* data, size_t size) {
+        callback(data, size, user_data);
+      });
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineCloseSharedMessageChannel(
+    FlutterSharedMessageChannel channel) {
+  if (channel == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments);
+  }
+
+  if (channel->role == kFlutterSharedMessageChannelSender) {
+    channel->channel->ReleaseWriter();
+  } else {
+    channel->channel->ReleaseReader();
+  }
+  delete channel;
+  return kSuccess;
+}
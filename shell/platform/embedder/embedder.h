@@ -207,6 +207,36 @@ typedef struct {
   VoidCallback destruction_callback;
 } FlutterOpenGLTexture;
 
+typedef enum {
+  // The native 32-bit RGBA format of the platform. This is the format of the
+  // engine owned buffers handed to |SoftwareSurfacePresentCallback|.
+  kFlutterSoftwarePixelFormatNative32,
+  kFlutterSoftwarePixelFormatRGBA8888,
+  kFlutterSoftwarePixelFormatBGRA8888,
+  kFlutterSoftwarePixelFormatRGB565,
+} FlutterSoftwarePixelFormat;
+
+typedef struct {
+  // The size of this struct. Must be sizeof(FlutterSoftwareBackingStore).
+  size_t struct_size;
+  //    A pointer to the writable pixels of the buffer. The engine renders
+  //    directly into this allocation.
+  void* allocation;
+  //    The number of bytes between the start of consecutive rows.
+  size_t row_bytes;
+  //    The number of rows in the allocation.
+  size_t height;
+  //    The format of the pixels in the allocation.
+  FlutterSoftwarePixelFormat pixel_format;
+  //    User data to be returned on the invocation of the destruction callback.
+  void* user_data;
+  //    Callback invoked (on an engine managed thread) once the engine no longer
+  //    references the buffer. This happens after the buffer has been presented
+  //    or when the frame rendered into it was dropped. The buffer may be handed
+  //    out again after this call. This callback is optional.
+  VoidCallback destruction_callback;
+} FlutterSoftwareBackingStore;
+
 typedef bool (*BoolCallback)(void* /* user data */);
 typedef FlutterTransformation (*TransformationCallback)(void* /* user data */);
 typedef uint32_t (*UIntCallback)(void* /* user data */);
@@ -214,6 +244,14 @@ typedef bool (*SoftwareSurfacePresentCallback)(void* /* user data */,
                                                const void* /* allocation */,
                                                size_t /* row bytes */,
                                                size_t /* height */);
+typedef bool (*SoftwareBackingStoreAcquireCallback)(
+    void* /* user data */,
+    size_t /* width */,
+    size_t /* height */,
+    FlutterSoftwareBackingStore* /* backing store out */);
+typedef bool (*SoftwareBackingStorePresentCallback)(
+    void* /* user data */,
+    const FlutterSoftwareBackingStore* /* backing store */);
 typedef void* (*ProcResolver)(void* /* user data */, const char* /* name */);
 typedef bool (*TextureFrameCallback)(void* /* user data */,
                                      int64_t /* texture identifier */,
@@ -258,8 +296,30 @@ typedef struct {
   // The callback presented to the embedder to present a fully populated buffer
   // to the user. The pixel format of the buffer is the native 32-bit RGBA
   // format. The buffer is owned by the Flutter engine and must be copied in
-  // this callback if needed.
+  // this callback if needed. Embedders that want to avoid the copy may instead
+  // specify |backing_store_acquire_callback| and
+  // |backing_store_present_callback|.
   SoftwareSurfacePresentCallback surface_present_callback;
+  // The number of horizontal tiles each frame is split into for
+  // rasterization. When greater than one, the frame is recorded once and the
+  // tiles are rasterized in parallel on an engine managed worker pool before
+  // the buffer is presented. A value of zero or one renders the frame on a
+  // single thread.
+  size_t raster_tile_count;
+  // Optional callback to render into buffers supplied by the embedder instead
+  // of an engine owned buffer. The engine calls this (on the GPU thread) before
+  // rendering each frame to obtain the next free buffer of at least the given
+  // dimensions. Embedders typically rotate between two or three buffers, such
+  // as DRM dumb buffers or shared memory segments, so that rendering the next
+  // frame overlaps with the display of the previous one. Must be specified
+  // together with |backing_store_present_callback|, in which case
+  // |surface_present_callback| is not used.
+  SoftwareBackingStoreAcquireCallback backing_store_acquire_callback;
+  // Presents a fully populated buffer previously obtained via
+  // |backing_store_acquire_callback|. No copy is necessary as the buffer is
+  // owned by the embedder. The engine will not touch the buffer again after
+  // this call.
+  SoftwareBackingStorePresentCallback backing_store_present_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -552,6 +612,42 @@ typedef struct {
   const FlutterTaskRunnerDescription* platform_task_runner;
 } FlutterCustomTaskRunners;
 
+// The memory held by one subsystem of the engine.
+typedef struct {
+  // The size of this struct. Must be sizeof(FlutterSubsystemMemoryUsage).
+  size_t struct_size;
+  // The name of the subsystem, for example "rasterCache". The string is only
+  // valid for the duration of the callback it is passed to.
+  const char* name;
+  // The bytes held by the subsystem.
+  size_t bytes;
+  // The number of entries, like cached images or layouts, the subsystem holds.
+  size_t entries;
+  // The bytes the subsystem holds at most before it evicts entries by itself,
+  // or zero if it is not bounded by size.
+  size_t budget_bytes;
+} FlutterSubsystemMemoryUsage;
+
+typedef void (*FlutterSubsystemMemoryUsageCallback)(
+    const FlutterSubsystemMemoryUsage* /* subsystem memory usage */,
+    void* /* user data */);
+
+typedef void (*FlutterNativeTraceCallback)(const char* /* trace */,
+                                           size_t /* trace length */,
+                                           void* /* user data */);
+
+// The end of a shared message channel held by the embedder. Dart code opens
+// the other end with `SharedMessageChannel` from `dart:ui`.
+struct _FlutterSharedMessageChannel;
+typedef struct _FlutterSharedMessageChannel* FlutterSharedMessageChannel;
+
+typedef enum {
+  // The end writes messages with |FlutterEngineSharedMessageChannelWrite|.
+  kFlutterSharedMessageChannelSender,
+  // The end reads messages with |FlutterEngineSharedMessageChannelRead|.
+  kFlutterSharedMessageChannelReceiver,
+} FlutterSharedMessageChannelRole;
+
 typedef struct {
   // The size of this struct. Must be sizeof(FlutterProjectArgs).
   size_t struct_size;
@@ -847,6 +943,26 @@ void FlutterEngineTraceEventDurationEnd(const char* name);
 FLUTTER_EXPORT
 void FlutterEngineTraceEventInstant(const char* name);
 
+// A profiling utility. Enables the comma separated trace |categories|, like
+// "flutter,skia", in the trace recorder of the engine and disables all others.
+// "*" enables every category. While any category is enabled, trace events are
+// kept in ring buffers owned by each thread instead of being added to the
+// timeline, and events in the other categories are dropped. Passing NULL or an
+// empty string stops recording. Can be called on any thread.
+FLUTTER_EXPORT
+void FlutterEngineTraceSetNativeCategories(const char* categories);
+
+// A profiling utility. Passes the events kept by the trace recorder of the
+// engine to |callback| as a JSON object in the Chrome trace event format, which
+// both chrome://tracing and the Perfetto UI open, before returning. The string
+// is only valid for the duration of the callback. If |clear| is true, the
+// events are forgotten afterwards. Can be called on any thread.
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineTraceCopyNativeEvents(
+    bool clear,
+    FlutterNativeTraceCallback callback,
+    void* user_data);
+
 // Posts a task onto the Flutter render thread. Typically, this may be called
 // from any thread as long as a |FlutterEngineShutdown| on the specific engine
 // has not already been initiated.
@@ -868,6 +984,57 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineRunTask(FlutterEngine engine,
                                          const FlutterTask* task);
 
+// Reports the memory held by each subsystem of the engine to |callback|, once
+// per subsystem, before returning. This waits for each of the threads of the
+// engine in turn, so it must be called on the thread on which the
+// |FlutterEngineRun| call was made.
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetMemoryUsage(
+    FlutterEngine engine,
+    FlutterSubsystemMemoryUsageCallback callback,
+    void* user_data);
+
+// Opens the shared message channel registered with |name|, creating it with
+// room for |capacity| bytes if it does not exist yet, and claims the |role|
+// side of it. A channel has one sender and one receiver at a time, so this
+// fails with |kInvalidArguments| if the side is already held by Dart code or
+// another embedder end. The end must be closed with
+// |FlutterEngineCloseSharedMessageChannel|, on any thread.
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineOpenSharedMessageChannel(
+    FlutterEngine engine,
+    const char* name,
+    size_t capacity,
+    FlutterSharedMessageChannelRole role,
+    FlutterSharedMessageChannel* channel_out);
+
+// Copies the message into a channel opened as the sender. |written_out| is
+// set to false if the channel does not have room for the message. Never
+// blocks, and must not be called from more than one thread at a time.
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSharedMessageChannelWrite(
+    FlutterSharedMessageChannel channel,
+    const uint8_t* message,
+    size_t message_size,
+    bool* written_out);
+
+// Passes the oldest message of a channel opened as the receiver to |callback|
+// and removes it. The message is only valid for the duration of the callback.
+// |read_out| is set to false if the channel is empty. Never blocks, and must
+// not be called from more than one thread at a time.
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSharedMessageChannelRead(
+    FlutterSharedMessageChannel channel,
+    FlutterDataCallback callback,
+    void* user_data,
+    bool* read_out);
+
+// Gives up the side of the channel claimed by |channel| and releases it. The
+// channel stays registered for the other end.
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCloseSharedMessageChannel(
+    FlutterSharedMessageChannel channel);
+
 #if defined(__cplusplus)
 }  // extern "C"
 #endif
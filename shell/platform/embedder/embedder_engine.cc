@@ -229,4 +229,27 @@ bool EmbedderEngine::RunTask(const FlutterTask* task) {
                                 task->task);
 }
 
+bool EmbedderEngine::GetMemoryUsage(MemoryUsage& usage) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  usage = shell_->GetMemoryUsage();
+  return true;
+}
+
+std::shared_ptr<SharedMessageChannel> EmbedderEngine::OpenSharedMessageChannel(
+    const std::string& name,
+    size_t capacity) {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  auto name_server = shell_->GetDartVM()->GetIsolateNameServer();
+  if (!name_server) {
+    return nullptr;
+  }
+  return name_server->OpenSharedMessageChannel(name, capacity);
+}
+
 }  // namespace flutter
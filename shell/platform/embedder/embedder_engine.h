@@ -9,6 +9,7 @@
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
+#include "flutter/lib/ui/isolate_name_server/shared_message_channel.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -71,6 +72,12 @@ class EmbedderEngine {
 
   bool RunTask(const FlutterTask* task);
 
+  bool GetMemoryUsage(MemoryUsage& usage);
+
+  std::shared_ptr<SharedMessageChannel> OpenSharedMessageChannel(
+      const std::string& name,
+      size_t capacity);
+
  private:
   const std::unique_ptr<EmbedderThreadHost> thread_host_;
   TaskRunners task_runners_;
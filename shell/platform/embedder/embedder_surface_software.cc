@@ -4,15 +4,20 @@
 
 #include "flutter/shell/platform/embedder/embedder_surface_software.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/gpu/GrContext.h"
 
 namespace flutter {
 
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
-    SoftwareDispatchTable software_dispatch_table)
-    : software_dispatch_table_(software_dispatch_table) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+    SoftwareDispatchTable software_dispatch_table,
+    size_t raster_tile_count)
+    : software_dispatch_table_(software_dispatch_table),
+      raster_tile_count_(std::max<size_t>(raster_tile_count, 1u)) {
+  if (!software_dispatch_table_.software_present_backing_store &&
+      !UsesEmbedderBackingStores()) {
     return;
   }
   valid_ = true;
@@ -55,6 +60,10 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return nullptr;
   }
 
+  if (UsesEmbedderBackingStores()) {
+    return AcquireEmbedderBackingStore(size);
+  }
+
   if (sk_surface_ != nullptr &&
       SkISize::Make(sk_surface_->width(), sk_surface_->height()) == size) {
     // The old and new surface sizes are the same. Nothing to do here.
@@ -81,6 +90,10 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
+  if (UsesEmbedderBackingStores()) {
+    return PresentEmbedderBackingStore(std::move(backing_store));
+  }
+
   SkPixmap pixmap;
   if (!backing_store->peekPixels(&pixmap)) {
     FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
@@ -104,4 +117,102 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
   );
 }
 
+// |GPUSurfaceSoftwareDelegate|
+size_t EmbedderSurfaceSoftware::GetRasterTileCount() const {
+  return raster_tile_count_;
+}
+
+bool EmbedderSurfaceSoftware::UsesEmbedderBackingStores() const {
+  return software_dispatch_table_.software_acquire_embedder_backing_store &&
+         software_dispatch_table_.software_present_embedder_backing_store;
+}
+
+static bool ColorTypeForPixelFormat(FlutterSoftwarePixelFormat pixel_format,
+                                    SkColorType* color_type) {
+  switch (pixel_format) {
+    case kFlutterSoftwarePixelFormatNative32:
+      *color_type = kN32_SkColorType;
+      return true;
+    case kFlutterSoftwarePixelFormatRGBA8888:
+      *color_type = kRGBA_8888_SkColorType;
+      return true;
+    case kFlutterSoftwarePixelFormatBGRA8888:
+      *color_type = kBGRA_8888_SkColorType;
+      return true;
+    case kFlutterSoftwarePixelFormatRGB565:
+      *color_type = kRGB_565_SkColorType;
+      return true;
+  }
+  return false;
+}
+
+static void ReleaseEmbedderBackingStore(void* pixels, void* context) {
+  auto backing_store = reinterpret_cast<FlutterSoftwareBackingStore*>(context);
+  if (backing_store->destruction_callback != nullptr) {
+    backing_store->destruction_callback(backing_store->user_data);
+  }
+  delete backing_store;
+}
+
+sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireEmbedderBackingStore(
+    const SkISize& size) {
+  embedder_backing_store_surface_ = nullptr;
+
+  FlutterSoftwareBackingStore backing_store = {};
+  backing_store.struct_size = sizeof(FlutterSoftwareBackingStore);
+  if (!software_dispatch_table_.software_acquire_embedder_backing_store(
+          size, &backing_store)) {
+    FML_LOG(ERROR) << "The embedder could not supply a software backing store.";
+    return nullptr;
+  }
+
+  SkColorType color_type = kUnknown_SkColorType;
+  if (backing_store.allocation == nullptr ||
+      !ColorTypeForPixelFormat(backing_store.pixel_format, &color_type) ||
+      backing_store.height < static_cast<size_t>(size.height())) {
+    FML_LOG(ERROR) << "The embedder supplied an invalid software backing store.";
+    if (backing_store.destruction_callback != nullptr) {
+      backing_store.destruction_callback(backing_store.user_data);
+    }
+    return nullptr;
+  }
+
+  const SkAlphaType alpha_type = color_type == kRGB_565_SkColorType
+                                     ? kOpaque_SkAlphaType
+                                     : kPremul_SkAlphaType;
+  SkImageInfo info = SkImageInfo::Make(size.fWidth, size.fHeight, color_type,
+                                       alpha_type, SkColorSpace::MakeSRGB());
+
+  // The release proc takes ownership of this copy and notifies the embedder
+  // once Skia no longer references the pixels.
+  auto release_context = new FlutterSoftwareBackingStore(backing_store);
+  auto surface = SkSurface::MakeRasterDirectReleaseProc(
+      info, backing_store.allocation, backing_store.row_bytes,
+      &ReleaseEmbedderBackingStore, release_context);
+
+  if (surface == nullptr) {
+    FML_LOG(ERROR) << "Could not wrap the embedder supplied software backing "
+                      "store. The row bytes may be too small.";
+    ReleaseEmbedderBackingStore(backing_store.allocation, release_context);
+    return nullptr;
+  }
+
+  embedder_backing_store_ = backing_store;
+  embedder_backing_store_surface_ = surface.get();
+  return surface;
+}
+
+bool EmbedderSurfaceSoftware::PresentEmbedderBackingStore(
+    sk_sp<SkSurface> backing_store) {
+  if (backing_store.get() != embedder_backing_store_surface_) {
+    FML_LOG(ERROR) << "Tried to present a software backing store that was not "
+                      "the last one acquired from the embedder.";
+    return false;
+  }
+
+  embedder_backing_store_surface_ = nullptr;
+  return software_dispatch_table_.software_present_embedder_backing_store(
+      &embedder_backing_store_);
+}
+
 }  // namespace flutter
@@ -7,6 +7,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
+#include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_surface.h"
 
 namespace flutter {
@@ -15,18 +16,37 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
                                       public GPUSurfaceSoftwareDelegate {
  public:
   struct SoftwareDispatchTable {
+    // Required unless the embedder supplies its own backing stores.
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;
+    // Either both or neither of these callbacks must be specified.
+    std::function<bool(const SkISize& size,
+                       FlutterSoftwareBackingStore* backing_store)>
+        software_acquire_embedder_backing_store;  // optional
+    std::function<bool(const FlutterSoftwareBackingStore* backing_store)>
+        software_present_embedder_backing_store;  // optional
   };
 
-  EmbedderSurfaceSoftware(SoftwareDispatchTable software_dispatch_table);
+  EmbedderSurfaceSoftware(SoftwareDispatchTable software_dispatch_table,
+                          size_t raster_tile_count = 1);
 
   ~EmbedderSurfaceSoftware() override;
 
  private:
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
+  const size_t raster_tile_count_;
   sk_sp<SkSurface> sk_surface_;
+  // The embedder supplied buffer of the frame currently being rendered and the
+  // surface wrapping it. Only used if the embedder supplies backing stores.
+  FlutterSoftwareBackingStore embedder_backing_store_ = {};
+  SkSurface* embedder_backing_store_surface_ = nullptr;
+
+  bool UsesEmbedderBackingStores() const;
+
+  sk_sp<SkSurface> AcquireEmbedderBackingStore(const SkISize& size);
+
+  bool PresentEmbedderBackingStore(sk_sp<SkSurface> backing_store);
 
   // |EmbedderSurface|
   bool IsValid() const override;
@@ -43,6 +63,9 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  size_t GetRasterTileCount() const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
@@ -18,7 +18,20 @@ EmbedderTaskRunner::EmbedderTaskRunner(DispatchTable table)
 EmbedderTaskRunner::~EmbedderTaskRunner() = default;
 
 void EmbedderTaskRunner::PostTask(fml::closure task) {
-  PostTaskForTime(task, fml::TimePoint::Now());
+  PostTaskForTime(std::move(task), fml::TimePoint::Now());
+}
+
+// The embedder API has no notion of task priorities, so tasks of all
+// priorities are handed to the embedder the same way.
+void EmbedderTaskRunner::PostTask(fml::closure task,
+                                  fml::TaskPriority priority) {
+  PostTask(std::move(task));
+}
+
+void EmbedderTaskRunner::PostTaskForTime(fml::closure task,
+                                         fml::TimePoint target_time,
+                                         fml::TaskPriority priority) {
+  PostTaskForTime(std::move(task), target_time);
 }
 
 void EmbedderTaskRunner::PostTaskForTime(fml::closure task,
@@ -33,7 +46,7 @@ void EmbedderTaskRunner::PostTaskForTime(fml::closure task,
     // Release the lock before the jump via the dispatch table.
     std::scoped_lock lock(tasks_mutex_);
     baton = ++last_baton_;
-    pending_tasks_[baton] = task;
+    pending_tasks_[baton] = std::move(task);
   }
 
   dispatch_table_.post_task_callback(this, baton, target_time);
@@ -41,7 +54,7 @@ void EmbedderTaskRunner::PostTaskForTime(fml::closure task,
 
 void EmbedderTaskRunner::PostDelayedTask(fml::closure task,
                                          fml::TimeDelta delay) {
-  PostTaskForTime(task, fml::TimePoint::Now() + delay);
+  PostTaskForTime(std::move(task), fml::TimePoint::Now() + delay);
 }
 
 bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
@@ -58,7 +71,7 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
       FML_LOG(ERROR) << "Embedder attempted to post an unknown task.";
       return false;
     }
-    task = found->second;
+    task = std::move(found->second);
     pending_tasks_.erase(found);
 
     // Let go of the tasks mutex befor executing the task.
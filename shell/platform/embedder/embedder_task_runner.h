@@ -33,9 +33,17 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   // |fml::TaskRunner|
   void PostTask(fml::closure task) override;
 
+  // |fml::TaskRunner|
+  void PostTask(fml::closure task, fml::TaskPriority priority) override;
+
   // |fml::TaskRunner|
   void PostTaskForTime(fml::closure task, fml::TimePoint target_time) override;
 
+  // |fml::TaskRunner|
+  void PostTaskForTime(fml::closure task,
+                       fml::TimePoint target_time,
+                       fml::TaskPriority priority) override;
+
   // |fml::TaskRunner|
   void PostDelayedTask(fml::closure task, fml::TimeDelta delay) override;
 
@@ -1,4 +1,5 @@
 import 'dart:async';
+import 'dart:isolate';
 import 'dart:typed_data';
 import 'dart:ui';
 import 'dart:convert';
@@ -167,3 +168,38 @@ void platform_messages_no_response() {
   };
   signalNativeTest();
 }
+
+@pragma('vm:entry-point')
+void draw_solid_red() { // ignore: non_constant_identifier_names
+  window.onBeginFrame = (Duration duration) {
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    canvas.drawPaint(Paint()..color = const Color(0xFFFF0000));
+    final SceneBuilder builder = SceneBuilder();
+    builder.addPicture(Offset.zero, recorder.endRecording());
+    window.render(builder.build());
+    // Keep producing frames so that the embedder sees several of them.
+    window.scheduleFrame();
+  };
+  window.scheduleFrame();
+}
+
+void notifySharedMessageEchoed() native 'NotifySharedMessageEchoed';
+
+@pragma('vm:entry-point')
+void shared_message_channel_echo() { // ignore: non_constant_identifier_names
+  final SharedMessageChannel fromEmbedder = SharedMessageChannel('embedder_to_dart');
+  final SharedMessageChannel toEmbedder = SharedMessageChannel('dart_to_embedder');
+  void echo() {
+    for (ByteData message = fromEmbedder.receive(); message != null; message = fromEmbedder.receive()) {
+      toEmbedder.send(message);
+      notifySharedMessageEchoed();
+    }
+  }
+  final ReceivePort port = ReceivePort();
+  port.listen((dynamic size) => echo());
+  fromEmbedder.setReceiveNotificationPort(port.sendPort);
+  // Finding the channel empty arms the notification for the next message.
+  echo();
+  signalNativeTest();
+}
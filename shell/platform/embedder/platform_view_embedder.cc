@@ -22,10 +22,12 @@ PlatformViewEmbedder::PlatformViewEmbedder(
     PlatformView::Delegate& delegate,
     flutter::TaskRunners task_runners,
     EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table,
+    size_t raster_tile_count,
     PlatformDispatchTable platform_dispatch_table)
     : PlatformView(delegate, std::move(task_runners)),
       embedder_surface_(
-          std::make_unique<EmbedderSurfaceSoftware>(software_dispatch_table)),
+          std::make_unique<EmbedderSurfaceSoftware>(software_dispatch_table,
+                                                    raster_tile_count)),
       platform_dispatch_table_(platform_dispatch_table) {}
 
 PlatformViewEmbedder::~PlatformViewEmbedder() = default;
@@ -47,6 +47,7 @@ class PlatformViewEmbedder final : public PlatformView {
       PlatformView::Delegate& delegate,
       flutter::TaskRunners task_runners,
       EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table,
+      size_t raster_tile_count,
       PlatformDispatchTable platform_dispatch_table);
 
   ~PlatformViewEmbedder() override;
@@ -61,6 +61,23 @@ void EmbedderConfigBuilder::SetSoftwareRendererConfig() {
   renderer_config_.software = software_renderer_config_;
 }
 
+void EmbedderConfigBuilder::SetSoftwareBackingStoreCallbacks() {
+  software_renderer_config_.surface_present_callback = nullptr;
+  software_renderer_config_.backing_store_acquire_callback =
+      [](void* context, size_t width, size_t height,
+         FlutterSoftwareBackingStore* backing_store) -> bool {
+    return reinterpret_cast<EmbedderContext*>(context)
+        ->SoftwareAcquireBackingStore(width, height, backing_store);
+  };
+  software_renderer_config_.backing_store_present_callback =
+      [](void* context,
+         const FlutterSoftwareBackingStore* backing_store) -> bool {
+    return reinterpret_cast<EmbedderContext*>(context)
+        ->SoftwarePresentBackingStore(backing_store);
+  };
+  SetSoftwareRendererConfig();
+}
+
 void EmbedderConfigBuilder::SetOpenGLRendererConfig() {
   renderer_config_.type = FlutterRendererType::kOpenGL;
   renderer_config_.open_gl = opengl_renderer_config_;
@@ -42,6 +42,8 @@ class EmbedderConfigBuilder {
 
   void SetSoftwareRendererConfig();
 
+  void SetSoftwareBackingStoreCallbacks();
+
   void SetOpenGLRendererConfig();
 
   void SetAssetsPath();
@@ -103,6 +103,31 @@ void EmbedderContext::PlatformMessageCallback(
   }
 }
 
+void EmbedderContext::SetSoftwareBackingStoreCallbacks(
+    BackingStoreAcquireCallback acquire,
+    BackingStorePresentCallback present) {
+  backing_store_acquire_callback_ = acquire;
+  backing_store_present_callback_ = present;
+}
+
+bool EmbedderContext::SoftwareAcquireBackingStore(
+    size_t width,
+    size_t height,
+    FlutterSoftwareBackingStore* backing_store) {
+  if (!backing_store_acquire_callback_) {
+    return false;
+  }
+  return backing_store_acquire_callback_(width, height, backing_store);
+}
+
+bool EmbedderContext::SoftwarePresentBackingStore(
+    const FlutterSoftwareBackingStore* backing_store) {
+  if (!backing_store_present_callback_) {
+    return false;
+  }
+  return backing_store_present_callback_(backing_store);
+}
+
 FlutterUpdateSemanticsNodeCallback
 EmbedderContext::GetUpdateSemanticsNodeCallbackHook() {
   return [](const FlutterSemanticsNode* semantics_node, void* user_data) {
@@ -23,6 +23,10 @@ namespace testing {
 using SemanticsNodeCallback = std::function<void(const FlutterSemanticsNode*)>;
 using SemanticsActionCallback =
     std::function<void(const FlutterSemanticsCustomAction*)>;
+using BackingStoreAcquireCallback = std::function<
+    bool(size_t width, size_t height, FlutterSoftwareBackingStore*)>;
+using BackingStorePresentCallback =
+    std::function<bool(const FlutterSoftwareBackingStore*)>;
 
 class EmbedderContext {
  public:
@@ -52,6 +56,9 @@ class EmbedderContext {
   void SetPlatformMessageCallback(
       std::function<void(const FlutterPlatformMessage*)> callback);
 
+  void SetSoftwareBackingStoreCallbacks(BackingStoreAcquireCallback acquire,
+                                        BackingStorePresentCallback present);
+
  private:
   // This allows the builder to access the hooks.
   friend class EmbedderConfigBuilder;
@@ -66,6 +73,8 @@ class EmbedderContext {
   SemanticsNodeCallback update_semantics_node_callback_;
   SemanticsActionCallback update_semantics_custom_action_callback_;
   std::function<void(const FlutterPlatformMessage*)> platform_message_callback_;
+  BackingStoreAcquireCallback backing_store_acquire_callback_;
+  BackingStorePresentCallback backing_store_present_callback_;
   std::unique_ptr<TestGLSurface> gl_surface_;
 
   static VoidCallback GetIsolateCreateCallbackHook();
@@ -96,6 +105,13 @@ class EmbedderContext {
 
   void PlatformMessageCallback(const FlutterPlatformMessage* message);
 
+  bool SoftwareAcquireBackingStore(size_t width,
+                                   size_t height,
+                                   FlutterSoftwareBackingStore* backing_store);
+
+  bool SoftwarePresentBackingStore(
+      const FlutterSoftwareBackingStore* backing_store);
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderContext);
 };
 
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/message_loop.h"
+#include "flutter/shell/platform/embedder/embedder_surface_software.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+
+namespace flutter {
+
+static sk_sp<SkPicture> CreateFramePicture(const SkISize& size) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas =
+      recorder.beginRecording(SkRect::MakeWH(size.width(), size.height()));
+
+  const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+  const SkPoint points[] = {SkPoint::Make(0, 0),
+                            SkPoint::Make(size.width(), size.height())};
+  SkPaint background;
+  background.setShader(SkGradientShader::MakeLinear(
+      points, colors, nullptr, 3, SkTileMode::kClamp));
+  canvas->drawPaint(background);
+
+  // A grid of anti-aliased rounded cards with strokes, roughly approximating a
+  // busy list or grid UI.
+  SkPaint fill;
+  fill.setAntiAlias(true);
+  SkPaint stroke;
+  stroke.setAntiAlias(true);
+  stroke.setStyle(SkPaint::kStroke_Style);
+  stroke.setStrokeWidth(3.0);
+  const int card_size = 60;
+  for (int y = 0; y < size.height(); y += card_size) {
+    for (int x = 0; x < size.width(); x += card_size) {
+      fill.setColor(SkColorSetARGB(0xC0, x % 255, y % 255, (x + y) % 255));
+      auto rrect = SkRRect::MakeRectXY(
+          SkRect::MakeXYWH(x + 4, y + 4, card_size - 8, card_size - 8), 12, 12);
+      canvas->drawRRect(rrect, fill);
+      canvas->drawRRect(rrect, stroke);
+      canvas->drawCircle(x + card_size / 2, y + card_size / 2, card_size / 4,
+                         stroke);
+    }
+  }
+
+  return recorder.finishRecordingAsPicture();
+}
+
+static void BM_EmbedderSoftwareRasterization(benchmark::State& state) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(),
+      fml::TimeDelta::FromMilliseconds(8));
+
+  const SkISize frame_size = SkISize::Make(1920, 1080);
+
+  EmbedderSurfaceSoftware::SoftwareDispatchTable dispatch_table = {
+      [](const void* allocation, size_t row_bytes, size_t height) -> bool {
+        return allocation != nullptr;
+      },
+  };
+
+  std::unique_ptr<EmbedderSurface> embedder_surface =
+      std::make_unique<EmbedderSurfaceSoftware>(dispatch_table,
+                                                state.range(0));
+  auto surface = embedder_surface->CreateGPUSurface();
+  FML_CHECK(surface);
+
+  auto root_layer = std::make_shared<ContainerLayer>();
+  root_layer->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0),
+      SkiaGPUObject<SkPicture>{CreateFramePicture(frame_size), unref_queue},
+      false, true));
+
+  LayerTree layer_tree;
+  layer_tree.set_root_layer(root_layer);
+  layer_tree.set_frame_size(frame_size);
+
+  CompositorContext compositor_context;
+
+  while (state.KeepRunning()) {
+    auto frame = surface->AcquireFrame(frame_size);
+    FML_CHECK(frame);
+    auto compositor_frame = compositor_context.AcquireFrame(
+        nullptr, frame->SkiaCanvas(), nullptr,
+        surface->GetRootTransformation(), false);
+    compositor_frame->Raster(layer_tree, false);
+    FML_CHECK(frame->Submit());
+  }
+
+  layer_tree.set_root_layer(nullptr);
+  root_layer.reset();
+  unref_queue->Drain();
+}
+
+BENCHMARK(BM_EmbedderSoftwareRasterization)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
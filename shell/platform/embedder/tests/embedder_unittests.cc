@@ -4,7 +4,11 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "embedder.h"
 #include "flutter/fml/file.h"
@@ -217,6 +221,132 @@ TEST_F(EmbedderTest, CanCreateOpenGLRenderingEngine) {
   ASSERT_TRUE(engine.is_valid());
 }
 
+TEST_F(EmbedderTest, CanCreateSoftwareEngineWithEmbedderBackingStores) {
+  EmbedderConfigBuilder builder(GetEmbedderContext());
+  builder.SetSoftwareBackingStoreCallbacks();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+}
+
+//------------------------------------------------------------------------------
+/// Renders frames into buffers supplied by the embedder. Like a typical
+/// embedder, the test rotates between three buffers and never hands out the
+/// buffer on screen or one the engine still references.
+///
+TEST_F(EmbedderTest, SoftwareEngineRendersIntoEmbedderBackingStores) {
+  static constexpr size_t kWidth = 64;
+  static constexpr size_t kHeight = 48;
+  static constexpr size_t kBufferCount = 3;
+  static constexpr size_t kFrameCount = 6;
+
+  struct Captures;
+  struct Buffer {
+    Captures* captures = nullptr;
+    size_t index = 0;
+    std::vector<uint32_t> pixels = std::vector<uint32_t>(kWidth * kHeight);
+    bool held_by_engine = false;
+  };
+  struct Captures {
+    std::mutex mutex;
+    Buffer buffers[kBufferCount];
+    size_t on_screen = kBufferCount;
+    size_t acquired_count = 0;
+    size_t destroyed_count = 0;
+    std::vector<size_t> presented;
+    bool presented_released_buffer = false;
+    bool presented_other_pixels = false;
+    fml::AutoResetWaitableEvent latch;
+  } captures;
+  for (size_t i = 0; i < kBufferCount; i++) {
+    captures.buffers[i].captures = &captures;
+    captures.buffers[i].index = i;
+  }
+
+  // Opaque red in the RGBA8888 byte order.
+  const uint8_t red_bytes[] = {0xFF, 0x00, 0x00, 0xFF};
+  uint32_t red = 0;
+  ::memcpy(&red, red_bytes, sizeof(red));
+
+  auto& context = GetEmbedderContext();
+  context.SetSoftwareBackingStoreCallbacks(
+      [&captures](size_t width, size_t height,
+                  FlutterSoftwareBackingStore* backing_store) -> bool {
+        if (width != kWidth || height != kHeight) {
+          return false;
+        }
+        std::scoped_lock lock(captures.mutex);
+        for (auto& buffer : captures.buffers) {
+          if (buffer.held_by_engine || buffer.index == captures.on_screen) {
+            continue;
+          }
+          buffer.held_by_engine = true;
+          std::fill(buffer.pixels.begin(), buffer.pixels.end(), 0u);
+          captures.acquired_count++;
+          backing_store->allocation = buffer.pixels.data();
+          backing_store->row_bytes = kWidth * sizeof(uint32_t);
+          backing_store->height = kHeight;
+          backing_store->pixel_format = kFlutterSoftwarePixelFormatRGBA8888;
+          backing_store->user_data = &buffer;
+          backing_store->destruction_callback = [](void* user_data) {
+            auto buffer = reinterpret_cast<Buffer*>(user_data);
+            std::scoped_lock lock(buffer->captures->mutex);
+            buffer->held_by_engine = false;
+            buffer->captures->destroyed_count++;
+          };
+          return true;
+        }
+        return false;
+      },
+      [&captures, red](const FlutterSoftwareBackingStore* backing_store) {
+        auto buffer = reinterpret_cast<Buffer*>(backing_store->user_data);
+        std::scoped_lock lock(captures.mutex);
+        if (!buffer->held_by_engine) {
+          captures.presented_released_buffer = true;
+        }
+        if (std::any_of(buffer->pixels.begin(), buffer->pixels.end(),
+                        [red](uint32_t pixel) { return pixel != red; })) {
+          captures.presented_other_pixels = true;
+        }
+        captures.on_screen = buffer->index;
+        captures.presented.push_back(buffer->index);
+        if (captures.presented.size() == kFrameCount) {
+          captures.latch.Signal();
+        }
+        return true;
+      });
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareBackingStoreCallbacks();
+  builder.SetDartEntrypoint("draw_solid_red");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = kWidth;
+  event.height = kHeight;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  captures.latch.Wait();
+  engine.reset();
+
+  std::scoped_lock lock(captures.mutex);
+  ASSERT_GE(captures.presented.size(), kFrameCount);
+  ASSERT_FALSE(captures.presented_released_buffer);
+  ASSERT_FALSE(captures.presented_other_pixels);
+  // Consecutive frames land in different buffers.
+  for (size_t i = 1; i < captures.presented.size(); i++) {
+    ASSERT_NE(captures.presented[i], captures.presented[i - 1]);
+  }
+  // Every buffer handed to the engine was released again.
+  ASSERT_EQ(captures.destroyed_count, captures.acquired_count);
+  for (const auto& buffer : captures.buffers) {
+    ASSERT_FALSE(buffer.held_by_engine);
+  }
+}
+
 TEST_F(EmbedderTest, IsolateServiceIdSent) {
   auto& context = GetEmbedderContext();
   fml::AutoResetWaitableEvent latch;
@@ -290,6 +420,61 @@ TEST_F(EmbedderTest, CanCreateAndCollectCallbacks) {
   ASSERT_EQ(result, kSuccess);
 }
 
+//------------------------------------------------------------------------------
+/// Asks a running engine for the memory held by each of its subsystems.
+///
+TEST_F(EmbedderTest, CanGetMemoryUsage) {
+  auto& context = GetEmbedderContext();
+  EmbedderConfigBuilder builder(context);
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  std::vector<std::string> names;
+  auto callback = [](const FlutterSubsystemMemoryUsage* usage,
+                     void* user_data) {
+    ASSERT_EQ(usage->struct_size, sizeof(FlutterSubsystemMemoryUsage));
+    reinterpret_cast<std::vector<std::string>*>(user_data)->push_back(
+        usage->name);
+  };
+  ASSERT_EQ(FlutterEngineGetMemoryUsage(engine.get(), callback, &names),
+            kSuccess);
+  ASSERT_NE(std::find(names.begin(), names.end(), "rasterCache"), names.end());
+  ASSERT_NE(std::find(names.begin(), names.end(), "textLayoutCache"),
+            names.end());
+
+  ASSERT_EQ(FlutterEngineGetMemoryUsage(engine.get(), nullptr, nullptr),
+            kInvalidArguments);
+}
+
+//------------------------------------------------------------------------------
+/// Records trace events natively while an engine is running and copies them
+/// out.
+///
+TEST_F(EmbedderTest, CanCopyNativeTraceEvents) {
+  FlutterEngineTraceSetNativeCategories("flutter");
+  auto& context = GetEmbedderContext();
+  EmbedderConfigBuilder builder(context);
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterEngineTraceEventDurationBegin("CanCopyNativeTraceEvents");
+  FlutterEngineTraceEventDurationEnd("CanCopyNativeTraceEvents");
+
+  std::string trace;
+  auto callback = [](const char* events, size_t length, void* user_data) {
+    reinterpret_cast<std::string*>(user_data)->assign(events, length);
+  };
+  ASSERT_EQ(FlutterEngineTraceCopyNativeEvents(true, callback, &trace),
+            kSuccess);
+  FlutterEngineTraceSetNativeCategories(nullptr);
+
+  ASSERT_EQ(trace.find("{\"traceEvents\":["), 0u);
+  ASSERT_NE(trace.find("\"name\":\"CanCopyNativeTraceEvents\""),
+            std::string::npos);
+  ASSERT_EQ(FlutterEngineTraceCopyNativeEvents(false, nullptr, nullptr),
+            kInvalidArguments);
+}
+
 //------------------------------------------------------------------------------
 /// Sends platform messages to Dart code than simply echoes the contents of the
 /// message back to the embedder. The embedder registers a native callback to
@@ -400,5 +585,80 @@ TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutResponseHandles) {
   message.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Sends a message to Dart code over a shared message channel. The Dart code
+/// echoes it back over a second channel, which the embedder reads.
+///
+TEST_F(EmbedderTest, SharedMessageChannelsRoundTripThroughDart) {
+  auto& context = GetEmbedderContext();
+  EmbedderConfigBuilder builder(context);
+  builder.SetDartEntrypoint("shared_message_channel_echo");
+
+  fml::AutoResetWaitableEvent ready, echoed;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "NotifySharedMessageEchoed",
+      CREATE_NATIVE_ENTRY(
+          [&echoed](Dart_NativeArguments args) { echoed.Signal(); }));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  FlutterSharedMessageChannel to_dart = nullptr;
+  FlutterSharedMessageChannel from_dart = nullptr;
+  ASSERT_EQ(FlutterEngineOpenSharedMessageChannel(
+                engine.get(), "embedder_to_dart", 1024,
+                kFlutterSharedMessageChannelSender, &to_dart),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineOpenSharedMessageChannel(
+                engine.get(), "dart_to_embedder", 1024,
+                kFlutterSharedMessageChannelReceiver, &from_dart),
+            kSuccess);
+
+  // The Dart code is already the receiver of the channel.
+  FlutterSharedMessageChannel second_receiver = nullptr;
+  ASSERT_EQ(FlutterEngineOpenSharedMessageChannel(
+                engine.get(), "embedder_to_dart", 1024,
+                kFlutterSharedMessageChannelReceiver, &second_receiver),
+            kInvalidArguments);
+
+  const std::string message = "Hello from embedder.";
+  bool written = false;
+  ASSERT_EQ(FlutterEngineSharedMessageChannelWrite(
+                to_dart, reinterpret_cast<const uint8_t*>(message.data()),
+                message.size(), &written),
+            kSuccess);
+  ASSERT_TRUE(written);
+  echoed.Wait();
+
+  std::string echo;
+  auto callback = [](const uint8_t* data, size_t size, void* user_data) {
+    reinterpret_cast<std::string*>(user_data)->assign(
+        reinterpret_cast<const char*>(data), size);
+  };
+  bool read = false;
+  ASSERT_EQ(
+      FlutterEngineSharedMessageChannelRead(from_dart, callback, &echo, &read),
+      kSuccess);
+  ASSERT_TRUE(read);
+  ASSERT_EQ(echo, message);
+  ASSERT_EQ(
+      FlutterEngineSharedMessageChannelRead(from_dart, callback, &echo, &read),
+      kSuccess);
+  ASSERT_FALSE(read);
+
+  // Each end only uses the side it claimed.
+  ASSERT_EQ(
+      FlutterEngineSharedMessageChannelRead(to_dart, callback, &echo, &read),
+      kInvalidArguments);
+
+  ASSERT_EQ(FlutterEngineCloseSharedMessageChannel(to_dart), kSuccess);
+  ASSERT_EQ(FlutterEngineCloseSharedMessageChannel(from_dart), kSuccess);
+}
+
 }  // namespace testing
 }  // namespace flutter
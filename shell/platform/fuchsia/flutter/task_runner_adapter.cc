@@ -23,12 +23,23 @@ class CompatTaskRunner : public fml::TaskRunner {
     async::PostTask(forwarding_target_, std::move(task));
   }
 
+  // Dispatchers have no notion of priorities.
+  void PostTask(fml::closure task, fml::TaskPriority priority) override {
+    PostTask(std::move(task));
+  }
+
   void PostTaskForTime(fml::closure task, fml::TimePoint target_time) override {
     async::PostTaskForTime(
         forwarding_target_, std::move(task),
         zx::time(target_time.ToEpochDelta().ToNanoseconds()));
   }
 
+  void PostTaskForTime(fml::closure task,
+                       fml::TimePoint target_time,
+                       fml::TaskPriority priority) override {
+    PostTaskForTime(std::move(task), target_time);
+  }
+
   void PostDelayedTask(fml::closure task, fml::TimeDelta delay) override {
     async::PostDelayedTask(forwarding_target_, std::move(task),
                            zx::duration(delay.ToNanoseconds()));
@@ -24,18 +24,33 @@ fi
 # Switch to buildroot dir. Some tests assume paths relative to buildroot.
 cd "$BUILDROOT_DIR"
 
+echo "Running assets_unittests..."
+"$HOST_DIR/assets_unittests"
+
+echo "Running assets_benchmarks..."
+"$HOST_DIR/assets_benchmarks"
+
 echo "Running embedder_unittests..."
 "$HOST_DIR/embedder_unittests"
 
+echo "Running embedder_benchmarks..."
+"$HOST_DIR/embedder_benchmarks"
+
 echo "Running flow_unittests..."
 "$HOST_DIR/flow_unittests"
 
+echo "Running flow_benchmarks..."
+"$HOST_DIR/flow_benchmarks"
+
 echo "Running fml_unittests..."
 "$HOST_DIR/fml_unittests" --gtest_filter="-*TimeSensitiveTest*"
 
 echo "Running fml_benchmarks..."
 "$HOST_DIR/fml_benchmarks"
 
+echo "Running fml_allocation_benchmarks..."
+"$HOST_DIR/fml_allocation_benchmarks"
+
 echo "Running runtime_unittests..."
 "$HOST_DIR/runtime_unittests"
 
@@ -45,6 +60,9 @@ echo "Running shell_unittests..."
 echo "Running shell_benchmarks..."
 "$HOST_DIR/shell_benchmarks"
 
+echo "Running layer_tree_replay_benchmarks..."
+"$HOST_DIR/layer_tree_replay_benchmarks"
+
 echo "Running client_wrapper_unittests..."
 "$HOST_DIR/client_wrapper_unittests"
 
@@ -57,6 +75,9 @@ echo "Running txt_unittests..."
 echo "Running ui_unittests..."
 "$HOST_DIR/ui_unittests"
 
+echo "Running ui_benchmarks..."
+"$HOST_DIR/ui_benchmarks"
+
 echo "Running txt_benchmarks..."
 "$HOST_DIR/txt_benchmarks" --font-directory="$BUILDROOT_DIR/flutter/third_party/txt/third_party/fonts"
 
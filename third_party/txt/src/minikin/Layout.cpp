@@ -98,6 +98,7 @@ class LayoutCacheKey {
     delete[] mChars;
     mChars = NULL;
   }
+  size_t textBytes() const { return mNchars * sizeof(uint16_t); }
 
   void doLayout(Layout* layout,
                 LayoutContext* ctx,
@@ -145,18 +146,27 @@ class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
       key.copyText();
       layout = new Layout();
       key.doLayout(layout, ctx, collection);
+      mBytes += entryBytes(key, *layout);
       mCache.put(key, layout);
     }
     return layout;
   }
 
+  size_t size() const { return mCache.size(); }
+  size_t bytes() const { return mBytes; }
+
  private:
   // callback for OnEntryRemoved
   void operator()(LayoutCacheKey& key, Layout*& value) {
+    mBytes -= entryBytes(key, *value);
     key.freeText();
     delete value;
   }
 
+  static size_t entryBytes(const LayoutCacheKey& key, const Layout& layout) {
+    return sizeof(Layout) + key.textBytes() + layout.getMemoryUsage();
+  }
+
   android::LruCache<LayoutCacheKey, Layout*> mCache;
 
   // static const size_t kMaxEntries = LruCache<LayoutCacheKey,
@@ -165,6 +175,8 @@ class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
   // TODO: eviction based on memory footprint; for now, we just use a constant
   // number of strings
   static const size_t kMaxEntries = 5000;
+
+  size_t mBytes = 0;
 };
 
 class LayoutEngine {
@@ -1201,4 +1213,17 @@ void Layout::purgeCaches() {
   purgeHbFontCacheLocked();
 }
 
+void Layout::getCacheUsage(size_t* entries, size_t* bytes) {
+  std::scoped_lock _l(gMinikinLock);
+  LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
+  *entries = layoutCache.size();
+  *bytes = layoutCache.bytes();
+}
+
+size_t Layout::getMemoryUsage() const {
+  return mGlyphs.capacity() * sizeof(LayoutGlyph) +
+         mAdvances.capacity() * sizeof(float) +
+         mFaces.capacity() * sizeof(FakedFont);
+}
+
 }  // namespace minikin
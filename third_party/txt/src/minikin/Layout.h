@@ -117,6 +117,12 @@ class Layout {
   // Purge all caches, useful in low memory conditions
   static void purgeCaches();
 
+  // The number of layouts in the layout cache and the bytes they hold
+  static void getCacheUsage(size_t* entries, size_t* bytes);
+
+  // The bytes held by the glyphs, advances and faces of this layout
+  size_t getMemoryUsage() const;
+
  private:
   friend class LayoutCacheKey;
 
@@ -126,6 +126,14 @@ void FontCollection::DisableFontFallback() {
   enable_font_fallback_ = false;
 }
 
+void FontCollection::SetFallbackFontHints(FallbackFontHints hints) {
+  fallback_font_hints_ = std::move(hints);
+}
+
+void FontCollection::SetFallbackFontListener(FallbackFontListener listener) {
+  fallback_font_listener_ = std::move(listener);
+}
+
 std::shared_ptr<minikin::FontCollection>
 FontCollection::GetMinikinFontCollectionForFamilies(
     const std::vector<std::string>& font_families,
@@ -251,9 +259,37 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
   return *match;
 }
 
+const std::shared_ptr<minikin::FontFamily>&
+FontCollection::MatchHintedFallbackFont(uint32_t ch,
+                                        const std::string& locale) {
+  auto hint = fallback_font_hints_.find(std::make_pair(locale, ch));
+  if (hint == fallback_font_hints_.end()) {
+    return g_null_family;
+  }
+  TRACE_EVENT0("flutter", "FontCollection::MatchHintedFallbackFont");
+
+  const std::string& family_name = hint->second;
+  for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
+    const std::shared_ptr<minikin::FontFamily>& family =
+        GetFallbackFontFamily(manager, family_name);
+    // The installed fonts may have changed since the hint was recorded.
+    if (family && family->hasGlyph(ch, 0)) {
+      fallback_fonts_for_locale_[locale].insert(family_name);
+      return family;
+    }
+  }
+  return g_null_family;
+}
+
 const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     uint32_t ch,
     std::string locale) {
+  const std::shared_ptr<minikin::FontFamily>& hinted_family =
+      MatchHintedFallbackFont(ch, locale);
+  if (hinted_family) {
+    return hinted_family;
+  }
+
   for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
     std::vector<const char*> bcp47;
     if (!locale.empty())
@@ -269,6 +305,10 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
 
     fallback_fonts_for_locale_[locale].insert(family_name);
 
+    if (fallback_font_listener_) {
+      fallback_font_listener_(ch, locale, family_name);
+    }
+
     return GetFallbackFontFamily(manager, family_name);
   }
   return g_null_family;
@@ -17,10 +17,13 @@
 #ifndef LIB_TXT_SRC_FONT_COLLECTION_H_
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include "flutter/fml/macros.h"
 #include "minikin/FontCollection.h"
 #include "minikin/FontFamily.h"
@@ -64,6 +67,20 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // missing from the requested font family.
   void DisableFontFallback();
 
+  // Families that previously matched characters during fallback, typically
+  // persisted by an earlier run, keyed by the locale and the character they
+  // were matched for. A hinted family is tried before asking the font
+  // managers to match the character, which can be slow.
+  using FallbackFontHints =
+      std::map<std::pair<std::string, uint32_t>, std::string>;
+  void SetFallbackFontHints(FallbackFontHints hints);
+
+  // Invoked whenever the font managers match a character to a fallback family.
+  using FallbackFontListener = std::function<void(uint32_t ch,
+                                                  const std::string& locale,
+                                                  const std::string& family)>;
+  void SetFallbackFontListener(FallbackFontListener listener);
+
   // Remove all entries in the font family cache.
   void ClearFontFamilyCache();
 
@@ -105,8 +122,16 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       fallback_fonts_;
   std::unordered_map<std::string, std::set<std::string>>
       fallback_fonts_for_locale_;
+  FallbackFontHints fallback_font_hints_;
+  FallbackFontListener fallback_font_listener_;
   bool enable_font_fallback_;
 
+  // Returns the hinted fallback family for ch if one of the font managers
+  // still provides it and it covers ch.
+  const std::shared_ptr<minikin::FontFamily>& MatchHintedFallbackFont(
+      uint32_t ch,
+      const std::string& locale);
+
   // Performs the actual work of MatchFallbackFont. The result is cached in
   // fallback_match_cache_.
   const std::shared_ptr<minikin::FontFamily>& DoMatchFallbackFont(